@@ -18,10 +18,12 @@
 /* ------- includes --------------------------------------------------------------------------------------------------*/
 
 #include "../Services/controller-service.h"
+#include "../Services/display-list-service.h"
+#include "../Services/format-service.h"
 #include "../Services/graph-service.h"
+#include "../Services/image-service.h"
 #include "../Services/time-service.h"
 #include "app-ui.h"
-#include <stdio.h>
 #include <string.h>
 
 
@@ -50,11 +52,25 @@
 #define PHASE_MAX                180
 #define PHASE_MIN                0
 
+#define UI_FIGURE_X0             33 // 图形查看边框内的起始列
+#define UI_FIGURE_X1             95 // 图形查看边框内的结束列
+#define UI_ADC_FULL_SCALE        4095 // 12位ADC满量程, Y-t显示中映射到第0行
+#define UI_GRATICULE_DIV         16   // Y-t刻度的格宽(像素)
+#define UI_GRATICULE_DOT         4    // Y-t刻度虚线的点距(像素)
+
+#define UI_LAYER_BACKGROUND      0 // 图形查看静态图层: 边框或刻度
+#define UI_LAYER_FIGURE          1 // 图形查看动态图层: 余辉, 连线或包络
+
 
 
 
 /* ------- macro -----------------------------------------------------------------------------------------------------*/
 
+// 判断两个矩形区域(包含边界)是否相交, 空区域不与任何区域相交
+#define RECT_INTERSECT(a, b)                                                                                           \
+    ((a).x0 <= (a).x1 && (b).x0 <= (b).x1 && (a).x0 <= (b).x1 && (b).x0 <= (a).x1 && (a).y0 <= (b).y1 &&             \
+     (b).y0 <= (a).y1)
+
 // 限幅自增, 最大选取不超过第6个索引
 #define UI_SELECTED_GOTO_NEXT(x)                                                                                       \
     do {                                                                                                               \
@@ -82,10 +98,31 @@
 static void actionWhileBrowse(void* argument);
 static void actionWhileEdit(void* argument);
 static void actionWhileFigureView(void* argument);
+static void decayFigure(UIAppParamTypeDef* pParam);
+static void decimateScope(UIAppParamTypeDef* pParam);
+static void drawScope(void* arg, const CanvasTypeDef* canvas, RectParamTypeDef area);
+#if STRIP_RENDER
+static void buildParamScene(UIAppParamTypeDef* pParam, uint8_t markIndex);
+static void buildFigureScene(UIAppParamTypeDef* pParam);
+static void buildSwitchScene(UIAppParamTypeDef* pParam);
+static void drawPhosphor(void* arg, const CanvasTypeDef* canvas, RectParamTypeDef area);
+#else
+static void renderFigure(UIAppParamTypeDef* pParam);
+static void drawFigure(UIAppParamTypeDef* pParam);
+static void renderSwitchFrame(UIAppParamTypeDef* pParam);
+static void renderFigureBackground(UIAppParamTypeDef* pParam);
+#endif /* STRIP_RENDER */
 
 static void browseAnimate(void* argument);
 
 static void updateSignal(void* argument);
+#if !STRIP_RENDER
+static void renderParamScreen(void* argument, uint8_t markIndex);
+#endif /* STRIP_RENDER */
+static uint8_t frameCacheMatches(const UIFrameCacheTypeDef* pCache, const int32_t* value, uint8_t markIndex,
+                                 const RoundedRectangleParaTypeDef* highlight);
+static int32_t getFieldValue(UIAppParamTypeDef* pParam, uint8_t index);
+static void formatField(uint8_t index, int32_t value, uint8_t marked);
 
 
 /* ------- variables -------------------------------------------------------------------------------------------------*/
@@ -125,68 +162,49 @@ static UISelDispInfoTypeDef uiSelInfoDispList[] = {
 };
 
 
-const uint8_t img[1024] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x40, 0xF0, 0x0C, 0x10, 0x50, 0x50, 0x54, 0x58, 0x50, 0x50, 0x10, 0x00, 0x80, 0x80, 0xBC, 0xA4, 0xA4,
-    0xA4, 0xA4, 0xA4, 0xBC, 0x80, 0x80, 0x00, 0x00, 0x10, 0x10, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xF0, 0x0C, 0x10, 0x50, 0x50, 0x54,
-    0x58, 0x50, 0x50, 0x10, 0x00, 0x80, 0x80, 0xBC, 0xA4, 0xA4, 0xA4, 0xA4, 0xA4, 0xBC, 0x80, 0x80, 0x00, 0x00, 0x30,
-    0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xBF, 0x80,
-    0x80, 0xBD, 0x95, 0x95, 0x95, 0x95, 0xBD, 0x80, 0x80, 0x80, 0x80, 0x86, 0x85, 0x84, 0x84, 0x84, 0xA4, 0xA4, 0x9C,
-    0x80, 0x80, 0x80, 0x88, 0x88, 0x8F, 0x88, 0x88, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xBF, 0x80, 0x80, 0xBD, 0x95, 0x95, 0x95, 0x95, 0xBD, 0x80, 0x80,
-    0x80, 0x80, 0x86, 0x85, 0x84, 0x84, 0x84, 0xA4, 0xA4, 0x9C, 0x80, 0x80, 0x80, 0x88, 0x8C, 0x8A, 0x89, 0x88, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x40, 0x78, 0x40, 0xFC, 0x48, 0x48, 0xE4,
-    0x34, 0xAC, 0x24, 0xE4, 0x00, 0x08, 0x28, 0x48, 0x68, 0x58, 0xCC, 0x48, 0x28, 0x48, 0x28, 0x08, 0x00, 0x00, 0x00,
-    0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0xA4, 0xA3, 0x90, 0x8B, 0x84, 0x82, 0xA7, 0x90, 0x8F, 0x90, 0xA7, 0x80,
-    0x88, 0x8A, 0x89, 0x8A, 0x8B, 0xBE, 0x8B, 0x8A, 0x89, 0x8A, 0x88, 0x80, 0x80, 0x80, 0x80, 0xFF, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00,
-    0x00, 0x00, 0xF0, 0x10, 0xFC, 0x10, 0xF0, 0x00, 0x74, 0x54, 0x54, 0x54, 0x74, 0x00, 0x00, 0xF8, 0x28, 0x28, 0xF8,
-    0xA8, 0xAC, 0xA8, 0xF8, 0x28, 0x28, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x87, 0x80, 0xBF,
-    0x84, 0x87, 0x80, 0xBF, 0x95, 0x9F, 0x95, 0xBF, 0x80, 0xA0, 0x9F, 0x80, 0xA2, 0xA6, 0xAA, 0x92, 0x92, 0xAA, 0xA6,
-    0xA0, 0x80, 0x80, 0x80, 0x80, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x20, 0xA0, 0xFC, 0x20, 0x00, 0xF8, 0x48, 0x48,
-    0x48, 0x48, 0xF8, 0x00, 0x40, 0xF0, 0x0C, 0x20, 0xA0, 0x20, 0x24, 0x28, 0x20, 0xA0, 0x20, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x3F, 0x01, 0x00, 0x3F, 0x12, 0x12, 0x12, 0x12, 0x3F, 0x00, 0x00,
-    0x3F, 0x00, 0x20, 0x21, 0x2E, 0x20, 0x30, 0x2C, 0x23, 0x20, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-
-
-// 点阵图像素数据
-static uint8_t dotMatrix[HEIGHT][WIDTH] = {0};
+// paramScreenImage: 128x64, 由img2rle.py从Tools/images/param-screen.pbm生成, 原始1024字节, 压缩后370字节
+static const uint8_t paramScreenImageData[354] = {
+    0x9B, 0x00, 0x00, 0xFF, 0x86, 0x00, 0x0E, 0x40, 0xF0, 0x0C, 0x10, 0x50, 0x50, 0x54, 0x58, 0x50, 0x50, 0x10, 0x00,
+    0x80, 0x80, 0xBC, 0x82, 0xA4, 0x07, 0xBC, 0x80, 0x80, 0x00, 0x00, 0x10, 0x10, 0xF8, 0x87, 0x00, 0x00, 0xFF, 0x86,
+    0x00, 0x0E, 0x40, 0xF0, 0x0C, 0x10, 0x50, 0x50, 0x54, 0x58, 0x50, 0x50, 0x10, 0x00, 0x80, 0x80, 0xBC, 0x82, 0xA4,
+    0x05, 0xBC, 0x80, 0x80, 0x00, 0x00, 0x30, 0x80, 0x08, 0x00, 0xF0, 0x87, 0x00, 0x9B, 0x80, 0x00, 0xFF, 0x87, 0x80,
+    0x03, 0xBF, 0x80, 0x80, 0xBD, 0x81, 0x95, 0x00, 0xBD, 0x81, 0x80, 0x01, 0x86, 0x85, 0x80, 0x84, 0x02, 0xA4, 0xA4,
+    0x9C, 0x80, 0x80, 0x04, 0x88, 0x88, 0x8F, 0x88, 0x88, 0x85, 0x80, 0x00, 0xFF, 0x87, 0x80, 0x03, 0xBF, 0x80, 0x80,
+    0xBD, 0x81, 0x95, 0x00, 0xBD, 0x81, 0x80, 0x01, 0x86, 0x85, 0x80, 0x84, 0x02, 0xA4, 0xA4, 0x9C, 0x80, 0x80, 0x04,
+    0x88, 0x8C, 0x8A, 0x89, 0x88, 0x87, 0x80, 0x80, 0x00, 0x16, 0x40, 0x78, 0x40, 0xFC, 0x48, 0x48, 0xE4, 0x34, 0xAC,
+    0x24, 0xE4, 0x00, 0x08, 0x28, 0x48, 0x68, 0x58, 0xCC, 0x48, 0x28, 0x48, 0x28, 0x08, 0x81, 0x00, 0x00, 0xFF, 0xAC,
+    0x00, 0x00, 0xFF, 0xAE, 0x00, 0x80, 0x80, 0x16, 0xA4, 0xA3, 0x90, 0x8B, 0x84, 0x82, 0xA7, 0x90, 0x8F, 0x90, 0xA7,
+    0x80, 0x88, 0x8A, 0x89, 0x8A, 0x8B, 0xBE, 0x8B, 0x8A, 0x89, 0x8A, 0x88, 0x81, 0x80, 0x00, 0xFF, 0xAC, 0x80, 0x00,
+    0xFF, 0xAE, 0x80, 0x80, 0x00, 0x06, 0xF0, 0x10, 0xFC, 0x10, 0xF0, 0x00, 0x74, 0x80, 0x54, 0x0C, 0x74, 0x00, 0x00,
+    0xF8, 0x28, 0x28, 0xF8, 0xA8, 0xAC, 0xA8, 0xF8, 0x28, 0x28, 0x81, 0x00, 0x00, 0xFF, 0xAC, 0x00, 0x00, 0xFF, 0xAE,
+    0x00, 0x80, 0x80, 0x16, 0x87, 0x80, 0xBF, 0x84, 0x87, 0x80, 0xBF, 0x95, 0x9F, 0x95, 0xBF, 0x80, 0xA0, 0x9F, 0x80,
+    0xA2, 0xA6, 0xAA, 0x92, 0x92, 0xAA, 0xA6, 0xA0, 0x81, 0x80, 0x00, 0xFF, 0xAC, 0x80, 0x00, 0xFF, 0xAE, 0x80, 0x80,
+    0x00, 0x05, 0x20, 0xA0, 0xFC, 0x20, 0x00, 0xF8, 0x81, 0x48, 0x0C, 0xF8, 0x00, 0x40, 0xF0, 0x0C, 0x20, 0xA0, 0x20,
+    0x24, 0x28, 0x20, 0xA0, 0x20, 0x81, 0x00, 0x00, 0xFF, 0xAC, 0x00, 0x00, 0xFF, 0xAE, 0x00, 0x80, 0x00, 0x05, 0x02,
+    0x01, 0x3F, 0x01, 0x00, 0x3F, 0x81, 0x12, 0x0C, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x20, 0x21, 0x2E, 0x20, 0x30, 0x2C,
+    0x23, 0x20, 0x81, 0x00, 0x00, 0xFF, 0xAC, 0x00, 0x00, 0xFF, 0xAE, 0x00};
+static const uint16_t paramScreenImagePageIndex[8] = {0, 70, 140, 176, 212, 248, 284, 319};
+const ImageAssetTypeDef paramScreenImage = {128, 64, paramScreenImagePageIndex, paramScreenImageData};
+
+
+#if !STRIP_RENDER
+// 页格式画布, 用作选择高亮掩码和图形查看的点阵
+static PageCanvasTypeDef dotMatrix = {0};
+static PageCanvasTypeDef figureBackground = {0}; // 图形查看静态图层
+#endif /* STRIP_RENDER */
 
 static uint8_t strBuffer[6][8];
 
+// 各字段字符串的打印范围, 依次为printStringOnBuffer的startX, startY, endX, endY
+static const RectParamTypeDef uiFieldLayoutList[UI_SELECT_INDEX_QUANTITY] = {
+    {30, 29, 79, 16},  // 信号1频率
+    {76, 29, 128, 16}, // 信号2频率
+    {30, 46, 79, 32},  // 信号1幅度
+    {76, 46, 128, 32}, // 信号2幅度
+    {30, 62, 79, 48},  // 信号1相位
+    {76, 62, 128, 48}, // 信号2相位
+};
+
 
 /* ------- function implement ----------------------------------------------------------------------------------------*/
 
@@ -199,11 +217,21 @@ void uiAppInit(void* argument) {
     UIAppParamTypeDef* pParam = (UIAppParamTypeDef*)argument;
 
 
-    memcpy(pParam->graphicsBuffers[0], img, sizeof(img)); // 初始化图形缓冲区
+#if STRIP_RENDER
+    displayListServIntf.clear(&pParam->displayList);
+    buildParamScene(pParam, UI_SELECT_INDEX_QUANTITY);          // 初始画面为参数界面
+    memset(&pParam->shownCache, 0, sizeof(pParam->shownCache)); // 尚未刷新, 第一帧总是刷新
+#else
+    imageServIntf.decode(&pParam->graphicsBuffers[0], &paramScreenImage, 0, 0, CANVAS_FULL_AREA); // 初始化图形缓冲区
+    memset(pParam->frameCache, 0, sizeof(pParam->frameCache)); // 参数界面缓存初始为无效
+#endif /* STRIP_RENDER */
+    memset(&pParam->renderStat, 0, sizeof(pParam->renderStat));
 
 
     pParam->browseAnimateTimer       = timeServIntf.softTimerRegister(); // 注册浏览动画定时器
     pParam->switchAnimateTimer       = timeServIntf.softTimerRegister(); // 注册切换动画定时器
+    pParam->phosphorTimer            = timeServIntf.softTimerRegister(); // 注册余辉衰减定时器
+    pParam->figureMode               = UI_FIGURE_PHOSPHOR;               // 图形查看默认为余辉点显示
 
     pParam->eventGroup               = 0;                                       // 初始化事件为无
     pParam->curState                 = UI_STATE_ADJUST_BROUWSE;                 // 初始状态为浏览状态
@@ -213,9 +241,18 @@ void uiAppInit(void* argument) {
     pParam->animateData.duration     = 0.3f; // 动画持续时间
     pParam->switchAnimData.duration  = 1.5f; // 切换动画持续时间
     pParam->switchAnimData.elapsed   = 10.0f;
-    pParam->dotMatrix                = dotMatrix; // 设置点阵图像素
+#if !STRIP_RENDER
+    pParam->dotMatrix                = CANVAS_FROM_ARRAY(dotMatrix);              // 设置点阵图像素
+    pParam->switchCanvas             = CANVAS_FROM_ARRAY(pParam->UISwitchBuffer); // 参数界面快照画布
+    pParam->figureBackground         = CANVAS_FROM_ARRAY(figureBackground);       // 图形查看静态图层画布
+    graphServIntf.layerInit(&pParam->figureLayers);
+    graphServIntf.layerAdd(&pParam->figureLayers, &pParam->figureBackground, RASTER_OP_COPY); // UI_LAYER_BACKGROUND
+    graphServIntf.layerAdd(&pParam->figureLayers, &pParam->dotMatrix, RASTER_OP_OR);          // UI_LAYER_FIGURE
+#endif /* STRIP_RENDER */
     pParam->switchAnimData.shift     = 0;
-    graphServIntf.drawRoundRect2DotMatrix(pParam->dotMatrix, 30, 16, 79, 32, 5, 0);
+#if !STRIP_RENDER
+    graphServIntf.drawRoundRect2DotMatrix(&pParam->dotMatrix, 30, 16, 79, 32, 5, 0);
+#endif /* STRIP_RENDER */
     ctrlServIntf.pidInit(&pParam->switchAnimData.shiftPID, 0.7f, 3.85f, 0.00f);
 
     pParam->signalInfo[0].freq  = 1.0f; // 初始化信号1频率
@@ -230,12 +267,19 @@ void uiAppInit(void* argument) {
  * @brief UI应用循环函数
  *
  * @param argument
+ * @return uint8_t 本帧画面需要提交时返回1
+ * @note 1. 每次循环切换到另一图形缓冲区渲染. 参数界面与最后提交的缓冲区内容相同时返回0, 并切换回该缓冲区,
+ *          主循环不提交也不触发帧调度, 下次循环仍渲染到同一缓冲区
+ *       2. 页带渲染时参数界面与最后刷新的画面相同时返回0, 主循环不刷新
+ *       3. 切换动画和图形查看每帧都在变化, 总是返回1
  */
-void uiAppLoop(void* argument) {
+uint8_t uiAppLoop(void* argument) {
     // 遍历状态机列表，检查每个状态机的条件函数
     UIAppParamTypeDef* pParam = (UIAppParamTypeDef*)argument;
 
-    pParam->bufferIndex       = !pParam->bufferIndex; // 切换图形缓冲区索引
+    pParam->bufferIndex                    = !pParam->bufferIndex; // 切换图形缓冲区索引
+    pParam->startLine[pParam->bufferIndex] = 0;                     // 仅切换动画使用非零起始行
+    pParam->frameChanged                   = 1;                     // 只有参数界面判断画面是否变化
 
     for (uint8_t i = 0; i < sizeof(uiStateMachineList) / sizeof(UIStateTransitionTypeDef); i++) {
         if (uiStateMachineList[i].curState == pParam->curState) {
@@ -249,6 +293,14 @@ void uiAppLoop(void* argument) {
     }
 
     pParam->eventGroup = 0;
+
+#if !STRIP_RENDER
+    if (!pParam->frameChanged) {
+        pParam->bufferIndex = !pParam->bufferIndex; // 不提交本帧, 最后提交的缓冲区仍为当前缓冲区
+    }
+#endif /* STRIP_RENDER */
+
+    return pParam->frameChanged;
 }
 
 /**
@@ -261,20 +313,39 @@ static void actionWhileBrowse(void* argument) {
 
     UIAppParamTypeDef* pParam = (UIAppParamTypeDef*)argument;
 
-    memset(pParam->dotMatrix, 0, HEIGHT * WIDTH);
-
     if (pParam->eventGroup & (1 << UI_EVENT_FIGURE_VIEW)) {
 
+        // 清空图形查看用画布和余辉
+#if !STRIP_RENDER
+        memset(pParam->dotMatrix.data, 0, sizeof(PageCanvasTypeDef));
+        renderFigureBackground(pParam); // 静态图层只在进入时渲染一次
+#endif /* STRIP_RENDER */
+        phosphorServIntf.init(&pParam->phosphor);
+        pParam->phosphorElapsed = 0.0f;
+        pParam->trace.head      = 0;
+        pParam->trace.count     = 0;
+        pParam->scope.fill      = 0;
+        pParam->scope.index     = 0;
+        pParam->scope.ready     = UI_SCOPE_NONE;
+        memset(pParam->scope.rowTop, 0xFF, sizeof(pParam->scope.rowTop)); // 第一个采样块抽取前不显示包络
+        memset(pParam->scope.rowBottom, 0, sizeof(pParam->scope.rowBottom));
+        timeServIntf.getElapsedTime(pParam->phosphorTimer); // 重置计时器
+
         // 启动采样定时器
         TIM_Cmd(TIM7, ENABLE);
 
-        // 将上一次计算完成的图形缓冲区复制到切换动画用缓冲区
-        memcpy(pParam->UISwitchBuffer[0], pParam->graphicsBuffers[!pParam->bufferIndex],
-               PAGE * WIDTH); // 将当前图形缓冲区复制到备用缓冲区
+        // 本帧仍显示参数界面. 上一帧可能是未完成的退出动画, 快照由本帧重新渲染的参数界面取得
+#if STRIP_RENDER
+        displayListServIntf.clear(&pParam->displayList);
+        buildParamScene(pParam, UI_SELECT_INDEX_QUANTITY);
+#else
+        renderParamScreen(argument, UI_SELECT_INDEX_QUANTITY);
+        graphServIntf.copyRect(&pParam->switchCanvas, &pParam->graphicsBuffers[pParam->bufferIndex], CANVAS_FULL_AREA);
+#endif /* STRIP_RENDER */
 
         // 设置切换动画数据
         pParam->switchAnimData.elapsed   = 0.0f;             // 重置切换动画计时器
-        pParam->switchAnimData.direction = UI_RIGHT_TO_LEFT; // 设置切换动画方向为从右到左
+        pParam->switchAnimData.direction = UI_RIGHT_TO_LEFT; // 图形查看界面从底部推入
         pParam->switchAnimData.shift     = 0;
 
         timeServIntf.getElapsedTime(pParam->switchAnimateTimer); // 重置计时器
@@ -284,6 +355,10 @@ static void actionWhileBrowse(void* argument) {
         return;
     }
 
+    if (pParam->eventGroup & (1 << UI_EVENT_VALUE_SELECT)) {
+        pParam->switchAnimData.elapsed = pParam->switchAnimData.duration; // 进入编辑状态时结束切换动画, 返回后不再继续
+    }
+
     if (pParam->switchAnimData.elapsed < pParam->switchAnimData.duration) { // 切换动画未完成
         // 如果切换动画还没有完成，更新切换动画数据
         float dt = timeServIntf.getElapsedTime(pParam->switchAnimateTimer); // 获取时间间隔
@@ -300,9 +375,14 @@ static void actionWhileBrowse(void* argument) {
             pParam->switchAnimData.shift = 127; // 限制偏移量不大于128
         }
 
-        graphServIntf.blendImagesWithSineScroll(pParam->UISwitchBuffer[1], pParam->UISwitchBuffer[0],
-                                                pParam->switchAnimData.shift, pParam->switchAnimData.direction,
-                                                pParam->graphicsBuffers[pParam->bufferIndex]);
+#if STRIP_RENDER
+        buildSwitchScene(pParam); // 采样已停止, 图形查看界面保持为最后的内容
+#else
+        // 采样已停止, 图形查看界面按当前内容重绘, 余辉的FRC相位与页带渲染一致
+        drawFigure(pParam);
+        renderSwitchFrame(pParam);
+        pParam->frameCache[pParam->bufferIndex].valid = 0; // 缓冲区被动画覆盖, 缓存失效
+#endif /* STRIP_RENDER */
 
 
 
@@ -310,41 +390,14 @@ static void actionWhileBrowse(void* argument) {
     } else {
 
 
-        memcpy(pParam->graphicsBuffers[pParam->bufferIndex], img, sizeof(img)); // 恢复图形缓冲区
-
-        sprintf((char*)(strBuffer[0]), "%.1fkHz", pParam->signalInfo[0].freq);
-        sprintf((char*)(strBuffer[1]), "%.1fkHz", pParam->signalInfo[1].freq);
-        sprintf((char*)(strBuffer[2]), "%.1f V", pParam->signalInfo[0].amp);
-        sprintf((char*)(strBuffer[3]), "%.1f V", pParam->signalInfo[1].amp);
-        sprintf((char*)(strBuffer[4]), "%d °", pParam->signalInfo[0].phase);
-        sprintf((char*)(strBuffer[5]), "%d °", pParam->signalInfo[1].phase);
-
-
-        graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[0], 30,
-                                          29, 79, 16);
-        graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[1], 76,
-                                          29, 128, 16);
-        graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[2], 30,
-                                          46, 79, 32);
-        graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[3], 76,
-                                          46, 128, 32);
-        graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[4], 30,
-                                          62, 79, 48);
-        graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[5], 76,
-                                          62, 128, 48);
-
-
-
         browseAnimate(argument); // 浏览动画处理
 
-        // 绘制当前选择信息的圆角矩形
-        graphServIntf.drawRoundRect2DotMatrix(pParam->dotMatrix, pParam->selDispInfo.rectParam.startX,
-                                              pParam->selDispInfo.rectParam.startY, pParam->selDispInfo.rectParam.endX,
-                                              pParam->selDispInfo.rectParam.endY, pParam->selDispInfo.rectParam.radius,
-                                              1);
-
-        // 将圆角矩形区域颜色反转
-        graphServIntf.InverBufferWithMask(pParam->dotMatrix, pParam->graphicsBuffers[pParam->bufferIndex]);
+#if STRIP_RENDER
+        displayListServIntf.clear(&pParam->displayList);
+        buildParamScene(pParam, UI_SELECT_INDEX_QUANTITY);
+#else
+        renderParamScreen(argument, UI_SELECT_INDEX_QUANTITY); // 增量渲染参数界面
+#endif /* STRIP_RENDER */
     }
 }
 
@@ -356,49 +409,14 @@ static void actionWhileBrowse(void* argument) {
 static void actionWhileEdit(void* argument) {
     UIAppParamTypeDef* pParam = (UIAppParamTypeDef*)argument;
 
-    memset(pParam->dotMatrix, 0, HEIGHT * WIDTH);
-
-    memcpy(pParam->graphicsBuffers[pParam->bufferIndex], img, sizeof(img)); // 恢复图形缓冲区
-
     updateSignal(argument);
 
-
-    sprintf((char*)(strBuffer[0]), "%.1fkHz", pParam->signalInfo[0].freq);
-    sprintf((char*)(strBuffer[1]), "%.1fkHz", pParam->signalInfo[1].freq);
-    sprintf((char*)(strBuffer[2]), "%.1f V", pParam->signalInfo[0].amp);
-    sprintf((char*)(strBuffer[3]), "%.1f V", pParam->signalInfo[1].amp);
-    sprintf((char*)(strBuffer[4]), "%d °", pParam->signalInfo[0].phase);
-    sprintf((char*)(strBuffer[5]), "%d °", pParam->signalInfo[1].phase);
-
-    for (uint8_t i = sizeof(strBuffer) / sizeof(strBuffer[0]); i > 0; i--) {
-        if (strBuffer[pParam->selectIndex][i - 1] != '\0') {
-            strBuffer[pParam->selectIndex][i] = '*';
-            break;
-        }
-    }
-
-    graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[0], 30, 29,
-                                      79, 16);
-    graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[1], 76, 29,
-                                      128, 16);
-    graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[2], 30, 46,
-                                      79, 32);
-    graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[3], 76, 46,
-                                      128, 32);
-    graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[4], 30, 62,
-                                      79, 48);
-    graphServIntf.printStringOnBuffer(pParam->graphicsBuffers[pParam->bufferIndex], (const char*)strBuffer[5], 76, 62,
-                                      128, 48);
-
-
-
-    // 绘制当前选择信息的圆角矩形
-    graphServIntf.drawRoundRect2DotMatrix(pParam->dotMatrix, pParam->selDispInfo.rectParam.startX,
-                                          pParam->selDispInfo.rectParam.startY, pParam->selDispInfo.rectParam.endX,
-                                          pParam->selDispInfo.rectParam.endY, pParam->selDispInfo.rectParam.radius, 1);
-
-    // 将圆角矩形区域颜色反转
-    graphServIntf.InverBufferWithMask(pParam->dotMatrix, pParam->graphicsBuffers[pParam->bufferIndex]);
+#if STRIP_RENDER
+    displayListServIntf.clear(&pParam->displayList);
+    buildParamScene(pParam, pParam->selectIndex); // 当前字段附加编辑标记
+#else
+    renderParamScreen(argument, pParam->selectIndex); // 增量渲染参数界面, 当前字段附加编辑标记
+#endif /* STRIP_RENDER */
 }
 
 
@@ -410,27 +428,52 @@ static void actionWhileEdit(void* argument) {
 static void actionWhileFigureView(void* argument) {
     UIAppParamTypeDef* pParam = (UIAppParamTypeDef*)argument;
 
+#if !STRIP_RENDER
+    pParam->frameCache[pParam->bufferIndex].valid = 0; // 图形查看会覆盖当前缓冲区, 参数界面缓存失效
+#endif /* STRIP_RENDER */
+
     // 退出图形查看状态时间
     if (pParam->eventGroup & (1 << UI_EVENT_FIGURE_EXIT)) {
 
         // 启动采样定时器
         TIM_Cmd(TIM7, DISABLE);
 
-        // 将上一次计算完成的图形缓冲区复制到切换动画用缓冲区
-        memcpy(pParam->UISwitchBuffer[1], pParam->graphicsBuffers[!pParam->bufferIndex],
-               PAGE * WIDTH); // 将当前图形缓冲区复制到备用缓冲区
-
         // 设置切换动画数据
         pParam->switchAnimData.elapsed   = 0.0f;             // 重置切换动画计时器
-        pParam->switchAnimData.direction = UI_LEFT_TO_RIGHT; // 设置切换动画方向为从右到左
+        pParam->switchAnimData.direction = UI_LEFT_TO_RIGHT; // 参数界面从顶部推入
         pParam->switchAnimData.shift     = 127;              // 设置切换动画偏移量为127
 
         timeServIntf.getElapsedTime(pParam->switchAnimateTimer); // 重置计时器
         ctrlServIntf.pidReset(&pParam->switchAnimData.shiftPID); // 重置PID控制器
 
+        // 本帧仍显示完整的图形查看界面, 退出动画从此开始
+#if STRIP_RENDER
+        decayFigure(pParam);
+        decimateScope(pParam);
+        displayListServIntf.clear(&pParam->displayList);
+        buildFigureScene(pParam);
+#else
+        renderFigure(pParam);
+        graphServIntf.layerCompose(&pParam->figureLayers, pParam->bufferIndex,
+                                   &pParam->graphicsBuffers[pParam->bufferIndex]);
+#endif /* STRIP_RENDER */
+
         return;
     }
 
+    // 旋转编码器依次切换余辉点显示, 连线显示与Y-t显示
+    if (pParam->eventGroup & (1 << UI_EVENT_SELECT_NEXT)) {
+        pParam->figureMode = (pParam->figureMode == UI_FIGURE_YT) ? UI_FIGURE_PHOSPHOR : pParam->figureMode + 1;
+    } else if (pParam->eventGroup & (1 << UI_EVENT_SELECT_PREV)) {
+        pParam->figureMode = (pParam->figureMode == UI_FIGURE_PHOSPHOR) ? UI_FIGURE_YT : pParam->figureMode - 1;
+    }
+#if !STRIP_RENDER
+    if (pParam->eventGroup & ((1 << UI_EVENT_SELECT_NEXT) | (1 << UI_EVENT_SELECT_PREV))) {
+        memset(pParam->dotMatrix.data, 0, sizeof(PageCanvasTypeDef)); // Y-t显示使用边框外的列, 切换时整体清空
+        renderFigureBackground(pParam);                                // 边框与刻度随模式切换
+    }
+#endif /* STRIP_RENDER */
+
 
     if (pParam->switchAnimData.elapsed < pParam->switchAnimData.duration) {
         // 如果切换动画还没有完成，更新切换动画数据
@@ -447,26 +490,370 @@ static void actionWhileFigureView(void* argument) {
         }
 
 
-        graphServIntf.drawRoundRect2DotMatrix(pParam->dotMatrix, 32, 1, 96, 64, 8, 0);
-        graphServIntf.bitToByte(pParam->dotMatrix, pParam->UISwitchBuffer[1]);
-
-        graphServIntf.blendImagesWithSineScroll(pParam->UISwitchBuffer[0], pParam->UISwitchBuffer[1],
-                                                pParam->switchAnimData.shift, pParam->switchAnimData.direction,
-                                                pParam->graphicsBuffers[pParam->bufferIndex]);
+#if STRIP_RENDER
+        decayFigure(pParam);
+        decimateScope(pParam);
+        buildSwitchScene(pParam);
+#else
+        renderFigure(pParam);
+        renderSwitchFrame(pParam);
+#endif /* STRIP_RENDER */
 
         // 计算切换动画位置
     } else {
-#if 1
-        graphServIntf.drawRoundRect2DotMatrix(pParam->dotMatrix, 32, 0, 96, 63, 8, 0);
-        graphServIntf.bitToByte(pParam->dotMatrix, pParam->graphicsBuffers[pParam->bufferIndex]);
+#if STRIP_RENDER
+        decayFigure(pParam);
+        decimateScope(pParam);
+        displayListServIntf.clear(&pParam->displayList);
+        buildFigureScene(pParam);
 #else
-        memset(pParam->dotMatrix, 0x1, HEIGHT * WIDTH); // 清空图形缓冲区
-        graphServIntf.bitToByte(pParam->dotMatrix, pParam->graphicsBuffers[pParam->bufferIndex]);
-#endif
+        renderFigure(pParam);
+        graphServIntf.layerCompose(&pParam->figureLayers, pParam->bufferIndex,
+                                   &pParam->graphicsBuffers[pParam->bufferIndex]);
+#endif /* STRIP_RENDER */
     }
 }
 
 
+#if !STRIP_RENDER
+/**
+ * @brief 以显示起始行实现的纵向推入切换帧
+ *
+ * @param pParam
+ * @note 1. 进度k = shift * HEIGHT / 127行. 新界面从底部推入时显存第0~k-1行取新界面, 其余取旧界面,
+ *          起始行为k; 从顶部推入时显存第64-k~63行取新界面, 起始行为64-k. 两个界面均按原行号写入显存,
+ *          屏幕的循环行映射完成整屏平移, 不需要逐帧搬移图像
+ *       2. 两个方向中分界之上均为图形查看界面: 先由图层合成整帧, 再以参数界面快照覆盖分界及之下的行.
+ *          每帧显存只有分界所在的页和图形中变化的页内容改变, 其余页由刷新时的CRC比较跳过
+ *       3. 起始行随本缓冲区一同发送, 动画结束后的第一帧恢复为0
+ */
+static void renderSwitchFrame(UIAppParamTypeDef* pParam) {
+    uint8_t rows                = (uint16_t)pParam->switchAnimData.shift * HEIGHT / 127;
+    uint8_t fromTop             = pParam->switchAnimData.direction == UI_LEFT_TO_RIGHT;
+    uint8_t split               = fromTop ? HEIGHT - rows : rows; // 显存中两个界面的分界行
+    const CanvasTypeDef* buffer = &pParam->graphicsBuffers[pParam->bufferIndex];
+
+    graphServIntf.layerInvalidateTarget(&pParam->figureLayers, pParam->bufferIndex); // 缓冲区中有参数界面的行
+    if (split > 0) {
+        graphServIntf.layerCompose(&pParam->figureLayers, pParam->bufferIndex, buffer);
+    }
+    if (split < HEIGHT) {
+        graphServIntf.copyRect(buffer, &pParam->switchCanvas, (RectParamTypeDef){0, split, WIDTH - 1, HEIGHT - 1});
+    }
+
+    pParam->startLine[pParam->bufferIndex] = split % HEIGHT;
+}
+
+/**
+ * @brief 更新采样数据并渲染图形查看区域
+ *
+ * @param pParam
+ * @note 余辉无论何种模式都持续衰减, 写满的Y-t采样块无论何种模式都及时抽取
+ */
+static void renderFigure(UIAppParamTypeDef* pParam) {
+    decayFigure(pParam);
+    decimateScope(pParam);
+    drawFigure(pParam);
+}
+
+/**
+ * @brief 按显示模式将采样数据绘制到点阵画布的图形查看区域
+ *
+ * @param pParam
+ * @note 1. 连线模式将队列中的采样点按时间顺序整批绘制为折线, 队列回绕处单独连接一段
+ *       2. Y-t模式使用整个画布. 边框和刻度位于静态图层, 不在此绘制
+ */
+static void drawFigure(UIAppParamTypeDef* pParam) {
+    const CanvasTypeDef* canvas = &pParam->dotMatrix;
+
+    graphServIntf.layerMarkDirty(&pParam->figureLayers, UI_LAYER_FIGURE, CANVAS_FULL_AREA); // 动态图层每帧重绘
+
+    if (pParam->figureMode == UI_FIGURE_YT) {
+        memset(canvas->data, 0, sizeof(PageCanvasTypeDef));
+        drawScope(&pParam->scope, canvas, CANVAS_FULL_AREA);
+        return;
+    }
+
+    for (uint8_t page = 0; page < PAGE; page++) {
+        memset(CANVAS_PAGE(canvas, page) + UI_FIGURE_X0, 0, UI_FIGURE_X1 - UI_FIGURE_X0 + 1);
+    }
+
+    if (pParam->figureMode == UI_FIGURE_PHOSPHOR) {
+        phosphorServIntf.render(&pParam->phosphor, canvas, CANVAS_FULL_AREA);
+        return;
+    }
+
+    UITraceTypeDef* trace = &pParam->trace;
+    uint16_t head         = trace->head;
+    uint16_t count        = trace->count;
+
+    if (count < UI_TRACE_LEN) {
+        graphServIntf.drawPolyline(canvas, trace->point, head);
+        return;
+    }
+
+    // 队列已满, 最旧的点位于head处
+    graphServIntf.drawPolyline(canvas, &trace->point[head], UI_TRACE_LEN - head);
+    if (head != 0) {
+        graphServIntf.drawLine(canvas, trace->point[UI_TRACE_LEN - 1].x, trace->point[UI_TRACE_LEN - 1].y,
+                               trace->point[0].x, trace->point[0].y);
+        graphServIntf.drawPolyline(canvas, trace->point, head);
+    }
+}
+
+/**
+ * @brief 按显示模式渲染图形查看的静态图层
+ *
+ * @param pParam
+ * @note 进入图形查看和切换显示模式时调用, 其余帧只合成不重绘. 余辉和连线模式为边框, Y-t模式为刻度
+ */
+static void renderFigureBackground(UIAppParamTypeDef* pParam) {
+    const CanvasTypeDef* canvas = &pParam->figureBackground;
+
+    memset(canvas->data, 0, sizeof(PageCanvasTypeDef));
+    if (pParam->figureMode == UI_FIGURE_YT) {
+        graphServIntf.drawGraticule(canvas, CANVAS_FULL_AREA, UI_GRATICULE_DIV, UI_GRATICULE_DOT);
+    } else {
+        graphServIntf.drawRoundRect2DotMatrix(canvas, 32, 0, 96, 63, 8, 0);
+    }
+
+    graphServIntf.layerMarkDirty(&pParam->figureLayers, UI_LAYER_BACKGROUND, CANVAS_FULL_AREA);
+}
+#else
+/**
+ * @brief 向显示列表添加参数界面
+ *
+ * @param pParam
+ * @param markIndex 附加编辑标记'*'的字段索引, 为UI_SELECT_INDEX_QUANTITY时不附加
+ * @note 背景图, 各字段字符串和异或高亮依次添加, 逐页渲染时每页重新执行与该页相交的命令.
+ *       字符串引用strBuffer, 在下一次添加参数界面前保持不变. 与shownCache比较得出画面是否变化, 然后更新shownCache
+ */
+static void buildParamScene(UIAppParamTypeDef* pParam, uint8_t markIndex) {
+    DisplayListTypeDef* list    = &pParam->displayList;
+    UIFrameCacheTypeDef* pShown = &pParam->shownCache;
+    int32_t value[UI_SELECT_INDEX_QUANTITY];
+
+    for (uint8_t i = 0; i < UI_SELECT_INDEX_QUANTITY; i++) {
+        value[i] = getFieldValue(pParam, i);
+    }
+
+    // 与最后刷新的参数界面相同时本帧无需刷新
+    pParam->frameChanged = !frameCacheMatches(pShown, value, markIndex, &pParam->selDispInfo.rectParam);
+    if (!pParam->frameChanged) {
+        pParam->renderStat.framesSkipped++;
+    }
+
+    displayListServIntf.addImage(list, &paramScreenImage, 0, 0, CANVAS_FULL_AREA);
+
+    for (uint8_t i = 0; i < UI_SELECT_INDEX_QUANTITY; i++) {
+        formatField(i, value[i], i == markIndex);
+        displayListServIntf.addText(list, &fontUI16, (const char*)strBuffer[i], uiFieldLayoutList[i].x0,
+                                    uiFieldLayoutList[i].y0, uiFieldLayoutList[i].x1, uiFieldLayoutList[i].y1);
+        pShown->field[i].value  = value[i];
+        pShown->field[i].marked = (i == markIndex);
+    }
+
+    // 将当前选择信息的圆角矩形区域颜色反转
+    displayListServIntf.addFillRoundRect(list, pParam->selDispInfo.rectParam.startX,
+                                         pParam->selDispInfo.rectParam.startY, pParam->selDispInfo.rectParam.endX,
+                                         pParam->selDispInfo.rectParam.endY, pParam->selDispInfo.rectParam.radius,
+                                         RASTER_OP_XOR);
+    pShown->highlight = pParam->selDispInfo.rectParam;
+    pShown->valid     = 1;
+
+    pParam->renderStat.frames++;
+    pParam->renderStat.fieldRendered += UI_SELECT_INDEX_QUANTITY;
+}
+
+/**
+ * @brief 向显示列表添加图形查看界面
+ *
+ * @param pParam
+ * @note 1. 余辉模式以自定义绘制命令按页渲染亮度缓冲区; 连线模式与renderFigure相同, 按时间顺序添加折线
+ *       2. 折线引用采样点队列, 逐页渲染期间采样中断仍在写入, 各页可能取到相差几个采样点的内容
+ */
+static void buildFigureScene(UIAppParamTypeDef* pParam) {
+    DisplayListTypeDef* list = &pParam->displayList;
+    UITraceTypeDef* trace    = &pParam->trace;
+    uint16_t head            = trace->head;
+    uint16_t count           = trace->count;
+
+    pParam->shownCache.valid = 0; // 屏幕上不再只有参数界面
+
+    if (pParam->figureMode == UI_FIGURE_YT) {
+        displayListServIntf.addCallback(list, drawScope, &pParam->scope, CANVAS_FULL_AREA);
+        return; // Y-t模式使用整个画布, 不绘制边框
+    }
+
+    if (pParam->figureMode == UI_FIGURE_PHOSPHOR) {
+        displayListServIntf.addCallback(list, drawPhosphor, &pParam->phosphor,
+                                        phosphorServIntf.area(&pParam->phosphor));
+    } else if (count < UI_TRACE_LEN) {
+        displayListServIntf.addPolyline(list, trace->point, head);
+    } else {
+        // 队列已满, 最旧的点位于head处
+        displayListServIntf.addPolyline(list, &trace->point[head], UI_TRACE_LEN - head);
+        if (head != 0) {
+            displayListServIntf.addLine(list, trace->point[UI_TRACE_LEN - 1].x, trace->point[UI_TRACE_LEN - 1].y,
+                                        trace->point[0].x, trace->point[0].y);
+            displayListServIntf.addPolyline(list, trace->point, head);
+        }
+    }
+
+    displayListServIntf.addRoundRect(list, 32, 0, 96, 63, 8);
+}
+
+/**
+ * @brief 向显示列表添加以显示起始行实现的纵向推入切换帧
+ *
+ * @param pParam
+ * @note 分界与起始行的计算同renderSwitchFrame. 两个方向中显存分界之上均为图形查看界面, 分界及之下均为参数界面,
+ *       两个界面各自以裁剪命令限定在所属的行内
+ */
+static void buildSwitchScene(UIAppParamTypeDef* pParam) {
+    DisplayListTypeDef* list = &pParam->displayList;
+    uint8_t rows             = (uint16_t)pParam->switchAnimData.shift * HEIGHT / 127;
+    uint8_t fromTop          = pParam->switchAnimData.direction == UI_LEFT_TO_RIGHT;
+    uint8_t split            = fromTop ? HEIGHT - rows : rows; // 显存中两个界面的分界行
+
+    displayListServIntf.clear(list);
+
+    if (split > 0) {
+        displayListServIntf.addClip(list, (RectParamTypeDef){0, 0, WIDTH - 1, split - 1});
+        buildFigureScene(pParam);
+    }
+    if (split < HEIGHT) {
+        displayListServIntf.addClip(list, (RectParamTypeDef){0, split, WIDTH - 1, HEIGHT - 1});
+        buildParamScene(pParam, UI_SELECT_INDEX_QUANTITY);
+    }
+
+    pParam->startLine[pParam->bufferIndex] = split % HEIGHT;
+    pParam->frameChanged                   = 1; // 切换帧每帧刷新, 之后的参数界面与之比较总是不同
+    pParam->shownCache.valid               = 0;
+}
+
+/**
+ * @brief 显示列表的余辉绘制命令
+ *
+ * @param arg 余辉亮度缓冲区
+ * @param canvas 目标画布
+ * @param area 允许写入的区域
+ */
+static void drawPhosphor(void* arg, const CanvasTypeDef* canvas, RectParamTypeDef area) {
+    phosphorServIntf.render((PhosphorTypeDef*)arg, canvas, area);
+}
+#endif /* STRIP_RENDER */
+
+/**
+ * @brief 余辉衰减
+ *
+ * @param pParam
+ * @note 经过的时间按PHOSPHOR_DECAY_PERIOD折算为衰减周期, 余数留到下一帧
+ */
+static void decayFigure(UIAppParamTypeDef* pParam) {
+    uint8_t ticks = 0;
+
+    pParam->phosphorElapsed += timeServIntf.getElapsedTime(pParam->phosphorTimer);
+    while (pParam->phosphorElapsed >= PHOSPHOR_DECAY_PERIOD && ticks < UINT8_MAX) {
+        pParam->phosphorElapsed -= PHOSPHOR_DECAY_PERIOD;
+        ticks++;
+    }
+
+    phosphorServIntf.decay(&pParam->phosphor, ticks);
+}
+
+/**
+ * @brief 将写满的Y-t采样块抽取为各通道的包络
+ *
+ * @param pParam
+ * @note 每个采样块只抽取一次, 抽取在UI循环中进行, 完成后采样中断才能发布下一个写满的块
+ */
+static void decimateScope(UIAppParamTypeDef* pParam) {
+    UIScopeTypeDef* scope = &pParam->scope;
+    uint8_t ready         = scope->ready;
+    EnvelopeTypeDef envelope;
+
+    if (ready == UI_SCOPE_NONE) {
+        return;
+    }
+
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        decimateServIntf.minMax(&scope->sample[ready][0][ch], 2, UI_SCOPE_BLOCK_LEN, &envelope);
+        decimateServIntf.toRows(&envelope, UI_ADC_FULL_SCALE, 0, HEIGHT - 1, scope->rowTop[ch], scope->rowBottom[ch]);
+    }
+
+    scope->ready = UI_SCOPE_NONE;
+}
+
+/**
+ * @brief 绘制两个通道的Y-t包络
+ *
+ * @param arg Y-t采样块和包络
+ * @param canvas 目标画布
+ * @param area 允许写入的区域, 行范围由裁剪矩形限定
+ */
+static void drawScope(void* arg, const CanvasTypeDef* canvas, RectParamTypeDef area) {
+    UIScopeTypeDef* scope = (UIScopeTypeDef*)arg;
+    uint8_t count         = area.x1 - area.x0 + 1;
+
+#if STRIP_RENDER
+    // 页带渲染没有静态图层, 刻度随包络逐页绘制
+    graphServIntf.drawGraticule(canvas, area, UI_GRATICULE_DIV, UI_GRATICULE_DOT);
+#endif /* STRIP_RENDER */
+
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        graphServIntf.fillColumnSpans(canvas, area.x0, count, &scope->rowTop[ch][area.x0],
+                                      &scope->rowBottom[ch][area.x0]);
+    }
+}
+
+/**
+ * @brief 插入XY采样点
+ *
+ * @param argument
+ * @param x
+ * @param y
+ * @note 在采样中断中调用, 只记录数据, 绘制由UI循环按采样块批量完成
+ */
+void uiAppInsertSample(void* argument, uint8_t x, uint8_t y) {
+    UIAppParamTypeDef* pParam = (UIAppParamTypeDef*)argument;
+    UITraceTypeDef* trace     = &pParam->trace;
+
+    phosphorServIntf.hit(&pParam->phosphor, x, y);
+
+    trace->point[trace->head].x = x;
+    trace->point[trace->head].y = y;
+    trace->head                 = (trace->head + 1 == UI_TRACE_LEN) ? 0 : trace->head + 1;
+    if (trace->count < UI_TRACE_LEN) {
+        trace->count++;
+    }
+}
+
+/**
+ * @brief 插入Y-t采样点
+ *
+ * @param argument
+ * @param signal1 信号1的ADC值
+ * @param signal2 信号2的ADC值
+ * @note 在采样中断中调用. 块写满后若上一个块已被抽取则发布该块并改写另一个块,
+ *       否则UI循环尚未取走上一个块, 丢弃本块重新写入
+ */
+void uiAppInsertScopeSample(void* argument, uint16_t signal1, uint16_t signal2) {
+    UIScopeTypeDef* scope = &((UIAppParamTypeDef*)argument)->scope;
+
+    scope->sample[scope->fill][scope->index][0] = signal1;
+    scope->sample[scope->fill][scope->index][1] = signal2;
+
+    if (++scope->index < UI_SCOPE_BLOCK_LEN) {
+        return;
+    }
+
+    scope->index = 0;
+    if (scope->ready == UI_SCOPE_NONE) {
+        scope->ready = scope->fill;
+        scope->fill  = !scope->fill;
+    }
+}
 
 /**
  * @brief 浏览动画处理函数
@@ -659,3 +1046,163 @@ void updateSignal(void* argument) {
         }
     }
 }
+
+
+
+#if !STRIP_RENDER
+/**
+ * @brief 参数界面增量渲染函数
+ *
+ * @param argument
+ * @param markIndex 附加编辑标记'*'的字段索引, 为UI_SELECT_INDEX_QUANTITY时不附加
+ * @note 每个图形缓冲区保留各字段上次渲染的数值和覆盖区域, 只有数值或编辑标记变化的字段才恢复背景并重绘.
+ *       高亮以异或方式绘制, 先异或一次旧高亮将其撤销, 更新字段后再异或新高亮
+ */
+static void renderParamScreen(void* argument, uint8_t markIndex) {
+    UIAppParamTypeDef* pParam   = (UIAppParamTypeDef*)argument;
+    UIFrameCacheTypeDef* pCache = &pParam->frameCache[pParam->bufferIndex];
+    const CanvasTypeDef* buffer = &pParam->graphicsBuffers[pParam->bufferIndex];
+    uint8_t dirty[UI_SELECT_INDEX_QUANTITY];
+    int32_t value[UI_SELECT_INDEX_QUANTITY];
+    uint8_t dirtyCount = 0;
+
+    for (uint8_t i = 0; i < UI_SELECT_INDEX_QUANTITY; i++) {
+        value[i] = getFieldValue(pParam, i);
+        dirty[i] = !pCache->valid || value[i] != pCache->field[i].value || (i == markIndex) != pCache->field[i].marked;
+    }
+
+    // 另一缓冲区为最后提交的画面, 其缓存与当前内容一致时本帧无需提交
+    pParam->frameChanged = !frameCacheMatches(&pParam->frameCache[!pParam->bufferIndex], value, markIndex,
+                                              &pParam->selDispInfo.rectParam);
+
+    // 恢复背景的区域与其他字段重叠时, 被波及的字段也需要重绘
+    for (uint8_t changed = pCache->valid; changed;) {
+        changed = 0;
+        for (uint8_t i = 0; i < UI_SELECT_INDEX_QUANTITY; i++) {
+            for (uint8_t j = 0; j < UI_SELECT_INDEX_QUANTITY; j++) {
+                if (dirty[i] && !dirty[j] && RECT_INTERSECT(pCache->field[i].area, pCache->field[j].area)) {
+                    dirty[j] = 1;
+                    changed  = 1;
+                }
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < UI_SELECT_INDEX_QUANTITY; i++) {
+        dirtyCount += dirty[i];
+    }
+
+    uint8_t highlightChanged =
+        !pCache->valid || memcmp(&pCache->highlight, &pParam->selDispInfo.rectParam, sizeof(pCache->highlight)) != 0;
+
+    pParam->renderStat.frames++;
+    pParam->renderStat.fieldRendered += dirtyCount;
+    pParam->renderStat.fieldSkipped += UI_SELECT_INDEX_QUANTITY - dirtyCount;
+
+    if (dirtyCount == 0 && !highlightChanged) {
+        pParam->renderStat.framesSkipped++;
+        return; // 缓冲区内容已是最新
+    }
+
+    if (!pCache->valid) {
+        imageServIntf.decode(buffer, &paramScreenImage, 0, 0, CANVAS_FULL_AREA); // 恢复整个图形缓冲区
+    } else {
+        // 撤销旧高亮, 再恢复需要重绘字段的背景
+        graphServIntf.fillRoundRect(buffer, pCache->highlight.startX, pCache->highlight.startY, pCache->highlight.endX,
+                                    pCache->highlight.endY, pCache->highlight.radius, RASTER_OP_XOR);
+        for (uint8_t i = 0; i < UI_SELECT_INDEX_QUANTITY; i++) {
+            if (dirty[i]) {
+                imageServIntf.decode(buffer, &paramScreenImage, 0, 0, pCache->field[i].area);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < UI_SELECT_INDEX_QUANTITY; i++) {
+        if (dirty[i]) {
+            formatField(i, value[i], i == markIndex);
+            pCache->field[i].value  = value[i];
+            pCache->field[i].marked = (i == markIndex);
+            pCache->field[i].area =
+                graphServIntf.printStringOnBuffer(buffer, &fontUI16, (const char*)strBuffer[i], uiFieldLayoutList[i].x0,
+                                                  uiFieldLayoutList[i].y0, uiFieldLayoutList[i].x1,
+                                                  uiFieldLayoutList[i].y1);
+        }
+    }
+
+    // 将当前选择信息的圆角矩形区域颜色反转
+    graphServIntf.fillRoundRect(buffer, pParam->selDispInfo.rectParam.startX, pParam->selDispInfo.rectParam.startY,
+                                pParam->selDispInfo.rectParam.endX, pParam->selDispInfo.rectParam.endY,
+                                pParam->selDispInfo.rectParam.radius, RASTER_OP_XOR);
+    pCache->highlight = pParam->selDispInfo.rectParam;
+    pCache->valid     = 1;
+}
+#endif /* STRIP_RENDER */
+
+/**
+ * @brief 判断帧缓存对应的图形缓冲区是否已是当前的参数界面
+ *
+ * @param pCache 参数界面帧缓存
+ * @param value 各字段当前的定点数值
+ * @param markIndex 附加编辑标记'*'的字段索引
+ * @param highlight 当前的高亮区域
+ * @return uint8_t 缓存有效且全部字段, 编辑标记和高亮都相同时返回1
+ * @note 缓存有效时对应的画面只含参数界面, 显示起始行为0
+ */
+static uint8_t frameCacheMatches(const UIFrameCacheTypeDef* pCache, const int32_t* value, uint8_t markIndex,
+                                 const RoundedRectangleParaTypeDef* highlight) {
+    if (!pCache->valid || memcmp(&pCache->highlight, highlight, sizeof(pCache->highlight)) != 0) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < UI_SELECT_INDEX_QUANTITY; i++) {
+        if (value[i] != pCache->field[i].value || (i == markIndex) != pCache->field[i].marked) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 获取字段对应的定点数值
+ *
+ * @param pParam
+ * @param index 字段索引
+ * @return int32_t 频率和幅度为十分之一单位的定点数, 相位为整数
+ */
+static int32_t getFieldValue(UIAppParamTypeDef* pParam, uint8_t index) {
+    SignalInfoTypeDef* pInfo = &pParam->signalInfo[index & 1]; // 偶数索引为信号1, 奇数索引为信号2
+
+    switch (index) {
+        case SIGNAL_1_FREQ:
+        case SIGNAL_2_FREQ: return FORMAT_TO_TENTHS(pInfo->freq);
+        case SIGNAL_1_AMP:
+        case SIGNAL_2_AMP: return FORMAT_TO_TENTHS(pInfo->amp);
+        default: return pInfo->phase;
+    }
+}
+
+/**
+ * @brief 将字段数值格式化到对应的字符串缓冲区
+ *
+ * @param index 字段索引
+ * @param value 定点数值
+ * @param marked 是否附加编辑标记'*'
+ */
+static void formatField(uint8_t index, int32_t value, uint8_t marked) {
+    char* str   = (char*)strBuffer[index];
+    uint8_t len = 0;
+
+    switch (index) {
+        case SIGNAL_1_FREQ:
+        case SIGNAL_2_FREQ: len = formatServIntf.formatFixed(str, value, 1, "kHz"); break;
+        case SIGNAL_1_AMP:
+        case SIGNAL_2_AMP: len = formatServIntf.formatFixed(str, value, 1, " V"); break;
+        default: len = formatServIntf.formatInt(str, value, " \xB0"); break; // 字体中度符号为Latin-1编码0xB0
+    }
+
+    if (marked) {
+        str[len]     = '*';
+        str[len + 1] = '\0';
+    }
+}
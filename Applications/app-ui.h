@@ -26,6 +26,10 @@
 /*-------- includes --------------------------------------------------------------------------------------------------*/
 
 #include "../Services/controller-service.h"
+#include "../Services/decimate-service.h"
+#include "../Services/display-list-service.h"
+#include "../Services/graph-service.h"
+#include "../Services/phosphor-service.h"
 #include "../Services/time-service.h"
 #include <stdint.h>
 
@@ -63,6 +67,12 @@ typedef enum {
     SIGNAL_2_PHASE, // 信号2相位
 } UISelectIndexEnum;
 
+typedef enum {
+    UI_FIGURE_PHOSPHOR, // 余辉点显示
+    UI_FIGURE_TRACE,    // 相邻采样点连线显示
+    UI_FIGURE_YT,       // 两通道对时间的峰值检测包络显示
+} UIFigureModeEnum;     // 图形查看显示模式枚举类型定义
+
 // UI状态机类型定义
 typedef struct {
     UIStateEnum curState;      // 当前UI状态
@@ -120,14 +130,64 @@ typedef struct {
 #endif               /* SINGAL_TYPE_DEF */
 
 
+#define UI_TRACE_LEN 256 // 连线模式保留的采样点数, 500Hz采样下约0.5s
+
+// 连线模式采样点环形队列, 由采样中断写入, 由UI循环整批绘制
+typedef struct {
+    PointTypeDef point[UI_TRACE_LEN]; // 采样点
+    volatile uint16_t head;           // 下一个写入位置
+    volatile uint16_t count;          // 有效采样点数量
+} UITraceTypeDef;
+
+#define UI_SCOPE_BLOCK_LEN 256  // Y-t显示每个采样块的采样点数, 500Hz采样下约0.5s
+#define UI_SCOPE_NONE      0xFF // 没有写满待抽取的采样块
+
+// Y-t显示采样块, 采样中断交替写入两个块, 写满的块由UI循环抽取为各列的包络
+typedef struct {
+    uint16_t sample[2][UI_SCOPE_BLOCK_LEN][2]; // 两个采样块, 每个采样点依次为信号1, 信号2的ADC值
+    volatile uint8_t fill;                     // 采样中断正在写入的块
+    volatile uint8_t ready;                    // 写满待抽取的块, UI_SCOPE_NONE表示没有
+    volatile uint16_t index;                   // 写入块中的下一个位置
+    uint8_t rowTop[2][WIDTH];                  // 各通道每列包络的起始行
+    uint8_t rowBottom[2][WIDTH];               // 各通道每列包络的结束行, 小于起始行表示该列为空
+} UIScopeTypeDef;
+
+// 参数界面字段缓存, 记录字段在某一图形缓冲区中上次渲染的内容
+typedef struct {
+    int32_t value;         // 已渲染的定点数值
+    uint8_t marked;        // 是否带有编辑标记'*'
+    RectParamTypeDef area; // 字符串实际覆盖区域
+} UIFieldCacheTypeDef;
+
+// 参数界面帧缓存, 每个图形缓冲区各一份; 页带渲染时记录最后刷新的画面
+typedef struct {
+    uint8_t valid;                                // 缓冲区内容是否为已缓存的参数界面
+    RoundedRectangleParaTypeDef highlight;        // 已异或到缓冲区的高亮区域
+    UIFieldCacheTypeDef field[SIGNAL_2_PHASE + 1]; // 各字段缓存
+} UIFrameCacheTypeDef;
+
+// 参数界面渲染统计
+typedef struct {
+    uint32_t frames;        // 参数界面帧数
+    uint32_t framesSkipped; // 无任何变化而跳过的帧数
+    uint32_t fieldRendered; // 重绘的字段数
+    uint32_t fieldSkipped;  // 复用缓存而跳过的字段数
+} UIRenderStatTypeDef;
+
 // UI应用参数类型定义
 typedef struct {
-    void* graphicsBuffers[2];      // 图形缓冲区
-    void* dotMatrix;               // 点阵图像素
-    uint8_t bufferIndex;           // 图形缓冲区索引
-    uint8_t eventGroup;            // 当前事件组
-    UIStateEnum curState;          // 当前状态
-    UISelectIndexEnum selectIndex; // 当前选择索引
+#if STRIP_RENDER
+    DisplayListTypeDef displayList;   // 当前画面的显示列表, 由主循环逐页渲染并发送
+    UIFrameCacheTypeDef shownCache;   // 最后刷新的参数界面, 不使用字段覆盖区域
+#else
+    CanvasTypeDef graphicsBuffers[2]; // 图形缓冲区
+    CanvasTypeDef dotMatrix;          // 页格式画布
+#endif /* STRIP_RENDER */
+    uint8_t bufferIndex;              // 图形缓冲区索引
+    uint8_t frameChanged;             // 本帧画面与最后提交的画面是否不同
+    uint8_t eventGroup;               // 当前事件组
+    UIStateEnum curState;             // 当前状态
+    UISelectIndexEnum selectIndex;    // 当前选择索引
 
     SignalInfoTypeDef signalInfo[2]; // 信号信息
 
@@ -136,7 +196,21 @@ typedef struct {
     SoftTimerHandle browseAnimateTimer;     // 浏览动画定时器句柄
     UISwitchAnimDataTypeDef switchAnimData; // UI切换动画数据
     SoftTimerHandle switchAnimateTimer;     // UI切换动画定时器句柄
-    uint8_t UISwitchBuffer[2][PAGE][WIDTH]; // UI切换缓冲区
+    uint8_t startLine[2];                   // 各图形缓冲区发送时使用的显示起始行
+#if !STRIP_RENDER
+    uint8_t UISwitchBuffer[PAGE][WIDTH];    // 参数界面快照, 切换动画中与图形查看界面拼接
+    CanvasTypeDef switchCanvas;             // 参数界面快照的画布
+    UIFrameCacheTypeDef frameCache[2];      // 参数界面帧缓存, 与图形缓冲区一一对应
+    CanvasTypeDef figureBackground;         // 图形查看静态图层的画布
+    LayerCompositorTypeDef figureLayers;    // 图形查看图层合成器, 合成目标为图形缓冲区索引
+#endif /* STRIP_RENDER */
+    UIRenderStatTypeDef renderStat;         // 参数界面渲染统计
+    PhosphorTypeDef phosphor;               // 图形查看余辉亮度缓冲区
+    SoftTimerHandle phosphorTimer;          // 余辉衰减定时器句柄
+    float phosphorElapsed;                  // 尚未折算为衰减周期的时间
+    UIFigureModeEnum figureMode;            // 图形查看显示模式
+    UITraceTypeDef trace;                   // 连线模式采样点队列
+    UIScopeTypeDef scope;                   // Y-t模式采样块和包络
 } UIAppParamTypeDef;
 
 
@@ -164,7 +238,10 @@ typedef struct {
 /*-------- function prototypes ---------------------------------------------------------------------------------------*/
 
 void uiAppInit(void* argument); // UI应用初始化函数
-void uiAppLoop(void* argument); // UI应用循环函数
+uint8_t uiAppLoop(void* argument); // UI应用循环函数, 返回本帧画面是否需要提交
+void uiAppInsertSample(void* argument, uint8_t x, uint8_t y); // 插入XY采样点, 在采样中断中调用
+void uiAppInsertScopeSample(void* argument, uint16_t signal1,
+                            uint16_t signal2); // 插入Y-t采样点, 在采样中断中调用
 
 
 
@@ -20,6 +20,7 @@
 #include "../Devices/drv-oled.h"
 #include "../Protocols/drv-usart.h"
 #include "../Services/graph-service.h"
+#include "../Services/phosphor-service.h"
 #include "../Services/time-service.h"
 #include "app-input.h"
 #include "app-signal.h"
@@ -44,6 +45,9 @@ struct {
 
     SoftTimerHandle mainLoopTimer; // 主循环定时器句柄
 
+    uint32_t oledThroughput; // OLED整帧传输的实测吞吐量(字节/秒)
+    uint32_t animateCycles;  // 矩形过渡动画单次调用的实测周期数
+
     uint8_t errCnt; // 错误计数
 } debugInfo;        // 调试信息结构体
 
@@ -52,6 +56,8 @@ struct {
 
 /* ------- define ----------------------------------------------------------------------------------------------------*/
 
+#define OLED_MAX_FPS        60 // OLED最大帧率, TIM6每周期开放一个发送时隙
+#define ANIMATE_BENCH_STEPS 64 // 测量矩形过渡动画周期数时的进度步数
 
 
 
@@ -74,6 +80,10 @@ SignalAppParamTypeDef signalAppParam; // 信号应用参数
 
 static void uiParamUpdate(UIAppParamTypeDef*);
 inline static void signalParamUpdate(SignalAppParamTypeDef* pSignalAppParam);
+static uint32_t measureAnimateCycles(void);
+#if STRIP_RENDER
+static void uiRenderStrip(const void* arg, const CanvasTypeDef* strip);
+#endif /* STRIP_RENDER */
 
 
 
@@ -89,8 +99,10 @@ int main(void) {
 
     /* ------ local variables ------------------------------------------------*/
 
+#if !STRIP_RENDER
     // TIM对象
     TIMObjTypeDef timFlashOLED;
+#endif /* STRIP_RENDER */
 
 
 
@@ -108,19 +120,30 @@ int main(void) {
 
     oledIntf.cmd(&oledObj);
 
-    oledIntf.draw(&oledObj);
+    oledIntf.clear(&oledObj);
+
+    debugInfo.oledThroughput = oledIntf.selfTest(&oledObj);
+    debugInfo.animateCycles  = measureAnimateCycles();
 
+#if !STRIP_RENDER
     timIntf.init(&timFlashOLED, TIM6);
-    timIntf.setFrequency(&timFlashOLED, 30);
+    timIntf.setFrequency(&timFlashOLED, OLED_MAX_FPS);
     timIntf.enableISR(&timFlashOLED);
+#endif /* STRIP_RENDER */
 
 
 
 
     /* ----- applications initialize -----------------------------------------*/
 
-    uiAppParam.graphicsBuffers[0] = oledObj.graphicsBuffer;    // 设置图形缓冲区
-    uiAppParam.graphicsBuffers[1] = oledObj.graphicsBufferSub; // 设置辅助图形缓冲区
+#if !STRIP_RENDER
+    uiAppParam.graphicsBuffers[0] = OLED_FRAME_CANVAS(oledObj.graphicsBuffer);    // 设置图形缓冲区
+    uiAppParam.graphicsBuffers[1] = OLED_FRAME_CANVAS(oledObj.graphicsBufferSub); // 设置辅助图形缓冲区
+
+    // 绘图服务修改图形缓冲区时同步标记脏页表, 供OLED局部刷新
+    graphServIntf.bindDirtyMap(&uiAppParam.graphicsBuffers[0], &oledObj.dirtyMap[0]);
+    graphServIntf.bindDirtyMap(&uiAppParam.graphicsBuffers[1], &oledObj.dirtyMap[1]);
+#endif /* STRIP_RENDER */
 
     inputAppInit(&inputAppParam);
     uiAppInit(&uiAppParam);
@@ -135,6 +158,8 @@ int main(void) {
     while (1) {
         debugInfo.timeInfo.systemTime = timeServIntf.getGlobalTime();
 
+        iicIntf.poll(oledObj.iic); // 总线卡死时不再产生中断, 由主循环检查传输超时
+
 
         // 调用应用
         inputAppLoop(&inputAppParam); // 输入应用循环
@@ -144,7 +169,26 @@ int main(void) {
         // 参数更新
         uiParamUpdate(&uiAppParam);
 
-        uiAppLoop(&uiAppParam);
+#if !STRIP_RENDER
+        // 本帧将渲染到的缓冲区可能仍在以DMA发送, 等待最后一次传输结束将其归还
+        while (oledIntf.frameInUse(&oledObj, !uiAppParam.bufferIndex)) {
+            iicIntf.poll(oledObj.iic);
+        }
+#endif /* STRIP_RENDER */
+
+        if (uiAppLoop(&uiAppParam)) {
+#if !STRIP_RENDER
+            // 提交渲染完成的缓冲区, 并挂起TIM6中断由帧调度决定是否立即以DMA发送. 画面不变时不提交, 总线保持空闲
+            oledIntf.submit(&oledObj, uiAppParam.bufferIndex, uiAppParam.startLine[uiAppParam.bufferIndex]);
+            NVIC_SetPendingIRQ(TIM6_IRQn);
+#else
+            // 逐页渲染显示列表, 每页渲染完成后以DMA发送, 同时渲染下一页; 成功后推进余辉FRC相位
+            oledIntf.setStartLine(&oledObj, uiAppParam.startLine[uiAppParam.bufferIndex]);
+            if (oledIntf.flushStrips(&oledObj, uiRenderStrip, &uiAppParam.displayList) == OLED_SUCCESS) {
+                phosphorServIntf.nextFrame(&uiAppParam.phosphor);
+            }
+#endif /* STRIP_RENDER */
+        }
 
 
 
@@ -152,7 +196,6 @@ int main(void) {
 
         signalAppLoop(&signalAppParam); // 信号应用循环
 
-        // 切换DMA缓冲区索引
         debugInfo.timeInfo.mainLoopTime = timeServIntf.getElapsedTime(debugInfo.mainLoopTimer); // 获取主循环时间
     }
 }
@@ -215,45 +258,95 @@ inline static void signalParamUpdate(SignalAppParamTypeDef* pSignalAppParam) {
     lastUIState = uiAppParam.curState;
 }
 
+/**
+ * @brief 以DWT周期计数器测量矩形过渡动画的单次调用周期数
+ *
+ * @return uint32_t 进度扫过[0, 1]时的平均周期数, 包含与app-ui相同的进度浮点除法
+ */
+static uint32_t measureAnimateCycles(void) {
+    uint32_t start = timeServIntf.getCycles();
+
+    for (uint8_t i = 0; i < ANIMATE_BENCH_STEPS; i++) {
+        RectParamTypeDef rect =
+            graphServIntf.animateMovingResizingRect(4, 4, 60, 20, 66, 40, 123, 59, (float)i / ANIMATE_BENCH_STEPS);
+        (void)rect;
+    }
+
+    return (timeServIntf.getCycles() - start) / ANIMATE_BENCH_STEPS;
+}
+
 
 
 /**
- * @brief DMA1通道6中断处理函数, 用于在发送完一帧数据后停止DMA
+ * @brief DMA1通道6中断处理函数, IIC1的DMA批量写搬运结束
  *
  * @return void
  */
 void DMA1_Channel6_IRQHandler(void) {
     if (DMA_GetITStatus(DMA1_IT_TC6)) {     // 检查DMA1通道6传输完成中断
         DMA_ClearITPendingBit(DMA1_IT_TC6); // 清除中断标志
-        DMA_Cmd(DMA1_Channel6, DISABLE);    // 禁用DMA通道6
-        I2C_DMACmd(I2C1, DISABLE);
+        iicIntf.dmaComplete(oledObj.iic);   // 等待最后一个字节移出后结束传输
+    }
+}
+
+/**
+ * @brief IIC1事件中断处理函数, 推进IIC传输队列
+ *
+ * @return void
+ */
+void I2C1_EV_IRQHandler(void) {
+    iicIntf.eventISR(oledObj.iic);
+#if !STRIP_RENDER
+    if (!oledObj.busy) {
+        NVIC_SetPendingIRQ(TIM6_IRQn); // OLED传输全部结束, 由帧调度决定是否发送下一帧
+    }
+#endif /* STRIP_RENDER */
+}
+
+/**
+ * @brief IIC1错误中断处理函数, 结束出错的传输并继续队列
+ *
+ * @return void
+ */
+void I2C1_ER_IRQHandler(void) {
+    iicIntf.errorISR(oledObj.iic);
+#if !STRIP_RENDER
+    if (!oledObj.busy) {
+        NVIC_SetPendingIRQ(TIM6_IRQn);
     }
+#endif /* STRIP_RENDER */
 }
 
 
+#if STRIP_RENDER
 /**
- * @brief TIM6中断处理函数, 固定30Hz频率刷新OLED屏幕
+ * @brief 将UI显示列表渲染到一个页带, 作为OLED页带刷新的渲染函数
+ *
+ * @param arg UI显示列表
+ * @param strip 页带画布
+ */
+static void uiRenderStrip(const void* arg, const CanvasTypeDef* strip) {
+    displayListServIntf.render((const DisplayListTypeDef*)arg, strip);
+}
+#else
+/**
+ * @brief TIM6中断处理函数, OLED帧调度
  *
  * @return void
+ * @note 定时器以OLED_MAX_FPS频率开放发送时隙; 主循环提交新帧和OLED传输全部结束后挂起本中断
  */
 void TIM6_IRQHandler(void) {
     if (TIM_GetITStatus(TIM6, TIM_IT_Update)) {
         TIM_ClearITPendingBit(TIM6, TIM_IT_Update);
+        oledIntf.frameTick(&oledObj);
+    }
 
-        // 将准备好的数据转运到缓冲区
-        if (uiAppParam.bufferIndex == 0) {
-            memcpy(oledObj.iic->txBuffer, uiAppParam.graphicsBuffers[1], OLED_WIDTH * OLED_HEIGHT);
-        } else if (uiAppParam.bufferIndex == 1) {
-            memcpy(oledObj.iic->txBuffer, uiAppParam.graphicsBuffers[0], OLED_WIDTH * OLED_HEIGHT);
-        }
-
-        DMA1_Channel6->CNDTR = 1024;
-
-        I2C_DMACmd(I2C1, ENABLE);
-        DMA_Cmd(DMA1_Channel6, ENABLE);
-        TIM_Cmd(TIM6, ENABLE);
+    // 发送最近提交的图形缓冲区中与屏幕不一致的页区间及其起始行, 取得新提交的缓冲区后推进余辉FRC相位
+    if (oledIntf.schedule(&oledObj) == OLED_SUCCESS) {
+        phosphorServIntf.nextFrame(&uiAppParam.phosphor);
     }
 }
+#endif /* STRIP_RENDER */
 
 /**
  * @brief TIM7中断处理函数, 500Hz采样ADC数据
@@ -269,14 +362,10 @@ void TIM7_IRQHandler(void) {
 
         ADC_SoftwareStartConvCmd(ADC1, ENABLE); // 启动 ADC（ADC2 自动同步）
 
-#if 1
-        graphServIntf.insertNewPoint(MAP_ADC_TO_OLED_Y(signalAppParam.adcData.adcValues.signal1),
-                                     MAP_ADC_TO_OLED_X(signalAppParam.adcData.adcValues.signal2), uiAppParam.dotMatrix);
-#else
-        ((uint8_t(*)[128])uiAppParam.dotMatrix)[MAP_ADC_TO_OLED_Y(signalAppParam.adcData.adcValues.signal2)]
-                                               [MAP_ADC_TO_OLED_X(signalAppParam.adcData.adcValues.signal1)] +=
-            1; // 在点阵图上设置点
-#endif // DELETE_OLD
+        uiAppInsertSample(&uiAppParam, MAP_ADC_TO_OLED_X(signalAppParam.adcData.adcValues.signal2),
+                          MAP_ADC_TO_OLED_Y(signalAppParam.adcData.adcValues.signal1));
+        uiAppInsertScopeSample(&uiAppParam, signalAppParam.adcData.adcValues.signal1,
+                               signalAppParam.adcData.adcValues.signal2);
     }
 }
 
@@ -38,6 +38,25 @@
 #define OLED_HEIGHT 8
 #define OLED_WIDTH  128
 
+// 1: 使用片上CRC外设计算页校验; 0: 使用软件CRC(主机构建), 两者结果一致
+#ifndef OLED_HARDWARE_CRC
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION)
+#define OLED_HARDWARE_CRC 1
+#else
+#define OLED_HARDWARE_CRC 0
+#endif
+#endif /* OLED_HARDWARE_CRC */
+
+// OLED的IIC速率, 多数SSD1306模块可在800kHz~1MHz下工作, 超过400kHz时须同时打开OLED_IIC_OVERCLOCK
+#ifndef OLED_IIC_SPEED
+#define OLED_IIC_SPEED 400000
+#endif /* OLED_IIC_SPEED */
+#ifndef OLED_IIC_OVERCLOCK
+#define OLED_IIC_OVERCLOCK 0 // 1: 允许OLED_IIC_SPEED超过400kHz, 超出STM32F1规格, 须以oledSelfTest在目标板上确认
+#endif /* OLED_IIC_OVERCLOCK */
+
+#define OLED_CRC_POLY 0x04C11DB7 // STM32 CRC外设使用的CRC-32多项式
+
 
 
 
@@ -54,7 +73,30 @@ OLEDErrCode oledDraw(OLEDObjTypeDef*);
 OLEDErrCode oledInit(OLEDObjTypeDef*);
 OLEDErrCode oledCmd(OLEDObjTypeDef*);
 OLEDErrCode oledFill(OLEDObjTypeDef*);
-OLEDErrCode oledDrawLoop(OLEDObjTypeDef*);
+OLEDErrCode oledFlush(OLEDObjTypeDef*);
+void oledSubmit(OLEDObjTypeDef*, uint8_t index, uint8_t line);
+uint8_t oledFrameInUse(OLEDObjTypeDef*, uint8_t index);
+void oledFrameTick(OLEDObjTypeDef*);
+OLEDErrCode oledSchedule(OLEDObjTypeDef*);
+OLEDErrCode oledFlushStrips(OLEDObjTypeDef*, OLEDStripRenderFunc render, const void* arg);
+void oledSetStartLine(OLEDObjTypeDef*, uint8_t line);
+OLEDErrCode oledScroll(OLEDObjTypeDef*, OLEDScrollEnum dir, uint8_t page0, uint8_t page1, uint8_t interval);
+OLEDErrCode oledStopScroll(OLEDObjTypeDef*);
+uint32_t oledSelfTest(OLEDObjTypeDef*);
+static void oledInvalidate(OLEDObjTypeDef* oledObj);
+static uint32_t oledPageCRC(const uint8_t* page);
+static OLEDErrCode oledStartSegments(OLEDObjTypeDef* oledObj, uint8_t count);
+static IICErrCode oledSubmitSegment(OLEDObjTypeDef* oledObj);
+static void oledSegmentDone(void* arg, IICErrCode status);
+static void oledWaitIdle(OLEDObjTypeDef* oledObj);
+static OLEDErrCode oledRequestCmd(OLEDObjTypeDef* oledObj, const uint8_t* data, uint8_t len);
+#if STRIP_RENDER
+static uint8_t oledPackWindow(uint8_t* dst, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1);
+static void oledFillStrip(const void* arg, const CanvasTypeDef* strip);
+#else
+static uint8_t (*oledFrame(OLEDObjTypeDef* oledObj, uint8_t index))[OLED_PAGE_STRIDE];
+static void oledFillFrame(OLEDObjTypeDef* oledObj, uint8_t value);
+#endif /* STRIP_RENDER */
 
 
 
@@ -63,10 +105,23 @@ OLEDErrCode oledDrawLoop(OLEDObjTypeDef*);
 
 OLEDIntfTypeDef oledIntf = {
     .clear = oledClear,
-    .draw  = oledDrawLoop,
-    .cmd   = oledCmd,
-    .init  = oledInit,
-    .fill  = oledFill,
+    .cmd              = oledCmd,
+    .init             = oledInit,
+    .fill             = oledFill,
+#if STRIP_RENDER
+    .flushStrips      = oledFlushStrips,
+#else
+    .draw             = oledDraw,
+    .submit           = oledSubmit,
+    .flush            = oledFlush,
+    .frameInUse       = oledFrameInUse,
+    .frameTick        = oledFrameTick,
+    .schedule         = oledSchedule,
+#endif /* STRIP_RENDER */
+    .setStartLine     = oledSetStartLine,
+    .scroll           = oledScroll,
+    .stopScroll       = oledStopScroll,
+    .selfTest         = oledSelfTest,
 };
 
 static IICObjTypeDef oledIIC;
@@ -92,12 +147,16 @@ OLEDErrCode oledInit(OLEDObjTypeDef* oledObj) {
     // 硬件IIC1
     // 数据线SDA连接到PB7
     // 时钟线SCL连接到PB6
-    // 发送缓冲区大小1025(更新一帧图像需要的最大字节数)
+    // 发送缓冲区大小OLED_TX_BUFFER_SIZE(页带模式为两个页带槽, 否则只存放命令, 图形缓冲区由DMA直接发送)
     // 接收缓冲区大小1(不需要接收数据)
     // 超时时间1000ms
-    // 传输速度400kHz(快速IIC)
-    if (iicIntf.init(&oledIIC, IIC_HARDWARE_1, PORT_B, PIN_7, PORT_B, PIN_6, OLED_WIDTH * OLED_HEIGHT + 2, 1, 1000,
-                     400000) != IIC_SUCCESS) {
+    // 传输速度400kHz(快速IIC), 随后按OLED_IIC_SPEED重新配置
+    if (iicIntf.init(&oledIIC, IIC_HARDWARE_1, PORT_B, PIN_7, PORT_B, PIN_6, OLED_TX_BUFFER_SIZE, 1, 1000, 400000) !=
+        IIC_SUCCESS) {
+        return OLED_ERR;
+    }
+
+    if (iicIntf.setClock(&oledIIC, OLED_IIC_SPEED, IIC_DUTY_2, OLED_IIC_OVERCLOCK) != IIC_SUCCESS) {
         return OLED_ERR;
     }
 
@@ -105,11 +164,48 @@ OLEDErrCode oledInit(OLEDObjTypeDef* oledObj) {
         return OLED_ERR;
     }
 
+    // 刷新以异步传输队列发送, 与其他设备共用总线
+    if (iicIntf.equippedWithQueue(&oledIIC) != IIC_SUCCESS) {
+        return OLED_ERR;
+    }
+
     timeServIntf.delayMs(200);
 
     oledObj->iic            = &oledIIC;
     oledObj->iic->slaveAddr = 0x78; // OLED的IIC地址
 
+    // 屏幕内容未知, 首次刷新发送整帧
+#if STRIP_RENDER
+    oledObj->stripIndex = 0;
+#else
+    for (uint8_t i = 0; i < 2; i++) {
+        graphServIntf.clearDirtyMap(&oledObj->dirtyMap[i]);
+
+        uint8_t(*frame)[OLED_PAGE_STRIDE] = oledFrame(oledObj, i);
+        for (uint8_t page = 0; page < OLED_HEIGHT; page++) {
+            frame[page][OLED_PAGE_HEADER_SIZE - 1] = 0x40; // 紧挨页数据的数据控制字节
+        }
+    }
+    oledObj->frameReady     = OLED_FRAME_NONE;
+    oledObj->frameSending   = OLED_FRAME_NONE;
+    oledObj->lastSeq        = 0;
+    oledObj->frameSlot      = 0;
+    oledObj->scrollReq      = OLED_SCROLL_REQ_NONE;
+    memset(&oledObj->frameStat, 0, sizeof(OLEDFrameStatTypeDef));
+#endif /* STRIP_RENDER */
+    oledInvalidate(oledObj);
+    oledObj->busy           = 0;
+    oledObj->pageSent       = 0;
+    oledObj->pageSkipped    = 0;
+    oledObj->byteSent       = 0;
+    oledObj->startLine      = 0;
+    oledObj->panelStartLine = 0; // 初始化命令中的0x40
+    oledObj->scrollCmdLen   = 0;
+
+#if OLED_HARDWARE_CRC
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+#endif
+
     return OLED_SUCCESS;
 }
 
@@ -125,17 +221,124 @@ OLEDErrCode oledCmd(OLEDObjTypeDef* oledObj) {
     return OLED_SUCCESS;
 }
 
+#if STRIP_RENDER
+/**
+ * @brief oledClear 清除OLED对象的显示内容
+ *
+ * @param oledObj
+ * @return OLEDErrCode
+ * @note 以页带刷新发送, 与屏幕上内容相同的页跳过
+ */
+OLEDErrCode oledClear(OLEDObjTypeDef* oledObj) {
+    static const uint8_t value = 0x00;
+    return oledFlushStrips(oledObj, oledFillStrip, &value);
+}
+
+/**
+ * @brief oledFill 填充OLED对象的显示内容
+ *
+ * @param oledObj
+ * @return OLEDErrCode
+ * @note 以页带刷新发送, 与屏幕上内容相同的页跳过
+ */
+OLEDErrCode oledFill(OLEDObjTypeDef* oledObj) {
+    static const uint8_t value = 0xFF;
+    return oledFlushStrips(oledObj, oledFillStrip, &value);
+}
+
+/**
+ * @brief oledFlushStrips 将画面逐页渲染到两个页带, 每页渲染完成后以DMA发送, 同时渲染下一页
+ *
+ * @param oledObj
+ * @param render 渲染函数, 每页调用一次, 须写满页带画布的全部OLED_WIDTH列
+ * @param arg 渲染函数的参数
+ * @return OLEDErrCode DMA启动失败时返回OLED_ERR
+ * @note 1. 页带位于IIC发送缓冲区中, 数据之前预留窗口传输头, 每页为一次只含该页的窗口传输, 不需要额外复制
+ *       2. 页带渲染完成后计算CRC, 与屏幕上该页最后一次发送内容的CRC相同则跳过, 页带留给下一页使用
+ *       3. 同一时刻只有一次DMA传输, 发送前等待另一页带发送完成; 正在发送的页带不会被下一页的渲染改写.
+ *          渲染一页的时间远小于发送一页(约3ms), 主循环大部分时间等待总线
+ *       4. 返回时最后一页可能仍在发送, 下次调用从另一页带开始渲染, 不需要等待
+ *       5. 起始行与屏幕不同时, 在全部页之后追加一次起始行命令传输, 与oledFlush一致
+ *       6. 在主循环中调用, 不可在中断中调用; 滚动命令使用单独的缓冲区, 同样在主循环中发送
+ */
+OLEDErrCode oledFlushStrips(OLEDObjTypeDef* oledObj, OLEDStripRenderFunc render, const void* arg) {
+    for (uint8_t page = 0; page < OLED_HEIGHT; page++) {
+        uint8_t* strip       = oledIIC.txBuffer + oledObj->stripIndex * OLED_STRIP_SLOT_SIZE + OLED_STRIP_DATA_OFFSET;
+        CanvasTypeDef canvas = CANVAS_STRIP(strip, page);
+
+        render(arg, &canvas);
+
+        uint32_t crc = oledPageCRC(strip);
+        if ((oledObj->pageCRCValid & (1 << page)) && crc == oledObj->pageCRC[page]) {
+            oledObj->pageSkipped++;
+            continue; // 内容与屏幕相同, 页带留给下一页
+        }
+
+        oledObj->pageCRC[page] = crc;
+        oledObj->pageCRCValid |= 1 << page;
+        oledObj->pageSent++;
+
+        uint8_t* header = strip - OLED_WINDOW_HEADER_SIZE;
+        oledPackWindow(header, 0, OLED_WIDTH - 1, page, page);
+
+        oledWaitIdle(oledObj); // 等待另一页带发送完成
+
+        oledObj->stripIndex = !oledObj->stripIndex;
+        oledObj->segment[0] = (OLEDSegmentTypeDef){header, OLED_WINDOW_HEADER_SIZE + OLED_WIDTH};
+
+        if (oledStartSegments(oledObj, 1) != OLED_SUCCESS) {
+            oledInvalidate(oledObj);
+            return OLED_ERR;
+        }
+    }
+
+    if (oledObj->startLine != oledObj->panelStartLine) {
+        uint8_t* slot = oledIIC.txBuffer + oledObj->stripIndex * OLED_STRIP_SLOT_SIZE;
+        slot[0]       = 0x00;
+        slot[1]       = 0x40 | oledObj->startLine;
+
+        oledWaitIdle(oledObj);
+
+        oledObj->panelStartLine = oledObj->startLine;
+        oledObj->segment[0]     = (OLEDSegmentTypeDef){slot, OLED_START_LINE_SIZE};
+
+        if (oledStartSegments(oledObj, 1) != OLED_SUCCESS) {
+            return OLED_ERR;
+        }
+    }
+
+    return OLED_SUCCESS;
+}
+
+/**
+ * @brief oledFillStrip 以同一字节填充页带
+ *
+ * @param arg 填充字节
+ * @param strip 页带画布
+ */
+static void oledFillStrip(const void* arg, const CanvasTypeDef* strip) {
+    memset(strip->data, *(const uint8_t*)arg, OLED_WIDTH);
+}
+#else
 /**
  * @brief oledDraw OLED对象绘制方法
  *
  * @param oledObj
  * @return OLEDErrCode
+ * @note 阻塞发送graphicsBuffer整屏, 等待最后一次传输结束归还缓冲区后返回
  */
 OLEDErrCode oledDraw(OLEDObjTypeDef* oledObj) {
-    oledIIC.txBuffer[0] = 0x40;
-    memcpy(oledIIC.txBuffer + 1, oledObj->graphicsBuffer, OLED_HEIGHT * OLED_WIDTH);
-    oledIIC.txLen = OLED_HEIGHT * OLED_WIDTH + 1;
-    return iicIntf.transmit(&oledIIC) == IIC_SUCCESS ? OLED_SUCCESS : OLED_ERR;
+    oledWaitIdle(oledObj);
+
+    oledInvalidate(oledObj); // 屏幕内容已改变, 下次刷新重新比较全部页
+    oledSubmit(oledObj, 0, oledObj->startLine);
+    if (oledFlush(oledObj) != OLED_SUCCESS) {
+        return OLED_ERR;
+    }
+
+    oledWaitIdle(oledObj);
+
+    return OLED_SUCCESS;
 }
 
 /**
@@ -145,7 +348,7 @@ OLEDErrCode oledDraw(OLEDObjTypeDef* oledObj) {
  * @return OLEDErrCode
  */
 OLEDErrCode oledClear(OLEDObjTypeDef* oledObj) {
-    memset(oledObj->graphicsBuffer, 0, OLED_HEIGHT * OLED_WIDTH);
+    oledFillFrame(oledObj, 0x00);
     return oledDraw(oledObj);
 }
 
@@ -156,19 +359,485 @@ OLEDErrCode oledClear(OLEDObjTypeDef* oledObj) {
  * @return OLEDErrCode
  */
 OLEDErrCode oledFill(OLEDObjTypeDef* oledObj) {
-    memset(oledObj->graphicsBuffer, 0xFF, OLED_HEIGHT * OLED_WIDTH);
+    oledFillFrame(oledObj, 0xFF);
     return oledDraw(oledObj);
 }
 
 /**
- * @brief oledDrawLoop 开启OLED发送循环
+ * @brief oledSubmit 提交渲染完成的图形缓冲区
  *
  * @param oledObj
- * @return OLEDErrCode
+ * @param index 0为graphicsBuffer, 1为graphicsBufferSub
+ * @param line 该缓冲区发送时使用的显示起始行
+ * @note 1. 在主循环中调用. 之前提交而尚未开始发送的缓冲区被取代, 不再发送
+ *       2. 提交另一缓冲区后, 正在发送的缓冲区以外的缓冲区都不会再被DMA读取, 渲染方只需等待oledFrameInUse为0
+ */
+void oledSubmit(OLEDObjTypeDef* oledObj, uint8_t index, uint8_t line) {
+    oledObj->frameStartLine[index] = line;
+    oledObj->frameSeq[index]       = ++oledObj->frameStat.rendered;
+    oledObj->frameReady            = index; // 三者均为volatile, 写入不被重排, 刷新中断取得的起始行和帧序号总与之对应
+}
+
+/**
+ * @brief oledFrameInUse 图形缓冲区是否正被DMA读取
+ *
+ * @param oledObj
+ * @param index 0为graphicsBuffer, 1为graphicsBufferSub
+ * @return uint8_t 1表示缓冲区仍归DMA所有, 不可改写
+ */
+uint8_t oledFrameInUse(OLEDObjTypeDef* oledObj, uint8_t index) { return oledObj->frameSending == index; }
+
+/**
+ * @brief oledFrameTick 开放发送时隙
+ *
+ * @param oledObj
+ * @note 在帧率定时器中断中以最大帧率调用; 时隙在取得一帧前保持开放, 不累计
+ */
+void oledFrameTick(OLEDObjTypeDef* oledObj) { oledObj->frameSlot = 1; }
+
+/**
+ * @brief oledSchedule 帧调度: 发送时隙开放, 总线空闲且有新提交的帧时取得该帧并开始发送
+ *
+ * @param oledObj
+ * @return OLEDErrCode 取得新帧时返回OLED_SUCCESS, 条件不满足或发送的是滚动命令时返回OLED_ERR
+ * @note 1. 所有发送都从同一个中断中调用本函数开始, 不会并发; 主循环提交新帧后, 以及最后一次传输结束总线空闲后,
+ *          均挂起该中断, 使满足条件的帧立即开始发送
+ *       2. 每个时隙最多取得一帧, 帧率不超过oledFrameTick的调用频率; 没有新帧时不发送, 画面不变时总线保持空闲
+ *       3. 总线空闲时先发送oledScroll/oledStopScroll提交的滚动命令, 不占用时隙; 命令发送结束后再次挂起该中断,
+ *          新帧随后发送
+ */
+OLEDErrCode oledSchedule(OLEDObjTypeDef* oledObj) {
+    if (oledObj->busy) {
+        return OLED_ERR;
+    }
+
+    if (oledObj->scrollReq == OLED_SCROLL_REQ_PENDING) {
+        oledObj->segment[0] = (OLEDSegmentTypeDef){oledObj->scrollCmd, oledObj->scrollCmdLen};
+        oledObj->scrollReq  = OLED_SCROLL_REQ_SENDING;
+        oledInvalidate(oledObj); // 滚动移动了显存内容
+        if (oledStartSegments(oledObj, 1) != OLED_SUCCESS) {
+            oledObj->scrollReq = OLED_SCROLL_REQ_NONE;
+        }
+        return OLED_ERR;
+    }
+
+    if (!oledObj->frameSlot || oledObj->frameReady == OLED_FRAME_NONE) {
+        return OLED_ERR;
+    }
+
+    oledObj->frameSlot = 0;
+    return oledFlush(oledObj);
+}
+
+/**
+ * @brief oledFlush 以DMA发送最近提交的图形缓冲区中与屏幕内容不一致的区域
+ *
+ * @param oledObj
+ * @return OLEDErrCode 没有新提交的缓冲区或上一次刷新尚未完成时返回OLED_ERR, 已提交的缓冲区留到下次刷新
+ * @note 1. 每页先计算CRC, 与屏幕上该页最后一次发送内容的CRC相同则跳过, 即使该页被标记为脏
+ *       2. CRC不同的页发送第0列到该缓冲区dirtyMap与staleMap之并的结束列; 未被标记过的页(绕过绘图服务的写入)整页发送.
+ *          窗口总是从第0列开始, 页数据连同紧挨在其前的控制字节0x40一起由DMA直接从图形缓冲区读取, 不做复制
+ *       3. 连续的待发送页合并为一个列/页地址窗口: 先以一次命令传输设置窗口, 再每页一次数据传输,
+ *          水平寻址模式下每页写满窗口宽度后地址自动进入下一页
+ *       4. 发送后屏幕与该缓冲区一致, 发送区域并入另一缓冲区的staleMap
+ *       5. 起始行与屏幕不同时, 在全部窗口之后追加一次起始行命令传输, 使显示在新内容写入后才移动
+ *       6. 有数据发送时缓冲区从此刻起归DMA所有, 最后一次传输结束时归还
  */
-OLEDErrCode oledDrawLoop(OLEDObjTypeDef* oledObj) {
-    oledIIC.txBuffer[0] = 0x40;
-    memcpy(oledIIC.txBuffer + 1, oledObj->graphicsBuffer, OLED_HEIGHT * OLED_WIDTH);
-    oledIIC.txLen = OLED_HEIGHT * OLED_WIDTH + 1;
-    return iicIntf.transmitWithDMA(&oledIIC) == IIC_SUCCESS ? OLED_SUCCESS : OLED_ERR;
+OLEDErrCode oledFlush(OLEDObjTypeDef* oledObj) {
+    if (oledObj->busy || oledObj->frameReady == OLED_FRAME_NONE) {
+        return OLED_ERR;
+    }
+
+    uint8_t index       = oledObj->frameReady;
+    oledObj->frameReady = OLED_FRAME_NONE;
+    oledObj->startLine  = oledObj->frameStartLine[index];
+
+    // 上次取得的帧与本帧之间提交的帧都已被取代
+    oledObj->frameStat.dropped += oledObj->frameSeq[index] - oledObj->lastSeq - 1;
+    oledObj->lastSeq = oledObj->frameSeq[index];
+
+    uint8_t(*frame)[OLED_PAGE_STRIDE] = oledFrame(oledObj, index);
+    DirtyMapTypeDef* dirty            = &oledObj->dirtyMap[index];
+    DirtyMapTypeDef* stale            = &oledObj->staleMap[index];
+    DirtyMapTypeDef* otherStale       = &oledObj->staleMap[!index];
+    uint8_t width[OLED_HEIGHT]; // 各页需要发送的列数, 0表示与屏幕一致
+    uint16_t offset = 0;
+    uint8_t count   = 0;
+
+    for (uint8_t page = 0; page < OLED_HEIGHT; page++) {
+        uint32_t crc = oledPageCRC(&frame[page][OLED_PAGE_HEADER_SIZE]);
+
+        if ((oledObj->pageCRCValid & (1 << page)) && crc == oledObj->pageCRC[page]) {
+            width[page] = 0;
+            oledObj->pageSkipped++;
+            continue; // 内容与屏幕相同
+        }
+
+        // 干净页的x1为0, 直接取最大值即为并集的结束列
+        if (DIRTY_PAGE_CLEAN(dirty, page) && DIRTY_PAGE_CLEAN(stale, page)) {
+            width[page] = OLED_WIDTH;
+        } else {
+            width[page] = (dirty->x1[page] > stale->x1[page] ? dirty->x1[page] : stale->x1[page]) + 1;
+        }
+
+        oledObj->pageCRC[page] = crc;
+        oledObj->pageCRCValid |= 1 << page;
+        oledObj->pageSent++;
+    }
+
+    for (uint8_t page = 0; page < OLED_HEIGHT;) {
+        // 合并连续的待发送页, 窗口宽度取各页的最大值
+        uint8_t w        = 0;
+        uint8_t lastPage = page;
+        while (lastPage < OLED_HEIGHT && width[lastPage]) {
+            w = width[lastPage] > w ? width[lastPage] : w;
+            lastPage++;
+        }
+
+        if (lastPage == page) {
+            page++;
+            continue; // 该页与屏幕一致
+        }
+
+        uint8_t* cmd = oledIIC.txBuffer + offset;
+        cmd[0]       = 0x00;
+        cmd[1]       = 0x21;
+        cmd[2]       = 0;
+        cmd[3]       = w - 1;
+        cmd[4]       = 0x22;
+        cmd[5]       = page;
+        cmd[6]       = lastPage - 1;
+        offset += OLED_WINDOW_CMD_SIZE;
+
+        oledObj->segment[count++] = (OLEDSegmentTypeDef){cmd, OLED_WINDOW_CMD_SIZE};
+        for (uint8_t p = page; p < lastPage; p++) {
+            oledObj->segment[count++] = (OLEDSegmentTypeDef){&frame[p][OLED_PAGE_HEADER_SIZE - 1], w + 1};
+
+            // 屏幕的这部分内容变为本缓冲区的内容, 另一缓冲区在此处与屏幕不再一致
+            otherStale->x0[p] = 0;
+            otherStale->x1[p] = w - 1 > otherStale->x1[p] ? w - 1 : otherStale->x1[p];
+        }
+
+        page = lastPage;
+    }
+
+    if (oledObj->startLine != oledObj->panelStartLine) {
+        uint8_t* cmd = oledIIC.txBuffer + offset;
+        cmd[0]       = 0x00;
+        cmd[1]       = 0x40 | oledObj->startLine;
+
+        oledObj->segment[count++] = (OLEDSegmentTypeDef){cmd, OLED_START_LINE_SIZE};
+        oledObj->panelStartLine   = oledObj->startLine;
+    }
+
+    graphServIntf.clearDirtyMap(dirty);
+    graphServIntf.clearDirtyMap(stale);
+
+    if (count == 0) {
+        oledObj->frameStat.unchanged++;
+        return OLED_SUCCESS; // 屏幕已是最新
+    }
+
+    oledObj->frameSending = index;
+    if (oledStartSegments(oledObj, count) != OLED_SUCCESS) {
+        oledObj->frameSending = OLED_FRAME_NONE;
+        oledInvalidate(oledObj);
+        return OLED_ERR;
+    }
+
+    oledObj->frameStat.sent++;
+    return OLED_SUCCESS;
+}
+
+/**
+ * @brief oledFrame 取得图形缓冲区
+ *
+ * @param oledObj
+ * @param index 0为graphicsBuffer, 1为graphicsBufferSub
+ * @return 带页头的图形缓冲区
+ */
+static uint8_t (*oledFrame(OLEDObjTypeDef* oledObj, uint8_t index))[OLED_PAGE_STRIDE] {
+    return index ? oledObj->graphicsBufferSub : oledObj->graphicsBuffer;
+}
+
+/**
+ * @brief oledFillFrame 以同一字节填充graphicsBuffer各页的数据, 页头不变
+ *
+ * @param oledObj
+ * @param value 填充字节
+ */
+static void oledFillFrame(OLEDObjTypeDef* oledObj, uint8_t value) {
+    for (uint8_t page = 0; page < OLED_HEIGHT; page++) {
+        memset(&oledObj->graphicsBuffer[page][OLED_PAGE_HEADER_SIZE], value, OLED_WIDTH);
+    }
+}
+#endif /* STRIP_RENDER */
+
+/**
+ * @brief oledStartSegments 开始依次进行传输列表中的传输
+ *
+ * @param oledObj
+ * @param count 传输数量
+ * @return OLEDErrCode 加入IIC传输队列失败时返回OLED_ERR
+ * @note 每个传输为一次DMA批量写, 之后的传输由oledSegmentDone在上一个传输结束时加入队列,
+ *       其他设备的传输可以插入在两次传输之间
+ */
+static OLEDErrCode oledStartSegments(OLEDObjTypeDef* oledObj, uint8_t count) {
+    oledObj->busy         = 1;
+    oledObj->segmentCount = count;
+    oledObj->segmentIndex = 0;
+
+    if (oledSubmitSegment(oledObj) != IIC_SUCCESS) {
+        oledObj->busy = 0;
+        return OLED_ERR;
+    }
+
+    return OLED_SUCCESS;
+}
+
+/**
+ * @brief oledSubmitSegment 将传输列表中的当前传输加入IIC传输队列
+ *
+ * @param oledObj
+ * @return IICErrCode
+ */
+static IICErrCode oledSubmitSegment(OLEDObjTypeDef* oledObj) {
+    const OLEDSegmentTypeDef* seg = &oledObj->segment[oledObj->segmentIndex];
+    IICXferTypeDef xfer           = {
+        .type      = IIC_XFER_DMA_WRITE,
+        .slaveAddr = oledIIC.slaveAddr,
+        .txData    = seg->data,
+        .txLen     = seg->len,
+        .callback  = oledSegmentDone,
+        .arg       = oledObj,
+    };
+
+    oledObj->byteSent += seg->len;
+    return iicIntf.submit(&oledIIC, &xfer);
+}
+
+/**
+ * @brief oledSegmentDone 一次传输结束
+ *
+ * @param arg OLED对象
+ * @param status 传输结果
+ * @note 1. IIC传输结束回调, 在中断中调用: 继续下一次传输; 全部完成后归还图形缓冲区
+ *       2. 传输失败时放弃剩余传输, 屏幕内容未知, 下次刷新发送整屏
+ */
+static void oledSegmentDone(void* arg, IICErrCode status) {
+    OLEDObjTypeDef* oledObj = (OLEDObjTypeDef*)arg;
+
+    if (status == IIC_SUCCESS && ++oledObj->segmentIndex < oledObj->segmentCount) {
+        if (oledSubmitSegment(oledObj) == IIC_SUCCESS) {
+            return;
+        }
+        status = IIC_ERR_BUSY; // 传输队列已满
+    }
+
+    if (status != IIC_SUCCESS) {
+        oledInvalidate(oledObj);
+    }
+#if !STRIP_RENDER
+    oledObj->frameSending = OLED_FRAME_NONE;
+    if (oledObj->scrollReq == OLED_SCROLL_REQ_SENDING) {
+        oledObj->scrollReq = OLED_SCROLL_REQ_NONE;
+    }
+#endif /* STRIP_RENDER */
+    oledObj->busy = 0;
+}
+
+/**
+ * @brief oledWaitIdle 等待刷新结束
+ *
+ * @param oledObj
+ * @note 等待期间检查IIC传输超时, 总线卡死时由超时结束传输, 不会一直等待
+ */
+static void oledWaitIdle(OLEDObjTypeDef* oledObj) {
+    while (oledObj->busy) {
+        iicIntf.poll(&oledIIC);
+    }
+}
+
+/**
+ * @brief oledSetStartLine 设置显示起始行
+ *
+ * @param oledObj
+ * @param line 显存中显示在屏幕第0行的行号(0~63)
+ * @note 不立即发送, 与下一次刷新的窗口一同发送; 显存内容不变, 整屏纵向循环平移.
+ *       图形缓冲区刷新时使用oledSubmit随缓冲区提交的起始行
+ */
+void oledSetStartLine(OLEDObjTypeDef* oledObj, uint8_t line) {
+    oledObj->startLine = line % OLED_LINE_COUNT;
+}
+
+/**
+ * @brief oledScroll 启动硬件水平滚动
+ *
+ * @param oledObj
+ * @param dir 滚动方向
+ * @param page0 起始页
+ * @param page1 结束页
+ * @param interval 每步间隔的帧数编码(0~7, 对应5/64/128/256/3/4/25/2帧)
+ * @return OLEDErrCode 上一条滚动命令尚未发送完成时返回OLED_ERR
+ * @note 命令的发送方式见oledRequestCmd; 滚动期间显存内容由屏幕自行移动, 不应再刷新
+ */
+OLEDErrCode oledScroll(OLEDObjTypeDef* oledObj, OLEDScrollEnum dir, uint8_t page0, uint8_t page1, uint8_t interval) {
+    // 先停止当前滚动, 再设置参数并激活
+    const uint8_t scrollCmd[] = {
+        0x00, 0x2E, dir, 0x00, page0 & 0x07, interval & 0x07, page1 & 0x07, 0x00, 0xFF, 0x2F,
+    };
+
+    return oledRequestCmd(oledObj, scrollCmd, sizeof(scrollCmd));
+}
+
+/**
+ * @brief oledStopScroll 停止硬件滚动
+ *
+ * @param oledObj
+ * @return OLEDErrCode 上一条滚动命令尚未发送完成时返回OLED_ERR
+ * @note 滚动停止后显存内容已被移动, 下次刷新重新发送整屏
+ */
+OLEDErrCode oledStopScroll(OLEDObjTypeDef* oledObj) {
+    static const uint8_t stopCmd[] = {0x00, 0x2E};
+
+    return oledRequestCmd(oledObj, stopCmd, sizeof(stopCmd));
+}
+
+/**
+ * @brief oledRequestCmd 发送一条滚动命令
+ *
+ * @param oledObj
+ * @param data 命令传输, 以命令控制字节0x00开始
+ * @param len 传输长度, 不超过OLED_SCROLL_CMD_SIZE
+ * @return OLEDErrCode 命令缓冲区仍被占用时返回OLED_ERR
+ * @note 1. 命令复制到单独的scrollCmd缓冲区, 不改写IIC发送缓冲区和传输列表, 与正在进行的刷新互不影响
+ *       2. 图形缓冲区模式下刷新在中断中开始, 这里只在命令缓冲区空闲时写入命令并置为待发送, 由oledSchedule
+ *          在总线空闲时发送; 请求状态的写入是单字节操作, 不需要关中断. 调用后挂起帧调度中断可使命令立即发送
+ *       3. 页带渲染模式下刷新只在主循环中进行, 总线空闲时直接发送
+ *       4. 滚动命令会移动显存内容, 之后的刷新发送整屏
+ */
+static OLEDErrCode oledRequestCmd(OLEDObjTypeDef* oledObj, const uint8_t* data, uint8_t len) {
+#if STRIP_RENDER
+    if (oledObj->busy) {
+        return OLED_ERR;
+    }
+
+    memcpy(oledObj->scrollCmd, data, len);
+    oledObj->scrollCmdLen = len;
+    oledObj->segment[0]   = (OLEDSegmentTypeDef){oledObj->scrollCmd, len};
+
+    oledInvalidate(oledObj);
+    return oledStartSegments(oledObj, 1);
+#else
+    if (oledObj->scrollReq != OLED_SCROLL_REQ_NONE) {
+        return OLED_ERR;
+    }
+
+    memcpy(oledObj->scrollCmd, data, len);
+    oledObj->scrollCmdLen = len;
+    oledObj->scrollReq    = OLED_SCROLL_REQ_PENDING;
+
+    return OLED_SUCCESS;
+#endif /* STRIP_RENDER */
+}
+
+/**
+ * @brief oledSelfTest 测量整帧传输的吞吐量
+ *
+ * @param oledObj
+ * @return uint32_t 从开始发送到最后一次传输完成的平均吞吐量(字节/秒), 包含控制字节和窗口命令; 失败时返回0
+ * @note 1. 以DMA阻塞发送整屏: 页带模式为清屏, 否则为graphicsBuffer的当前内容
+ *       2. 结果包含每次传输的START/地址和传输之间的中断开销, 用于确认OLED_IIC_SPEED在目标板上的实际效果
+ *       3. 依赖IIC事件中断和DMA传输完成中断, 在初始化阶段调用
+ */
+uint32_t oledSelfTest(OLEDObjTypeDef* oledObj) {
+    oledWaitIdle(oledObj);
+
+    oledInvalidate(oledObj); // 屏幕上的页全部视为不同, 不因CRC相同而跳过
+
+    uint32_t bytes = oledObj->byteSent;
+    float start    = timeServIntf.getGlobalTime();
+
+#if STRIP_RENDER
+    OLEDErrCode status = oledClear(oledObj);
+#else
+    OLEDErrCode status = oledDraw(oledObj);
+#endif /* STRIP_RENDER */
+
+    oledWaitIdle(oledObj);
+
+    float elapsed = timeServIntf.getGlobalTime() - start;
+    bytes         = oledObj->byteSent - bytes;
+
+    if (status != OLED_SUCCESS || elapsed <= 0.0f) {
+        return 0;
+    }
+
+    return (uint32_t)(bytes / elapsed);
+}
+
+/**
+ * @brief oledInvalidate 屏幕内容未知, 两个缓冲区下次刷新均发送整屏及起始行
+ *
+ * @param oledObj
+ */
+static void oledInvalidate(OLEDObjTypeDef* oledObj) {
+#if !STRIP_RENDER
+    for (uint8_t i = 0; i < 2; i++) {
+        memset(oledObj->staleMap[i].x0, 0, sizeof(oledObj->staleMap[i].x0));
+        memset(oledObj->staleMap[i].x1, OLED_WIDTH - 1, sizeof(oledObj->staleMap[i].x1));
+    }
+#endif /* STRIP_RENDER */
+    oledObj->pageCRCValid   = 0;
+    oledObj->panelStartLine = OLED_LINE_UNKNOWN;
+}
+
+#if STRIP_RENDER
+/**
+ * @brief oledPackWindow 写入设置列/页地址窗口的传输头
+ *
+ * @param dst 目标地址
+ * @param x0 起始列
+ * @param x1 结束列
+ * @param page0 起始页
+ * @param page1 结束页
+ * @return uint8_t 传输头长度
+ * @note 水平寻址模式下数据在窗口内逐页填充, 写满窗口后回到窗口起点
+ */
+static uint8_t oledPackWindow(uint8_t* dst, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+    const uint8_t header[OLED_WINDOW_HEADER_SIZE] = {
+        0x80, 0x21, 0x80, x0, 0x80, x1, 0x80, 0x22, 0x80, page0, 0x80, page1, 0x40,
+    };
+
+    memcpy(dst, header, sizeof(header));
+
+    return sizeof(header);
+}
+#endif /* STRIP_RENDER */
+
+/**
+ * @brief oledPageCRC 计算一页显存数据的CRC
+ *
+ * @param page 一页数据(OLED_WIDTH字节, 4字节对齐)
+ * @return uint32_t CRC-32(多项式0x04C11DB7, 初值0xFFFFFFFF, 按32位字输入), 与CRC外设的结果一致
+ */
+static uint32_t oledPageCRC(const uint8_t* page) {
+#if OLED_HARDWARE_CRC
+    CRC_ResetDR();
+    return CRC_CalcBlockCRC((uint32_t*)page, OLED_WIDTH / 4);
+#else
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (uint8_t i = 0; i < OLED_WIDTH; i += 4) {
+        uint32_t word;
+        memcpy(&word, page + i, sizeof(word));
+
+        crc ^= word;
+        for (uint8_t bit = 0; bit < 32; bit++) {
+            crc = (crc & 0x80000000) ? (crc << 1) ^ OLED_CRC_POLY : crc << 1;
+        }
+    }
+
+    return crc;
+#endif
 }
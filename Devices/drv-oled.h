@@ -7,7 +7,11 @@
  ***********************************************************************************************************************
  * @attention
  *
- * OLED对象具有IIC对象和图形缓冲区两个属性
+ * OLED对象具有IIC对象和图形缓冲区两个属性; 页带渲染模式(STRIP_RENDER)下不保留图形缓冲区,
+ * 画面逐页渲染到IIC发送缓冲区中的两个页带并直接发送.
+ * 图形缓冲区每页数据之前紧挨一个控制字节0x40, 刷新时DMA直接读取图形缓冲区, 不复制到发送缓冲区;
+ * 提交的缓冲区从开始发送到最后一次传输完成期间归DMA所有, 渲染方须等待其归还后才能改写.
+ * 帧调度: 帧率定时器每周期开放一个发送时隙, 时隙开放, 总线空闲且有新提交的帧时才开始发送, 画面不变时总线保持空闲
  *
  ***********************************************************************************************************************
  **/
@@ -26,6 +30,7 @@
 /*-------- includes --------------------------------------------------------------------------------------------------*/
 
 #include "../Protocols/drv-iic.h"
+#include "../Services/graph-service.h"
 
 
 
@@ -35,6 +40,29 @@
 #define OLED_HEIGHT 8
 #define OLED_WIDTH  128
 
+#define OLED_WINDOW_HEADER_SIZE 13 // 窗口传输头: 6组(0x80, 命令)设置列/页地址, 加上数据控制字节0x40
+#define OLED_START_LINE_SIZE    2  // 起始行传输: 命令控制字节0x00, 加上命令0x40|line
+#define OLED_WINDOW_CMD_SIZE    7  // 窗口命令传输: 命令控制字节0x00, 加上0x21/0x22命令及其参数
+#define OLED_SCROLL_CMD_SIZE    10 // 滚动命令传输: 命令控制字节0x00, 停止滚动, 6字节滚动设置, 激活滚动
+
+#define OLED_PAGE_HEADER_SIZE 4 // 图形缓冲区每页数据之前的页头: 3字节填充使数据4字节对齐, 最后一字节为控制字节0x40
+#define OLED_PAGE_STRIDE      (OLED_PAGE_HEADER_SIZE + OLED_WIDTH) // 图形缓冲区中相邻两页的间隔
+#define OLED_FRAME_NONE       0xFF // 没有图形缓冲区
+
+#define OLED_STRIP_COUNT       2  // 页带数量, 一个页带以DMA发送时渲染另一个
+#define OLED_STRIP_DATA_OFFSET 16 // 页带数据在槽内的偏移, 4字节对齐供CRC计算, 窗口传输头紧挨在数据之前
+#define OLED_STRIP_SLOT_SIZE   (OLED_STRIP_DATA_OFFSET + OLED_WIDTH) // 每个页带在IIC发送缓冲区中占用的字节数
+
+#if STRIP_RENDER
+#define OLED_TX_BUFFER_SIZE (OLED_STRIP_COUNT * OLED_STRIP_SLOT_SIZE) // 两个页带槽, 页带直接在发送缓冲区中渲染
+#else
+#define OLED_TX_BUFFER_SIZE                                                                                            \
+    (OLED_HEIGHT * OLED_WINDOW_CMD_SIZE + OLED_START_LINE_SIZE) // 只存放命令, 最坏情况每页一个窗口
+#endif /* STRIP_RENDER */
+
+#define OLED_LINE_COUNT   64   // 显存行数, 起始行取值0~63
+#define OLED_LINE_UNKNOWN 0xFF // 屏幕的显示起始行未知, 下次刷新重新发送起始行
+
 
 
 
@@ -46,18 +74,91 @@ typedef enum {
 } OLEDErrCode;
 
 typedef struct {
-    IICObjTypeDef* iic;
-    uint8_t graphicsBuffer[OLED_HEIGHT][OLED_WIDTH];
-    uint8_t graphicsBufferSub[OLED_HEIGHT][OLED_WIDTH]; // 用于DMA传输时的辅助缓冲区
+    const uint8_t* data; // DMA读取的起始地址, 位于IIC发送缓冲区或图形缓冲区中
+    uint16_t len;        // 长度, 包含控制字节
+} OLEDSegmentTypeDef;    // 一次IIC传输
+
+typedef enum {
+    OLED_SCROLL_RIGHT = 0x26, // 向右水平滚动
+    OLED_SCROLL_LEFT  = 0x27, // 向左水平滚动
+} OLEDScrollEnum;             // 硬件水平滚动方向
 
+typedef enum {
+    OLED_SCROLL_REQ_NONE,    // 没有滚动命令, 命令缓冲区可以改写
+    OLED_SCROLL_REQ_PENDING, // 命令已写入缓冲区, 等待帧调度发送
+    OLED_SCROLL_REQ_SENDING, // 命令正在发送, 缓冲区归DMA所有
+} OLEDScrollReqEnum;         // 滚动命令请求状态
+
+typedef struct {
+    uint32_t rendered;  // 提交的帧数
+    uint32_t sent;      // 开始发送的帧数
+    uint32_t unchanged; // 与屏幕内容相同, 取得后无需发送的帧数
+    uint32_t dropped;   // 尚未取得即被更新的帧取代的帧数, 在取得更新的帧时计入
+} OLEDFrameStatTypeDef; // 帧调度统计
+
+typedef void (*OLEDStripRenderFunc)(const void* arg, const CanvasTypeDef* strip); // 将画面中的一页渲染到页带画布
+
+typedef struct {
+    IICObjTypeDef* iic;
+#if STRIP_RENDER
+    uint8_t stripIndex; // 下一页渲染使用的页带, 另一页带可能正在发送
+#else
+    uint8_t graphicsBuffer[OLED_HEIGHT][OLED_PAGE_STRIDE];    // 每页数据之前带页头, 以OLED_FRAME_CANVAS构造画布
+    uint8_t graphicsBufferSub[OLED_HEIGHT][OLED_PAGE_STRIDE]; // 双缓冲的另一图形缓冲区
+
+    DirtyMapTypeDef dirtyMap[2]; // 两个图形缓冲区自上次发送后被修改的区域, 由绘图服务标记
+    DirtyMapTypeDef staleMap[2]; // 因发送另一缓冲区而与屏幕内容不一致的区域, 仅在发送时更新
+
+    volatile uint8_t frameReady;        // 已提交且尚未开始发送的图形缓冲区, OLED_FRAME_NONE表示没有
+    volatile uint8_t frameSending;      // 正被DMA读取的图形缓冲区, 最后一次传输完成时归还
+    volatile uint8_t frameStartLine[2]; // 各图形缓冲区提交时的显示起始行
+    volatile uint32_t frameSeq[2];      // 各图形缓冲区提交时的帧序号
+    uint32_t lastSeq;                   // 最后取得的帧序号, 与新取得帧序号之间的帧被丢弃
+    volatile uint8_t frameSlot;         // 发送时隙是否开放, 由帧率定时器开放, 取得一帧后关闭
+
+    OLEDFrameStatTypeDef frameStat; // 帧调度统计
+#endif /* STRIP_RENDER */
+
+    OLEDSegmentTypeDef segment[OLED_HEIGHT * 2 + 1]; // 本次刷新的传输列表, 每个窗口为一次命令及各页数据传输
+    uint8_t segmentCount;                            // 传输数量
+    uint8_t segmentIndex;                            // 正在进行的传输
+    volatile uint8_t busy;                           // DMA刷新是否进行中
+
+    uint8_t scrollCmd[OLED_SCROLL_CMD_SIZE]; // 滚动命令缓冲区, 与刷新使用的IIC发送缓冲区分开
+    uint8_t scrollCmdLen;                    // 滚动命令长度
+#if !STRIP_RENDER
+    volatile uint8_t scrollReq; // 滚动命令请求状态, 由主循环提交, 在帧调度中发送
+#endif /* STRIP_RENDER */
+
+    uint32_t pageCRC[OLED_HEIGHT]; // 屏幕上各页最后一次发送内容的CRC
+    uint8_t pageCRCValid;          // pageCRC中有效的页(按位)
+    uint32_t pageSent;             // 累计发送的页数
+    uint32_t pageSkipped;          // 累计因CRC相同而跳过的页数
+    uint32_t byteSent;             // 累计以DMA发送的字节数, 包含控制字节和命令
+
+    uint8_t startLine;      // 下次刷新时生效的显示起始行
+    uint8_t panelStartLine; // 屏幕当前的显示起始行, OLED_LINE_UNKNOWN表示未知
 } OLEDObjTypeDef;
 
 typedef struct {
     OLEDErrCode (*clear)(OLEDObjTypeDef*);
-    OLEDErrCode (*draw)(OLEDObjTypeDef*);
     OLEDErrCode (*init)(OLEDObjTypeDef*);
     OLEDErrCode (*fill)(OLEDObjTypeDef*);
     OLEDErrCode (*cmd)(OLEDObjTypeDef*);
+#if STRIP_RENDER
+    OLEDErrCode (*flushStrips)(OLEDObjTypeDef*, OLEDStripRenderFunc render, const void* arg); // 逐页渲染并以DMA发送
+#else
+    OLEDErrCode (*draw)(OLEDObjTypeDef*);
+    void (*submit)(OLEDObjTypeDef*, uint8_t index, uint8_t line); // 提交渲染完成的图形缓冲区及其显示起始行
+    OLEDErrCode (*flush)(OLEDObjTypeDef*);                       // 以DMA发送最近提交的图形缓冲区的脏区域
+    uint8_t (*frameInUse)(OLEDObjTypeDef*, uint8_t index);        // 图形缓冲区是否正被DMA读取
+    void (*frameTick)(OLEDObjTypeDef*);                           // 开放发送时隙, 以最大帧率调用
+    OLEDErrCode (*schedule)(OLEDObjTypeDef*);                     // 满足条件时取得最新提交的帧并开始发送
+#endif /* STRIP_RENDER */
+    void (*setStartLine)(OLEDObjTypeDef*, uint8_t line);  // 设置显示起始行, 随下次刷新发送
+    OLEDErrCode (*scroll)(OLEDObjTypeDef*, OLEDScrollEnum dir, uint8_t page0, uint8_t page1, uint8_t interval);
+    OLEDErrCode (*stopScroll)(OLEDObjTypeDef*); // 停止硬件滚动, 之后的刷新重新发送整屏
+    uint32_t (*selfTest)(OLEDObjTypeDef*);      // 阻塞发送整屏, 返回实测吞吐量(字节/秒)
 } OLEDIntfTypeDef;
 
 
@@ -66,6 +167,9 @@ typedef struct {
 
 /*-------- macro -----------------------------------------------------------------------------------------------------*/
 
+// 以带页头的图形缓冲区uint8_t frame[OLED_HEIGHT][OLED_PAGE_STRIDE]构造屏幕画布, 画布只包含各页的数据部分
+#define OLED_FRAME_CANVAS(frame)                                                                                       \
+    ((CanvasTypeDef){&(frame)[0][OLED_PAGE_HEADER_SIZE], OLED_WIDTH, OLED_LINE_COUNT, OLED_PAGE_STRIDE, 0})
 
 
 
@@ -20,6 +20,7 @@
 #include "../Services/time-service.h"
 #include "drv-iic.h"
 #include <stdlib.h>
+#include <string.h>
 
 
 
@@ -33,13 +34,32 @@
 
 /* ------- define ----------------------------------------------------------------------------------------------------*/
 
-#define TIMEOUT 0
+#define IIC_PCLK1_MIN_MHZ      2      // 标准模式要求的最低PCLK1频率
+#define IIC_FAST_PCLK1_MIN_MHZ 4      // 快速模式要求的最低PCLK1频率
+#define IIC_PCLK1_MAX_MHZ      36     // CR2.FREQ允许的最高PCLK1频率
+#define IIC_STANDARD_CCR_MIN   4      // 标准模式CCR的最小值
+#define IIC_CCR_MAX            0x0FFF // CCR字段的最大值
+
+#define IIC_IRQ_PRIORITY         1    // 事件/错误中断的抢占优先级, 与DMA传输完成中断相同, 互不嵌套
+#define IIC_RECOVERY_CLOCKS      9    // 总线恢复时最多产生的SCL脉冲数, 从设备最多还需输出8位数据和1位应答
+#define IIC_RECOVERY_HALF_US     5    // 总线恢复时SCL的半周期, 约100kHz
+#define IIC_STOP_WAIT_US         50   // 开始传输前等待上一次STOP发出的最长时间
+#define IIC_XFER_TIMEOUT_BASE_US 1000 // 估算传输超时时间时额外增加的时间
+
+// 主机测试在包含本文件前以模拟的周期计数器代替
+#ifndef IIC_DWT_CYCCNT
+#define IIC_DWT_CTRL      (*(volatile uint32_t*)0xE0001000) // DWT控制寄存器, 所用CMSIS版本未定义DWT
+#define IIC_DWT_CYCCNT    (*(volatile uint32_t*)0xE0001004) // DWT周期计数器, 72MHz下约59s回绕一次
+#endif /* IIC_DWT_CYCCNT */
+#define IIC_DWT_CYCCNTENA 0x00000001                        // DWT_CTRL中的周期计数器使能位
 
 
 
 
 /* ------- macro -----------------------------------------------------------------------------------------------------*/
 
+#define IIC_US_TO_CYCLES(us) ((uint32_t)(us) * (SystemCoreClock / 1000000)) // 微秒换算为内核时钟周期数
+
 
 
 
@@ -52,6 +72,25 @@ IICErrCode iicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA
 IICErrCode iicSend(IICObjTypeDef* iicObj);
 IICErrCode iicTxEquipWithDMA(IICObjTypeDef* iicObj);
 IICErrCode iicSendWithDMA(IICObjTypeDef* iicObj);
+IICErrCode iicSendBlockWithDMA(IICObjTypeDef* iicObj, const uint8_t* data, uint16_t len);
+IICErrCode iicFinishWithDMA(IICObjTypeDef* iicObj);
+IICErrCode iicSetClock(IICObjTypeDef* iicObj, uint32_t speed, IICDutyEnum duty, uint8_t overclock);
+IICErrCode iicQueueEquip(IICObjTypeDef* iicObj);
+IICErrCode iicQueueSubmit(IICObjTypeDef* iicObj, const IICXferTypeDef* xfer);
+void iicQueueEventISR(IICObjTypeDef* iicObj);
+void iicQueueErrorISR(IICObjTypeDef* iicObj);
+void iicQueueDMAComplete(IICObjTypeDef* iicObj);
+void iicQueuePoll(IICObjTypeDef* iicObj);
+IICErrCode iicRecover(IICObjTypeDef* iicObj);
+static void iicQueueStart(IICObjTypeDef* iicObj);
+static void iicQueueAfterWrite(IICObjTypeDef* iicObj, const IICXferTypeDef* xfer);
+static void iicQueueFinish(IICObjTypeDef* iicObj, IICErrCode status);
+static void iicQueueStopDMA(IICObjTypeDef* iicObj);
+static uint32_t iicXferTimeoutUs(const IICObjTypeDef* iicObj, const IICXferTypeDef* xfer);
+static IICErrCode iicWaitEvent(IICObjTypeDef* iicObj, uint32_t event);
+static IICErrCode iicWaitFlag(IICObjTypeDef* iicObj, uint32_t flag, FlagStatus state);
+static void iicDelayCycles(uint32_t cycles);
+static void iicCycleCounterInit(void);
 
 
 
@@ -60,10 +99,20 @@ IICErrCode iicSendWithDMA(IICObjTypeDef* iicObj);
 /* ------- variables -------------------------------------------------------------------------------------------------*/
 
 IICIntfTypeDef iicIntf = {
-    .init            = iicInit,
-    .transmit        = iicSend,
-    .equippedWithDMA = iicTxEquipWithDMA,
-    .transmitWithDMA = iicSendWithDMA,
+    .init                 = iicInit,
+    .transmit             = iicSend,
+    .equippedWithDMA      = iicTxEquipWithDMA,
+    .transmitWithDMA      = iicSendWithDMA,
+    .transmitBlockWithDMA = iicSendBlockWithDMA,
+    .finishWithDMA        = iicFinishWithDMA,
+    .setClock             = iicSetClock,
+    .equippedWithQueue    = iicQueueEquip,
+    .submit               = iicQueueSubmit,
+    .eventISR             = iicQueueEventISR,
+    .errorISR             = iicQueueErrorISR,
+    .dmaComplete          = iicQueueDMAComplete,
+    .poll                 = iicQueuePoll,
+    .recover              = iicRecover,
 };
 
 extern uint16_t debug_errCnt;
@@ -85,6 +134,7 @@ extern uint16_t debug_errCnt;
  * @param txBufferSize
  * @param rxBufferSize
  * @return IICErrCode
+ * @note 硬件IIC以占空比2配置时钟, 超过400kHz的速率须在初始化后以iicSetClock显式允许超频
  */
 IICErrCode iicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA, GPIOPinEnum SDA_Pin, GPIOPortEnum SCL,
                    GPIOPinEnum SCL_Pin, uint16_t txBufferSize, uint16_t rxBufferSize, uint16_t timeoutUs,
@@ -96,7 +146,7 @@ IICErrCode iicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA
     if (txBufferSize == 0 || rxBufferSize == 0) {
         return IIC_ERR_PARAM;
     }
-    if (speed <= 0 || speed > 400000) {
+    if (speed <= 0 || speed > IIC_FAST_MODE_MAX_SPEED) {
         return IIC_ERR_PARAM;
     }
 
@@ -113,6 +163,12 @@ IICErrCode iicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA
     iicObj->rxBufferSize = rxBufferSize;
     iicObj->txIndex      = 0;
     iicObj->rxIndex      = 0;
+    iicObj->SDAPort      = SDA;
+    iicObj->SDAPin       = SDA_Pin;
+    iicObj->SCLPort      = SCL;
+    iicObj->SCLPin       = SCL_Pin;
+    iicObj->dmaObj       = NULL;
+    iicObj->queue        = NULL;
 
 
 
@@ -126,14 +182,7 @@ IICErrCode iicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA
         gpioIntf.pinInit(SDA, SDA_Pin, OUTPUT_OPEN_DRAIN); // SDA设置成为开漏输出
         gpioIntf.pinInit(SCL, SCL_Pin, OUTPUT_OPEN_DRAIN); // SCL设置成为开漏输出
 
-        /* 4. 配置IIC对象 */
-        iicObj->SDAPort = SDA;
-        iicObj->SDAPin  = SDA_Pin;
-        iicObj->SCLPort = SCL;
-        iicObj->SCLPin  = SCL_Pin;
-
-
-        /* 5. 初始状态释放总线 */
+        /* 4. 初始状态释放总线 */
         gpioIntf.pinSet(iicObj->SCLPort, iicObj->SCLPin); // SCL拉高
         gpioIntf.pinSet(iicObj->SDAPort, iicObj->SDAPin); // SDA拉高
         return IIC_SUCCESS;
@@ -156,13 +205,11 @@ IICErrCode iicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA
             return IIC_ERR_PARAM; // 无效的IIC类型
         }
 
-        if (speed > 100000) {
-            RCC_PCLK1Config(RCC_HCLK_Div2);
-        }
-
         I2C_SoftwareResetCmd(iicObj->i2c, ENABLE);
         I2C_SoftwareResetCmd(iicObj->i2c, DISABLE);
 
+        iicCycleCounterInit(); // 超时以周期计数器计时
+
         I2C_InitTypeDef i2cstruct;
         i2cstruct.I2C_Mode                = I2C_Mode_I2C;
         i2cstruct.I2C_DutyCycle           = I2C_DutyCycle_2;
@@ -170,12 +217,75 @@ IICErrCode iicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA
         i2cstruct.I2C_Ack                 = I2C_Ack_Enable;
         i2cstruct.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
         i2cstruct.I2C_ClockSpeed          = speed;
-        I2C_Init(I2C1, &i2cstruct);
+        I2C_Init(iicObj->i2c, &i2cstruct);
 
-        I2C_Cmd(I2C1, ENABLE);
+        // I2C_Init的时钟配置向下取整, 可能略高于speed, 由iicSetClock按PCLK1重新计算
+        return iicSetClock(iicObj, speed, IIC_DUTY_2, 0);
+    }
+}
 
-        return IIC_SUCCESS;
+
+/**
+ * @brief 配置硬件IIC的速率
+ *
+ * @param iicObj
+ * @param speed 目标速率(Hz)
+ * @param duty 快速模式下SCL低/高电平时间比, 标准模式忽略
+ * @param overclock 非0时允许超过IIC_FAST_MODE_MAX_SPEED, 最高IIC_OVERCLOCK_MAX_SPEED
+ * @return IICErrCode 软件IIC, 速率超出范围或PCLK1不满足所需模式时返回IIC_ERR_PARAM
+ * @note 1. 按当前PCLK1计算CR2.FREQ, CCR和TRISE, 不修改PCLK1分频
+ *       2. 标准模式SCL周期为2个CCR, 快速模式占空比2时为3个CCR, 16:9时为25个CCR(单位为PCLK1周期);
+ *          CCR向上取整使实际速率不超过speed, 实际速率写回iicObj->speed
+ *       3. TRISE为最大上升时间对应的PCLK1周期数加1: 标准模式1000ns, 快速模式300ns, 超频时按快速模式+的120ns
+ *       4. 超过400kHz已超出STM32F1的规格, 依赖从设备和上拉电阻, 须在目标板上确认通信可靠
+ *       5. 配置期间关闭外设, 须在总线空闲时调用
+ */
+IICErrCode iicSetClock(IICObjTypeDef* iicObj, uint32_t speed, IICDutyEnum duty, uint8_t overclock) {
+    if (iicObj == NULL || iicObj->type == IIC_SOFTWARE || speed == 0) {
+        return IIC_ERR_PARAM;
+    }
+    if (speed > (overclock ? IIC_OVERCLOCK_MAX_SPEED : IIC_FAST_MODE_MAX_SPEED)) {
+        return IIC_ERR_PARAM;
     }
+
+    RCC_ClocksTypeDef clocks;
+    RCC_GetClocksFreq(&clocks);
+
+    uint32_t pclk1   = clocks.PCLK1_Frequency;
+    uint16_t freqMHz = pclk1 / 1000000;
+    uint8_t fast     = speed > IIC_STANDARD_MODE_MAX_SPEED;
+    uint32_t period  = !fast ? 2 : duty == IIC_DUTY_16_9 ? 25 : 3; // SCL周期包含的CCR数
+    uint32_t ccr     = (pclk1 + speed * period - 1) / (speed * period);
+    uint16_t trise;
+
+    if (freqMHz < (fast ? IIC_FAST_PCLK1_MIN_MHZ : IIC_PCLK1_MIN_MHZ) || freqMHz > IIC_PCLK1_MAX_MHZ) {
+        return IIC_ERR_PARAM;
+    }
+
+    if (!fast) {
+        if (ccr < IIC_STANDARD_CCR_MIN) {
+            ccr = IIC_STANDARD_CCR_MIN;
+        }
+        trise = freqMHz + 1;
+    } else {
+        trise = freqMHz * (speed > IIC_FAST_MODE_MAX_SPEED ? 120 : 300) / 1000 + 1;
+    }
+    if (ccr > IIC_CCR_MAX) {
+        return IIC_ERR_PARAM; // 速率过低
+    }
+
+    I2C_Cmd(iicObj->i2c, DISABLE); // CCR和TRISE只能在外设关闭时写入
+
+    iicObj->i2c->CR2   = (iicObj->i2c->CR2 & ~I2C_CR2_FREQ) | freqMHz;
+    iicObj->i2c->CCR   = ccr | (fast ? I2C_CCR_FS : 0) | (fast && duty == IIC_DUTY_16_9 ? I2C_CCR_DUTY : 0);
+    iicObj->i2c->TRISE = trise;
+
+    I2C_Cmd(iicObj->i2c, ENABLE);
+
+    iicObj->speed = pclk1 / (ccr * period);
+    iicObj->duty  = duty;
+
+    return IIC_SUCCESS;
 }
 
 
@@ -302,6 +412,7 @@ static IICErrCode iicSendByte(IICObjTypeDef* iicObj, uint8_t byte) {
 /**
  * @brief IIC发送数据
  * @note 发送IIC数据前赋值slaveAddr, 给发送缓冲区txBuffer填充数据，并指明发送长度txLen。
+ *       阻塞发送, 不可在异步传输队列有进行中的传输时调用; 硬件IIC的START超时后恢复总线
  * @param iicObj
  * @return IICErrCode
  */
@@ -347,58 +458,31 @@ IICErrCode iicSend(IICObjTypeDef* iicObj) {
 
     } else {
 
-        /* 硬件IIC通信 */
-        float startTime;
-		
-		// 防止warnning
-		(void)startTime;
-#if TIMEOUT
+        /* 硬件IIC通信, 每一步等待不超过timeoutUs */
 
-        float timeDiff;
-#endif
-
-        // 1. 检查IIC是否忙碌
+        // 1.发送START, 总线被占用时恢复总线
         I2C_GenerateSTART(iicObj->i2c, ENABLE);
-
-        startTime = timeServIntf.getGlobalTime(); // 获取当前时间
-        while (!I2C_CheckEvent(iicObj->i2c, I2C_EVENT_MASTER_MODE_SELECT)) {
-#if TIMEOUT
-            timeDiff = timeServIntf.getGlobalTime() - startTime; // 计算时间差
-            if (timeDiff > iicObj->timeoutUs / 1000.0f) {        // 如果超过超时时间
-                I2C_GenerateSTOP(iicObj->i2c, ENABLE);           // 发送STOP信号
-                return IIC_ERR_BUSY;                             // 返回总线繁忙
-            }
-#endif
+        if (iicWaitEvent(iicObj, I2C_EVENT_MASTER_MODE_SELECT) != IIC_SUCCESS) {
+            iicRecover(iicObj);
+            return IIC_ERR_BUSY;
         }
 
         // 2.发送从设备地址并检查ACK
         I2C_Send7bitAddress(iicObj->i2c, iicObj->slaveAddr, I2C_Direction_Transmitter);
-
-        startTime = timeServIntf.getGlobalTime(); // 获取当前时间
-        while (!I2C_CheckEvent(iicObj->i2c, I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED)) {
-#if TIMEOUT
-            timeDiff = timeServIntf.getGlobalTime() - startTime; // 计算时间差
-            if (timeDiff > iicObj->timeoutUs / 1000.0f) {        // 如果超过超时时间
-                I2C_GenerateSTOP(iicObj->i2c, ENABLE);           // 发送STOP信号
-                return IIC_ERR_NACK;                             // 返回NACK错误
-            }
-#endif
+        if (iicWaitEvent(iicObj, I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED) != IIC_SUCCESS) {
+            I2C_GenerateSTOP(iicObj->i2c, ENABLE);
+            I2C_ClearFlag(iicObj->i2c, I2C_FLAG_AF);
+            return IIC_ERR_NACK;
         }
 
-
         // 3.发送数据
         for (uint16_t i = 0; i < iicObj->txLen; i++) {
             I2C_SendData(iicObj->i2c, iicObj->txBuffer[i]);
 
-            startTime = timeServIntf.getGlobalTime(); // 获取当前时间
-            while (!I2C_CheckEvent(iicObj->i2c, I2C_EVENT_MASTER_BYTE_TRANSMITTED)) {
-#if TIMEOUT
-                timeDiff = timeServIntf.getGlobalTime() - startTime; // 计算时间差
-                if (timeDiff > iicObj->timeoutUs / 1000.0f) {        // 如果超过超时时间
-                    I2C_GenerateSTOP(iicObj->i2c, ENABLE);           // 发送STOP信号
-                    return IIC_ERR_TIMEOUT;                          // 响应超时
-                }
-#endif
+            if (iicWaitEvent(iicObj, I2C_EVENT_MASTER_BYTE_TRANSMITTED) != IIC_SUCCESS) {
+                I2C_GenerateSTOP(iicObj->i2c, ENABLE);
+                I2C_ClearFlag(iicObj->i2c, I2C_FLAG_AF);
+                return IIC_ERR_TIMEOUT;
             }
         }
 
@@ -433,14 +517,14 @@ IICErrCode iicTxEquipWithDMA(IICObjTypeDef* obj) {
     if (obj->type == IIC_HARDWARE_1) {
         obj->dmaObj->channel = DMA1_Channel6; // 硬件IIC1使用DMA1通道6
     } else if (obj->type == IIC_HARDWARE_2) {
-        obj->dmaObj->channel = DMA1_Channel7; // 硬件IIC2使用DMA1通道7
+        obj->dmaObj->channel = DMA1_Channel4; // 硬件IIC2发送使用DMA1通道4
     } else {
         return IIC_ERR_PARAM; // 无效的IIC类型
     }
 
     dmaIntf.init(obj->dmaObj, obj->dmaObj->channel, DMA_Priority_Medium);
     dmaIntf.setSorce(obj->dmaObj, (uint32_t)obj->txBuffer, DMA_SIZE_BYTE, obj->txBufferSize);
-    dmaIntf.setDest(obj->dmaObj, (uint32_t)&I2C1->DR, DMA_SIZE_BYTE, 1); // 目的地址为I2C数据寄存器
+    dmaIntf.setDest(obj->dmaObj, (uint32_t)&obj->i2c->DR, DMA_SIZE_BYTE, 1); // 目的地址为I2C数据寄存器
     dmaIntf.configISR(obj->dmaObj);
 
     return IIC_SUCCESS;
@@ -452,6 +536,7 @@ IICErrCode iicTxEquipWithDMA(IICObjTypeDef* obj) {
  *
  * @param iicObj
  * @return IICErrCode
+ * @note 发送txBuffer中从txIndex开始的txLen个字节, 传输完成后需调用iicFinishWithDMA产生STOP
  */
 IICErrCode iicSendWithDMA(IICObjTypeDef* iicObj) {
     if (iicObj == NULL || iicObj->dmaObj == NULL) {
@@ -464,16 +549,40 @@ IICErrCode iicSendWithDMA(IICObjTypeDef* iicObj) {
     if (iicObj->txLen == 0 || iicObj->txBuffer == NULL) {
         return IIC_ERR_PARAM; // 发送缓冲区不能为空
     }
-    if (iicObj->txLen > iicObj->txBufferSize) {
+    if (iicObj->txIndex + iicObj->txLen > iicObj->txBufferSize) {
         return IIC_ERR_PARAM; // 发送长度超过缓冲区大小
     }
 
+    return iicSendBlockWithDMA(iicObj, iicObj->txBuffer + iicObj->txIndex, iicObj->txLen);
+}
+
+
+/**
+ *@brief IIC使用DMA发送指定地址的数据
+ *
+ * @param iicObj
+ * @param data 待发送数据的首地址, 传输完成前须保持不变
+ * @param len 发送的字节数
+ * @return IICErrCode 总线被占用或START超时时恢复总线并返回IIC_ERR_BUSY, 从设备无应答时返回IIC_ERR_NACK
+ * @note DMA的存储器地址直接指向data, 数据不经过发送缓冲区; 传输完成后需调用iicFinishWithDMA产生STOP
+ */
+IICErrCode iicSendBlockWithDMA(IICObjTypeDef* iicObj, const uint8_t* data, uint16_t len) {
+    if (iicObj == NULL || iicObj->dmaObj == NULL) {
+        return IIC_ERR_PARAM;
+    }
+    if (iicObj->type == IIC_SOFTWARE) {
+        return IIC_ERR_PARAM; // 仅硬件IIC支持DMA
+    }
+    if (data == NULL || len == 0) {
+        return IIC_ERR_PARAM;
+    }
+
     //    if (iicObj->type == IIC_HARDWARE_1) {
     //        if (DMA_GetFlagStatus(DMA1_FLAG_TC6) == RESET) {
     //            return IIC_ERR_BUSY; // DMA未准备好
     //        };
     //    } else if (iicObj->type == IIC_HARDWARE_2) {
-    //        if (DMA_GetFlagStatus(DMA1_FLAG_TC7) == RESET) {
+    //        if (DMA_GetFlagStatus(DMA1_FLAG_TC4) == RESET) {
     //            return IIC_ERR_BUSY; // DMA未准备好
     //        };
     //    } else {
@@ -482,22 +591,29 @@ IICErrCode iicSendWithDMA(IICObjTypeDef* iicObj) {
 
 
 
-    while (I2C_GetFlagStatus(iicObj->i2c, I2C_FLAG_BUSY))
-        ;
+    // 每一步等待不超过timeoutUs, 总线被占用或START发不出时恢复总线
+    if (iicWaitFlag(iicObj, I2C_FLAG_BUSY, RESET) != IIC_SUCCESS) {
+        iicRecover(iicObj);
+        return IIC_ERR_BUSY;
+    }
 
     I2C_GenerateSTART(iicObj->i2c, ENABLE); // 发送START信号
-
-    while (!I2C_CheckEvent(iicObj->i2c, I2C_EVENT_MASTER_MODE_SELECT))
-        ; // 等待START信号发送完成
+    if (iicWaitEvent(iicObj, I2C_EVENT_MASTER_MODE_SELECT) != IIC_SUCCESS) {
+        iicRecover(iicObj);
+        return IIC_ERR_BUSY;
+    }
 
     I2C_Send7bitAddress(iicObj->i2c, iicObj->slaveAddr, I2C_Direction_Transmitter); // 发送从设备地址
-    while (!I2C_CheckEvent(iicObj->i2c, I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED))
-        ; // 等待从设备地址发送完成
+    if (iicWaitEvent(iicObj, I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED) != IIC_SUCCESS) {
+        I2C_GenerateSTOP(iicObj->i2c, ENABLE);
+        I2C_ClearFlag(iicObj->i2c, I2C_FLAG_AF);
+        return IIC_ERR_NACK;
+    }
 
 
 
 
-    dmaIntf.setSorce(iicObj->dmaObj, (uint32_t)iicObj->txBuffer, DMA_SIZE_BYTE, iicObj->txLen);
+    dmaIntf.setSorce(iicObj->dmaObj, (uint32_t)data, DMA_SIZE_BYTE, len);
     dmaIntf.setDest(iicObj->dmaObj, (uint32_t)&iicObj->i2c->DR, DMA_SIZE_BYTE, 1);
     dmaIntf.start(iicObj->dmaObj);   // 启动DMA传输
     I2C_DMACmd(iicObj->i2c, ENABLE); // 使能IIC的DMA功能
@@ -508,10 +624,551 @@ IICErrCode iicSendWithDMA(IICObjTypeDef* iicObj) {
         DMA_ClearFlag(DMA1_FLAG_TC6); // 清除DMA传输完成标志
     } else if (iicObj->type == IIC_HARDWARE_2) {
 
-        DMA_ClearFlag(DMA1_FLAG_TC7); // 清除DMA传输完成标志
+        DMA_ClearFlag(DMA1_FLAG_TC4); // 清除DMA传输完成标志
+    }
+
+
+
+    return IIC_SUCCESS;
+}
+
+
+/**
+ *@brief 结束IIC的DMA发送
+ *
+ * @param iicObj
+ * @return IICErrCode
+ * @note 在DMA传输完成中断中调用. DMA搬运完最后一个字节时该字节尚未移出, 需等待BTF后再产生STOP,
+ *       等待不超过timeoutUs
+ */
+IICErrCode iicFinishWithDMA(IICObjTypeDef* iicObj) {
+    if (iicObj == NULL || iicObj->dmaObj == NULL) {
+        return IIC_ERR_PARAM;
+    }
+
+    DMA_Cmd(iicObj->dmaObj->channel, DISABLE);
+    I2C_DMACmd(iicObj->i2c, DISABLE);
+
+    // 等待最后一个字节发送完成, 超过timeoutUs时从设备可能拉住了SCL, 恢复总线
+    if (iicWaitFlag(iicObj, I2C_FLAG_BTF, SET) != IIC_SUCCESS) {
+        I2C_GenerateSTOP(iicObj->i2c, ENABLE);
+        iicRecover(iicObj);
+        return IIC_ERR_TIMEOUT;
+    }
+
+    I2C_GenerateSTOP(iicObj->i2c, ENABLE);
+
+    return IIC_SUCCESS;
+}
+
+
+
+/**
+ * @brief 配置异步传输队列
+ *
+ * @param iicObj
+ * @return IICErrCode
+ * @note 1. 使能事件/错误中断的NVIC通道, 外设中断在开始传输时打开, 队列为空时关闭
+ *       2. 使用IIC_XFER_DMA_WRITE前须先调用iicTxEquipWithDMA, DMA传输完成中断中须调用iicQueueDMAComplete
+ */
+IICErrCode iicQueueEquip(IICObjTypeDef* iicObj) {
+    if (iicObj == NULL || iicObj->type == IIC_SOFTWARE) {
+        return IIC_ERR_PARAM; // 仅硬件IIC支持异步传输
+    }
+
+    if ((iicObj->queue = (IICQueueTypeDef*)malloc(sizeof(IICQueueTypeDef))) == NULL) {
+        return IIC_ERR_MEM_ALLOC_FAIL;
+    }
+    memset(iicObj->queue, 0, sizeof(IICQueueTypeDef));
+    iicObj->queue->state = IIC_STATE_IDLE;
+
+    NVIC_InitTypeDef nvic;
+    nvic.NVIC_IRQChannelPreemptionPriority = IIC_IRQ_PRIORITY;
+    nvic.NVIC_IRQChannelSubPriority        = 0;
+    nvic.NVIC_IRQChannelCmd                = ENABLE;
+
+    nvic.NVIC_IRQChannel = iicObj->type == IIC_HARDWARE_1 ? I2C1_EV_IRQn : I2C2_EV_IRQn;
+    NVIC_Init(&nvic);
+    nvic.NVIC_IRQChannel = iicObj->type == IIC_HARDWARE_1 ? I2C1_ER_IRQn : I2C2_ER_IRQn;
+    NVIC_Init(&nvic);
+
+    return IIC_SUCCESS;
+}
+
+
+/**
+ * @brief 加入异步传输
+ *
+ * @param iicObj
+ * @param xfer 传输描述, 复制到队列中, 调用后可以释放; 其中的数据地址在传输结束前须保持有效
+ * @return IICErrCode 队列已满时返回IIC_ERR_BUSY
+ * @note 1. 总线空闲时立即开始, 否则在前面的传输结束后依次开始
+ *       2. 可在主循环, 中断和传输结束回调中调用
+ */
+IICErrCode iicQueueSubmit(IICObjTypeDef* iicObj, const IICXferTypeDef* xfer) {
+    if (iicObj == NULL || iicObj->queue == NULL || xfer == NULL) {
+        return IIC_ERR_PARAM;
+    }
+    if ((xfer->txLen > 0 && xfer->txData == NULL) || (xfer->type == IIC_XFER_DMA_WRITE && xfer->txLen == 0)) {
+        return IIC_ERR_PARAM;
+    }
+    if (xfer->type == IIC_XFER_WRITE_READ && (xfer->rxLen == 0 || xfer->rxData == NULL)) {
+        return IIC_ERR_PARAM;
+    }
+    if (xfer->type == IIC_XFER_DMA_WRITE && iicObj->dmaObj == NULL) {
+        return IIC_ERR_PARAM; // 未配置DMA
+    }
+
+    IICQueueTypeDef* queue = iicObj->queue;
+    uint32_t primask       = __get_PRIMASK();
+    __disable_irq();
+
+    if (queue->count >= IIC_QUEUE_SIZE) {
+        __set_PRIMASK(primask);
+        return IIC_ERR_BUSY;
+    }
+
+    queue->xfer[(queue->head + queue->count) % IIC_QUEUE_SIZE] = *xfer;
+    queue->count++;
+    iicQueueStart(iicObj);
+
+    __set_PRIMASK(primask);
+
+    return IIC_SUCCESS;
+}
+
+
+/**
+ * @brief 异步传输的事件中断处理
+ *
+ * @param iicObj
+ * @note 1. 写: START -> 地址 -> TXE逐字节写入 -> BTF后STOP; 先写后读在BTF后重复START进入接收
+ *       2. 接收按参考手册的方法在最后几个字节处理ACK/STOP: 1字节在清除ADDR前关闭ACK并在之后STOP;
+ *          2字节使用POS, 在BTF时STOP并读取2字节; 多于2字节时逐字节读取, 剩3字节起改为等待BTF,
+ *          BTF时关闭ACK读取倒数第3字节, 下一个BTF时STOP并读取最后2字节
+ *       3. DMA批量写在地址应答后启动DMA, 搬运结束后由iicQueueDMAComplete转为等待BTF
+ */
+void iicQueueEventISR(IICObjTypeDef* iicObj) {
+    IICQueueTypeDef* queue = iicObj->queue;
+    I2C_TypeDef* i2c       = iicObj->i2c;
+
+    if (queue == NULL || queue->state == IIC_STATE_IDLE) {
+        I2C_ITConfig(i2c, I2C_IT_EVT | I2C_IT_BUF, DISABLE); // 上一次传输STOP前残留的BTF, 关闭中断防止反复进入
+        return;
+    }
+
+    const IICXferTypeDef* xfer = &queue->xfer[queue->head];
+    uint16_t sr1               = i2c->SR1;
+
+    // START已发送, 写入地址清除SB
+    if (sr1 & I2C_SR1_SB) {
+        if (queue->state == IIC_STATE_RESTART) {
+            I2C_Send7bitAddress(i2c, xfer->slaveAddr, I2C_Direction_Receiver);
+        } else {
+            I2C_Send7bitAddress(i2c, xfer->slaveAddr, I2C_Direction_Transmitter);
+        }
+        return;
+    }
+
+    // 从设备应答地址, 先读SR1再读SR2清除ADDR
+    if (sr1 & I2C_SR1_ADDR) {
+        queue->index = 0;
+
+        if (queue->state == IIC_STATE_RESTART) {
+            queue->state = IIC_STATE_RX;
+
+            if (xfer->rxLen == 1) {
+                I2C_AcknowledgeConfig(i2c, DISABLE);
+                (void)i2c->SR2;
+                I2C_GenerateSTOP(i2c, ENABLE);
+                I2C_ITConfig(i2c, I2C_IT_BUF, ENABLE);
+            } else if (xfer->rxLen == 2) {
+                I2C_AcknowledgeConfig(i2c, DISABLE);
+                I2C_NACKPositionConfig(i2c, I2C_NACKPosition_Next);
+                (void)i2c->SR2;
+            } else {
+                I2C_AcknowledgeConfig(i2c, ENABLE);
+                (void)i2c->SR2;
+                if (xfer->rxLen > 3) {
+                    I2C_ITConfig(i2c, I2C_IT_BUF, ENABLE);
+                }
+            }
+        } else if (xfer->type == IIC_XFER_DMA_WRITE) {
+            (void)i2c->SR2;
+            queue->state = IIC_STATE_DMA;
+
+            dmaIntf.setSorce(iicObj->dmaObj, (uint32_t)xfer->txData, DMA_SIZE_BYTE, xfer->txLen);
+            dmaIntf.setDest(iicObj->dmaObj, (uint32_t)&i2c->DR, DMA_SIZE_BYTE, 1);
+            dmaIntf.start(iicObj->dmaObj);
+            I2C_DMACmd(i2c, ENABLE);
+        } else {
+            (void)i2c->SR2;
+            queue->state = IIC_STATE_TX;
+
+            if (xfer->txLen == 0) {
+                iicQueueAfterWrite(iicObj, xfer); // 没有数据, 地址应答后即结束
+            } else {
+                I2C_ITConfig(i2c, I2C_IT_BUF, ENABLE);
+            }
+        }
+        return;
     }
 
+    if (queue->state == IIC_STATE_TX) {
+        if ((sr1 & I2C_SR1_TXE) && queue->index < xfer->txLen) {
+            I2C_SendData(i2c, xfer->txData[queue->index++]);
+            if (queue->index == xfer->txLen) {
+                I2C_ITConfig(i2c, I2C_IT_BUF, DISABLE); // 最后一个字节已写入, 等待BTF
+            }
+        } else if (sr1 & I2C_SR1_BTF) {
+            iicQueueAfterWrite(iicObj, xfer);
+        }
+    } else if (queue->state == IIC_STATE_RX && (sr1 & (I2C_SR1_RXNE | I2C_SR1_BTF))) {
+        uint16_t remaining = xfer->rxLen - queue->index;
 
+        if (remaining > 3) {
+            xfer->rxData[queue->index++] = I2C_ReceiveData(i2c);
+            if (remaining == 4) {
+                I2C_ITConfig(i2c, I2C_IT_BUF, DISABLE); // 剩余3字节, 改为等待BTF
+            }
+        } else if (remaining == 1) {
+            xfer->rxData[queue->index++] = I2C_ReceiveData(i2c); // 单字节接收, STOP已在清除ADDR后产生
+            iicQueueFinish(iicObj, IIC_SUCCESS);
+        } else if (!(sr1 & I2C_SR1_BTF)) {
+            I2C_ITConfig(i2c, I2C_IT_BUF, DISABLE);
+        } else if (remaining == 3) {
+            I2C_AcknowledgeConfig(i2c, DISABLE); // 最后一个字节回复NACK
+            xfer->rxData[queue->index++] = I2C_ReceiveData(i2c);
+        } else {
+            I2C_GenerateSTOP(i2c, ENABLE);
+            xfer->rxData[queue->index++] = I2C_ReceiveData(i2c);
+            xfer->rxData[queue->index++] = I2C_ReceiveData(i2c);
+            iicQueueFinish(iicObj, IIC_SUCCESS);
+        }
+    }
+}
+
+
+/**
+ * @brief 异步传输的错误中断处理
+ *
+ * @param iicObj
+ * @note 从设备NACK时产生STOP并以IIC_ERR_NACK结束; 总线错误, 仲裁丢失和溢出时总线状态不确定,
+ *       恢复总线后以IIC_ERR_BUSY结束. 之后继续队列中的下一个传输
+ */
+void iicQueueErrorISR(IICObjTypeDef* iicObj) {
+    I2C_TypeDef* i2c = iicObj->i2c;
+    uint16_t sr1     = i2c->SR1;
+
+    i2c->SR1 = (uint16_t)~(I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR); // 写0清除错误标志
+
+    if (iicObj->queue == NULL || iicObj->queue->state == IIC_STATE_IDLE) {
+        return;
+    }
+
+    iicQueueStopDMA(iicObj);
+
+    if (sr1 & I2C_SR1_AF) {
+        I2C_GenerateSTOP(i2c, ENABLE);
+        iicQueueFinish(iicObj, IIC_ERR_NACK);
+    } else {
+        iicRecover(iicObj);
+        iicQueueFinish(iicObj, IIC_ERR_BUSY);
+    }
+}
+
+
+/**
+ * @brief 异步传输的DMA搬运结束
+ *
+ * @param iicObj
+ * @note 在DMA传输完成中断中调用. 最后一个字节尚未移出, 转为等待BTF后STOP, 中断中不等待
+ */
+void iicQueueDMAComplete(IICObjTypeDef* iicObj) {
+    IICQueueTypeDef* queue = iicObj->queue;
+
+    if (queue == NULL || queue->state != IIC_STATE_DMA) {
+        return;
+    }
+
+    iicQueueStopDMA(iicObj);
+    queue->index = queue->xfer[queue->head].txLen;
+    queue->state = IIC_STATE_TX;
+}
+
+
+/**
+ * @brief 检查进行中的异步传输是否超时
+ *
+ * @param iicObj
+ * @note 1. 总线卡死时不再产生中断, 须在主循环或等待传输结束的循环中周期调用
+ *       2. 超时后恢复总线, 以IIC_ERR_TIMEOUT结束该传输并继续下一个; 期间关闭中断, 回调也在关中断时执行
+ */
+void iicQueuePoll(IICObjTypeDef* iicObj) {
+    if (iicObj == NULL || iicObj->queue == NULL) {
+        return;
+    }
+
+    IICQueueTypeDef* queue = iicObj->queue;
+    uint32_t primask       = __get_PRIMASK();
+    __disable_irq();
+
+    if (queue->state != IIC_STATE_IDLE && IIC_DWT_CYCCNT - queue->startCycle > queue->timeoutCycles) {
+        iicQueueStopDMA(iicObj);
+        iicRecover(iicObj);
+        iicQueueFinish(iicObj, IIC_ERR_TIMEOUT);
+    }
+
+    __set_PRIMASK(primask);
+}
+
+
+/**
+ * @brief 恢复总线并复位硬件IIC
+ *
+ * @param iicObj
+ * @return IICErrCode 恢复后SDA或SCL仍为低电平时返回IIC_ERR_BUSY
+ * @note 1. 从设备在传输中途复位前可能一直拉低SDA等待剩余的时钟. 以GPIO产生最多9个SCL脉冲,
+ *          直到SDA被释放, 再产生STOP使从设备回到空闲
+ *       2. 之后软件复位外设, 清除BUSY等卡住的状态, 并恢复复位前的时钟, 地址和应答配置
+ *       3. 阻塞约100us, 不使用IIC中断, 可在中断中调用
+ */
+IICErrCode iicRecover(IICObjTypeDef* iicObj) {
+    if (iicObj == NULL || iicObj->type == IIC_SOFTWARE) {
+        return IIC_ERR_PARAM;
+    }
+
+    I2C_TypeDef* i2c  = iicObj->i2c;
+    uint32_t halfTime = IIC_US_TO_CYCLES(IIC_RECOVERY_HALF_US);
+
+    // 软件复位会清除全部寄存器
+    uint16_t cr1   = i2c->CR1 & I2C_CR1_ACK;
+    uint16_t cr2   = i2c->CR2 & I2C_CR2_FREQ;
+    uint16_t ccr   = i2c->CCR;
+    uint16_t trise = i2c->TRISE;
+    uint16_t oar1  = i2c->OAR1;
+
+    I2C_Cmd(i2c, DISABLE);
+
+    gpioIntf.pinInit(iicObj->SCLPort, iicObj->SCLPin, OUTPUT_OPEN_DRAIN);
+    gpioIntf.pinInit(iicObj->SDAPort, iicObj->SDAPin, OUTPUT_OPEN_DRAIN);
+    gpioIntf.pinSet(iicObj->SDAPort, iicObj->SDAPin);
+    gpioIntf.pinSet(iicObj->SCLPort, iicObj->SCLPin);
+    iicDelayCycles(halfTime);
+
+    for (uint8_t i = 0; i < IIC_RECOVERY_CLOCKS && !gpioIntf.pinRead(iicObj->SDAPort, iicObj->SDAPin); i++) {
+        gpioIntf.pinReset(iicObj->SCLPort, iicObj->SCLPin);
+        iicDelayCycles(halfTime);
+        gpioIntf.pinSet(iicObj->SCLPort, iicObj->SCLPin);
+        iicDelayCycles(halfTime);
+    }
+
+    // STOP: SCL为高时SDA由低变高
+    gpioIntf.pinReset(iicObj->SCLPort, iicObj->SCLPin);
+    iicDelayCycles(halfTime);
+    gpioIntf.pinReset(iicObj->SDAPort, iicObj->SDAPin);
+    iicDelayCycles(halfTime);
+    gpioIntf.pinSet(iicObj->SCLPort, iicObj->SCLPin);
+    iicDelayCycles(halfTime);
+    gpioIntf.pinSet(iicObj->SDAPort, iicObj->SDAPin);
+    iicDelayCycles(halfTime);
+
+    uint8_t released = gpioIntf.pinRead(iicObj->SDAPort, iicObj->SDAPin) &&
+                       gpioIntf.pinRead(iicObj->SCLPort, iicObj->SCLPin);
+
+    gpioIntf.pinInit(iicObj->SCLPort, iicObj->SCLPin, ALT_OUTPUT_OPEN_DRAIN);
+    gpioIntf.pinInit(iicObj->SDAPort, iicObj->SDAPin, ALT_OUTPUT_OPEN_DRAIN);
+
+    I2C_SoftwareResetCmd(i2c, ENABLE);
+    I2C_SoftwareResetCmd(i2c, DISABLE);
+
+    i2c->CR2   = cr2;
+    i2c->CCR   = ccr;
+    i2c->TRISE = trise;
+    i2c->OAR1  = oar1;
+    I2C_Cmd(i2c, ENABLE);
+    i2c->CR1 |= cr1; // ACK须在外设使能后设置
+
+    if (iicObj->queue != NULL) {
+        iicObj->queue->stat.recoveries++;
+    }
+
+    return released ? IIC_SUCCESS : IIC_ERR_BUSY;
+}
+
+
+/**
+ * @brief 开始队首的异步传输
+ *
+ * @param iicObj
+ * @note 在关中断或IIC中断中调用; 已有进行中的传输或队列为空时不做任何事
+ */
+static void iicQueueStart(IICObjTypeDef* iicObj) {
+    IICQueueTypeDef* queue = iicObj->queue;
+
+    if (queue->state != IIC_STATE_IDLE || queue->count == 0) {
+        return;
+    }
+
+    const IICXferTypeDef* xfer = &queue->xfer[queue->head];
+    uint32_t timeoutUs         = xfer->timeoutUs ? xfer->timeoutUs : iicXferTimeoutUs(iicObj, xfer);
+
+    queue->state         = IIC_STATE_START;
+    queue->index         = 0;
+    queue->startCycle    = IIC_DWT_CYCCNT;
+    queue->timeoutCycles = IIC_US_TO_CYCLES(timeoutUs);
+
+    // 上一次传输的STOP可能尚未发出, 此时设置START会被忽略
+    uint32_t stopWait = IIC_US_TO_CYCLES(IIC_STOP_WAIT_US);
+    while ((iicObj->i2c->CR1 & I2C_CR1_STOP) && IIC_DWT_CYCCNT - queue->startCycle < stopWait)
+        ;
+
+    I2C_AcknowledgeConfig(iicObj->i2c, ENABLE);
+    I2C_ITConfig(iicObj->i2c, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+    I2C_GenerateSTART(iicObj->i2c, ENABLE);
+}
+
+
+/**
+ * @brief 写入的数据已全部移出
+ *
+ * @param iicObj
+ * @param xfer 进行中的传输
+ * @note 先写后读时重复START进入接收, 否则STOP并结束传输
+ */
+static void iicQueueAfterWrite(IICObjTypeDef* iicObj, const IICXferTypeDef* xfer) {
+    if (xfer->type == IIC_XFER_WRITE_READ) {
+        iicObj->queue->state = IIC_STATE_RESTART;
+        I2C_GenerateSTART(iicObj->i2c, ENABLE);
+    } else {
+        I2C_GenerateSTOP(iicObj->i2c, ENABLE);
+        iicQueueFinish(iicObj, IIC_SUCCESS);
+    }
+}
+
+
+/**
+ * @brief 结束队首的异步传输
+ *
+ * @param iicObj
+ * @param status 传输结果, 传给回调
+ * @note 先出队再调用回调, 回调中可以加入新的传输; 之后开始队列中的下一个传输
+ */
+static void iicQueueFinish(IICObjTypeDef* iicObj, IICErrCode status) {
+    IICQueueTypeDef* queue   = iicObj->queue;
+    IICXferCallback callback = queue->xfer[queue->head].callback;
+    void* arg                = queue->xfer[queue->head].arg;
+
+    I2C_ITConfig(iicObj->i2c, I2C_IT_BUF, DISABLE);
+    I2C_NACKPositionConfig(iicObj->i2c, I2C_NACKPosition_Current);
+    I2C_AcknowledgeConfig(iicObj->i2c, ENABLE);
+
+    queue->head  = (queue->head + 1) % IIC_QUEUE_SIZE;
+    queue->count = queue->count - 1;
+    queue->state = IIC_STATE_IDLE;
+
+    if (status == IIC_SUCCESS) {
+        queue->stat.completed++;
+    } else if (status == IIC_ERR_TIMEOUT) {
+        queue->stat.timeouts++;
+    } else {
+        queue->stat.failed++;
+    }
+
+    if (callback != NULL) {
+        callback(arg, status);
+    }
+
+    iicQueueStart(iicObj);
+}
+
+
+/**
+ * @brief 停止进行中的DMA搬运
+ *
+ * @param iicObj
+ */
+static void iicQueueStopDMA(IICObjTypeDef* iicObj) {
+    if (iicObj->dmaObj != NULL) {
+        DMA_Cmd(iicObj->dmaObj->channel, DISABLE);
+        I2C_DMACmd(iicObj->i2c, DISABLE);
+    }
+}
+
+
+/**
+ * @brief 估算异步传输的超时时间
+ *
+ * @param iicObj
+ * @param xfer
+ * @return uint32_t 每字节按9位计算传输时间, 取两倍再加IIC_XFER_TIMEOUT_BASE_US(us)
+ */
+static uint32_t iicXferTimeoutUs(const IICObjTypeDef* iicObj, const IICXferTypeDef* xfer) {
+    uint32_t bytes = xfer->txLen + xfer->rxLen + 2; // 加上写, 读各一次地址
+    return bytes * 18000 / (iicObj->speed / 1000 + 1) + IIC_XFER_TIMEOUT_BASE_US;
+}
+
+
+/**
+ * @brief 阻塞等待硬件IIC事件
+ *
+ * @param iicObj
+ * @param event I2C_EVENT_xxx
+ * @return IICErrCode 超过timeoutUs仍未发生时返回IIC_ERR_TIMEOUT
+ */
+static IICErrCode iicWaitEvent(IICObjTypeDef* iicObj, uint32_t event) {
+    uint32_t start   = IIC_DWT_CYCCNT;
+    uint32_t timeout = IIC_US_TO_CYCLES(iicObj->timeoutUs);
+
+    while (!I2C_CheckEvent(iicObj->i2c, event)) {
+        if (IIC_DWT_CYCCNT - start > timeout) {
+            return IIC_ERR_TIMEOUT;
+        }
+    }
+
+    return IIC_SUCCESS;
+}
+
+
+/**
+ * @brief 阻塞等待硬件IIC标志变为指定状态
+ *
+ * @param iicObj
+ * @param flag I2C_FLAG_xxx
+ * @param state 等待的状态
+ * @return IICErrCode 超过timeoutUs仍未变为state时返回IIC_ERR_TIMEOUT
+ */
+static IICErrCode iicWaitFlag(IICObjTypeDef* iicObj, uint32_t flag, FlagStatus state) {
+    uint32_t start   = IIC_DWT_CYCCNT;
+    uint32_t timeout = IIC_US_TO_CYCLES(iicObj->timeoutUs);
+
+    while (I2C_GetFlagStatus(iicObj->i2c, flag) != state) {
+        if (IIC_DWT_CYCCNT - start > timeout) {
+            return IIC_ERR_TIMEOUT;
+        }
+    }
 
     return IIC_SUCCESS;
 }
+
+
+/**
+ * @brief 以周期计数器延时
+ *
+ * @param cycles 内核时钟周期数
+ * @note 不占用SysTick, 可在中断中调用
+ */
+static void iicDelayCycles(uint32_t cycles) {
+    uint32_t start = IIC_DWT_CYCCNT;
+    while (IIC_DWT_CYCCNT - start < cycles)
+        ;
+}
+
+
+/**
+ * @brief 使能DWT周期计数器, 用于超时计时
+ */
+static void iicCycleCounterInit(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    IIC_DWT_CTRL |= IIC_DWT_CYCCNTENA;
+}
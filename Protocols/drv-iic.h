@@ -54,6 +54,67 @@ typedef enum {
     IIC_SOFTWARE,   // 软件IIC
 } IICImplTypeEnum;
 
+/* 硬件IIC快速模式下SCL低/高电平时间比 */
+typedef enum {
+    IIC_DUTY_2,    // 2:1, SCL周期为3个CCR, 36MHz的PCLK1下可精确得到400kHz和1MHz
+    IIC_DUTY_16_9, // 16:9, SCL周期为25个CCR, PCLK1为10MHz的整数倍时可精确得到400kHz
+} IICDutyEnum;
+
+/* 异步传输类型 */
+typedef enum {
+    IIC_XFER_WRITE,      // 写, 由事件中断逐字节发送
+    IIC_XFER_WRITE_READ, // 先写后读, 写完后重复START读取
+    IIC_XFER_DMA_WRITE,  // DMA批量写, 适合整页图形数据
+} IICXferTypeEnum;
+
+typedef void (*IICXferCallback)(void* arg, IICErrCode status); // 传输结束回调, 在中断或iicQueuePoll中调用
+
+/* 异步传输 */
+typedef struct {
+    IICXferTypeEnum type;     // 传输类型
+    uint8_t slaveAddr;        // 从设备地址, 最低位为0
+    const uint8_t* txData;    // 写入的数据, 传输结束前须保持不变
+    uint16_t txLen;           // 写入的字节数, 可为0(只检查从设备应答)
+    uint8_t* rxData;          // 读取数据的存放地址
+    uint16_t rxLen;           // 读取的字节数, 仅IIC_XFER_WRITE_READ使用
+    uint32_t timeoutUs;       // 从开始传输起的超时时间, 0表示按字节数和速率估算
+    IICXferCallback callback; // 传输结束回调, 可为NULL
+    void* arg;                // 回调参数
+} IICXferTypeDef;
+
+/* 异步传输所处阶段 */
+typedef enum {
+    IIC_STATE_IDLE,    // 没有进行中的传输
+    IIC_STATE_START,   // 等待START发送完成
+    IIC_STATE_TX,      // 逐字节发送, 或DMA搬运结束后等待最后一个字节移出
+    IIC_STATE_DMA,     // DMA搬运中
+    IIC_STATE_RESTART, // 等待重复START发送完成
+    IIC_STATE_RX,      // 接收
+} IICStateEnum;
+
+typedef struct {
+    uint32_t completed;  // 成功完成的传输数
+    uint32_t failed;     // 因NACK或总线错误失败的传输数
+    uint32_t timeouts;   // 超时的传输数
+    uint32_t recoveries; // 总线恢复次数
+} IICQueueStatTypeDef;   // 异步传输统计
+
+#ifndef IIC_QUEUE_SIZE
+#define IIC_QUEUE_SIZE 8 // 异步传输队列容量
+#endif /* IIC_QUEUE_SIZE */
+
+/* 异步传输队列 */
+typedef struct {
+    IICXferTypeDef xfer[IIC_QUEUE_SIZE]; // 环形队列, head处为进行中的传输
+    volatile uint8_t head;               // 队首
+    volatile uint8_t count;              // 队列中的传输数, 包含进行中的传输
+    volatile IICStateEnum state;         // 进行中的传输所处阶段
+    uint16_t index;                      // 当前阶段已收发的字节数
+    uint32_t startCycle;                 // 进行中的传输开始时的周期计数
+    uint32_t timeoutCycles;              // 进行中的传输的超时周期数
+    IICQueueStatTypeDef stat;            // 传输统计
+} IICQueueTypeDef;
+
 /* IIC类 */
 typedef struct {
     IICImplTypeEnum type; // IIC实现类型
@@ -74,11 +135,13 @@ typedef struct {
     uint16_t txLen;        // 发送长度
     uint16_t timeoutUs;    // 超时时间
 
-    uint32_t speed; // 传输速度(bps)
+    uint32_t speed;   // 传输速度(bps), 硬件IIC为按CCR计算的实际速率
+    IICDutyEnum duty; // 硬件IIC快速模式下的占空比
 
     uint8_t slaveAddr; // 从设备地址
 
-    DMAObjTypeDef* dmaObj; // DMA对象指针，若使用DMA传输则不为NULL
+    DMAObjTypeDef* dmaObj;  // DMA对象指针，若使用DMA传输则不为NULL
+    IICQueueTypeDef* queue; // 异步传输队列指针, 若使用异步传输则不为NULL
 
 } IICObjTypeDef;
 
@@ -90,6 +153,18 @@ typedef struct {
     IICErrCode (*transmit)(IICObjTypeDef* iicObj);
     IICErrCode (*equippedWithDMA)(IICObjTypeDef*);
     IICErrCode (*transmitWithDMA)(IICObjTypeDef* iicObj);
+    IICErrCode (*transmitBlockWithDMA)(IICObjTypeDef* iicObj, const uint8_t* data,
+                                       uint16_t len); // 以DMA直接发送指定地址的数据, 不经过发送缓冲区
+    IICErrCode (*finishWithDMA)(IICObjTypeDef* iicObj);
+    IICErrCode (*setClock)(IICObjTypeDef* iicObj, uint32_t speed, IICDutyEnum duty,
+                           uint8_t overclock); // 按PCLK1重新配置硬件IIC的速率, overclock非0时允许超过400kHz
+    IICErrCode (*equippedWithQueue)(IICObjTypeDef* iicObj);                     // 配置异步传输队列和事件/错误中断
+    IICErrCode (*submit)(IICObjTypeDef* iicObj, const IICXferTypeDef* xfer);    // 加入异步传输, 总线空闲时立即开始
+    void (*eventISR)(IICObjTypeDef* iicObj);                                     // 在I2Cx_EV_IRQHandler中调用
+    void (*errorISR)(IICObjTypeDef* iicObj);                                     // 在I2Cx_ER_IRQHandler中调用
+    void (*dmaComplete)(IICObjTypeDef* iicObj);                                  // 在DMA传输完成中断中调用
+    void (*poll)(IICObjTypeDef* iicObj);                                         // 检查进行中的传输是否超时
+    IICErrCode (*recover)(IICObjTypeDef* iicObj);                                // 以9个SCL脉冲释放总线并复位外设
 } IICIntfTypeDef;
 
 
@@ -97,6 +172,10 @@ typedef struct {
 
 /*-------- define ----------------------------------------------------------------------------------------------------*/
 
+#define IIC_STANDARD_MODE_MAX_SPEED 100000  // 标准模式最高速率, 超过后使用快速模式
+#define IIC_FAST_MODE_MAX_SPEED     400000  // 快速模式最高速率, 超过须显式允许超频
+#define IIC_OVERCLOCK_MAX_SPEED     1000000 // 允许超频时的最高速率(快速模式+)
+
 
 
 
@@ -0,0 +1,133 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : decimate-service.c
+ * @brief          : 采样抽取服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 列边界以(c + 1) * count / ENVELOPE_COLUMNS递推求出, 列数为2的幂时除法即移位;
+ * 值到行的映射使用16位小数的定点比例, 每次映射只做一次除法
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "decimate-service.h"
+#include <string.h>
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define DECIMATE_SCALE_SHIFT 24 // 值到行映射比例的小数位数, 行差不超过255时乘积不溢出32位, 满量程65535时误差小于0.004行
+
+
+
+
+/* ------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- function prototypes ---------------------------------------------------------------------------------------*/
+
+static void decimateMinMax(const uint16_t* samples, uint8_t stride, uint16_t count, EnvelopeTypeDef* envelope);
+static void decimateToRows(const EnvelopeTypeDef* envelope, uint16_t fullScale, uint8_t top, uint8_t bottom,
+                           uint8_t* rowTop, uint8_t* rowBottom);
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+DecimateServIntfTypeDef decimateServIntf = {
+    .minMax = decimateMinMax,
+    .toRows = decimateToRows,
+};
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 将采样块抽取为每列的最小/最大值包络
+ *
+ * @param samples 第一个采样点
+ * @param stride 相邻采样点间隔的元素数, 多通道交错存放时为通道数
+ * @param count 采样点数量, 可以多于或少于列数
+ * @param envelope 输出的包络
+ * @note 1. 第c列包含下标为[c * count / ENVELOPE_COLUMNS, (c + 1) * count / ENVELOPE_COLUMNS)的采样点,
+ *          每个采样点只读取一次
+ *       2. 每列的范围并入上一列的最后一个采样点, 相邻列的竖线首尾相接, 陡峭的边沿不会断开
+ *       3. 采样点少于列数时, 没有分到采样点的列保持上一个采样点
+ */
+static void decimateMinMax(const uint16_t* samples, uint8_t stride, uint16_t count, EnvelopeTypeDef* envelope) {
+    if (count == 0) {
+        memset(envelope, 0, sizeof(EnvelopeTypeDef));
+        return;
+    }
+
+    const uint16_t* p = samples;
+    uint16_t last     = *p;    // 上一列的最后一个采样点
+    uint16_t index    = 0;     // 下一个未读取的采样点
+    uint32_t bound    = count; // (c + 1) * count
+
+    for (uint8_t c = 0; c < ENVELOPE_COLUMNS; c++, bound += count) {
+        uint16_t end = bound / ENVELOPE_COLUMNS;
+        uint16_t lo  = last;
+        uint16_t hi  = last;
+
+        for (; index < end; index++, p += stride) {
+            uint16_t value = *p;
+            if (value < lo) {
+                lo = value;
+            }
+            if (value > hi) {
+                hi = value;
+            }
+            last = value;
+        }
+
+        envelope->min[c] = lo;
+        envelope->max[c] = hi;
+    }
+}
+
+/**
+ * @brief 将包络映射为各列的起止行
+ *
+ * @param envelope 包络
+ * @param fullScale 映射到top行的值, 大于它的值按它处理
+ * @param top 最大值对应的行
+ * @param bottom 值0对应的行, 须不小于top
+ * @param rowTop 输出各列最大值所在的行
+ * @param rowBottom 输出各列最小值所在的行
+ */
+static void decimateToRows(const EnvelopeTypeDef* envelope, uint16_t fullScale, uint8_t top, uint8_t bottom,
+                           uint8_t* rowTop, uint8_t* rowBottom) {
+    uint32_t scale = fullScale ? ((uint32_t)(bottom - top) << DECIMATE_SCALE_SHIFT) / fullScale : 0;
+    uint32_t round = 1UL << (DECIMATE_SCALE_SHIFT - 1);
+
+    for (uint8_t c = 0; c < ENVELOPE_COLUMNS; c++) {
+        uint16_t hi = envelope->max[c] < fullScale ? envelope->max[c] : fullScale;
+        uint16_t lo = envelope->min[c] < fullScale ? envelope->min[c] : fullScale;
+
+        rowTop[c]    = bottom - (uint8_t)((hi * scale + round) >> DECIMATE_SCALE_SHIFT);
+        rowBottom[c] = bottom - (uint8_t)((lo * scale + round) >> DECIMATE_SCALE_SHIFT);
+    }
+}
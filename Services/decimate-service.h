@@ -0,0 +1,80 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : decimate-service.h
+ * @brief          : 采样抽取服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 峰值检测抽取: 一次遍历将任意长度的采样块归约为每列的最小/最大值包络, 高频信号显示为填充带而不是混叠波形.
+ * 全部为定点运算, 在UI循环中按采样块调用, 不在中断中执行
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __DECIMATE_SERVICE_H__
+#define __DECIMATE_SERVICE_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include <stdint.h>
+
+
+
+
+/*-------- define ----------------------------------------------------------------------------------------------------*/
+
+#define ENVELOPE_COLUMNS WIDTH // 包络列数
+
+
+
+
+/*-------- typedef ---------------------------------------------------------------------------------------------------*/
+
+// 每列的最小/最大值包络, 单位与采样值相同
+typedef struct {
+    uint16_t min[ENVELOPE_COLUMNS]; // 各列最小值
+    uint16_t max[ENVELOPE_COLUMNS]; // 各列最大值
+} EnvelopeTypeDef;
+
+/* 采样抽取服务对外接口 */
+typedef struct {
+    void (*minMax)(const uint16_t* samples, uint8_t stride, uint16_t count,
+                   EnvelopeTypeDef* envelope); // 将采样块抽取为每列的最小/最大值包络
+    void (*toRows)(const EnvelopeTypeDef* envelope, uint16_t fullScale, uint8_t top, uint8_t bottom, uint8_t* rowTop,
+                   uint8_t* rowBottom); // 将包络映射为各列的起止行
+} DecimateServIntfTypeDef;
+
+
+
+
+/*-------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+extern DecimateServIntfTypeDef decimateServIntf;
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+
+
+
+
+#endif /* __DECIMATE_SERVICE_H__ */
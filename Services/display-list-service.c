@@ -0,0 +1,385 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : display-list-service.c
+ * @brief          : 显示列表服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 添加命令时求出其可能修改的区域, 渲染时跳过与画布或裁剪矩形不相交的命令; 绘制由绘图服务和图像服务完成
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "display-list-service.h"
+#include <stddef.h>
+#include <string.h>
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- function prototypes ---------------------------------------------------------------------------------------*/
+
+static void clear(DisplayListTypeDef* list);
+static void addImage(DisplayListTypeDef* list, const ImageAssetTypeDef* asset, uint8_t x, uint8_t page,
+                     RectParamTypeDef area);
+static void addText(DisplayListTypeDef* list, const FontFaceTypeDef* font, const char* str, uint8_t startX,
+                    uint8_t startY, uint8_t endX, uint8_t endY);
+static void addRoundRect(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                         uint8_t radius);
+static void addFillRoundRect(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                             uint8_t radius, RasterOpEnum rop);
+static void addLine(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY);
+static void addPolyline(DisplayListTypeDef* list, const PointTypeDef* points, uint16_t count);
+static void addClip(DisplayListTypeDef* list, RectParamTypeDef clip);
+static void addCallback(DisplayListTypeDef* list, DisplayDrawFunc draw, void* arg, RectParamTypeDef bounds);
+static void render(const DisplayListTypeDef* list, const CanvasTypeDef* canvas);
+static DisplayCmdTypeDef* appendCmd(DisplayListTypeDef* list, DisplayCmdEnum type, RectParamTypeDef bounds);
+static inline uint8_t clipBounds(const RectParamTypeDef* clip, RectParamTypeDef* bounds);
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+DisplayListServIntfTypeDef displayListServIntf = {
+    .clear            = clear,
+    .addImage         = addImage,
+    .addText          = addText,
+    .addRoundRect     = addRoundRect,
+    .addFillRoundRect = addFillRoundRect,
+    .addLine          = addLine,
+    .addPolyline      = addPolyline,
+    .addClip          = addClip,
+    .addCallback      = addCallback,
+    .render           = render,
+};
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 清空显示列表
+ *
+ * @param list
+ */
+static void clear(DisplayListTypeDef* list) {
+    list->count   = 0;
+    list->dropped = 0;
+}
+
+/**
+ * @brief 添加压缩图像
+ *
+ * @param list
+ * @param asset 图像资源
+ * @param x 图像左上角所在列
+ * @param page 图像第一页所在页
+ * @param area 允许写入的区域(包含边界), 参见imageServIntf.decode
+ */
+static void addImage(DisplayListTypeDef* list, const ImageAssetTypeDef* asset, uint8_t x, uint8_t page,
+                     RectParamTypeDef area) {
+    uint16_t right          = x + asset->width - 1;
+    uint16_t bottom         = ((page + BITMAP_PAGES(asset->height)) << 3) - 1;
+    RectParamTypeDef bounds = {x, page << 3, right < 0xFF ? right : 0xFF, bottom < 0xFF ? bottom : 0xFF};
+    DisplayCmdTypeDef* pCmd = NULL;
+
+    clipBounds(&area, &bounds);
+
+    pCmd = appendCmd(list, DISPLAY_CMD_IMAGE, bounds);
+    if (pCmd != NULL) {
+        pCmd->param.image.asset = asset;
+        pCmd->param.image.x     = x;
+        pCmd->param.image.page  = page;
+        pCmd->param.image.area  = area;
+    }
+}
+
+/**
+ * @brief 添加字符串
+ *
+ * @param list
+ * @param font 字体
+ * @param str 字符串, 渲染完成前须保持有效
+ * @param startX 参见graphServIntf.printStringOnBuffer
+ * @param startY 打印范围的底部
+ * @param endX
+ * @param endY 打印范围的顶部
+ * @note 字形可能超出打印范围的左右边界, 区域取整个屏幕宽度; 纵向按最大的垂直居中偏移估计字形单元的顶部
+ */
+static void addText(DisplayListTypeDef* list, const FontFaceTypeDef* font, const char* str, uint8_t startX,
+                    uint8_t startY, uint8_t endX, uint8_t endY) {
+    int16_t top             = startY - font->height - (startY > endY ? (startY - endY) / 2 : 0);
+    RectParamTypeDef bounds = {0, top > 0 ? top : 0, WIDTH - 1, startY - 1};
+    DisplayCmdTypeDef* pCmd = NULL;
+
+    if (startY == 0) {
+        bounds.y0 = 1; // 字形单元在第0行之上, 不可见
+        bounds.y1 = 0;
+    }
+
+    pCmd = appendCmd(list, DISPLAY_CMD_TEXT, bounds);
+    if (pCmd != NULL) {
+        pCmd->param.text.font   = font;
+        pCmd->param.text.str    = str;
+        pCmd->param.text.layout = (RectParamTypeDef){startX, startY, endX, endY};
+    }
+}
+
+/**
+ * @brief 添加圆角矩形边框
+ *
+ * @param list
+ * @param startX 起始X坐标
+ * @param startY 起始Y坐标
+ * @param endX 结束X坐标
+ * @param endY 结束Y坐标
+ * @param radius 圆角半径
+ */
+static void addRoundRect(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                         uint8_t radius) {
+    RectParamTypeDef rect   = {startX, startY, endX, endY};
+    DisplayCmdTypeDef* pCmd = appendCmd(list, DISPLAY_CMD_ROUND_RECT, rect);
+
+    if (pCmd != NULL) {
+        pCmd->param.roundRect.rect   = rect;
+        pCmd->param.roundRect.radius = radius;
+    }
+}
+
+/**
+ * @brief 添加实心圆角矩形
+ *
+ * @param list
+ * @param startX 起始X坐标
+ * @param startY 起始Y坐标
+ * @param endX 结束X坐标
+ * @param endY 结束Y坐标
+ * @param radius 圆角半径
+ * @param rop 光栅操作, 参见graphServIntf.fillRoundRect
+ */
+static void addFillRoundRect(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                             uint8_t radius, RasterOpEnum rop) {
+    RectParamTypeDef rect   = {startX, startY, endX, endY};
+    DisplayCmdTypeDef* pCmd = appendCmd(list, DISPLAY_CMD_FILL_ROUND_RECT, rect);
+
+    if (pCmd != NULL) {
+        pCmd->param.roundRect.rect   = rect;
+        pCmd->param.roundRect.radius = radius;
+        pCmd->param.roundRect.rop    = rop;
+    }
+}
+
+/**
+ * @brief 添加线段
+ *
+ * @param list
+ * @param startX 起点X坐标
+ * @param startY 起点Y坐标
+ * @param endX 终点X坐标
+ * @param endY 终点Y坐标
+ */
+static void addLine(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY) {
+    RectParamTypeDef bounds = {
+        startX < endX ? startX : endX,
+        startY < endY ? startY : endY,
+        startX > endX ? startX : endX,
+        startY > endY ? startY : endY,
+    };
+    DisplayCmdTypeDef* pCmd = appendCmd(list, DISPLAY_CMD_LINE, bounds);
+
+    if (pCmd != NULL) {
+        pCmd->param.line.from = (PointTypeDef){startX, startY};
+        pCmd->param.line.to   = (PointTypeDef){endX, endY};
+    }
+}
+
+/**
+ * @brief 添加依次连接各点的折线
+ *
+ * @param list
+ * @param points 顶点, 渲染完成前须保持有效
+ * @param count 顶点数量
+ * @note 添加时求出顶点的包围盒, 逐页渲染时不与该页相交的折线整条跳过
+ */
+static void addPolyline(DisplayListTypeDef* list, const PointTypeDef* points, uint16_t count) {
+    RectParamTypeDef bounds = {0xFF, 0xFF, 0, 0};
+    DisplayCmdTypeDef* pCmd = NULL;
+
+    for (uint16_t i = 0; i < count; i++) {
+        bounds.x0 = points[i].x < bounds.x0 ? points[i].x : bounds.x0;
+        bounds.y0 = points[i].y < bounds.y0 ? points[i].y : bounds.y0;
+        bounds.x1 = points[i].x > bounds.x1 ? points[i].x : bounds.x1;
+        bounds.y1 = points[i].y > bounds.y1 ? points[i].y : bounds.y1;
+    }
+
+    pCmd = appendCmd(list, DISPLAY_CMD_POLYLINE, bounds);
+    if (pCmd != NULL) {
+        pCmd->param.polyline.points = points;
+        pCmd->param.polyline.count  = count;
+    }
+}
+
+/**
+ * @brief 设置之后命令的裁剪矩形
+ *
+ * @param list
+ * @param clip 裁剪矩形(包含边界), 参见graphServIntf.setClipRect
+ * @note 替换之前设置的裁剪矩形, 列表开始时不裁剪
+ */
+static void addClip(DisplayListTypeDef* list, RectParamTypeDef clip) {
+    DisplayCmdTypeDef* pCmd = appendCmd(list, DISPLAY_CMD_CLIP, clip);
+
+    if (pCmd != NULL) {
+        pCmd->param.clip = clip;
+    }
+}
+
+/**
+ * @brief 添加自定义绘制
+ *
+ * @param list
+ * @param draw 绘制函数, 只写入传入区域内的像素
+ * @param arg 绘制函数的参数
+ * @param bounds 绘制函数可能修改的区域(包含边界)
+ */
+static void addCallback(DisplayListTypeDef* list, DisplayDrawFunc draw, void* arg, RectParamTypeDef bounds) {
+    DisplayCmdTypeDef* pCmd = appendCmd(list, DISPLAY_CMD_CALLBACK, bounds);
+
+    if (pCmd != NULL) {
+        pCmd->param.callback.draw = draw;
+        pCmd->param.callback.arg  = arg;
+    }
+}
+
+/**
+ * @brief 将显示列表渲染到画布
+ *
+ * @param list
+ * @param canvas 目标画布, 可以是整幅画布或覆盖屏幕一页的页带画布
+ * @note 1. 先清空画布, 列表描述整个画面, 未被命令覆盖的像素为0
+ *       2. 依次执行与画布及当前裁剪矩形相交的命令, 图像和自定义绘制只写入相交的区域
+ *       3. 列表中的裁剪命令通过graphServIntf.setClipRect生效, 渲染前后裁剪矩形恢复为整个画布
+ */
+static void render(const DisplayListTypeDef* list, const CanvasTypeDef* canvas) {
+    RectParamTypeDef area = CANVAS_AREA(canvas);
+    RectParamTypeDef clip = area; // 当前裁剪矩形与画布的交集
+
+    for (uint8_t page = canvas->firstPage; page < canvas->firstPage + BITMAP_PAGES(canvas->height); page++) {
+        memset(CANVAS_PAGE(canvas, page), 0, canvas->width);
+    }
+    graphServIntf.markDirty(canvas, area);
+    graphServIntf.resetClipRect();
+
+    for (uint8_t i = 0; i < list->count; i++) {
+        const DisplayCmdTypeDef* pCmd = &list->cmd[i];
+        RectParamTypeDef bounds       = pCmd->bounds;
+
+        if (pCmd->type == DISPLAY_CMD_CLIP) {
+            clip = area;
+            clipBounds(&pCmd->param.clip, &clip);
+            graphServIntf.setClipRect(pCmd->param.clip);
+            continue;
+        }
+
+        if (!clipBounds(&clip, &bounds)) {
+            continue; // 与画布或裁剪矩形不相交
+        }
+
+        switch (pCmd->type) {
+            case DISPLAY_CMD_IMAGE:
+                imageServIntf.decode(canvas, pCmd->param.image.asset, pCmd->param.image.x, pCmd->param.image.page,
+                                     bounds);
+                break;
+            case DISPLAY_CMD_TEXT:
+                graphServIntf.printStringOnBuffer(canvas, pCmd->param.text.font, pCmd->param.text.str,
+                                                  pCmd->param.text.layout.x0, pCmd->param.text.layout.y0,
+                                                  pCmd->param.text.layout.x1, pCmd->param.text.layout.y1);
+                break;
+            case DISPLAY_CMD_ROUND_RECT:
+                graphServIntf.drawRoundRect2DotMatrix(canvas, pCmd->param.roundRect.rect.x0,
+                                                      pCmd->param.roundRect.rect.y0, pCmd->param.roundRect.rect.x1,
+                                                      pCmd->param.roundRect.rect.y1, pCmd->param.roundRect.radius, 0);
+                break;
+            case DISPLAY_CMD_FILL_ROUND_RECT:
+                graphServIntf.fillRoundRect(canvas, pCmd->param.roundRect.rect.x0, pCmd->param.roundRect.rect.y0,
+                                            pCmd->param.roundRect.rect.x1, pCmd->param.roundRect.rect.y1,
+                                            pCmd->param.roundRect.radius, pCmd->param.roundRect.rop);
+                break;
+            case DISPLAY_CMD_LINE:
+                graphServIntf.drawLine(canvas, pCmd->param.line.from.x, pCmd->param.line.from.y,
+                                       pCmd->param.line.to.x, pCmd->param.line.to.y);
+                break;
+            case DISPLAY_CMD_POLYLINE:
+                graphServIntf.drawPolyline(canvas, pCmd->param.polyline.points, pCmd->param.polyline.count);
+                break;
+            case DISPLAY_CMD_CALLBACK: pCmd->param.callback.draw(pCmd->param.callback.arg, canvas, bounds); break;
+            default: break;
+        }
+    }
+
+    graphServIntf.resetClipRect();
+}
+
+/**
+ * @brief 在列表末尾追加一条命令
+ *
+ * @param list
+ * @param type 命令类型
+ * @param bounds 命令可能修改的区域
+ * @return DisplayCmdTypeDef* 新命令, 列表已满时返回NULL并计入dropped
+ */
+static DisplayCmdTypeDef* appendCmd(DisplayListTypeDef* list, DisplayCmdEnum type, RectParamTypeDef bounds) {
+    if (list->count >= DISPLAY_LIST_MAX) {
+        list->dropped++;
+        return NULL;
+    }
+
+    DisplayCmdTypeDef* pCmd = &list->cmd[list->count++];
+    pCmd->type              = type;
+    pCmd->bounds            = bounds;
+
+    return pCmd;
+}
+
+/**
+ * @brief 将区域与裁剪矩形求交集
+ *
+ * @param clip 裁剪矩形
+ * @param bounds 区域(包含边界), 返回时被截取
+ * @return uint8_t 交集非空时返回1
+ */
+static inline uint8_t clipBounds(const RectParamTypeDef* clip, RectParamTypeDef* bounds) {
+    bounds->x0 = bounds->x0 > clip->x0 ? bounds->x0 : clip->x0;
+    bounds->y0 = bounds->y0 > clip->y0 ? bounds->y0 : clip->y0;
+    bounds->x1 = bounds->x1 < clip->x1 ? bounds->x1 : clip->x1;
+    bounds->y1 = bounds->y1 < clip->y1 ? bounds->y1 : clip->y1;
+
+    return bounds->x0 <= bounds->x1 && bounds->y0 <= bounds->y1;
+}
@@ -0,0 +1,145 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : display-list-service.h
+ * @brief          : 显示列表服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 以绘图命令列表描述整个画面, 可渲染到任意画布; 渲染到覆盖屏幕一页的页带画布时只执行与该页相交的命令,
+ * 逐页渲染即得到与整帧渲染相同的画面
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __DISPLAY_LIST_SERVICE_H__
+#define __DISPLAY_LIST_SERVICE_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include "image-service.h"
+#include <stdint.h>
+
+
+
+
+/*-------- define ----------------------------------------------------------------------------------------------------*/
+
+#ifndef DISPLAY_LIST_MAX
+#define DISPLAY_LIST_MAX 16 // 显示列表的最大命令数
+#endif /* DISPLAY_LIST_MAX */
+
+
+
+
+/*-------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef void (*DisplayDrawFunc)(void* arg, const CanvasTypeDef* canvas,
+                                RectParamTypeDef area); // 自定义绘制函数, 只写入area内的像素
+
+typedef enum {
+    DISPLAY_CMD_IMAGE,           // 解码压缩图像
+    DISPLAY_CMD_TEXT,            // 打印字符串
+    DISPLAY_CMD_ROUND_RECT,      // 圆角矩形边框
+    DISPLAY_CMD_FILL_ROUND_RECT, // 以光栅操作填充实心圆角矩形
+    DISPLAY_CMD_LINE,            // 线段
+    DISPLAY_CMD_POLYLINE,        // 依次连接各点的折线
+    DISPLAY_CMD_CLIP,            // 设置之后命令的裁剪矩形
+    DISPLAY_CMD_CALLBACK,        // 调用自定义绘制函数
+} DisplayCmdEnum;                // 显示命令类型枚举
+
+// 显示命令, 引用的图像, 字体, 字符串和点数组在渲染完成前须保持有效
+typedef struct {
+    DisplayCmdEnum type;     // 命令类型
+    RectParamTypeDef bounds; // 命令可能修改的区域(包含边界), 与画布不相交时跳过
+    union {
+        struct {
+            const ImageAssetTypeDef* asset; // 图像资源
+            uint8_t x;                      // 图像左上角所在列
+            uint8_t page;                   // 图像第一页所在页
+            RectParamTypeDef area;          // 允许写入的区域
+        } image;
+        struct {
+            const FontFaceTypeDef* font; // 字体
+            const char* str;             // 字符串
+            RectParamTypeDef layout;     // 依次为printStringOnBuffer的startX, startY, endX, endY
+        } text;
+        struct {
+            RectParamTypeDef rect; // 矩形(包含边界)
+            uint8_t radius;        // 圆角半径
+            RasterOpEnum rop;      // 填充时的光栅操作
+        } roundRect;
+        struct {
+            PointTypeDef from; // 起点
+            PointTypeDef to;   // 终点
+        } line;
+        struct {
+            const PointTypeDef* points; // 顶点
+            uint16_t count;             // 顶点数量
+        } polyline;
+        RectParamTypeDef clip; // 裁剪矩形
+        struct {
+            DisplayDrawFunc draw; // 绘制函数
+            void* arg;            // 绘制函数的参数
+        } callback;
+    } param;
+} DisplayCmdTypeDef;
+
+typedef struct {
+    DisplayCmdTypeDef cmd[DISPLAY_LIST_MAX]; // 按绘制顺序排列的命令
+    uint8_t count;                           // 命令数量
+    uint8_t dropped;                         // 因列表已满而丢弃的命令数量
+} DisplayListTypeDef;
+
+/* 显示列表服务对外接口 */
+typedef struct {
+    void (*clear)(DisplayListTypeDef* list); // 清空显示列表
+    void (*addImage)(DisplayListTypeDef* list, const ImageAssetTypeDef* asset, uint8_t x, uint8_t page,
+                     RectParamTypeDef area); // 添加图像
+    void (*addText)(DisplayListTypeDef* list, const FontFaceTypeDef* font, const char* str, uint8_t startX,
+                    uint8_t startY, uint8_t endX, uint8_t endY); // 添加字符串
+    void (*addRoundRect)(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                         uint8_t radius); // 添加圆角矩形边框
+    void (*addFillRoundRect)(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                             uint8_t radius, RasterOpEnum rop); // 添加实心圆角矩形
+    void (*addLine)(DisplayListTypeDef* list, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY); // 添加线段
+    void (*addPolyline)(DisplayListTypeDef* list, const PointTypeDef* points, uint16_t count); // 添加折线
+    void (*addClip)(DisplayListTypeDef* list, RectParamTypeDef clip); // 设置之后命令的裁剪矩形
+    void (*addCallback)(DisplayListTypeDef* list, DisplayDrawFunc draw, void* arg,
+                        RectParamTypeDef bounds); // 添加自定义绘制
+    void (*render)(const DisplayListTypeDef* list, const CanvasTypeDef* canvas); // 将显示列表渲染到画布
+} DisplayListServIntfTypeDef;
+
+
+
+
+/*-------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+extern DisplayListServIntfTypeDef displayListServIntf;
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+
+
+
+
+#endif /* __DISPLAY_LIST_SERVICE_H__ */
@@ -0,0 +1,201 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : font-ui16.c
+ * @brief          : fontUI16字体数据
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 由Tools/bdf2font.py从Tools/fonts/ui-16.bdf生成, 请勿手动修改
+ * 字形单元16行, 18个字形, 位图190字节, 预移位位图2280字节
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include <stddef.h>
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static const uint8_t fontUI16Bitmap[190] = {
+    0x00, 0x05, 0x80, 0x0F, 0x00, 0x02, 0x00, 0x05, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x7C, 0x00, 0xC2, 0x00, 0x81, 0x80,
+    0x80, 0x80, 0x40, 0x80, 0x20, 0x00, 0x1F, 0x00, 0x80, 0x00, 0x81, 0x00, 0xF9, 0x80, 0x87, 0x00, 0x80, 0x00, 0xC1,
+    0x80, 0xA0, 0x80, 0x90, 0x80, 0x8C, 0x00, 0x83, 0x00, 0x80, 0x00, 0x80, 0x80, 0x88, 0x80, 0x88, 0x80, 0xCC, 0x00,
+    0x73, 0x00, 0x18, 0x00, 0x14, 0x80, 0x13, 0x80, 0xD0, 0x00, 0x3C, 0x00, 0x17, 0x00, 0x10, 0x00, 0x80, 0x00, 0x87,
+    0x80, 0x84, 0x80, 0x4C, 0x80, 0x28, 0x80, 0x00, 0x00, 0x7C, 0x00, 0xCB, 0x80, 0x85, 0x80, 0x84, 0x80, 0x44, 0x80,
+    0x38, 0x80, 0xC0, 0x80, 0x30, 0x80, 0x0C, 0x80, 0x02, 0x80, 0x01, 0x80, 0x00, 0x00, 0x70, 0x00, 0xCB, 0x80, 0x84,
+    0x80, 0x88, 0x80, 0x9C, 0x00, 0x73, 0x00, 0x8E, 0x00, 0x91, 0x80, 0x90, 0x80, 0xD0, 0x80, 0x69, 0x00, 0x1F, 0x00,
+    0xC0, 0x00, 0x3C, 0x80, 0x27, 0x00, 0x10, 0x00, 0x10, 0x00, 0xF0, 0x00, 0x1C, 0x80, 0x03, 0x80, 0x7F, 0x00, 0x80,
+    0x00, 0x40, 0x00, 0x20, 0x00, 0x18, 0x00, 0x07, 0x80, 0x01, 0x00, 0xE0, 0x00, 0x3C, 0x80, 0x13, 0x00, 0xE8, 0x00,
+    0x04, 0x00, 0xC0, 0x00, 0xB8, 0x00, 0xA8, 0x00, 0x98, 0x00, 0x48, 0x00, 0x07, 0x80, 0x05, 0x80, 0x04, 0x80, 0x03};
+
+static const uint8_t fontUI16Shifted[2280] = {
+    0x00, 0x05, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x14, 0x00, 0x00, 0x28, 0x00, 0x00, 0x50, 0x00, 0x00, 0xA0, 0x00, 0x00,
+    0x40, 0x01, 0x00, 0x80, 0x02, 0x80, 0x0F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x7C, 0x00, 0x00, 0xF8,
+    0x00, 0x00, 0xF0, 0x01, 0x00, 0xE0, 0x03, 0x00, 0xC0, 0x07, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00,
+    0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x05, 0x00, 0x00,
+    0x0A, 0x00, 0x00, 0x14, 0x00, 0x00, 0x28, 0x00, 0x00, 0x50, 0x00, 0x00, 0xA0, 0x00, 0x00, 0x40, 0x01, 0x00, 0x80,
+    0x02, 0x00, 0xC0, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x06, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x18,
+    0x00, 0x00, 0x30, 0x00, 0x00, 0x60, 0x00, 0xC0, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x06, 0x00,
+    0x00, 0x0C, 0x00, 0x00, 0x18, 0x00, 0x00, 0x30, 0x00, 0x00, 0x60, 0x00, 0x7C, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF0,
+    0x01, 0x00, 0xE0, 0x03, 0x00, 0xC0, 0x07, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x3E, 0x00, 0xC2, 0x00,
+    0x00, 0x84, 0x01, 0x00, 0x08, 0x03, 0x00, 0x10, 0x06, 0x00, 0x20, 0x0C, 0x00, 0x40, 0x18, 0x00, 0x80, 0x30, 0x00,
+    0x00, 0x61, 0x00, 0x81, 0x00, 0x00, 0x02, 0x01, 0x00, 0x04, 0x02, 0x00, 0x08, 0x04, 0x00, 0x10, 0x08, 0x00, 0x20,
+    0x10, 0x00, 0x40, 0x20, 0x00, 0x80, 0x40, 0x80, 0x80, 0x00, 0x00, 0x01, 0x01, 0x00, 0x02, 0x02, 0x00, 0x04, 0x04,
+    0x00, 0x08, 0x08, 0x00, 0x10, 0x10, 0x00, 0x20, 0x20, 0x00, 0x40, 0x40, 0x80, 0x40, 0x00, 0x00, 0x81, 0x00, 0x00,
+    0x02, 0x01, 0x00, 0x04, 0x02, 0x00, 0x08, 0x04, 0x00, 0x10, 0x08, 0x00, 0x20, 0x10, 0x00, 0x40, 0x20, 0x80, 0x20,
+    0x00, 0x00, 0x41, 0x00, 0x00, 0x82, 0x00, 0x00, 0x04, 0x01, 0x00, 0x08, 0x02, 0x00, 0x10, 0x04, 0x00, 0x20, 0x08,
+    0x00, 0x40, 0x10, 0x00, 0x1F, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x7C, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF0, 0x01, 0x00,
+    0xE0, 0x03, 0x00, 0xC0, 0x07, 0x00, 0x80, 0x0F, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0x81, 0x00, 0x00, 0x02, 0x01,
+    0x00, 0x04, 0x02, 0x00, 0x08, 0x04, 0x00, 0x10, 0x08, 0x00, 0x20, 0x10, 0x00, 0x40, 0x20, 0x00, 0x80, 0x40, 0x00,
+    0xF9, 0x00, 0x00, 0xF2, 0x01, 0x00, 0xE4, 0x03, 0x00, 0xC8, 0x07, 0x00, 0x90, 0x0F, 0x00, 0x20, 0x1F, 0x00, 0x40,
+    0x3E, 0x00, 0x80, 0x7C, 0x80, 0x87, 0x00, 0x00, 0x0F, 0x01, 0x00, 0x1E, 0x02, 0x00, 0x3C, 0x04, 0x00, 0x78, 0x08,
+    0x00, 0xF0, 0x10, 0x00, 0xE0, 0x21, 0x00, 0xC0, 0x43, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0xC1, 0x00, 0x00, 0x82,
+    0x01, 0x00, 0x04, 0x03, 0x00, 0x08, 0x06, 0x00, 0x10, 0x0C, 0x00, 0x20, 0x18, 0x00, 0x40, 0x30, 0x00, 0x80, 0x60,
+    0x80, 0xA0, 0x00, 0x00, 0x41, 0x01, 0x00, 0x82, 0x02, 0x00, 0x04, 0x05, 0x00, 0x08, 0x0A, 0x00, 0x10, 0x14, 0x00,
+    0x20, 0x28, 0x00, 0x40, 0x50, 0x80, 0x90, 0x00, 0x00, 0x21, 0x01, 0x00, 0x42, 0x02, 0x00, 0x84, 0x04, 0x00, 0x08,
+    0x09, 0x00, 0x10, 0x12, 0x00, 0x20, 0x24, 0x00, 0x40, 0x48, 0x80, 0x8C, 0x00, 0x00, 0x19, 0x01, 0x00, 0x32, 0x02,
+    0x00, 0x64, 0x04, 0x00, 0xC8, 0x08, 0x00, 0x90, 0x11, 0x00, 0x20, 0x23, 0x00, 0x40, 0x46, 0x00, 0x83, 0x00, 0x00,
+    0x06, 0x01, 0x00, 0x0C, 0x02, 0x00, 0x18, 0x04, 0x00, 0x30, 0x08, 0x00, 0x60, 0x10, 0x00, 0xC0, 0x20, 0x00, 0x80,
+    0x41, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10,
+    0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00,
+    0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x80, 0x88, 0x00, 0x00, 0x11, 0x01, 0x00, 0x22,
+    0x02, 0x00, 0x44, 0x04, 0x00, 0x88, 0x08, 0x00, 0x10, 0x11, 0x00, 0x20, 0x22, 0x00, 0x40, 0x44, 0x80, 0x88, 0x00,
+    0x00, 0x11, 0x01, 0x00, 0x22, 0x02, 0x00, 0x44, 0x04, 0x00, 0x88, 0x08, 0x00, 0x10, 0x11, 0x00, 0x20, 0x22, 0x00,
+    0x40, 0x44, 0x80, 0xCC, 0x00, 0x00, 0x99, 0x01, 0x00, 0x32, 0x03, 0x00, 0x64, 0x06, 0x00, 0xC8, 0x0C, 0x00, 0x90,
+    0x19, 0x00, 0x20, 0x33, 0x00, 0x40, 0x66, 0x00, 0x73, 0x00, 0x00, 0xE6, 0x00, 0x00, 0xCC, 0x01, 0x00, 0x98, 0x03,
+    0x00, 0x30, 0x07, 0x00, 0x60, 0x0E, 0x00, 0xC0, 0x1C, 0x00, 0x80, 0x39, 0x00, 0x18, 0x00, 0x00, 0x30, 0x00, 0x00,
+    0x60, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x06, 0x00, 0x00, 0x0C, 0x00, 0x14,
+    0x00, 0x00, 0x28, 0x00, 0x00, 0x50, 0x00, 0x00, 0xA0, 0x00, 0x00, 0x40, 0x01, 0x00, 0x80, 0x02, 0x00, 0x00, 0x05,
+    0x00, 0x00, 0x0A, 0x80, 0x13, 0x00, 0x00, 0x27, 0x00, 0x00, 0x4E, 0x00, 0x00, 0x9C, 0x00, 0x00, 0x38, 0x01, 0x00,
+    0x70, 0x02, 0x00, 0xE0, 0x04, 0x00, 0xC0, 0x09, 0x80, 0xD0, 0x00, 0x00, 0xA1, 0x01, 0x00, 0x42, 0x03, 0x00, 0x84,
+    0x06, 0x00, 0x08, 0x0D, 0x00, 0x10, 0x1A, 0x00, 0x20, 0x34, 0x00, 0x40, 0x68, 0x00, 0x3C, 0x00, 0x00, 0x78, 0x00,
+    0x00, 0xF0, 0x00, 0x00, 0xE0, 0x01, 0x00, 0xC0, 0x03, 0x00, 0x80, 0x07, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x1E, 0x00,
+    0x17, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x5C, 0x00, 0x00, 0xB8, 0x00, 0x00, 0x70, 0x01, 0x00, 0xE0, 0x02, 0x00, 0xC0,
+    0x05, 0x00, 0x80, 0x0B, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0x87, 0x00, 0x00, 0x0E,
+    0x01, 0x00, 0x1C, 0x02, 0x00, 0x38, 0x04, 0x00, 0x70, 0x08, 0x00, 0xE0, 0x10, 0x00, 0xC0, 0x21, 0x00, 0x80, 0x43,
+    0x80, 0x84, 0x00, 0x00, 0x09, 0x01, 0x00, 0x12, 0x02, 0x00, 0x24, 0x04, 0x00, 0x48, 0x08, 0x00, 0x90, 0x10, 0x00,
+    0x20, 0x21, 0x00, 0x40, 0x42, 0x80, 0x4C, 0x00, 0x00, 0x99, 0x00, 0x00, 0x32, 0x01, 0x00, 0x64, 0x02, 0x00, 0xC8,
+    0x04, 0x00, 0x90, 0x09, 0x00, 0x20, 0x13, 0x00, 0x40, 0x26, 0x80, 0x28, 0x00, 0x00, 0x51, 0x00, 0x00, 0xA2, 0x00,
+    0x00, 0x44, 0x01, 0x00, 0x88, 0x02, 0x00, 0x10, 0x05, 0x00, 0x20, 0x0A, 0x00, 0x40, 0x14, 0x80, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40,
+    0x00, 0x00, 0x7C, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF0, 0x01, 0x00, 0xE0, 0x03, 0x00, 0xC0, 0x07, 0x00, 0x80, 0x0F,
+    0x00, 0x00, 0x1F, 0x00, 0x00, 0x3E, 0x00, 0xCB, 0x00, 0x00, 0x96, 0x01, 0x00, 0x2C, 0x03, 0x00, 0x58, 0x06, 0x00,
+    0xB0, 0x0C, 0x00, 0x60, 0x19, 0x00, 0xC0, 0x32, 0x00, 0x80, 0x65, 0x80, 0x85, 0x00, 0x00, 0x0B, 0x01, 0x00, 0x16,
+    0x02, 0x00, 0x2C, 0x04, 0x00, 0x58, 0x08, 0x00, 0xB0, 0x10, 0x00, 0x60, 0x21, 0x00, 0xC0, 0x42, 0x80, 0x84, 0x00,
+    0x00, 0x09, 0x01, 0x00, 0x12, 0x02, 0x00, 0x24, 0x04, 0x00, 0x48, 0x08, 0x00, 0x90, 0x10, 0x00, 0x20, 0x21, 0x00,
+    0x40, 0x42, 0x80, 0x44, 0x00, 0x00, 0x89, 0x00, 0x00, 0x12, 0x01, 0x00, 0x24, 0x02, 0x00, 0x48, 0x04, 0x00, 0x90,
+    0x08, 0x00, 0x20, 0x11, 0x00, 0x40, 0x22, 0x80, 0x38, 0x00, 0x00, 0x71, 0x00, 0x00, 0xE2, 0x00, 0x00, 0xC4, 0x01,
+    0x00, 0x88, 0x03, 0x00, 0x10, 0x07, 0x00, 0x20, 0x0E, 0x00, 0x40, 0x1C, 0x80, 0xC0, 0x00, 0x00, 0x81, 0x01, 0x00,
+    0x02, 0x03, 0x00, 0x04, 0x06, 0x00, 0x08, 0x0C, 0x00, 0x10, 0x18, 0x00, 0x20, 0x30, 0x00, 0x40, 0x60, 0x80, 0x30,
+    0x00, 0x00, 0x61, 0x00, 0x00, 0xC2, 0x00, 0x00, 0x84, 0x01, 0x00, 0x08, 0x03, 0x00, 0x10, 0x06, 0x00, 0x20, 0x0C,
+    0x00, 0x40, 0x18, 0x80, 0x0C, 0x00, 0x00, 0x19, 0x00, 0x00, 0x32, 0x00, 0x00, 0x64, 0x00, 0x00, 0xC8, 0x00, 0x00,
+    0x90, 0x01, 0x00, 0x20, 0x03, 0x00, 0x40, 0x06, 0x80, 0x02, 0x00, 0x00, 0x05, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x14,
+    0x00, 0x00, 0x28, 0x00, 0x00, 0x50, 0x00, 0x00, 0xA0, 0x00, 0x00, 0x40, 0x01, 0x80, 0x01, 0x00, 0x00, 0x03, 0x00,
+    0x00, 0x06, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x18, 0x00, 0x00, 0x30, 0x00, 0x00, 0x60, 0x00, 0x00, 0xC0, 0x00, 0x80,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x00, 0x20,
+    0x00, 0x00, 0x40, 0x00, 0x00, 0x70, 0x00, 0x00, 0xE0, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x80, 0x03, 0x00, 0x00, 0x07,
+    0x00, 0x00, 0x0E, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x38, 0x00, 0xCB, 0x00, 0x00, 0x96, 0x01, 0x00, 0x2C, 0x03, 0x00,
+    0x58, 0x06, 0x00, 0xB0, 0x0C, 0x00, 0x60, 0x19, 0x00, 0xC0, 0x32, 0x00, 0x80, 0x65, 0x80, 0x84, 0x00, 0x00, 0x09,
+    0x01, 0x00, 0x12, 0x02, 0x00, 0x24, 0x04, 0x00, 0x48, 0x08, 0x00, 0x90, 0x10, 0x00, 0x20, 0x21, 0x00, 0x40, 0x42,
+    0x80, 0x88, 0x00, 0x00, 0x11, 0x01, 0x00, 0x22, 0x02, 0x00, 0x44, 0x04, 0x00, 0x88, 0x08, 0x00, 0x10, 0x11, 0x00,
+    0x20, 0x22, 0x00, 0x40, 0x44, 0x80, 0x9C, 0x00, 0x00, 0x39, 0x01, 0x00, 0x72, 0x02, 0x00, 0xE4, 0x04, 0x00, 0xC8,
+    0x09, 0x00, 0x90, 0x13, 0x00, 0x20, 0x27, 0x00, 0x40, 0x4E, 0x00, 0x73, 0x00, 0x00, 0xE6, 0x00, 0x00, 0xCC, 0x01,
+    0x00, 0x98, 0x03, 0x00, 0x30, 0x07, 0x00, 0x60, 0x0E, 0x00, 0xC0, 0x1C, 0x00, 0x80, 0x39, 0x00, 0x8E, 0x00, 0x00,
+    0x1C, 0x01, 0x00, 0x38, 0x02, 0x00, 0x70, 0x04, 0x00, 0xE0, 0x08, 0x00, 0xC0, 0x11, 0x00, 0x80, 0x23, 0x00, 0x00,
+    0x47, 0x00, 0x91, 0x00, 0x00, 0x22, 0x01, 0x00, 0x44, 0x02, 0x00, 0x88, 0x04, 0x00, 0x10, 0x09, 0x00, 0x20, 0x12,
+    0x00, 0x40, 0x24, 0x00, 0x80, 0x48, 0x80, 0x90, 0x00, 0x00, 0x21, 0x01, 0x00, 0x42, 0x02, 0x00, 0x84, 0x04, 0x00,
+    0x08, 0x09, 0x00, 0x10, 0x12, 0x00, 0x20, 0x24, 0x00, 0x40, 0x48, 0x80, 0xD0, 0x00, 0x00, 0xA1, 0x01, 0x00, 0x42,
+    0x03, 0x00, 0x84, 0x06, 0x00, 0x08, 0x0D, 0x00, 0x10, 0x1A, 0x00, 0x20, 0x34, 0x00, 0x40, 0x68, 0x80, 0x69, 0x00,
+    0x00, 0xD3, 0x00, 0x00, 0xA6, 0x01, 0x00, 0x4C, 0x03, 0x00, 0x98, 0x06, 0x00, 0x30, 0x0D, 0x00, 0x60, 0x1A, 0x00,
+    0xC0, 0x34, 0x00, 0x1F, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x7C, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF0, 0x01, 0x00, 0xE0,
+    0x03, 0x00, 0xC0, 0x07, 0x00, 0x80, 0x0F, 0x00, 0xC0, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x06,
+    0x00, 0x00, 0x0C, 0x00, 0x00, 0x18, 0x00, 0x00, 0x30, 0x00, 0x00, 0x60, 0x00, 0x3C, 0x00, 0x00, 0x78, 0x00, 0x00,
+    0xF0, 0x00, 0x00, 0xE0, 0x01, 0x00, 0xC0, 0x03, 0x00, 0x80, 0x07, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x1E, 0x80, 0x27,
+    0x00, 0x00, 0x4F, 0x00, 0x00, 0x9E, 0x00, 0x00, 0x3C, 0x01, 0x00, 0x78, 0x02, 0x00, 0xF0, 0x04, 0x00, 0xE0, 0x09,
+    0x00, 0xC0, 0x13, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0x00, 0x80,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0xF0, 0x00, 0x00, 0xE0, 0x01,
+    0x00, 0xC0, 0x03, 0x00, 0x80, 0x07, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x3C, 0x00, 0x00, 0x78, 0x00,
+    0x1C, 0x00, 0x00, 0x38, 0x00, 0x00, 0x70, 0x00, 0x00, 0xE0, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x80, 0x03, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x0E, 0x80, 0x03, 0x00, 0x00, 0x07, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x38, 0x00,
+    0x00, 0x70, 0x00, 0x00, 0xE0, 0x00, 0x00, 0xC0, 0x01, 0x80, 0x7F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFE, 0x01, 0x00,
+    0xFC, 0x03, 0x00, 0xF8, 0x07, 0x00, 0xF0, 0x0F, 0x00, 0xE0, 0x1F, 0x00, 0xC0, 0x3F, 0x00, 0x80, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x00, 0x40,
+    0x00, 0x40, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00,
+    0x00, 0x10, 0x00, 0x00, 0x20, 0x00, 0x20, 0x00, 0x00, 0x40, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x18, 0x00, 0x00, 0x30, 0x00, 0x00, 0x60, 0x00,
+    0x00, 0xC0, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x06, 0x00, 0x00, 0x0C, 0x00, 0x07, 0x00, 0x00,
+    0x0E, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x38, 0x00, 0x00, 0x70, 0x00, 0x00, 0xE0, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x80,
+    0x03, 0x80, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x06, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x18, 0x00, 0x00, 0x30, 0x00,
+    0x00, 0x60, 0x00, 0x00, 0xC0, 0x00, 0x00, 0xE0, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x80, 0x03, 0x00, 0x00, 0x07, 0x00,
+    0x00, 0x0E, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x38, 0x00, 0x00, 0x70, 0x00, 0x3C, 0x00, 0x00, 0x78, 0x00, 0x00, 0xF0,
+    0x00, 0x00, 0xE0, 0x01, 0x00, 0xC0, 0x03, 0x00, 0x80, 0x07, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x1E, 0x80, 0x13, 0x00,
+    0x00, 0x27, 0x00, 0x00, 0x4E, 0x00, 0x00, 0x9C, 0x00, 0x00, 0x38, 0x01, 0x00, 0x70, 0x02, 0x00, 0xE0, 0x04, 0x00,
+    0xC0, 0x09, 0x00, 0xE8, 0x00, 0x00, 0xD0, 0x01, 0x00, 0xA0, 0x03, 0x00, 0x40, 0x07, 0x00, 0x80, 0x0E, 0x00, 0x00,
+    0x1D, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x74, 0x00, 0x04, 0x00, 0x00, 0x08, 0x00, 0x00, 0x10, 0x00, 0x00, 0x20, 0x00,
+    0x00, 0x40, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x00, 0xC0, 0x00, 0x00, 0x80, 0x01, 0x00,
+    0x00, 0x03, 0x00, 0x00, 0x06, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x18, 0x00, 0x00, 0x30, 0x00, 0x00, 0x60, 0x00, 0xB8,
+    0x00, 0x00, 0x70, 0x01, 0x00, 0xE0, 0x02, 0x00, 0xC0, 0x05, 0x00, 0x80, 0x0B, 0x00, 0x00, 0x17, 0x00, 0x00, 0x2E,
+    0x00, 0x00, 0x5C, 0x00, 0xA8, 0x00, 0x00, 0x50, 0x01, 0x00, 0xA0, 0x02, 0x00, 0x40, 0x05, 0x00, 0x80, 0x0A, 0x00,
+    0x00, 0x15, 0x00, 0x00, 0x2A, 0x00, 0x00, 0x54, 0x00, 0x98, 0x00, 0x00, 0x30, 0x01, 0x00, 0x60, 0x02, 0x00, 0xC0,
+    0x04, 0x00, 0x80, 0x09, 0x00, 0x00, 0x13, 0x00, 0x00, 0x26, 0x00, 0x00, 0x4C, 0x00, 0x48, 0x00, 0x00, 0x90, 0x00,
+    0x00, 0x20, 0x01, 0x00, 0x40, 0x02, 0x00, 0x80, 0x04, 0x00, 0x00, 0x09, 0x00, 0x00, 0x12, 0x00, 0x00, 0x24, 0x00,
+    0x07, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x38, 0x00, 0x00, 0x70, 0x00, 0x00, 0xE0, 0x00, 0x00, 0xC0,
+    0x01, 0x00, 0x80, 0x03, 0x80, 0x05, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x16, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x58, 0x00,
+    0x00, 0xB0, 0x00, 0x00, 0x60, 0x01, 0x00, 0xC0, 0x02, 0x80, 0x04, 0x00, 0x00, 0x09, 0x00, 0x00, 0x12, 0x00, 0x00,
+    0x24, 0x00, 0x00, 0x48, 0x00, 0x00, 0x90, 0x00, 0x00, 0x20, 0x01, 0x00, 0x40, 0x02, 0x80, 0x03, 0x00, 0x00, 0x07,
+    0x00, 0x00, 0x0E, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x38, 0x00, 0x00, 0x70, 0x00, 0x00, 0xE0, 0x00, 0x00, 0xC0, 0x01};
+
+static const uint8_t fontUI16Index[145] = {
+    0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 1, 255, 255, 255, 2, 255, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 13, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 14, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 15, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 16, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 17};
+
+static const FontGlyphTypeDef fontUI16Glyph[18] = {
+    {0, 0, 0, 4, 0},   // 空格
+    {0, 4, 9, 5, 0},   // *
+    {4, 2, 2, 4, 0},   // .
+    {6, 7, 9, 6, 0},   // 0
+    {13, 5, 9, 6, 0},  // 1
+    {18, 5, 9, 6, 0},  // 2
+    {23, 6, 9, 6, 0},  // 3
+    {29, 7, 9, 6, 0},  // 4
+    {36, 6, 9, 7, 0},  // 5
+    {42, 6, 9, 6, 0},  // 6
+    {48, 6, 9, 6, 0},  // 7
+    {54, 6, 9, 6, 0},  // 8
+    {60, 6, 9, 6, 0},  // 9
+    {66, 8, 16, 7, 0}, // H
+    {74, 7, 9, 8, 0},  // V
+    {81, 5, 9, 5, 0},  // k
+    {86, 5, 5, 5, 0},  // z
+    {91, 4, 9, 5, 0},  // 0xB0
+};
+
+const FontFaceTypeDef fontUI16 = {
+    .height    = 16,
+    .firstChar = 0x20,
+    .lastChar  = 0xB0,
+    .kernCount = 0,
+    .index     = fontUI16Index,
+    .glyph     = fontUI16Glyph,
+    .bitmap    = fontUI16Bitmap,
+    .shifted   = fontUI16Shifted,
+    .kern      = NULL,
+};
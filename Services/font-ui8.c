@@ -0,0 +1,161 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : font-ui8.c
+ * @brief          : fontUI8字体数据
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 由Tools/bdf2font.py从Tools/fonts/ui-8.bdf生成, 请勿手动修改
+ * 字形单元8行, 21个字形, 位图96字节, 预移位位图1536字节
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include <stddef.h>
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static const uint8_t fontUI8Bitmap[96] = {
+    0x14, 0x08, 0x3E, 0x08, 0x14, 0x08, 0x08, 0x08, 0x08, 0x08, 0x60, 0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00, 0x42, 0x7F,
+    0x40, 0x00, 0x42, 0x61, 0x51, 0x49, 0x46, 0x21, 0x41, 0x45, 0x4B, 0x31, 0x18, 0x14, 0x12, 0x7F, 0x10, 0x27, 0x45,
+    0x45, 0x45, 0x39, 0x3C, 0x4A, 0x49, 0x49, 0x30, 0x01, 0x71, 0x09, 0x05, 0x03, 0x36, 0x49, 0x49, 0x49, 0x36, 0x06,
+    0x49, 0x49, 0x29, 0x1E, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x1F, 0x20, 0x40, 0x20, 0x1F, 0x7F, 0x10, 0x28, 0x44, 0x00,
+    0x7C, 0x04, 0x18, 0x04, 0x78, 0x48, 0x54, 0x54, 0x54, 0x20, 0x44, 0x64, 0x54, 0x4C, 0x44, 0x06, 0x09, 0x09, 0x06,
+    0x00};
+
+static const uint8_t fontUI8Shifted[1536] = {
+    0x14, 0x00, 0x28, 0x00, 0x50, 0x00, 0xA0, 0x00, 0x40, 0x01, 0x80, 0x02, 0x00, 0x05, 0x00, 0x0A, 0x08, 0x00, 0x10,
+    0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x3E, 0x00, 0x7C, 0x00, 0xF8, 0x00,
+    0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F, 0x00, 0x1F, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80,
+    0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x14, 0x00, 0x28, 0x00, 0x50, 0x00, 0xA0, 0x00, 0x40, 0x01, 0x80, 0x02,
+    0x00, 0x05, 0x00, 0x0A, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x04, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x08, 0x00,
+    0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x08, 0x00, 0x10, 0x00, 0x20,
+    0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00,
+    0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x60, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x03, 0x00, 0x06, 0x00,
+    0x0C, 0x00, 0x18, 0x00, 0x30, 0x3E, 0x00, 0x7C, 0x00, 0xF8, 0x00, 0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F,
+    0x00, 0x1F, 0x51, 0x00, 0xA2, 0x00, 0x44, 0x01, 0x88, 0x02, 0x10, 0x05, 0x20, 0x0A, 0x40, 0x14, 0x80, 0x28, 0x49,
+    0x00, 0x92, 0x00, 0x24, 0x01, 0x48, 0x02, 0x90, 0x04, 0x20, 0x09, 0x40, 0x12, 0x80, 0x24, 0x45, 0x00, 0x8A, 0x00,
+    0x14, 0x01, 0x28, 0x02, 0x50, 0x04, 0xA0, 0x08, 0x40, 0x11, 0x80, 0x22, 0x3E, 0x00, 0x7C, 0x00, 0xF8, 0x00, 0xF0,
+    0x01, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x84, 0x00, 0x08, 0x01, 0x10, 0x02, 0x20, 0x04, 0x40, 0x08, 0x80,
+    0x10, 0x00, 0x21, 0x7F, 0x00, 0xFE, 0x00, 0xFC, 0x01, 0xF8, 0x03, 0xF0, 0x07, 0xE0, 0x0F, 0xC0, 0x1F, 0x80, 0x3F,
+    0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x00, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x84, 0x00, 0x08, 0x01,
+    0x10, 0x02, 0x20, 0x04, 0x40, 0x08, 0x80, 0x10, 0x00, 0x21, 0x61, 0x00, 0xC2, 0x00, 0x84, 0x01, 0x08, 0x03, 0x10,
+    0x06, 0x20, 0x0C, 0x40, 0x18, 0x80, 0x30, 0x51, 0x00, 0xA2, 0x00, 0x44, 0x01, 0x88, 0x02, 0x10, 0x05, 0x20, 0x0A,
+    0x40, 0x14, 0x80, 0x28, 0x49, 0x00, 0x92, 0x00, 0x24, 0x01, 0x48, 0x02, 0x90, 0x04, 0x20, 0x09, 0x40, 0x12, 0x80,
+    0x24, 0x46, 0x00, 0x8C, 0x00, 0x18, 0x01, 0x30, 0x02, 0x60, 0x04, 0xC0, 0x08, 0x80, 0x11, 0x00, 0x23, 0x21, 0x00,
+    0x42, 0x00, 0x84, 0x00, 0x08, 0x01, 0x10, 0x02, 0x20, 0x04, 0x40, 0x08, 0x80, 0x10, 0x41, 0x00, 0x82, 0x00, 0x04,
+    0x01, 0x08, 0x02, 0x10, 0x04, 0x20, 0x08, 0x40, 0x10, 0x80, 0x20, 0x45, 0x00, 0x8A, 0x00, 0x14, 0x01, 0x28, 0x02,
+    0x50, 0x04, 0xA0, 0x08, 0x40, 0x11, 0x80, 0x22, 0x4B, 0x00, 0x96, 0x00, 0x2C, 0x01, 0x58, 0x02, 0xB0, 0x04, 0x60,
+    0x09, 0xC0, 0x12, 0x80, 0x25, 0x31, 0x00, 0x62, 0x00, 0xC4, 0x00, 0x88, 0x01, 0x10, 0x03, 0x20, 0x06, 0x40, 0x0C,
+    0x80, 0x18, 0x18, 0x00, 0x30, 0x00, 0x60, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x03, 0x00, 0x06, 0x00, 0x0C, 0x14,
+    0x00, 0x28, 0x00, 0x50, 0x00, 0xA0, 0x00, 0x40, 0x01, 0x80, 0x02, 0x00, 0x05, 0x00, 0x0A, 0x12, 0x00, 0x24, 0x00,
+    0x48, 0x00, 0x90, 0x00, 0x20, 0x01, 0x40, 0x02, 0x80, 0x04, 0x00, 0x09, 0x7F, 0x00, 0xFE, 0x00, 0xFC, 0x01, 0xF8,
+    0x03, 0xF0, 0x07, 0xE0, 0x0F, 0xC0, 0x1F, 0x80, 0x3F, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01,
+    0x00, 0x02, 0x00, 0x04, 0x00, 0x08, 0x27, 0x00, 0x4E, 0x00, 0x9C, 0x00, 0x38, 0x01, 0x70, 0x02, 0xE0, 0x04, 0xC0,
+    0x09, 0x80, 0x13, 0x45, 0x00, 0x8A, 0x00, 0x14, 0x01, 0x28, 0x02, 0x50, 0x04, 0xA0, 0x08, 0x40, 0x11, 0x80, 0x22,
+    0x45, 0x00, 0x8A, 0x00, 0x14, 0x01, 0x28, 0x02, 0x50, 0x04, 0xA0, 0x08, 0x40, 0x11, 0x80, 0x22, 0x45, 0x00, 0x8A,
+    0x00, 0x14, 0x01, 0x28, 0x02, 0x50, 0x04, 0xA0, 0x08, 0x40, 0x11, 0x80, 0x22, 0x39, 0x00, 0x72, 0x00, 0xE4, 0x00,
+    0xC8, 0x01, 0x90, 0x03, 0x20, 0x07, 0x40, 0x0E, 0x80, 0x1C, 0x3C, 0x00, 0x78, 0x00, 0xF0, 0x00, 0xE0, 0x01, 0xC0,
+    0x03, 0x80, 0x07, 0x00, 0x0F, 0x00, 0x1E, 0x4A, 0x00, 0x94, 0x00, 0x28, 0x01, 0x50, 0x02, 0xA0, 0x04, 0x40, 0x09,
+    0x80, 0x12, 0x00, 0x25, 0x49, 0x00, 0x92, 0x00, 0x24, 0x01, 0x48, 0x02, 0x90, 0x04, 0x20, 0x09, 0x40, 0x12, 0x80,
+    0x24, 0x49, 0x00, 0x92, 0x00, 0x24, 0x01, 0x48, 0x02, 0x90, 0x04, 0x20, 0x09, 0x40, 0x12, 0x80, 0x24, 0x30, 0x00,
+    0x60, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x03, 0x00, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x01, 0x00, 0x02, 0x00, 0x04,
+    0x00, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x71, 0x00, 0xE2, 0x00, 0xC4, 0x01, 0x88, 0x03,
+    0x10, 0x07, 0x20, 0x0E, 0x40, 0x1C, 0x80, 0x38, 0x09, 0x00, 0x12, 0x00, 0x24, 0x00, 0x48, 0x00, 0x90, 0x00, 0x20,
+    0x01, 0x40, 0x02, 0x80, 0x04, 0x05, 0x00, 0x0A, 0x00, 0x14, 0x00, 0x28, 0x00, 0x50, 0x00, 0xA0, 0x00, 0x40, 0x01,
+    0x80, 0x02, 0x03, 0x00, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x30, 0x00, 0x60, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x36,
+    0x00, 0x6C, 0x00, 0xD8, 0x00, 0xB0, 0x01, 0x60, 0x03, 0xC0, 0x06, 0x80, 0x0D, 0x00, 0x1B, 0x49, 0x00, 0x92, 0x00,
+    0x24, 0x01, 0x48, 0x02, 0x90, 0x04, 0x20, 0x09, 0x40, 0x12, 0x80, 0x24, 0x49, 0x00, 0x92, 0x00, 0x24, 0x01, 0x48,
+    0x02, 0x90, 0x04, 0x20, 0x09, 0x40, 0x12, 0x80, 0x24, 0x49, 0x00, 0x92, 0x00, 0x24, 0x01, 0x48, 0x02, 0x90, 0x04,
+    0x20, 0x09, 0x40, 0x12, 0x80, 0x24, 0x36, 0x00, 0x6C, 0x00, 0xD8, 0x00, 0xB0, 0x01, 0x60, 0x03, 0xC0, 0x06, 0x80,
+    0x0D, 0x00, 0x1B, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x30, 0x00, 0x60, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x03,
+    0x49, 0x00, 0x92, 0x00, 0x24, 0x01, 0x48, 0x02, 0x90, 0x04, 0x20, 0x09, 0x40, 0x12, 0x80, 0x24, 0x49, 0x00, 0x92,
+    0x00, 0x24, 0x01, 0x48, 0x02, 0x90, 0x04, 0x20, 0x09, 0x40, 0x12, 0x80, 0x24, 0x29, 0x00, 0x52, 0x00, 0xA4, 0x00,
+    0x48, 0x01, 0x90, 0x02, 0x20, 0x05, 0x40, 0x0A, 0x80, 0x14, 0x1E, 0x00, 0x3C, 0x00, 0x78, 0x00, 0xF0, 0x00, 0xE0,
+    0x01, 0xC0, 0x03, 0x80, 0x07, 0x00, 0x0F, 0x7F, 0x00, 0xFE, 0x00, 0xFC, 0x01, 0xF8, 0x03, 0xF0, 0x07, 0xE0, 0x0F,
+    0xC0, 0x1F, 0x80, 0x3F, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x04, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x08, 0x00,
+    0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x7F, 0x00, 0xFE, 0x00, 0xFC,
+    0x01, 0xF8, 0x03, 0xF0, 0x07, 0xE0, 0x0F, 0xC0, 0x1F, 0x80, 0x3F, 0x1F, 0x00, 0x3E, 0x00, 0x7C, 0x00, 0xF8, 0x00,
+    0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x04, 0x00, 0x08, 0x00, 0x10, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x00, 0x08, 0x00, 0x10,
+    0x00, 0x20, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x00, 0x08, 0x00, 0x10, 0x1F,
+    0x00, 0x3E, 0x00, 0x7C, 0x00, 0xF8, 0x00, 0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F, 0x7F, 0x00, 0xFE, 0x00,
+    0xFC, 0x01, 0xF8, 0x03, 0xF0, 0x07, 0xE0, 0x0F, 0xC0, 0x1F, 0x80, 0x3F, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80,
+    0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x00, 0x08, 0x28, 0x00, 0x50, 0x00, 0xA0, 0x00, 0x40, 0x01, 0x80, 0x02,
+    0x00, 0x05, 0x00, 0x0A, 0x00, 0x14, 0x44, 0x00, 0x88, 0x00, 0x10, 0x01, 0x20, 0x02, 0x40, 0x04, 0x80, 0x08, 0x00,
+    0x11, 0x00, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x7C, 0x00, 0xF8, 0x00, 0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F, 0x00, 0x1F, 0x00, 0x3E, 0x04, 0x00, 0x08,
+    0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x18, 0x00, 0x30, 0x00, 0x60, 0x00,
+    0xC0, 0x00, 0x80, 0x01, 0x00, 0x03, 0x00, 0x06, 0x00, 0x0C, 0x04, 0x00, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40,
+    0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x78, 0x00, 0xF0, 0x00, 0xE0, 0x01, 0xC0, 0x03, 0x80, 0x07, 0x00, 0x0F,
+    0x00, 0x1E, 0x00, 0x3C, 0x48, 0x00, 0x90, 0x00, 0x20, 0x01, 0x40, 0x02, 0x80, 0x04, 0x00, 0x09, 0x00, 0x12, 0x00,
+    0x24, 0x54, 0x00, 0xA8, 0x00, 0x50, 0x01, 0xA0, 0x02, 0x40, 0x05, 0x80, 0x0A, 0x00, 0x15, 0x00, 0x2A, 0x54, 0x00,
+    0xA8, 0x00, 0x50, 0x01, 0xA0, 0x02, 0x40, 0x05, 0x80, 0x0A, 0x00, 0x15, 0x00, 0x2A, 0x54, 0x00, 0xA8, 0x00, 0x50,
+    0x01, 0xA0, 0x02, 0x40, 0x05, 0x80, 0x0A, 0x00, 0x15, 0x00, 0x2A, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0x01,
+    0x00, 0x02, 0x00, 0x04, 0x00, 0x08, 0x00, 0x10, 0x44, 0x00, 0x88, 0x00, 0x10, 0x01, 0x20, 0x02, 0x40, 0x04, 0x80,
+    0x08, 0x00, 0x11, 0x00, 0x22, 0x64, 0x00, 0xC8, 0x00, 0x90, 0x01, 0x20, 0x03, 0x40, 0x06, 0x80, 0x0C, 0x00, 0x19,
+    0x00, 0x32, 0x54, 0x00, 0xA8, 0x00, 0x50, 0x01, 0xA0, 0x02, 0x40, 0x05, 0x80, 0x0A, 0x00, 0x15, 0x00, 0x2A, 0x4C,
+    0x00, 0x98, 0x00, 0x30, 0x01, 0x60, 0x02, 0xC0, 0x04, 0x80, 0x09, 0x00, 0x13, 0x00, 0x26, 0x44, 0x00, 0x88, 0x00,
+    0x10, 0x01, 0x20, 0x02, 0x40, 0x04, 0x80, 0x08, 0x00, 0x11, 0x00, 0x22, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x30,
+    0x00, 0x60, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x03, 0x09, 0x00, 0x12, 0x00, 0x24, 0x00, 0x48, 0x00, 0x90, 0x00,
+    0x20, 0x01, 0x40, 0x02, 0x80, 0x04, 0x09, 0x00, 0x12, 0x00, 0x24, 0x00, 0x48, 0x00, 0x90, 0x00, 0x20, 0x01, 0x40,
+    0x02, 0x80, 0x04, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x30, 0x00, 0x60, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x03,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+static const uint8_t fontUI8Index[145] = {
+    0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 1, 255, 255, 2, 3, 255, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 14, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 15, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 16, 255, 17, 255, 255, 255, 255, 255, 18, 255, 255, 255, 255, 255, 255, 19, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    20};
+
+static const FontGlyphTypeDef fontUI8Glyph[21] = {
+    {0, 0, 0, 3, 0},  // 空格
+    {0, 5, 7, 6, 0},  // *
+    {5, 5, 5, 6, 0},  // -
+    {10, 1, 3, 2, 0}, // .
+    {11, 5, 8, 6, 0}, // 0
+    {16, 5, 8, 6, 0}, // 1
+    {21, 5, 8, 6, 0}, // 2
+    {26, 5, 8, 6, 0}, // 3
+    {31, 5, 8, 6, 0}, // 4
+    {36, 5, 8, 6, 0}, // 5
+    {41, 5, 8, 6, 0}, // 6
+    {46, 5, 8, 6, 0}, // 7
+    {51, 5, 8, 6, 0}, // 8
+    {56, 5, 8, 6, 0}, // 9
+    {61, 5, 8, 6, 0}, // H
+    {66, 5, 8, 6, 0}, // V
+    {71, 5, 8, 6, 0}, // k
+    {76, 5, 6, 6, 0}, // m
+    {81, 5, 6, 6, 0}, // s
+    {86, 5, 6, 6, 0}, // z
+    {91, 5, 8, 6, 0}, // 0xB0
+};
+
+const FontFaceTypeDef fontUI8 = {
+    .height    = 8,
+    .firstChar = 0x20,
+    .lastChar  = 0xB0,
+    .kernCount = 0,
+    .index     = fontUI8Index,
+    .glyph     = fontUI8Glyph,
+    .bitmap    = fontUI8Bitmap,
+    .shifted   = fontUI8Shifted,
+    .kern      = NULL,
+};
@@ -0,0 +1,164 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : format-service.c
+ * @brief          : 数值格式化服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 以定点整数为输入直接生成字符串, 不依赖C库的浮点printf, 输出与sprintf("%.Nf")/("%d")逐字节一致
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "format-service.h"
+#include <stddef.h>
+#include <string.h>
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- function prototypes ---------------------------------------------------------------------------------------*/
+
+static uint8_t formatFixed(char* buffer, int32_t value, uint8_t decimals, const char* suffix);
+static uint8_t formatInt(char* buffer, int32_t value, const char* suffix);
+static int32_t roundFixed(float value, uint8_t decimals);
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+FormatServIntfTypeDef formatServIntf = {
+    .formatFixed = formatFixed,
+    .formatInt   = formatInt,
+    .roundFixed  = roundFixed,
+};
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 将定点数格式化为字符串
+ *
+ * @param buffer 输出缓冲区, 调用者保证足够容纳数字、小数点、后缀和结束符
+ * @param value 定点数值, 实际值为 value / 10^decimals
+ * @param decimals 小数位数, 为0时不输出小数点
+ * @param suffix 单位后缀, 可为NULL
+ * @return uint8_t 写入的字符数, 不含结束符
+ */
+static uint8_t formatFixed(char* buffer, int32_t value, uint8_t decimals, const char* suffix) {
+    char digits[FORMAT_DIGITS_MAX];
+    uint8_t count = 0;
+    uint8_t len   = 0;
+    uint32_t mag  = (value < 0) ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+
+    // 从低位到高位取出数字, 至少保留整数位1位和全部小数位
+    do {
+        digits[count++] = (char)('0' + mag % 10);
+        mag /= 10;
+    } while ((mag != 0 || count <= decimals) && count < FORMAT_DIGITS_MAX);
+
+    if (value < 0) {
+        buffer[len++] = '-';
+    }
+
+    while (count > 0) {
+        if (count == decimals) {
+            buffer[len++] = '.';
+        }
+        buffer[len++] = digits[--count];
+    }
+
+    if (suffix != NULL) {
+        while (*suffix != '\0') {
+            buffer[len++] = *suffix++;
+        }
+    }
+
+    buffer[len] = '\0';
+
+    return len;
+}
+
+/**
+ * @brief 将整数格式化为字符串
+ *
+ * @param buffer 输出缓冲区
+ * @param value 整数值
+ * @param suffix 单位后缀, 可为NULL
+ * @return uint8_t 写入的字符数, 不含结束符
+ */
+static uint8_t formatInt(char* buffer, int32_t value, const char* suffix) { return formatFixed(buffer, value, 0, suffix); }
+
+/**
+ * @brief 将非负浮点数按"%.Nf"的规则舍入为定点数
+ *
+ * @param value 非负浮点数, value * 10^decimals 不超过INT32_MAX
+ * @param decimals 小数位数, 不超过FORMAT_DECIMALS_MAX
+ * @return int32_t 定点数值, 实际值为 返回值 / 10^decimals
+ * @note 浮点数为 尾数 * 2^指数, 尾数乘10^decimals后以整数右移得到结果, 按被截去部分与一半比较进位,
+ *       恰好为一半时舍入到偶数. 全程没有浮点运算和舍入误差, 与C库printf对二进制精确值的舍入一致;
+ *       (int32_t)(value * 10 + 0.5f)在乘法舍入和恰为一半时会多进一位
+ */
+static int32_t roundFixed(float value, uint8_t decimals) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    int16_t exponent  = (int16_t)((bits >> 23) & 0xFF);
+    uint64_t mantissa = bits & 0x7FFFFF;
+
+    if (exponent == 0) {
+        exponent = 1; // 非规格化数
+    } else {
+        mantissa |= 0x800000;
+    }
+
+    for (uint8_t i = 0; i < decimals && i < FORMAT_DECIMALS_MAX; i++) {
+        mantissa *= 10;
+    }
+
+    int16_t shift = 150 - exponent; // value = mantissa * 2^-shift
+    if (shift <= 0) {
+        return (int32_t)(mantissa << -shift);
+    }
+    if (shift >= 64) {
+        return 0; // 小于最小的一半单位
+    }
+
+    uint64_t quotient = mantissa >> shift;
+    uint64_t remain   = mantissa & (((uint64_t)1 << shift) - 1);
+    uint64_t half     = (uint64_t)1 << (shift - 1);
+
+    if (remain > half || (remain == half && (quotient & 1))) {
+        quotient++;
+    }
+
+    return (int32_t)quotient;
+}
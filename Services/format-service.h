@@ -0,0 +1,74 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : format-service.h
+ * @brief          : 数值格式化服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 以定点整数为输入的数值格式化, 用于替代UI循环中的sprintf
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __FORMAT_SERVICE_H__
+#define __FORMAT_SERVICE_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+
+
+
+/*-------- typedef ---------------------------------------------------------------------------------------------------*/
+
+/* 格式化服务对外接口 */
+typedef struct {
+    uint8_t (*formatFixed)(char* buffer, int32_t value, uint8_t decimals, const char* suffix);
+    uint8_t (*formatInt)(char* buffer, int32_t value, const char* suffix);
+    int32_t (*roundFixed)(float value, uint8_t decimals); // 按"%.Nf"的舍入规则将浮点数转换为定点数
+} FormatServIntfTypeDef;
+
+
+
+
+/*-------- define ----------------------------------------------------------------------------------------------------*/
+
+#define FORMAT_DIGITS_MAX   10 // int32_t的最大十进制位数
+#define FORMAT_DECIMALS_MAX 4  // roundFixed支持的最大小数位数, 尾数乘10^4后仍可放入64位整数
+
+
+
+
+/*-------- macro -----------------------------------------------------------------------------------------------------*/
+
+// 将非负浮点数转换为十分之一单位的定点数, 与"%.1f"的舍入结果一致
+#define FORMAT_TO_TENTHS(x) (formatServIntf.roundFixed((x), 1))
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+extern FormatServIntfTypeDef formatServIntf;
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+
+
+
+
+#endif /* __FORMAT_SERVICE_H__ */
@@ -18,7 +18,7 @@
 /* ------- includes --------------------------------------------------------------------------------------------------*/
 
 #include "graph-service.h"
-#include <math.h>
+#include "trig-service.h"
 #include <string.h>
 
 
@@ -27,140 +27,190 @@
 
 /* ------- typedef ---------------------------------------------------------------------------------------------------*/
 
+typedef struct {
+    const void* canvas;   // 画布首地址
+    DirtyMapTypeDef* map; // 绑定的脏页表
+} DirtyBindTypeDef;       // 画布与脏页表的绑定关系
 
+typedef struct {
+    uint8_t* dst[BITMAP_PAGES(FONT_MAX_HEIGHT) + 1]; // 字形单元顶部所在页及其下各页
+    uint8_t mask[BITMAP_PAGES(FONT_MAX_HEIGHT) + 1]; // 各页在裁剪矩形内的行掩码
+    uint8_t first;                                   // 第一个可见的页, 以单元顶部所在页为0
+    uint8_t last;                                    // 最后一个可见的页
+    uint8_t span;                                    // 预移位后每列覆盖的页数
+    uint8_t shift;                                   // 字形单元顶部的页内偏移, 选择预移位位图
+} GlyphRowTypeDef;                                   // 同一行字形共用的目标页和行掩码
 
 
 
-/* ------- define ----------------------------------------------------------------------------------------------------*/
 
-#define MAX_POINTS 1000
 
+/* ------- define ----------------------------------------------------------------------------------------------------*/
 
+#ifndef GRAPH_WORD_TRANSPOSE
+#define GRAPH_WORD_TRANSPOSE 1 // 1: bitToByte使用32位字并行的8x8位矩阵转置; 0: 使用逐像素的参考实现
+#endif /* GRAPH_WORD_TRANSPOSE */
 
+#define CORNER_TABLE_MAX_RADIUS 8 // 圆角缩进表覆盖的最大半径
 
-/* ------- macro -----------------------------------------------------------------------------------------------------*/
+#define GLYPH_RUN_MAX 32 // 单次打印的最大字形数(最窄字形下已超出屏幕)
 
+#define DIRTY_BIND_MAX 2 // 可绑定脏页表的画布数量(双缓冲)
 
+#define CLIP_RECT_NONE ((RectParamTypeDef){0, 0, 0xFF, 0xFF}) // 不裁剪, 绘制时截取为整个目标画布
 
 
 
-/* ------- function prototypes ---------------------------------------------------------------------------------------*/
 
-static void drawLine(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
-static void drawStarDot(uint8_t dotMatrix[HEIGHT][WIDTH], float centerX, float centerY, float radius);
-static void bitToByte(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t graphBuffer[PAGE][WIDTH]);
-static void drawRoundRect2DotMatrix(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t startX, uint8_t startY, uint8_t endX,
-                                    uint8_t endY, uint8_t radius, uint8_t);
-#if 0
-static void drawStar(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t graphBuffer[PAGE][WIDTH]);
-#endif
-static void InverBufferWithMask(uint8_t mask[HEIGHT][WIDTH], uint8_t buffer[PAGE][WIDTH]);
-static void printStringOnBuffer(uint8_t buffer[PAGE][WIDTH], const char* str, uint8_t startX, uint8_t startY,
-                                uint8_t endX, uint8_t endY);
-static void printCharOnBuffer(uint8_t x, uint8_t y, const uint8_t font[16], uint8_t buffer[8][128]);
-RectParamTypeDef animateMovingResizingRect(uint8_t sx0, uint8_t sy0, uint8_t sx1, uint8_t sy1, uint8_t ex0, uint8_t ey0,
-                                           uint8_t ex1, uint8_t ey1, float progress);
-static void insertNewPoint(uint8_t new_x, uint8_t new_y, uint8_t pixelDrawCount[HEIGHT][WIDTH]);
-static void blendImagesWithSineScroll(uint8_t imageA[PAGE][WIDTH], uint8_t imageB[PAGE][WIDTH], uint8_t shift,
-                                      uint8_t direction, uint8_t result[PAGE][WIDTH]);
+/* ------- macro -----------------------------------------------------------------------------------------------------*/
 
+// 按字节执行光栅操作
+#define RASTER_OP_BYTE(dst, src, rop)                                                                                  \
+    do {                                                                                                               \
+        switch (rop) {                                                                                                 \
+            case RASTER_OP_COPY: *(dst) = *(src); break;                                                               \
+            case RASTER_OP_OR: *(dst) |= *(src); break;                                                                \
+            case RASTER_OP_AND: *(dst) &= *(src); break;                                                               \
+            case RASTER_OP_XOR: *(dst) ^= *(src); break;                                                               \
+            default: break;                                                                                            \
+        }                                                                                                              \
+    } while (0)
 
+// 以按值传入的画布调用内联实现impl. 屏幕尺寸的连续画布改用常量尺寸和行距调用,
+// 内联后编译器生成128x64专用的版本, 页间步进为立即数; 其余画布使用运行时的尺寸和行距
+#define CANVAS_DISPATCH(canvas, impl, ...)                                                                             \
+    (CANVAS_IS_SCREEN(canvas) ? impl((CanvasTypeDef){(canvas)->data, WIDTH, HEIGHT, WIDTH, 0}, __VA_ARGS__)            \
+                              : impl(*(canvas), __VA_ARGS__))
+
+// 以32位字为单位执行光栅操作, OP为复合赋值运算符
+#define RASTER_OP_WORDS(dst, src, words, OP)                                                                           \
+    do {                                                                                                               \
+        for (uint8_t w = 0; w < (words); w++) {                                                                        \
+            uint32_t d, s;                                                                                             \
+            memcpy(&d, (dst) + w * 4, 4);                                                                              \
+            memcpy(&s, (src) + w * 4, 4);                                                                              \
+            d OP s;                                                                                                    \
+            memcpy((dst) + w * 4, &d, 4);                                                                              \
+        }                                                                                                              \
+    } while (0)
 
-/* ------- variables -------------------------------------------------------------------------------------------------*/
 
-#if 0
-const uint8_t font016x8[2][8] = { {0x7F, 0x80, 0x88, 0x80, 0x7F, 0x00, 0x00, 0x00},
-                                   {0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00} };
-const uint8_t font116x8[2][8]      = {{0x81, 0x81, 0xFF, 0x80, 0x80, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t font516x8[2][8] = { {0x67, 0x84, 0x84, 0x84, 0x78, 0x00, 0x00, 0x00},
-                                      {0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00} };
-const uint8_t font216x8[2][8]      = {{0x83, 0xC0, 0xA0, 0x90, 0x8F, 0x00, 0x00, 0x00},
-                                      {0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t font316x8[2][8]      = {{0x60, 0x80, 0x86, 0x85, 0x78, 0x00, 0x00, 0x00},
-                                      {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}};
-const uint8_t font416x8[2][8]      = {{0x30, 0x2C, 0x20, 0x03, 0x20, 0x00, 0x00, 0x00},
-                                      {0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00}};
-
-const uint8_t font616x8[2][8]      = {{0x78, 0x8C, 0x85, 0x88, 0x78, 0x00, 0x00, 0x00},
-                                      {0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t font716x8[2][8]      = {{0x00, 0x80, 0xE0, 0x1C, 0x03, 0x00, 0x00, 0x00},
-                                      {0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00}};
-const uint8_t font816x8[2][8]      = {{0x77, 0x88, 0x88, 0x88, 0x77, 0x00, 0x00, 0x00},
-                                      {0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t font916x8[2][8]      = {{0x0F, 0x10, 0xD0, 0x30, 0x1F, 0x00, 0x00, 0x00},
-                                      {0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
-#else
-const uint8_t font016x8[2][8] = {{0x7C, 0xC2, 0x81, 0x80, 0x40, 0x20, 0x1F, 0x00},
-                                 {0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00}};
-const uint8_t font116x8[2][8] = {{0x80, 0x81, 0xF9, 0x87, 0x80, 0x00, 0x00, 0x00},
-                                 {0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t font216x8[2][8] = {{0xC1, 0xA0, 0x90, 0x8C, 0x83, 0x00, 0x00, 0x00},
-                                 {0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t font316x8[2][8] = {{0x80, 0x80, 0x88, 0x88, 0xCC, 0x73, 0x00, 0x00},
-                                 {0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00}};
-const uint8_t font416x8[2][8] = {{0x18, 0x14, 0x13, 0xD0, 0x3C, 0x17, 0x10, 0x00},
-                                 {0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t font516x8[2][8] = {{0x80, 0x87, 0x84, 0x4C, 0x28, 0x00, 0x00, 0x00},
-                                 {0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00}};
-const uint8_t font616x8[2][8] = {{0x7C, 0xCB, 0x85, 0x84, 0x44, 0x38, 0x00, 0x00},
-                                 {0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00}};
-const uint8_t font716x8[2][8] = {{0xC0, 0x30, 0x0C, 0x02, 0x01, 0x00, 0x00, 0x00},
-                                 {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00}};
-const uint8_t font816x8[2][8] = {{0x70, 0xCB, 0x84, 0x88, 0x9C, 0x73, 0x00, 0x00},
-                                 {0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00}};
-const uint8_t font916x8[2][8] = {{0x8E, 0x91, 0x90, 0xD0, 0x69, 0x1F, 0x00, 0x00},
-                                 {0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00}};
 
 
-#endif
 
-const uint8_t fontDot16x8[2][8]    = {{0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-                                      {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}; // 小数点
+/* ------- function prototypes ---------------------------------------------------------------------------------------*/
 
-const uint8_t fontk16x8[2][8]      = {{0xE0, 0x3C, 0x13, 0xE8, 0x04, 0x00, 0x00, 0x00},
-                                      {0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t fontH16x8[2][8]      = {{0xC0, 0x3C, 0x27, 0x10, 0x10, 0xF0, 0x1C, 0x03},
-                                      {0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x80}};
-const uint8_t fontz16x8[2][8]      = {{0xC0, 0xB8, 0xA8, 0x98, 0x48, 0x00, 0x00, 0x00},
-                                      {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t fontV16x8[2][8]      = {{0x7F, 0x80, 0x40, 0x20, 0x18, 0x07, 0x01, 0x00},
-                                      {0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00}};
-const uint8_t fontDeg16x8[2][8]    = {{0x07, 0x05, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00},
-                                      {0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
-const uint8_t fontStar16x8[2][8]   = {{0x05, 0x0F, 0x02, 0x05, 0x00, 0x00, 0x00, 0x00},
-                                      {0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}};
+static void drawLine(const CanvasTypeDef* canvas, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+static void drawPolyline(const CanvasTypeDef* canvas, const PointTypeDef* points, uint16_t count);
+static inline void rasterPolyline(CanvasTypeDef canvas, RectParamTypeDef clip, const PointTypeDef* points,
+                                  uint16_t count);
+static inline void rasterLine(CanvasTypeDef canvas, RectParamTypeDef clip, uint8_t x0, uint8_t y0, uint8_t x1,
+                              uint8_t y1);
+static void drawStarDot(const CanvasTypeDef* canvas, uint8_t centerX, uint8_t centerY, uint8_t radius);
+static void bitToByte(const uint8_t* dotMatrix, const CanvasTypeDef* graphBuffer);
+#if GRAPH_WORD_TRANSPOSE
+static inline uint32_t packNonZeroBytes(const uint8_t* pixels);
+#endif
+static void drawRoundRect2DotMatrix(const CanvasTypeDef* canvas, uint8_t startX, uint8_t startY, uint8_t endX,
+                                    uint8_t endY, uint8_t radius, uint8_t);
+#if 0
+static void drawStar(const CanvasTypeDef* canvas);
+#endif
+static inline uint8_t cornerOffset(uint8_t radius, uint8_t l);
+static inline void fillColumnSpan(CanvasTypeDef canvas, uint8_t x, uint8_t y0, uint8_t y1, RasterOpEnum rop);
+static void fillRoundRect(const CanvasTypeDef* canvas, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                          uint8_t radius, RasterOpEnum rop);
+static inline void fillRoundRectColumns(CanvasTypeDef canvas, RectParamTypeDef area, RectParamTypeDef rect,
+                                        uint8_t radius, RasterOpEnum rop);
+static void fillColumnSpans(const CanvasTypeDef* canvas, uint8_t x, uint8_t count, const uint8_t* top,
+                            const uint8_t* bottom);
+static inline void fillClippedSpans(CanvasTypeDef canvas, RectParamTypeDef area, uint8_t x, const uint8_t* top,
+                                    const uint8_t* bottom);
+static void drawGraticule(const CanvasTypeDef* canvas, RectParamTypeDef area, uint8_t division, uint8_t dot);
+static void InverBufferWithMask(const CanvasTypeDef* mask, const CanvasTypeDef* buffer, RectParamTypeDef area);
+static void rasterOp(const CanvasTypeDef* dst, const CanvasTypeDef* src, RectParamTypeDef area, RasterOpEnum rop);
+static void rasterOpSpan(uint8_t* dst, const uint8_t* src, uint8_t len, RasterOpEnum rop);
+static void copyRect(const CanvasTypeDef* dst, const CanvasTypeDef* src, RectParamTypeDef area);
+static void blit(const CanvasTypeDef* canvas, int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bitmap,
+                 RasterOpEnum rop);
+static const uint8_t* blitShiftRow(uint8_t* row, const uint8_t* lo, const uint8_t* hi, uint8_t len, uint8_t shift);
+static void blitSpan(uint8_t* dst, const uint8_t* src, const uint8_t* srcMask, uint8_t len, uint8_t pageMask,
+                     RasterOpEnum rop);
+static RectParamTypeDef printStringOnBuffer(const CanvasTypeDef* canvas, const FontFaceTypeDef* font, const char* str,
+                                            uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY);
+static int8_t fontKerning(const FontFaceTypeDef* font, uint8_t left, uint8_t right);
+static uint8_t glyphRowInit(GlyphRowTypeDef* row, const CanvasTypeDef* canvas, const RectParamTypeDef* clip,
+                            const FontFaceTypeDef* font, uint8_t y);
+static inline uint8_t drawGlyph(const GlyphRowTypeDef* row, const RectParamTypeDef* clip, const FontFaceTypeDef* font,
+                                int16_t x, const FontGlyphTypeDef* glyph);
+static RectParamTypeDef animateMovingResizingRect(uint8_t sx0, uint8_t sy0, uint8_t sx1, uint8_t sy1, uint8_t ex0,
+                                                  uint8_t ey0, uint8_t ex1, uint8_t ey1, float progress);
+static void blendImagesWithSineScroll(const CanvasTypeDef* imageA, const CanvasTypeDef* imageB, uint8_t shift,
+                                      uint8_t direction, const CanvasTypeDef* result);
+static void bindDirtyMap(const CanvasTypeDef* canvas, DirtyMapTypeDef* map);
+static void markDirty(const CanvasTypeDef* canvas, RectParamTypeDef area);
+static void clearDirtyMap(DirtyMapTypeDef* map);
+static inline void markDirtyArea(const CanvasTypeDef* canvas, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+static void layerInit(LayerCompositorTypeDef* compositor);
+static uint8_t layerAdd(LayerCompositorTypeDef* compositor, const CanvasTypeDef* canvas, RasterOpEnum rop);
+static void layerMarkDirty(LayerCompositorTypeDef* compositor, uint8_t index, RectParamTypeDef area);
+static void layerInvalidateTarget(LayerCompositorTypeDef* compositor, uint8_t target);
+static void layerCompose(LayerCompositorTypeDef* compositor, uint8_t target, const CanvasTypeDef* dst);
+static void setClipRect(RectParamTypeDef clip);
+static void resetClipRect(void);
+static inline RectParamTypeDef canvasClip(const CanvasTypeDef* canvas);
+static inline uint8_t clipArea(const RectParamTypeDef* clip, RectParamTypeDef* area);
+static inline uint8_t clipPageMask(const RectParamTypeDef* clip, uint8_t page);
 
 
 
+/* ------- variables -------------------------------------------------------------------------------------------------*/
 
 GraphServIntfTypeDef graphServIntf = {
     .drawRoundRect2DotMatrix   = drawRoundRect2DotMatrix,
     .bitToByte                 = bitToByte,
     .drawStarDot               = drawStarDot,
     .drawLine                  = drawLine,
+    .drawPolyline              = drawPolyline,
     .InverBufferWithMask       = InverBufferWithMask,
+    .rasterOp                  = rasterOp,
+    .copyRect                  = copyRect,
+    .blit                      = blit,
+    .fillRoundRect             = fillRoundRect,
+    .fillColumnSpans           = fillColumnSpans,
+    .drawGraticule             = drawGraticule,
     .printStringOnBuffer       = printStringOnBuffer,
     .animateMovingResizingRect = animateMovingResizingRect,
-    .insertNewPoint            = insertNewPoint,
     .blendImagesWithSineScroll = blendImagesWithSineScroll,
+    .bindDirtyMap              = bindDirtyMap,
+    .markDirty                 = markDirty,
+    .clearDirtyMap             = clearDirtyMap,
+    .layerInit                 = layerInit,
+    .layerAdd                  = layerAdd,
+    .layerMarkDirty            = layerMarkDirty,
+    .layerInvalidateTarget     = layerInvalidateTarget,
+    .layerCompose              = layerCompose,
+    .setClipRect               = setClipRect,
+    .resetClipRect             = resetClipRect,
 };
 
-// 字体
-FontTypeDef font[] = {
-    {'0', 9, 6, (uint8_t*)font016x8},    {'1', 9, 6, (uint8_t*)font116x8},
-    {'.', 2, 4, (uint8_t*)fontDot16x8},  {'2', 9, 6, (uint8_t*)font216x8},
-    {'3', 9, 6, (uint8_t*)font316x8},    {'4', 9, 6, (uint8_t*)font416x8},
-    {'5', 9, 7, (uint8_t*)font516x8},    {'6', 9, 6, (uint8_t*)font616x8},
-    {'7', 9, 6, (uint8_t*)font716x8},    {'8', 9, 6, (uint8_t*)font816x8},
-    {'9', 9, 6, (uint8_t*)font916x8},    {'k', 9, 5, (uint8_t*)fontk16x8},
-    {'H', 16, 7, (uint8_t*)fontH16x8},   {'z', 5, 5, (uint8_t*)fontz16x8},
-    {'V', 9, 8, (uint8_t*)fontV16x8},    {(uint16_t)"°"[0], 8, 5, (uint8_t*)fontDeg16x8}, // 度符号
-    {'*', 8, 5, (uint8_t*)fontStar16x8},                                                  // 星号
+static DirtyBindTypeDef dirtyBindList[DIRTY_BIND_MAX]; // 画布与脏页表的绑定列表
+
+static RectParamTypeDef clipRect = {0, 0, 0xFF, 0xFF}; // 当前裁剪矩形, 默认不裁剪, 绘制时再与目标画布求交
+
+// 圆角缩进表: cornerTable[r][l] = r - floor(sqrt(2lr - 2l - l^2)) - 1, l为距上(下)边的行数
+static const uint8_t cornerTable[CORNER_TABLE_MAX_RADIUS + 1][CORNER_TABLE_MAX_RADIUS] = {
+    {0},
+    {0},
+    {1, 0},
+    {2, 1, 0},
+    {3, 1, 1, 0},
+    {4, 2, 1, 1, 0},
+    {5, 2, 1, 1, 1, 0},
+    {6, 3, 2, 1, 1, 1, 0},
+    {7, 4, 3, 2, 1, 1, 1, 0},
 };
 
-static PointTypeDef points[MAX_POINTS]; // 点阵图点存储
-
 
 
 /* ------- function implement ----------------------------------------------------------------------------------------*/
@@ -168,36 +218,164 @@ static PointTypeDef points[MAX_POINTS]; // 点阵图点存储
 /**
  * @brief Bresenham算法绘制线段
  *
- * @param dotMatrix
+ * @param canvas
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ */
+static void drawLine(const CanvasTypeDef* canvas, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    RectParamTypeDef clip = canvasClip(canvas);
+    RectParamTypeDef area = {x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1, x0 < x1 ? x1 : x0, y0 < y1 ? y1 : y0};
+
+    if (clipArea(&clip, &area)) {
+        markDirtyArea(canvas, area.x0, area.y0, area.x1, area.y1);
+        CANVAS_DISPATCH(canvas, rasterLine, clip, x0, y0, x1, y1);
+    }
+}
+
+/**
+ * @brief 依次连接各点绘制折线
+ *
+ * @param canvas
+ * @param points 顶点数组
+ * @param count 顶点数量, 为1时只绘制一个点
+ * @note 整批线段只标记一次脏区域, 用于按采样块批量绘制连续轨迹
+ */
+static void drawPolyline(const CanvasTypeDef* canvas, const PointTypeDef* points, uint16_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    RectParamTypeDef clip = canvasClip(canvas);
+    RectParamTypeDef area = {points[0].x, points[0].y, points[0].x, points[0].y};
+    for (uint16_t i = 1; i < count; i++) {
+        area.x0 = points[i].x < area.x0 ? points[i].x : area.x0;
+        area.x1 = points[i].x > area.x1 ? points[i].x : area.x1;
+        area.y0 = points[i].y < area.y0 ? points[i].y : area.y0;
+        area.y1 = points[i].y > area.y1 ? points[i].y : area.y1;
+    }
+    if (!clipArea(&clip, &area)) {
+        return; // 折线完全在裁剪矩形外
+    }
+    markDirtyArea(canvas, area.x0, area.y0, area.x1, area.y1);
+
+    CANVAS_DISPATCH(canvas, rasterPolyline, clip, points, count);
+}
+
+/**
+ * @brief 将折线的各段依次光栅化到画布
+ *
+ * @param canvas 按值传入的画布, 屏幕尺寸时各字段为常量
+ * @param clip 已与画布求交的裁剪矩形
+ * @param points 顶点数组
+ * @param count 顶点数量, 不为0
+ */
+static inline void rasterPolyline(CanvasTypeDef canvas, RectParamTypeDef clip, const PointTypeDef* points,
+                                  uint16_t count) {
+    if (count == 1) {
+        rasterLine(canvas, clip, points[0].x, points[0].y, points[0].x, points[0].y);
+        return;
+    }
+
+    for (uint16_t i = 1; i < count; i++) {
+        rasterLine(canvas, clip, points[i - 1].x, points[i - 1].y, points[i].x, points[i].y);
+    }
+}
+
+/**
+ * @brief 以Bresenham算法将线段直接光栅化到页格式画布, 适用于全部八个方向, 按裁剪矩形裁剪
+ *
+ * @param canvas 按值传入的画布, 屏幕尺寸时各字段为常量
+ * @param clip 已与画布求交的裁剪矩形
  * @param x0
  * @param y0
  * @param x1
  * @param y1
+ * @note 1. 设主轴长度为D, 副轴长度为d, 第i步(沿主轴)的副轴偏移为 floor((2id + D) / 2D), 与逐步迭代的结果一致
+ *       2. 主轴上的可见步数区间由裁剪矩形直接得到, 副轴上的区间由上式反解, 每条线段只裁剪一次;
+ *          起点的误差项按已走过的步数直接算出, 之后以字节指针和位掩码步进, 不再逐点判断边界
  */
-static void drawLine(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
-    uint8_t dx  = (x1 - x0) > 0 ? (x1 - x0) : (x0 - x1);
-    uint8_t dy  = (y1 - y0) > 0 ? (y0 - y1) : (y1 - y0);
-    uint8_t sx  = x0 < x1 ? 1 : -1;
-    uint8_t sy  = y0 < y1 ? 1 : -1;
-    uint8_t err = dx + dy;
+static inline void rasterLine(CanvasTypeDef canvas, RectParamTypeDef clip, uint8_t x0, uint8_t y0, uint8_t x1,
+                              uint8_t y1) {
+    if (clip.x0 > clip.x1 || clip.y0 > clip.y1) {
+        return; // 裁剪矩形为空
+    }
 
-    while (1) {
-        // 在合法范围内设置像素点
-        if (x0 < WIDTH && y0 < HEIGHT) {
-            dotMatrix[y0][x0] = 1;
+    int32_t dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int32_t dy = y1 > y0 ? y1 - y0 : y0 - y1;
+    int8_t sx  = x0 < x1 ? 1 : -1;
+    int8_t sy  = y0 < y1 ? 1 : -1;
+
+    // 沿步进方向相对于起点的可见偏移范围
+    int32_t xLo = sx > 0 ? clip.x0 - x0 : x0 - clip.x1;
+    int32_t xHi = sx > 0 ? clip.x1 - x0 : x0 - clip.x0;
+    int32_t yLo = sy > 0 ? clip.y0 - y0 : y0 - clip.y1;
+    int32_t yHi = sy > 0 ? clip.y1 - y0 : y0 - clip.y0;
+
+    uint8_t xMajor  = dx >= dy;
+    int32_t major   = xMajor ? dx : dy;
+    int32_t minor   = xMajor ? dy : dx;
+    int32_t minorLo = xMajor ? yLo : xLo;
+    int32_t minorHi = xMajor ? yHi : xHi;
+    int32_t first   = xMajor ? xLo : yLo;
+    int32_t last    = xMajor ? xHi : yHi;
+
+    first = first > 0 ? first : 0;
+    last  = last < major ? last : major;
+
+    if (minorHi < 0 || (minor == 0 && minorLo > 0)) {
+        return; // 副轴方向不可见
+    }
+    if (minor != 0) {
+        if (minorLo > 0) {
+            int32_t enter = (2 * major * minorLo - major + 2 * minor - 1) / (2 * minor); // 副轴偏移首次达到minorLo的步
+            first         = enter > first ? enter : first;
         }
+        int32_t leave = (2 * major * (minorHi + 1) - major - 1) / (2 * minor); // 副轴偏移最后不超过minorHi的步
+        last          = leave < last ? leave : last;
+    }
+    if (first > last) {
+        return; // 线段完全在裁剪矩形外
+    }
 
-        if (x0 == x1 && y0 == y1)
+    // 定位到第first步
+    int32_t side  = major ? (2 * first * minor + major) / (2 * major) : 0;
+    int32_t xStep = xMajor ? first : side;
+    int32_t yStep = xMajor ? side : first;
+    int32_t err   = dx - dy - xStep * dy + yStep * dx;
+    uint8_t x     = (uint8_t)(x0 + sx * xStep);
+    uint8_t y     = (uint8_t)(y0 + sy * yStep);
+
+    uint8_t* byte = CANVAS_PAGE(&canvas, y >> 3) + x;
+    uint8_t bit   = (uint8_t)(1 << (y & 7));
+
+    for (int32_t n = last - first;; n--) {
+        *byte |= bit;
+
+        if (n == 0)
             break;
 
-        uint8_t e2 = 2 * err;
-        if (e2 >= dy) {
-            err += dy;
-            x0 += sx;
+        int32_t e2 = 2 * err;
+        if (e2 >= -dy) {
+            err -= dy;
+            byte += sx;
         }
         if (e2 <= dx) {
             err += dx;
-            y0 += sy;
+            if (sy > 0) {
+                bit <<= 1;
+                if (bit == 0) {
+                    bit = 0x01;
+                    byte += canvas.stride; // 进入下一页
+                }
+            } else {
+                bit >>= 1;
+                if (bit == 0) {
+                    bit = 0x80;
+                    byte -= canvas.stride; // 进入上一页
+                }
+            }
         }
     }
 }
@@ -205,115 +383,413 @@ static void drawLine(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t x0, uint8_t y0, u
 /**
  * @brief 绘制五角星
  *
- * @param dotMatrix
+ * @param canvas
  * @param centerX
  * @param centerY
  * @param radius
+ * @note 顶点角度为 2PI/5 * i + PI/10, 以二进制角度查表计算
  */
-static void drawStarDot(uint8_t dotMatrix[HEIGHT][WIDTH], float centerX, float centerY, float radius) {
-    float theta = PI * 2 / 5;
+static void drawStarDot(const CanvasTypeDef* canvas, uint8_t centerX, uint8_t centerY, uint8_t radius) {
     uint8_t vertex[5][2];
     for (uint8_t i = 0; i < 5; i++) {
-        vertex[i][0] = (uint8_t)(radius * cos(theta * i + PI / 10) + centerX);
-        vertex[i][1] = (uint8_t)(radius * sin(theta * i + PI / 10) + centerY);
+        uint16_t angle = (uint16_t)((i * 65536UL + 65536UL / 4) / 5); // (2PI * i + PI/2) / 5
+        vertex[i][0]   = (uint8_t)((((int32_t)centerX << 15) + radius * trigServIntf.cosQ15(angle)) >> 15);
+        vertex[i][1]   = (uint8_t)((((int32_t)centerY << 15) + radius * trigServIntf.sinQ15(angle)) >> 15);
     }
     for (uint8_t i = 0; i < 5; i++) {
-        drawLine(dotMatrix, vertex[i][0], vertex[i][1], vertex[(i + 2) % 5][0], vertex[(i + 2) % 5][1]);
-        drawLine(dotMatrix, vertex[i][0], vertex[i][1], vertex[(i + 2) % 5][0], vertex[(i + 2) % 5][1]);
+        drawLine(canvas, vertex[i][0], vertex[i][1], vertex[(i + 2) % 5][0], vertex[(i + 2) % 5][1]);
+        drawLine(canvas, vertex[i][0], vertex[i][1], vertex[(i + 2) % 5][0], vertex[(i + 2) % 5][1]);
     }
 }
 
 /**
- * @brief 将点阵图转换为字节数组
+ * @brief 将字节点阵图(每像素一字节)转换为页格式
  *
- * @param dotMatrix 点阵图
- * @param graphBuffer 字节数组
+ * @param dotMatrix 点阵图, 共height行, 每行width字节
+ * @param graphBuffer 页格式画布
+ * @note 各绘图函数已直接绘制到页格式画布, 本函数仅用于转换外部的字节点阵数据.
+ *       宽高均为8的倍数时按8x8块转置, 否则逐像素转换
  */
-static void bitToByte(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t graphBuffer[PAGE][WIDTH]) {
-    for (uint16_t col = 0; col < WIDTH; col++) {
-        for (uint16_t page = 0; page < PAGE; page++) {
+static void bitToByte(const uint8_t* dotMatrix, const CanvasTypeDef* graphBuffer) {
+    uint8_t width  = graphBuffer->width;
+    uint8_t height = graphBuffer->height;
+
+    markDirtyArea(graphBuffer, 0, CANVAS_TOP(graphBuffer), width - 1, CANVAS_BOTTOM(graphBuffer));
+
+#if GRAPH_WORD_TRANSPOSE
+    if ((width & 7) == 0 && (height & 7) == 0) {
+        for (uint8_t page = 0; page < (height >> 3); page++) {
+            const uint8_t* rows = dotMatrix + page * 8 * width;
+            uint8_t* dst        = CANVAS_PAGE(graphBuffer, graphBuffer->firstPage + page);
+
+            for (uint8_t col = 0; col < width; col += 8) {
+                // 1. 每行8个像素压缩为1字节(bit7对应col), 按Hacker's Delight的行序打包:
+                //    x = 行7..行4, y = 行3..行0
+                uint32_t x = 0;
+                uint32_t y = 0;
+                for (uint8_t row = 0; row < 4; row++) {
+                    x = (x << 8) | (packNonZeroBytes(&rows[(7 - row) * width + col]) << 4) |
+                        packNonZeroBytes(&rows[(7 - row) * width + col + 4]);
+                    y = (y << 8) | (packNonZeroBytes(&rows[(3 - row) * width + col]) << 4) |
+                        packNonZeroBytes(&rows[(3 - row) * width + col + 4]);
+                }
+
+                // 2. 8x8位矩阵转置: 依次交换1x1, 2x2, 4x4子块
+                uint32_t t;
+                t = (x ^ (x >> 7)) & 0x00AA00AAu;
+                x = x ^ t ^ (t << 7);
+                t = (y ^ (y >> 7)) & 0x00AA00AAu;
+                y = y ^ t ^ (t << 7);
+
+                t = (x ^ (x >> 14)) & 0x0000CCCCu;
+                x = x ^ t ^ (t << 14);
+                t = (y ^ (y >> 14)) & 0x0000CCCCu;
+                y = y ^ t ^ (t << 14);
+
+                t = (x & 0xF0F0F0F0u) | ((y >> 4) & 0x0F0F0F0Fu);
+                y = ((x << 4) & 0xF0F0F0F0u) | (y & 0x0F0F0F0Fu);
+                x = t;
+
+                // 3. 转置结果的第i个字节即第col+i列的页字节(bit0对应页顶部像素)
+                dst[col + 0] = (uint8_t)(x >> 24);
+                dst[col + 1] = (uint8_t)(x >> 16);
+                dst[col + 2] = (uint8_t)(x >> 8);
+                dst[col + 3] = (uint8_t)x;
+                dst[col + 4] = (uint8_t)(y >> 24);
+                dst[col + 5] = (uint8_t)(y >> 16);
+                dst[col + 6] = (uint8_t)(y >> 8);
+                dst[col + 7] = (uint8_t)y;
+            }
+        }
+        return;
+    }
+#endif
+
+    for (uint16_t col = 0; col < width; col++) {
+        for (uint16_t page = 0; page < BITMAP_PAGES(height); page++) {
             uint8_t byte = 0;
             for (uint8_t bit = 0; bit < 8; bit++) {
-                uint8_t y = page * 8 + bit;
-                if (y < HEIGHT && dotMatrix[y][col]) {
+                uint16_t y = page * 8 + bit;
+                if (y < height && dotMatrix[y * width + col]) {
                     byte |= (1 << bit); // bit0对应页顶部像素
                 }
             }
-            graphBuffer[page][col] = byte;
+            CANVAS_PAGE(graphBuffer, graphBuffer->firstPage + page)[col] = byte;
         }
     }
 }
 
+#if GRAPH_WORD_TRANSPOSE
+/**
+ * @brief 以一次32位读取判断4个字节像素是否非0, 压缩为4位
+ *
+ * @param pixels 4个连续的字节像素
+ * @return uint32_t 低4位有效, bit3对应pixels[0]
+ * @note 依赖小端字节序(Cortex-M3与主机x86均满足), 非0字节与参考实现一致视为点亮
+ */
+static inline uint32_t packNonZeroBytes(const uint8_t* pixels) {
+    uint32_t word;
+    memcpy(&word, pixels, sizeof(word)); // Cortex-M3支持非对齐LDR, 编译为单条读取
+
+    word = (((word & 0x7F7F7F7Fu) + 0x7F7F7F7Fu) | word) & 0x80808080u; // 非0字节的最高位置1
+    return ((word >> 7) * 0x08040201u) >> 24;                           // 4个标志位收拢到最高字节
+}
+#endif
+
 #if 0
 /**
  * @brief 绘制五角星
  *
  * @param graphBuffer 字节数组
  */
-void drawStar(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t graphBuffer[PAGE][WIDTH]) {
+void drawStar(const CanvasTypeDef* canvas) {
 
-    float centerX = WIDTH / 2;
-    float centerY = HEIGHT / 2;
-    float radius  = 25;
+    uint8_t centerX = canvas->width / 2;
+    uint8_t centerY = canvas->height / 2;
+    uint8_t radius  = 25;
 
-    drawStarDot(dotMatrix, centerX, centerY, radius);
-    bitToByte(dotMatrix, graphBuffer);
+    drawStarDot(canvas, centerX, centerY, radius);
 }
 #endif
 
 /**
- * @brief 点阵中绘制圆角矩形
+ * @brief 获取圆角在第l行(从外向内)的水平缩进量
+ *
+ * @param radius 圆角半径
+ * @param l 距离矩形上(下)边的行数, 需小于radius
+ * @return uint8_t 缩进像素数
+ * @note 半径不超过CORNER_TABLE_MAX_RADIUS时查表, 否则使用整数开方计算, 结果与原sqrt公式一致
+ */
+static inline uint8_t cornerOffset(uint8_t radius, uint8_t l) {
+    if (radius <= CORNER_TABLE_MAX_RADIUS) {
+        return cornerTable[radius][l];
+    }
+
+    // r - floor(sqrt(2lr - 2l - l^2)) - 1
+    uint16_t n    = 2 * l * radius - 2 * l - l * l;
+    uint16_t root = 0;
+    for (uint16_t bit = 1 << 14; bit != 0; bit >>= 2) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+    }
+    return radius - (uint8_t)root - 1;
+}
+
+/**
+ * @brief 按页掩码填充或反转一列中的连续像素
+ *
+ * @param canvas 按值传入的画布, 屏幕尺寸时各字段为常量
+ * @param x 列坐标
+ * @param y0 起始行
+ * @param y1 结束行(包含)
+ * @param rop RASTER_OP_XOR反转, 其余点亮
+ */
+static inline void fillColumnSpan(CanvasTypeDef canvas, uint8_t x, uint8_t y0, uint8_t y1, RasterOpEnum rop) {
+    uint8_t lastPage = y1 >> 3;
+    uint8_t* byte    = CANVAS_PAGE(&canvas, y0 >> 3) + x;
+
+    for (uint8_t page = y0 >> 3; page <= lastPage; page++, byte += canvas.stride) {
+        uint8_t mask = 0xFF;
+        if (page == (y0 >> 3)) {
+            mask &= (uint8_t)(0xFF << (y0 & 7));
+        }
+        if (page == lastPage) {
+            mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+        }
+
+        if (rop == RASTER_OP_XOR) {
+            *byte ^= mask;
+        } else {
+            *byte |= mask;
+        }
+    }
+}
+
+/**
+ * @brief 以列跨度绘制实心圆角矩形
+ *
+ * @param canvas 页格式画布
+ * @param startX 起始X坐标
+ * @param startY 起始Y坐标
+ * @param endX 结束X坐标
+ * @param endY 结束Y坐标
+ * @param radius 圆角半径
+ * @param rop RASTER_OP_XOR直接反转画布中的区域, 其余点亮
+ * @note 每列只需按圆角表求出上下端, 再以1~3个页掩码写入, 结果与逐行逐像素绘制一致.
+ *       列范围和每列的上下端按裁剪矩形截取
+ */
+static void fillRoundRect(const CanvasTypeDef* canvas, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                          uint8_t radius, RasterOpEnum rop) {
+    RectParamTypeDef clip = canvasClip(canvas);
+    RectParamTypeDef rect = {startX, startY, endX, endY};
+    RectParamTypeDef area = rect;
+
+    if (!clipArea(&clip, &area)) {
+        return;
+    }
+
+    markDirtyArea(canvas, area.x0, area.y0, area.x1, area.y1);
+
+    CANVAS_DISPATCH(canvas, fillRoundRectColumns, area, rect, radius, rop);
+}
+
+/**
+ * @brief 逐列填充实心圆角矩形
+ *
+ * @param canvas 按值传入的画布, 屏幕尺寸时各字段为常量
+ * @param area 圆角矩形与裁剪矩形的交集
+ * @param rect 圆角矩形
+ * @param radius 圆角半径
+ * @param rop RASTER_OP_XOR反转, 其余点亮
+ */
+static inline void fillRoundRectColumns(CanvasTypeDef canvas, RectParamTypeDef area, RectParamTypeDef rect,
+                                        uint8_t radius, RasterOpEnum rop) {
+    // 上圆角区域为[rect.y0, topEnd], 区域内最后一行缩进恒为0
+    uint8_t topEnd = (radius > 0 && rect.y0 + radius - 1 < rect.y1) ? rect.y0 + radius - 1 : rect.y1;
+
+    for (uint8_t x = area.x0; x <= area.x1; x++) {
+        uint8_t d     = (x - rect.x0) < (rect.x1 - x) ? (x - rect.x0) : (rect.x1 - x); // 到较近竖边的距离
+        uint8_t inset = 0;                                                             // 首个缩进不超过d的行
+
+        if (radius > 0) {
+            while (cornerOffset(radius, inset) > d) {
+                inset++;
+            }
+        }
+        if (rect.y0 + inset > rect.y1) {
+            continue; // 矩形过矮, 该列没有像素
+        }
+
+        uint8_t y0 = rect.y0 + inset;
+        uint8_t y1 = (rect.y1 - inset > topEnd) ? rect.y1 - inset : topEnd;
+        y0         = y0 > area.y0 ? y0 : area.y0;
+        y1         = y1 < area.y1 ? y1 : area.y1;
+        if (y0 <= y1) {
+            fillColumnSpan(canvas, x, y0, y1, rop);
+        }
+    }
+}
+
+/**
+ * @brief 逐列点亮竖直跨度
+ *
+ * @param canvas 页格式画布
+ * @param x 第一列
+ * @param count 列数
+ * @param top 各列跨度的起始行
+ * @param bottom 各列跨度的结束行(包含), 小于起始行的列不绘制
+ * @note 用于绘制抽取后的波形包络, 每列以1~8个页掩码写入. 列范围和每列的上下端按裁剪矩形截取,
+ *       脏区域为实际绘制的行范围
+ */
+static void fillColumnSpans(const CanvasTypeDef* canvas, uint8_t x, uint8_t count, const uint8_t* top,
+                            const uint8_t* bottom) {
+    RectParamTypeDef clip = canvasClip(canvas);
+    RectParamTypeDef area = {x, 0, x + count - 1, 0xFF};
+
+    if (count == 0 || x + count - 1 > 0xFF || !clipArea(&clip, &area)) {
+        return;
+    }
+
+    uint8_t y0 = 0xFF; // 实际绘制的行范围
+    uint8_t y1 = 0;
+    for (uint8_t c = area.x0 - x; c <= area.x1 - x; c++) {
+        y0 = top[c] < y0 ? top[c] : y0;
+        y1 = bottom[c] > y1 ? bottom[c] : y1;
+    }
+    y0 = y0 > area.y0 ? y0 : area.y0;
+    y1 = y1 < area.y1 ? y1 : area.y1;
+    if (y0 > y1) {
+        return;
+    }
+
+    markDirtyArea(canvas, area.x0, y0, area.x1, y1);
+
+    CANVAS_DISPATCH(canvas, fillClippedSpans, area, x, top, bottom);
+}
+
+/**
+ * @brief 逐列点亮裁剪后的竖直跨度
+ *
+ * @param canvas 按值传入的画布, 屏幕尺寸时各字段为常量
+ * @param area 列范围与裁剪矩形的交集
+ * @param x 第一列, top与bottom的下标0对应该列
+ * @param top 各列跨度的起始行
+ * @param bottom 各列跨度的结束行(包含)
+ */
+static inline void fillClippedSpans(CanvasTypeDef canvas, RectParamTypeDef area, uint8_t x, const uint8_t* top,
+                                    const uint8_t* bottom) {
+    for (uint8_t col = area.x0; col <= area.x1; col++) {
+        uint8_t y0 = top[col - x] > area.y0 ? top[col - x] : area.y0;
+        uint8_t y1 = bottom[col - x] < area.y1 ? bottom[col - x] : area.y1;
+        if (y0 <= y1) {
+            fillColumnSpan(canvas, col, y0, y1, RASTER_OP_OR);
+        }
+    }
+}
+
+/**
+ * @brief 在区域内绘制点线网格刻度
+ *
+ * @param canvas 页格式画布
+ * @param area 绘制区域(包含边界), 与裁剪矩形求交
+ * @param division 格宽, 屏幕坐标为其倍数的行和列(第0行和第0列除外)各有一条虚线, 不为0
+ * @param dot 虚线的点距, 横线上列坐标, 竖线上行坐标为其倍数的像素点亮, 不为0
+ * @note 网格相对屏幕原点固定, 与区域位置无关, 因此逐页带分块绘制与整幅绘制结果相同.
+ *       每页先算出竖线和横线的行掩码, 再按点距和格宽跳过无点的列. 脏区域为整个截取后的区域
+ */
+static void drawGraticule(const CanvasTypeDef* canvas, RectParamTypeDef area, uint8_t division, uint8_t dot) {
+    RectParamTypeDef clip = canvasClip(canvas);
+
+    if (division == 0 || dot == 0 || !clipArea(&clip, &area)) {
+        return;
+    }
+
+    markDirtyArea(canvas, area.x0, area.y0, area.x1, area.y1);
+
+    for (uint8_t page = area.y0 >> 3; page <= (area.y1 >> 3); page++) {
+        uint8_t mask       = clipPageMask(&area, page);
+        uint8_t vertical   = 0; // 竖线在本页中的点
+        uint8_t horizontal = 0; // 横线在本页中的行
+        uint8_t* row       = CANVAS_PAGE(canvas, page);
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            uint8_t y = (page << 3) | bit;
+            vertical |= (y % dot == 0) ? (1 << bit) : 0;
+            horizontal |= (y != 0 && y % division == 0) ? (1 << bit) : 0;
+        }
+        vertical &= mask;
+        horizontal &= mask;
+
+        // 只访问有点的列: 横线每dot列一点, 竖线每division列一条
+        for (uint16_t x = (area.x0 + dot - 1) / dot * dot; horizontal && x <= area.x1; x += dot) {
+            row[x] |= horizontal;
+        }
+        for (uint16_t x = (area.x0 > 0 ? area.x0 + division - 1 : division) / division * division;
+             vertical && x <= area.x1; x += division) {
+            row[x] |= vertical;
+        }
+    }
+}
+
+/**
+ * @brief 画布中绘制圆角矩形
  *
- * @param dotMatrix 点阵图像素数组
+ * @param canvas 页格式画布
  * @param startX 起始X坐标
  * @param startY 起始Y坐标
  * @param endX 结束X坐标
  * @param endY 结束Y坐标
  * @param radius 圆角半径
+ * @note 行范围按裁剪矩形截取, 上下边按裁剪矩形截取列范围, 左右边只在裁剪矩形内时绘制
  */
-void drawRoundRect2DotMatrix(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t startX, uint8_t startY, uint8_t endX,
+void drawRoundRect2DotMatrix(const CanvasTypeDef* canvas, uint8_t startX, uint8_t startY, uint8_t endX,
                              uint8_t endY, uint8_t radius, uint8_t padding) {
 
+    if (padding) {
+        fillRoundRect(canvas, startX, startY, endX, endY, radius, RASTER_OP_OR);
+        return;
+    }
+
+    RectParamTypeDef clip = canvasClip(canvas);
+    RectParamTypeDef area = {startX, startY, endX, endY};
+
+    if (!clipArea(&clip, &area)) {
+        return;
+    }
+
+    markDirtyArea(canvas, area.x0, area.y0, area.x1, area.y1);
 
-    // 逐行绘制
-    for (uint8_t y = startY; y <= endY; y++) {
-        uint8_t lightUpFromX;
-        uint8_t lightUpToX;
+    // 仅绘制边框, 逐行计算左右端点
+    for (uint8_t y = area.y0; y <= area.y1; y++) {
+        uint8_t xOffset = 0;
 
-        // 计算当前行的起始和结束点
-        // 1.位于上方圆角区域
         if (y < startY + radius) {
-            uint8_t l       = y - startY;
-            uint8_t xOffset = radius - (uint8_t)sqrt(2 * l * radius - 2 * l - l * l) - 1;
-            lightUpFromX    = startX + xOffset;
-            lightUpToX      = endX - xOffset;
-        } else if (y < endY - radius + 1) {
-            // 2.位于中间区域
-            lightUpFromX = startX;
-            lightUpToX   = endX;
-        } else {
-            // 3.位于下方圆角区域
-            uint8_t l       = endY - y; // 计算当前行到下方圆角的距离
-            uint8_t xOffset = radius - (uint8_t)sqrt(2 * l * radius - 2 * l - l * l) - 1;
-            lightUpFromX    = startX + xOffset;
-            lightUpToX      = endX - xOffset;
+            xOffset = cornerOffset(radius, y - startY); // 1.位于上方圆角区域
+        } else if (y >= endY - radius + 1) {
+            xOffset = cornerOffset(radius, endY - y); // 3.位于下方圆角区域
         }
 
-        if (padding) {
-
-            for (uint8_t x = lightUpFromX; x <= lightUpToX; x++) {
+        uint8_t lightUpFromX = startX + xOffset;
+        uint8_t lightUpToX   = endX - xOffset;
 
-                dotMatrix[y][x] = 1; // 设置点阵图像素为1
+        if (y == startY || y == endY) {
+            uint8_t* pageRow = CANVAS_PAGE(canvas, y >> 3);
+            uint8_t bit      = (uint8_t)(1 << (y & 7));
+            uint8_t fromX    = lightUpFromX > area.x0 ? lightUpFromX : area.x0;
+            uint8_t toX      = lightUpToX < area.x1 ? lightUpToX : area.x1;
+            for (uint8_t x = fromX; x <= toX; x++) {
+                pageRow[x] |= bit;
             }
         } else {
-            // 如果不需要填充，则只绘制边框
-            if (y == startY || y == endY) {
-                for (uint8_t x = lightUpFromX; x <= lightUpToX; x++) {
-                    dotMatrix[y][x] = 1; // 设置点阵图像素为1
-                }
-            } else {
-                dotMatrix[y][lightUpFromX] = 1; // 左边框
-                dotMatrix[y][lightUpToX]   = 1; // 右边框
+            if (lightUpFromX >= area.x0 && lightUpFromX <= area.x1) {
+                CANVAS_SET_PIXEL(canvas, lightUpFromX, y); // 左边框
+            }
+            if (lightUpToX >= area.x0 && lightUpToX <= area.x1) {
+                CANVAS_SET_PIXEL(canvas, lightUpToX, y); // 右边框
             }
         }
     }
@@ -323,44 +799,330 @@ void drawRoundRect2DotMatrix(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t startX, u
 /**
  * @brief 反转图形缓冲区中指定掩码的像素
  *
- * @param mask 掩码数组，指示哪些像素需要被反转
+ * @param mask 页格式掩码，置位的像素需要被反转
  * @param buffer 图形缓冲区
+ * @param area 掩码的包围盒, 仅处理其覆盖的页和列
+ */
+void InverBufferWithMask(const CanvasTypeDef* mask, const CanvasTypeDef* buffer, RectParamTypeDef area) {
+    rasterOp(buffer, mask, area, RASTER_OP_XOR);
+}
+
+/**
+ * @brief 在区域内将源画布以光栅操作合成到目标画布
+ *
+ * @param dst 目标画布
+ * @param src 源画布
+ * @param area 操作区域(包含边界), 纵向扩展到整页
+ * @param rop 光栅操作类型
+ * @note 纵向扩展不超出裁剪矩形, 裁剪矩形上下边界所在的页只改写其中的行. 区域同时限制在源画布范围内
+ */
+static void rasterOp(const CanvasTypeDef* dst, const CanvasTypeDef* src, RectParamTypeDef area, RasterOpEnum rop) {
+    RectParamTypeDef clip   = canvasClip(dst);
+    RectParamTypeDef bounds = CANVAS_AREA(src);
+
+    if (area.y0 <= area.y1) {
+        area.y0 &= (uint8_t)~7; // 扩展到整页后再裁剪
+        area.y1 |= 7;
+    }
+
+    if (!clipArea(&bounds, &clip) || !clipArea(&clip, &area)) {
+        return; // 区域为空或完全在裁剪矩形外
+    }
+
+    uint8_t len = area.x1 - area.x0 + 1;
+
+    markDirtyArea(dst, area.x0, area.y0, area.x1, area.y1);
+
+    for (uint8_t page = area.y0 >> 3; page <= (area.y1 >> 3); page++) {
+        uint8_t mask        = clipPageMask(&clip, page);
+        uint8_t* to         = CANVAS_PAGE(dst, page) + area.x0;
+        const uint8_t* from = CANVAS_PAGE(src, page) + area.x0;
+
+        if (mask == 0xFF) {
+            rasterOpSpan(to, from, len, rop);
+        } else {
+            for (uint8_t i = 0; i < len; i++) {
+                uint8_t value = to[i];
+                RASTER_OP_BYTE(&value, &from[i], rop);
+                to[i] = (to[i] & (uint8_t)~mask) | (value & mask);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 对一页中连续的列执行光栅操作
+ *
+ * @param dst 目标字节
+ * @param src 源字节
+ * @param len 列数
+ * @param rop 光栅操作类型
+ * @note 先按字节处理到目标4字节对齐, 中间按32位字处理, 剩余的尾部按字节处理
+ */
+static void rasterOpSpan(uint8_t* dst, const uint8_t* src, uint8_t len, RasterOpEnum rop) {
+    uint8_t head = (uint8_t)((4 - ((uintptr_t)dst & 3)) & 3);
+
+    if (head > len) {
+        head = len;
+    }
+    for (uint8_t i = 0; i < head; i++) {
+        RASTER_OP_BYTE(dst + i, src + i, rop);
+    }
+    dst += head;
+    src += head;
+    len -= head;
+
+    uint8_t words = len >> 2;
+    switch (rop) {
+        case RASTER_OP_COPY: memcpy(dst, src, words * 4); break;
+        case RASTER_OP_OR: RASTER_OP_WORDS(dst, src, words, |=); break;
+        case RASTER_OP_AND: RASTER_OP_WORDS(dst, src, words, &=); break;
+        case RASTER_OP_XOR: RASTER_OP_WORDS(dst, src, words, ^=); break;
+        default: break;
+    }
+    dst += words * 4;
+    src += words * 4;
+
+    for (uint8_t i = 0; i < (len & 3); i++) {
+        RASTER_OP_BYTE(dst + i, src + i, rop);
+    }
+}
+
+/**
+ * @brief 按像素行精确复制矩形区域
+ *
+ * @param dst 目标画布
+ * @param src 源画布
+ * @param area 复制区域(包含边界)
+ * @note 与rasterOp不同, 区域上下边界所在的页只替换区域内的位, 不影响同一页中区域外的像素.
+ *       区域同时限制在源画布范围内
+ */
+static void copyRect(const CanvasTypeDef* dst, const CanvasTypeDef* src, RectParamTypeDef area) {
+    RectParamTypeDef clip   = canvasClip(dst);
+    RectParamTypeDef bounds = CANVAS_AREA(src);
+
+    if (!clipArea(&bounds, &clip) || !clipArea(&clip, &area)) {
+        return; // 区域为空或完全在裁剪矩形外
+    }
+
+    uint8_t x1  = area.x1;
+    uint8_t y1  = area.y1;
+    uint8_t len = x1 - area.x0 + 1;
+
+    markDirtyArea(dst, area.x0, area.y0, x1, y1);
+
+    for (uint8_t page = area.y0 >> 3; page <= (y1 >> 3); page++) {
+        uint8_t top         = page == (area.y0 >> 3) ? (area.y0 & 7) : 0;
+        uint8_t bottom      = page == (y1 >> 3) ? (y1 & 7) : 7;
+        uint8_t mask        = (uint8_t)((0xFF << top) & (0xFF >> (7 - bottom)));
+        uint8_t* to         = CANVAS_PAGE(dst, page) + area.x0;
+        const uint8_t* from = CANVAS_PAGE(src, page) + area.x0;
+
+        if (mask == 0xFF) {
+            rasterOpSpan(to, from, len, RASTER_OP_COPY);
+        } else {
+            for (uint8_t i = 0; i < len; i++) {
+                to[i] = (to[i] & (uint8_t)~mask) | (from[i] & mask);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 以光栅操作将页格式位图绘制到画布的任意像素位置
+ *
+ * @param canvas 目标画布
+ * @param x 位图左上角X坐标, 可为负数
+ * @param y 位图左上角Y坐标, 可为负数
+ * @param w 位图宽度
+ * @param h 位图高度
+ * @param bitmap 页格式位图: BITMAP_PAGES(h)页, 每页w字节, bit0为该页最上方一行;
+ *               RASTER_OP_MASK时其后紧跟同样布局的掩码平面, 掩码为1的像素取位图, 为0的像素保持画布不变
+ * @param rop 光栅操作类型
+ * @note 1. 位图先与裁剪矩形求交, 只修改交集内的像素
+ *       2. 画布的每一页由位图相邻两页的同一列错位拼接而成: (lo >> s) | (hi << (8 - s)), 以32位字一次拼接4列
+ *       3. y与页对齐且该页全部行都可见时, 除RASTER_OP_MASK外直接按32位字执行光栅操作
  */
-void InverBufferWithMask(uint8_t mask[HEIGHT][WIDTH], uint8_t buffer[PAGE][WIDTH]) {
-    for (uint8_t y = 0; y < 64; y++) {
-        for (uint8_t x = 0; x < 128; x++) {
-            if (mask[y][x]) {
-                uint8_t page    = y / 8;
-                uint8_t bit_pos = y % 8;
-                buffer[page][x] ^= (1 << bit_pos);
+static void blit(const CanvasTypeDef* canvas, int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bitmap,
+                 RasterOpEnum rop) {
+    RectParamTypeDef clip = canvasClip(canvas);
+    int16_t x0            = x > clip.x0 ? x : clip.x0;
+    int16_t y0            = y > clip.y0 ? y : clip.y0;
+    int16_t x1            = x + w - 1 < clip.x1 ? x + w - 1 : clip.x1;
+    int16_t y1            = y + h - 1 < clip.y1 ? y + h - 1 : clip.y1;
+
+    if (w == 0 || h == 0 || x0 > x1 || y0 > y1) {
+        return; // 位图完全在裁剪矩形外
+    }
+
+    uint8_t pages          = BITMAP_PAGES(h);
+    uint8_t len            = x1 - x0 + 1;
+    const uint8_t* image   = bitmap + (x0 - x);
+    const uint8_t* maskMap = rop == RASTER_OP_MASK ? image + pages * w : NULL;
+    uint8_t row[WIDTH];     // 错位拼接后的位图行, 比屏幕宽的画布分段拼接
+    uint8_t maskRow[WIDTH]; // 错位拼接后的掩码行
+
+    markDirtyArea(canvas, x0, y0, x1, y1);
+
+    for (uint8_t page = y0 >> 3; page <= (y1 >> 3); page++) {
+        uint8_t top    = page == (y0 >> 3) ? (y0 & 7) : 0;
+        uint8_t bottom = page == (y1 >> 3) ? (y1 & 7) : 7;
+        uint8_t mask   = (uint8_t)((0xFF << top) & (0xFF >> (7 - bottom)));
+        uint8_t* dst   = CANVAS_PAGE(canvas, page) + x0;
+
+        // 该页第0行对应位图中的行号不小于-7, 加8后按非负数取整, lo为其所在的位图页, hi为下一页
+        int16_t srcRow    = (int16_t)(page << 3) - y + 8;
+        uint8_t shift     = srcRow & 7;
+        int16_t lo        = srcRow / 8 - 1;
+        uint8_t hasLo     = lo >= 0;
+        uint8_t hasHi     = lo + 1 < pages;
+        uint16_t loOffset = hasLo ? lo * w : 0;
+        uint16_t hiOffset = (lo + 1) * w;
+
+        for (uint16_t col = 0; col < len; col += WIDTH) {
+            uint8_t n          = len - col < WIDTH ? len - col : WIDTH;
+            const uint8_t* src = blitShiftRow(row, hasLo ? image + loOffset + col : NULL,
+                                              hasHi ? image + hiOffset + col : NULL, n, shift);
+            const uint8_t* srcMask = NULL;
+
+            if (maskMap != NULL) {
+                srcMask = blitShiftRow(maskRow, hasLo ? maskMap + loOffset + col : NULL,
+                                       hasHi ? maskMap + hiOffset + col : NULL, n, shift);
             }
+
+            blitSpan(dst + col, src, srcMask, n, mask, rop);
+        }
+    }
+}
+
+/**
+ * @brief 将位图相邻两页的同一列错位拼接为画布中一页的字节
+ *
+ * @param row 拼接结果的存放位置
+ * @param lo 位图上一页(超出位图时为NULL, 视为0)
+ * @param hi 位图下一页(超出位图时为NULL, 视为0)
+ * @param len 列数
+ * @param shift 错位行数, 0表示与页对齐
+ * @return const uint8_t* 拼接结果; 与页对齐时直接返回lo, 不复制
+ */
+static const uint8_t* blitShiftRow(uint8_t* row, const uint8_t* lo, const uint8_t* hi, uint8_t len, uint8_t shift) {
+    if (shift == 0) {
+        return lo; // 与页对齐时该页一定在位图内
+    }
+
+    uint32_t loMask = 0x01010101u * (0xFF >> shift);              // 每字节保留右移后的有效位
+    uint32_t hiMask = 0x01010101u * (uint8_t)(0xFF << (8 - shift)); // 每字节保留左移后的有效位
+    uint8_t i       = 0;
+
+    for (; i + 4 <= len; i += 4) {
+        uint32_t l = 0, u = 0, v;
+        if (lo != NULL) {
+            memcpy(&l, lo + i, 4);
+        }
+        if (hi != NULL) {
+            memcpy(&u, hi + i, 4);
         }
+        v = ((l >> shift) & loMask) | ((u << (8 - shift)) & hiMask);
+        memcpy(row + i, &v, 4);
+    }
+
+    for (; i < len; i++) {
+        uint8_t l = lo != NULL ? lo[i] : 0;
+        uint8_t u = hi != NULL ? hi[i] : 0;
+        row[i]    = (uint8_t)((l >> shift) | (u << (8 - shift)));
+    }
+
+    return row;
+}
+
+/**
+ * @brief 在画布一页的连续列中以行掩码执行光栅操作
+ *
+ * @param dst 目标字节
+ * @param src 源字节
+ * @param srcMask 源掩码字节, 仅RASTER_OP_MASK使用
+ * @param len 列数
+ * @param pageMask 该页中允许修改的行
+ * @param rop 光栅操作类型
+ */
+static void blitSpan(uint8_t* dst, const uint8_t* src, const uint8_t* srcMask, uint8_t len, uint8_t pageMask,
+                     RasterOpEnum rop) {
+    if (pageMask == 0xFF && rop != RASTER_OP_MASK) {
+        rasterOpSpan(dst, src, len, rop); // 整页可见, 按32位字处理
+        return;
+    }
+
+    switch (rop) {
+        case RASTER_OP_COPY:
+            for (uint8_t i = 0; i < len; i++) {
+                dst[i] = (dst[i] & (uint8_t)~pageMask) | (src[i] & pageMask);
+            }
+            break;
+        case RASTER_OP_OR:
+            for (uint8_t i = 0; i < len; i++) {
+                dst[i] |= src[i] & pageMask;
+            }
+            break;
+        case RASTER_OP_AND:
+            for (uint8_t i = 0; i < len; i++) {
+                dst[i] &= src[i] | (uint8_t)~pageMask;
+            }
+            break;
+        case RASTER_OP_XOR:
+            for (uint8_t i = 0; i < len; i++) {
+                dst[i] ^= src[i] & pageMask;
+            }
+            break;
+        case RASTER_OP_MASK:
+            for (uint8_t i = 0; i < len; i++) {
+                uint8_t m = srcMask[i] & pageMask;
+                dst[i]    = (dst[i] & (uint8_t)~m) | (src[i] & m);
+            }
+            break;
     }
 }
 
 /**
  * @brief 在图形缓冲区中在一定范围内居中打印字符串
  *
- * @param buffer 图形缓冲区
+ * @param canvas 图形缓冲区
+ * @param font 字体
  * @param str 要打印的字符串
  * @param startX // 打印起始X坐标
  * @param startY // 打印起始Y坐标
  * @param endX // 打印结束X坐标
  * @param endY // 打印结束Y坐标
- * @note 字符串会在指定范围内水平和垂直居中对齐
+ * @return RectParamTypeDef 字形实际覆盖的区域(包含边界), 未绘制任何字形时x0 > x1
+ * @note 1. 字符串会在指定范围内水平和垂直居中对齐, 字形单元底部对齐
+ *       2. 宽度按有墨迹字形的前进量与字距调整之和测量, 空格只移动光标; 高度取各字形框的最大值
  */
-void printStringOnBuffer(uint8_t buffer[PAGE][WIDTH], const char* str, uint8_t startX, uint8_t startY, uint8_t endX,
-                         uint8_t endY) {
+RectParamTypeDef printStringOnBuffer(const CanvasTypeDef* canvas, const FontFaceTypeDef* font, const char* str,
+                                     uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY) {
+    const FontGlyphTypeDef* run[GLYPH_RUN_MAX]; // 查表后的字形序列, 测量和绘制共用
+    int8_t kern[GLYPH_RUN_MAX];                 // 各字形与前一字形之间的字距调整
+    uint8_t runLen      = 0;
+    uint8_t prevChar    = 0;
     uint8_t totalWidth  = 0; // 当前字符串总宽度
     uint8_t totalHeight = 0; // 当前字符串总高度
-    for (uint8_t i = 0; str[i] != '\0'; i++) {
-        for (uint8_t j = 0; j < sizeof(font) / sizeof(FontTypeDef); j++) {
-            if (str[i] == font[j].character) {
-                totalWidth += font[j].width; // 累加字符宽度
-                if (font[j].height > totalHeight) {
-                    totalHeight = font[j].height; // 更新总高度
-                }
-                break;
+
+    for (uint8_t i = 0; str[i] != '\0' && runLen < GLYPH_RUN_MAX; i++) {
+        uint8_t code  = (uint8_t)str[i];
+        uint8_t index = code >= font->firstChar && code <= font->lastChar ? font->index[code - font->firstChar]
+                                                                          : FONT_GLYPH_NONE;
+        if (index == FONT_GLYPH_NONE) {
+            continue; // 字体中没有的字符直接跳过
+        }
+
+        const FontGlyphTypeDef* glyph = &font->glyph[index];
+
+        kern[runLen]  = runLen > 0 && font->kernCount > 0 ? fontKerning(font, prevChar, code) : 0;
+        run[runLen++] = glyph;
+        prevChar      = code;
+
+        if (glyph->width > 0) {
+            totalWidth += glyph->advance + kern[runLen - 1]; // 累加字符宽度
+            if (glyph->height > totalHeight) {
+                totalHeight = glyph->height; // 更新总高度
             }
         }
     }
@@ -378,67 +1140,175 @@ void printStringOnBuffer(uint8_t buffer[PAGE][WIDTH], const char* str, uint8_t s
         offsetY = (startY - endY - totalHeight) / 2; // 垂直居中
     }
 
-    uint8_t cursor = startX + offsetX;
-    uint8_t charY  = startY - offsetY; // 字符的起始Y坐标
+    int16_t cursor        = startX + offsetX;
+    uint8_t charY         = startY - offsetY;             // 字形单元底部的下一行
+    RectParamTypeDef clip = canvasClip(canvas);           // 裁剪矩形, 各字形共用
+    RectParamTypeDef area = {canvas->width - 1, 0, 0, 0}; // 字形覆盖区域, 初始为空
+    GlyphRowTypeDef row;                                  // 各字形共用的目标页和行掩码
+    uint8_t visible = glyphRowInit(&row, canvas, &clip, font, charY);
+
+    for (uint8_t i = 0; i < runLen && visible; i++) {
+        cursor += kern[i];
+        if (drawGlyph(&row, &clip, font, cursor, run[i])) {
+            int16_t left  = cursor + run[i]->xOffset;
+            int16_t right = left + run[i]->width - 1;
+            if (left < area.x0) {
+                area.x0 = left > 0 ? left : 0;
+            }
+            area.x1 = right < canvas->width ? right : canvas->width - 1;
+        }
+        cursor += run[i]->advance; // 更新光标位置
+    }
+
+    // 字形占据charY之上的一个字形单元
+    area.y0 = charY > font->height ? charY - font->height : 0;
+    area.y1 = charY - 1;
+
+    if (area.x0 > area.x1 || charY == 0 || !clipArea(&clip, &area)) {
+        area.x0 = 1;
+        area.x1 = 0;
+        return area; // 没有可见的字形
+    }
+
+    markDirtyArea(canvas, area.x0, area.y0, area.x1, area.y1);
+
+    return area;
+}
 
-    for (uint8_t i = 0; str[i] != '\0'; i++) {
-        if (str[i] == ' ') {
-            cursor += 4; // 空格宽度为4
-            continue;    // 跳过空格
+
+/**
+ * @brief 查找两个字符之间的字距调整量
+ *
+ * @param font 字体
+ * @param left 左侧字符
+ * @param right 右侧字符
+ * @return int8_t 光标调整量, 没有对应的调整对时为0
+ * @note 调整对按(left, right)升序排列, 二分查找
+ */
+static int8_t fontKerning(const FontFaceTypeDef* font, uint8_t left, uint8_t right) {
+    uint16_t key = (left << 8) | right;
+    uint8_t low  = 0;
+    uint8_t high = font->kernCount;
+
+    while (low < high) {
+        uint8_t mid     = (low + high) >> 1;
+        uint16_t midKey = (font->kern[mid].left << 8) | font->kern[mid].right;
+
+        if (midKey == key) {
+            return font->kern[mid].adjust;
         }
-        for (uint8_t j = 0; j < sizeof(font) / sizeof(FontTypeDef); j++) {
-            if (str[i] == font[j].character) {
-                // 计算字符在缓冲区中的起始位置
-                // 打印字符到缓冲区
-                printCharOnBuffer(cursor, charY, font[j].fontByte, buffer);
-                cursor += font[j].width; // 更新光标位置
-                break;
-            }
+        if (midKey < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
+
+    return 0;
 }
 
 
 /**
- * @brief 在图形缓冲区中打印单个字符
+ * @brief 求出一行字形共用的目标页和行掩码
  *
- * @param x 左下角X坐标
- * @param y 左下角Y坐标
- * @param fontByte 字符对应的字模数据
- * @param buffer 图形缓冲区
+ * @param row 返回的目标页和行掩码
+ * @param canvas 画布
+ * @param clip 已与画布求交的裁剪矩形
+ * @param font 字体
+ * @param y 字形单元底部的下一行
+ * @return uint8_t 字形单元是否有行落在裁剪矩形内
+ * @note 字形单元顶部的页内偏移决定所用的预移位位图, 预移位后每列覆盖单元顶部所在页及其下BITMAP_PAGES(height)页,
+ *       其中与画布和裁剪矩形相交的页是连续的, 记为first~last
  */
-void printCharOnBuffer(uint8_t x, uint8_t y, const uint8_t fontByte[16], uint8_t buffer[8][128]) {
-    if (x > 120 || y > 63) {
-        return; // 越界检查
-	}
+static uint8_t glyphRowInit(GlyphRowTypeDef* row, const CanvasTypeDef* canvas, const RectParamTypeDef* clip,
+                            const FontFaceTypeDef* font, uint8_t y) {
+    int16_t top       = (int16_t)y - font->height + FONT_MAX_HEIGHT; // 单元顶部所在行, 偏移后不为负
+    int8_t page       = (top >> 3) - (FONT_MAX_HEIGHT >> 3);          // 单元顶部所在页, 可为负
+    uint8_t pageCount = BITMAP_PAGES(canvas->height);
+
+    row->span  = BITMAP_PAGES(font->height) + 1;
+    row->shift = top & 7;
+    row->first = row->span;
+    row->last  = 0;
+
+    for (uint8_t j = 0; j < row->span; j++) {
+        int8_t p = page + j;
+        if (p < canvas->firstPage || p >= canvas->firstPage + pageCount) {
+            continue; // 页在画布之外
+        }
+        row->mask[j] = clipPageMask(clip, p);
+        if (row->mask[j] == 0) {
+            continue; // 页在裁剪矩形之外
+        }
+        row->dst[j] = CANVAS_PAGE(canvas, p);
+        row->first  = j < row->first ? j : row->first;
+        row->last   = j;
+    }
 
-    uint8_t page      = y / 8;     // 起始页（从下往上）
-    uint8_t bitOffset = 8 - y % 8; // 像素行偏移（不为0说明跨页）
+    return row->first <= row->last;
+}
 
-    for (uint8_t i = 0; i < 8; i++) {    // 字符列数 = 8
-        uint8_t lower = fontByte[i];     // 字模下半部分（低位）
-        uint8_t upper = fontByte[i + 8]; // 字模上半部分（高位）
 
-        // 合成到页 buffer 中（注意跨页处理）
-        if (bitOffset == 0) {
-            // 恰好对齐页边界
-            buffer[page - 1][x + i] |= lower;
-            if (page - 2 >= 0) {
-                buffer[page - 2][x + i] |= upper;
-            }
-        } else {
-            // 跨页，需要移位叠加
-            uint8_t lowerShifted = lower >> bitOffset;
-            uint8_t upperShifted = (upper >> bitOffset) | (lower << (8 - bitOffset));
-            uint8_t top          = upper << (8 - bitOffset);
-
-            buffer[page][x + i] |= lowerShifted;
-            buffer[page - 1][x + i] |= upperShifted;
-            if (page - 2 >= 0) {
-                buffer[page - 2][x + i] |= top;
+/**
+ * @brief 在图形缓冲区中绘制单个字形
+ *
+ * @param row 本行字形共用的目标页和行掩码
+ * @param clip 已与画布求交的裁剪矩形
+ * @param font 字体
+ * @param x 光标X坐标, 位图从x + xOffset列开始
+ * @param glyph 字形
+ * @return uint8_t 是否有列落在裁剪矩形内
+ * @note 按单元顶部的页内偏移取预移位位图, 每列只需把各页的字节与行掩码相与后或入, 不再逐列拼接和移位.
+ *       行方向的裁剪已在glyphRowInit中求出, 这里只裁剪列
+ */
+static inline uint8_t drawGlyph(const GlyphRowTypeDef* row, const RectParamTypeDef* clip, const FontFaceTypeDef* font,
+                                int16_t x, const FontGlyphTypeDef* glyph) {
+    x += glyph->xOffset;
+    if (glyph->width == 0 || x > clip->x1 || x + glyph->width - 1 < clip->x0) {
+        return 0; // 字形没有墨迹或完全在裁剪矩形外
+    }
+
+    uint8_t first  = x < clip->x0 ? clip->x0 - x : 0;
+    uint8_t last   = x + glyph->width - 1 > clip->x1 ? clip->x1 - x : glyph->width - 1;
+    uint8_t stride = row->span << 3; // 相邻两列预移位数据的间隔
+
+    const uint8_t* src = font->shifted + ((glyph->offset + first) * 8 + row->shift) * row->span;
+
+    if (row->first == 0 && row->last == 2) {
+        // 常见情况: 16行字体跨越的3页全部可见, 每列依次或入3页; 3页都不裁剪行时省去与行掩码相与
+        uint8_t* dst0 = row->dst[0];
+        uint8_t* dst1 = row->dst[1];
+        uint8_t* dst2 = row->dst[2];
+        uint8_t mask0 = row->mask[0];
+        uint8_t mask1 = row->mask[1];
+        uint8_t mask2 = row->mask[2];
+        if ((mask0 & mask1 & mask2) == 0xFF) {
+            for (int16_t i = x + first; i <= x + last; i++, src += stride) {
+                dst0[i] |= src[0];
+                dst1[i] |= src[1];
+                dst2[i] |= src[2];
             }
+            return 1;
+        }
+        for (int16_t i = x + first; i <= x + last; i++, src += stride) {
+            dst0[i] |= src[0] & mask0;
+            dst1[i] |= src[1] & mask1;
+            dst2[i] |= src[2] & mask2;
         }
+        return 1;
     }
+
+    for (uint8_t j = row->first; j <= row->last; j++) {
+        uint8_t* dst         = row->dst[j];
+        uint8_t mask         = row->mask[j];
+        const uint8_t* bytes = src + j;
+
+        for (uint8_t i = first; i <= last; i++, bytes += stride) {
+            dst[x + i] |= *bytes & mask;
+        }
+    }
+
+    return 1;
 }
 
 
@@ -455,88 +1325,58 @@ void printCharOnBuffer(uint8_t x, uint8_t y, const uint8_t fontByte[16], uint8_t
  * @param ey1 结束矩形右下角Y坐标
  * @param progress 动画进度 [0, 1]，0表示起始状态，1表示结束状态
  * @return RectParamTypeDef
+ * @note 进度转换为Q15后全程定点计算: 位置缓动 0.5 * (1 - cos(PI * t)), 尺寸缩放 0.8 + 0.2 * cos(2PI * t),
+ *       坐标以Q8表示, 结果与浮点实现相差不超过1像素
  */
-RectParamTypeDef animateMovingResizingRect(uint8_t sx0, uint8_t sy0, uint8_t sx1, uint8_t sy1, uint8_t ex0, uint8_t ey0,
-                                           uint8_t ex1, uint8_t ey1, float progress) {
+static RectParamTypeDef animateMovingResizingRect(uint8_t sx0, uint8_t sy0, uint8_t sx1, uint8_t sy1, uint8_t ex0,
+                                                  uint8_t ey0, uint8_t ex1, uint8_t ey1, float progress) {
     RectParamTypeDef r;
-
-    // 限制进度在 [0,1]
-    if (progress < 0.0f)
-        progress = 0.0f;
-    if (progress > 1.0f)
-        progress = 1.0f;
-
-    // 平滑位置过渡（sine in-out）
-    float posFactor   = 0.5f * (1 - cosf(PI * progress));
-
-    // 尺寸缩放：1 → 0.3 → 1，最大压缩出现在 progress=0.5
-    float scaleFactor = 0.8f + 0.2f * cosf(2 * PI * progress);
-    // 范围 [0.3, 1.0]
-
-    // 起始中心和大小
-    float sx          = (sx0 + sx1) / 2.0f;
-    float sy          = (sy0 + sy1) / 2.0f;
-    float sw          = sx1 - sx0;
-    float sh          = sy1 - sy0;
-
-    // 目标中心和大小
-    float ex          = (ex0 + ex1) / 2.0f;
-    float ey          = (ey0 + ey1) / 2.0f;
-    float ew          = ex1 - ex0;
-    float eh          = ey1 - ey0;
-
-    // 当前中心位置
-    float cx          = sx + (ex - sx) * posFactor;
-    float cy          = sy + (ey - sy) * posFactor;
-
-    // 当前宽高
-    float w           = (sw + (ew - sw) * posFactor) * scaleFactor;
-    float h           = (sh + (eh - sh) * posFactor) * scaleFactor;
-
-    // 当前矩形
-    r.x0              = (uint8_t)(cx - w / 2.0f);
-    r.y0              = (uint8_t)(cy - h / 2.0f);
-    r.x1              = (uint8_t)(cx + w / 2.0f);
-    r.y1              = (uint8_t)(cy + h / 2.0f);
+    int32_t t;
+
+    // 限制进度在 [0,1], 并转换为Q15
+    if (progress <= 0.0f)
+        t = 0;
+    else if (progress >= 1.0f)
+        t = TRIG_Q15_ONE;
+    else
+        t = TRIG_FLOAT_TO_Q15(progress);
+
+    // 平滑位置过渡（sine in-out）, Q15, 二进制角度下 PI * t 即为 t
+    int32_t posFactor   = (TRIG_Q15_ONE - trigServIntf.cosQ15((uint16_t)t)) >> 1;
+
+    // 尺寸缩放：1 → 0.6 → 1，最大压缩出现在 progress=0.5, Q15
+    int32_t scaleFactor = (4 * TRIG_Q15_ONE + trigServIntf.cosQ15((uint16_t)(t << 1))) / 5;
+
+    // 起始中心(2倍)和大小
+    int32_t sx          = sx0 + sx1;
+    int32_t sy          = sy0 + sy1;
+    int32_t sw          = sx1 - sx0;
+    int32_t sh          = sy1 - sy0;
+
+    // 目标中心(2倍)和大小
+    int32_t ex          = ex0 + ex1;
+    int32_t ey          = ey0 + ey1;
+    int32_t ew          = ex1 - ex0;
+    int32_t eh          = ey1 - ey0;
+
+    // 当前中心位置(2倍), Q8
+    int32_t cx2         = (sx << 8) + (((ex - sx) * posFactor) >> 7);
+    int32_t cy2         = (sy << 8) + (((ey - sy) * posFactor) >> 7);
+
+    // 当前宽高, Q8
+    int32_t w           = (((sw << 8) + (((ew - sw) * posFactor) >> 7)) * scaleFactor) >> 15;
+    int32_t h           = (((sh << 8) + (((eh - sh) * posFactor) >> 7)) * scaleFactor) >> 15;
+
+    // 当前矩形, (2倍中心 ± 宽高) / 2 并去掉Q8小数位
+    r.x0                = (uint8_t)((cx2 - w) >> 9);
+    r.y0                = (uint8_t)((cy2 - h) >> 9);
+    r.x1                = (uint8_t)((cx2 + w) >> 9);
+    r.y1                = (uint8_t)((cy2 + h) >> 9);
 
     return r;
 }
 
 
-/**
- * @brief 点阵队列中插入新点
- *
- * @param new_y
- * @param new_x
- * @param pixelDrawCount
- */
-void insertNewPoint(uint8_t new_y, uint8_t new_x, uint8_t pixelDrawCount[HEIGHT][WIDTH]) {
-    static uint16_t count;
-    static uint16_t head = 0; // 队列头指针
-
-    // 如果队列满，删除最旧的点（从 head 出队）
-    if (count == MAX_POINTS) {
-        PointTypeDef old = points[head];
-
-        if (pixelDrawCount[old.y][old.x] > 0) {
-            pixelDrawCount[old.y][old.x]--;
-        }
-
-        head = (head + 1) % MAX_POINTS;
-        count--;
-    }
-
-    // 插入新点到 tail
-    uint16_t tail  = (head + count) % MAX_POINTS;
-    points[tail].x = new_x;
-    points[tail].y = new_y;
-    count++;
-
-    // 增加新点计数
-
-    pixelDrawCount[new_y][new_x]++;
-}
-
 /**
  * @brief 使用正弦滚动效果混合两张图像
  *
@@ -545,33 +1385,295 @@ void insertNewPoint(uint8_t new_y, uint8_t new_x, uint8_t pixelDrawCount[HEIGHT]
  * @param ratio 混合比例，范围从 0.0 到 1.0
  * @param direction 滚动方向，0 表示向左，1 表示向右
  * @param result 混合后的结果图像
+ * @note 三个画布尺寸及所在页相同, shift不超过画布宽度
  */
-static void blendImagesWithSineScroll(uint8_t imageA[PAGE][WIDTH], uint8_t imageB[PAGE][WIDTH], uint8_t shift,
-                                      uint8_t direction, uint8_t result[PAGE][WIDTH]) {
+static void blendImagesWithSineScroll(const CanvasTypeDef* imageA, const CanvasTypeDef* imageB, uint8_t shift,
+                                      uint8_t direction, const CanvasTypeDef* result) {
+    uint8_t width = result->width;
+
+    markDirtyArea(result, 0, CANVAS_TOP(result), width - 1, CANVAS_BOTTOM(result));
+
+    for (uint8_t row = result->firstPage; row < result->firstPage + BITMAP_PAGES(result->height); row++) {
+        uint8_t* dst     = CANVAS_PAGE(result, row);
+        const uint8_t* a = CANVAS_PAGE(imageA, row);
+        const uint8_t* b = CANVAS_PAGE(imageB, row);
 
-    for (uint8_t row = 0; row < PAGE; row++) {
         if (direction == 0) // 向左滑动：A 向左退，B 从右入
         {
-            uint8_t partA = WIDTH - shift;
+            uint8_t partA = width - shift;
             uint8_t partB = shift;
 
             if (partA > 0) {
-                memcpy(&result[row][0], &imageA[row][shift], partA);
+                memcpy(&dst[0], &a[shift], partA);
             }
             if (partB > 0) {
-                memcpy(&result[row][partA], &imageB[row][0], partB);
+                memcpy(&dst[partA], &b[0], partB);
             }
         } else // 向右滑动：A 向右退，B 从左入
         {
             uint8_t partB = shift;
-            uint8_t partA = WIDTH - shift;
+            uint8_t partA = width - shift;
 
             if (partB > 0) {
-                memcpy(&result[row][0], &imageB[row][WIDTH - shift], partB);
+                memcpy(&dst[0], &b[width - shift], partB);
             }
             if (partA > 0) {
-                memcpy(&result[row][partB], &imageA[row][0], partA);
+                memcpy(&dst[partB], &a[0], partA);
             }
         }
     }
 }
+
+/**
+ * @brief 为画布绑定脏页表
+ *
+ * @param canvas 页格式画布
+ * @param map 脏页表, 绑定后各绘图函数修改该画布时会同步标记脏页表
+ * @note 未绑定的画布(如图形查看用点阵)不做标记. 绑定数量超过DIRTY_BIND_MAX时忽略.
+ *       绑定关系以画布数据地址区分, 脏页表只记录前PAGE页
+ */
+static void bindDirtyMap(const CanvasTypeDef* canvas, DirtyMapTypeDef* map) {
+    for (uint8_t i = 0; i < DIRTY_BIND_MAX; i++) {
+        if (dirtyBindList[i].canvas == NULL || dirtyBindList[i].canvas == canvas->data) {
+            dirtyBindList[i].canvas = canvas->data;
+            dirtyBindList[i].map    = map;
+            clearDirtyMap(map);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 标记画布中被外部直接修改(如memcpy)的区域
+ *
+ * @param canvas 页格式画布
+ * @param area 被修改的区域(包含边界)
+ */
+static void markDirty(const CanvasTypeDef* canvas, RectParamTypeDef area) {
+    markDirtyArea(canvas, area.x0, area.y0, area.x1, area.y1);
+}
+
+/**
+ * @brief 清空脏页表
+ *
+ * @param map 脏页表
+ */
+static void clearDirtyMap(DirtyMapTypeDef* map) {
+    memset(map->x0, 0xFF, sizeof(map->x0));
+    memset(map->x1, 0x00, sizeof(map->x1));
+}
+
+/**
+ * @brief 将区域合并到画布绑定的脏页表中
+ *
+ * @param canvas 页格式画布
+ * @param x0 起始列
+ * @param y0 起始行
+ * @param x1 结束列(包含)
+ * @param y1 结束行(包含)
+ * @note 按页记录列范围, 纵向粒度为整页, 与SSD1306的页寻址一致
+ */
+static inline void markDirtyArea(const CanvasTypeDef* canvas, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    DirtyMapTypeDef* map = NULL;
+
+    for (uint8_t i = 0; i < DIRTY_BIND_MAX; i++) {
+        if (dirtyBindList[i].canvas == canvas->data) {
+            map = dirtyBindList[i].map;
+            break;
+        }
+    }
+
+    if (map == NULL || x0 > x1 || y0 > y1 || x0 >= canvas->width || y0 > CANVAS_BOTTOM(canvas) ||
+        y1 < CANVAS_TOP(canvas)) {
+        return; // 画布未绑定或区域为空
+    }
+
+    if (x1 >= canvas->width) {
+        x1 = canvas->width - 1;
+    }
+    if (y0 < CANVAS_TOP(canvas)) {
+        y0 = CANVAS_TOP(canvas);
+    }
+    if (y1 > CANVAS_BOTTOM(canvas)) {
+        y1 = CANVAS_BOTTOM(canvas);
+    }
+
+    uint8_t lastPage = (y1 >> 3) < PAGE ? (y1 >> 3) : PAGE - 1; // 脏页表按屏幕页数分配
+
+    for (uint8_t page = y0 >> 3; page <= lastPage; page++) {
+        if (x0 < map->x0[page]) {
+            map->x0[page] = x0;
+        }
+        if (x1 > map->x1[page]) {
+            map->x1[page] = x1;
+        }
+    }
+}
+
+/**
+ * @brief 清空合成器
+ *
+ * @param compositor
+ */
+static void layerInit(LayerCompositorTypeDef* compositor) { memset(compositor, 0, sizeof(LayerCompositorTypeDef)); }
+
+/**
+ * @brief 在最上方添加图层
+ *
+ * @param compositor
+ * @param canvas 图层内容, 须覆盖整个屏幕
+ * @param rop 与下方图层合成的光栅操作; 静态和动态图层使用RASTER_OP_OR, 高亮等覆盖图层使用RASTER_OP_XOR
+ * @return uint8_t 图层序号, 图层已满或画布不是屏幕尺寸时返回LAYER_MAX
+ * @note 新图层的所有页标记为已修改
+ */
+static uint8_t layerAdd(LayerCompositorTypeDef* compositor, const CanvasTypeDef* canvas, RasterOpEnum rop) {
+    if (compositor->count >= LAYER_MAX || !CANVAS_COVERS_SCREEN(canvas)) {
+        return LAYER_MAX;
+    }
+
+    LayerTypeDef* layer = &compositor->layer[compositor->count];
+    layer->canvas       = canvas;
+    layer->rop          = rop;
+    layer->dirty        = 0xFF;
+
+    return compositor->count++;
+}
+
+/**
+ * @brief 标记图层中被修改的区域
+ *
+ * @param compositor
+ * @param index 图层序号
+ * @param area 被修改的区域(包含边界), 按所在的页记录
+ */
+static void layerMarkDirty(LayerCompositorTypeDef* compositor, uint8_t index, RectParamTypeDef area) {
+    if (index >= compositor->count || area.y0 > area.y1 || area.y0 >= HEIGHT) {
+        return;
+    }
+
+    uint8_t lastPage = (area.y1 < HEIGHT ? area.y1 : HEIGHT - 1) >> 3;
+    for (uint8_t page = area.y0 >> 3; page <= lastPage; page++) {
+        compositor->layer[index].dirty |= 1 << page;
+    }
+}
+
+/**
+ * @brief 标记合成目标被合成器之外的绘制覆盖
+ *
+ * @param compositor
+ * @param target 合成目标序号
+ */
+static void layerInvalidateTarget(LayerCompositorTypeDef* compositor, uint8_t target) {
+    if (target < LAYER_TARGET_MAX) {
+        compositor->stale[target] = 0xFF;
+    }
+}
+
+/**
+ * @brief 将过期的页合成到目标缓冲区
+ *
+ * @param compositor
+ * @param target 合成目标序号, 双缓冲时为缓冲区索引
+ * @param dst 目标缓冲区, 须覆盖整个屏幕
+ * @note 1. 合成的页为该目标过期的页与各图层自上次合成以来被修改的页之并; 各图层的修改并入其他目标的过期页后清除,
+ *          双缓冲交替合成时另一缓冲区在下次合成时补上这些页
+ *       2. 每页先复制最底层, 再逐层以32位字执行该层的光栅操作, 不受裁剪矩形限制
+ */
+static void layerCompose(LayerCompositorTypeDef* compositor, uint8_t target, const CanvasTypeDef* dst) {
+    if (target >= LAYER_TARGET_MAX || compositor->count == 0 || !CANVAS_COVERS_SCREEN(dst)) {
+        return;
+    }
+
+    uint8_t changed = 0;
+    for (uint8_t i = 0; i < compositor->count; i++) {
+        changed |= compositor->layer[i].dirty;
+        compositor->layer[i].dirty = 0;
+    }
+    for (uint8_t t = 0; t < LAYER_TARGET_MAX; t++) {
+        compositor->stale[t] |= changed;
+    }
+
+    uint8_t pages             = compositor->stale[target];
+    compositor->stale[target] = 0;
+
+    for (uint8_t page = 0; page < PAGE; page++) {
+        if (!(pages & (1 << page))) {
+            continue;
+        }
+
+        uint8_t* to = CANVAS_PAGE(dst, page);
+        memcpy(to, CANVAS_PAGE(compositor->layer[0].canvas, page), WIDTH);
+        for (uint8_t i = 1; i < compositor->count; i++) {
+            rasterOpSpan(to, CANVAS_PAGE(compositor->layer[i].canvas, page), WIDTH, compositor->layer[i].rop);
+        }
+
+        markDirtyArea(dst, 0, page << 3, WIDTH - 1, (page << 3) | 7);
+    }
+}
+
+/**
+ * @brief 设置裁剪矩形, 之后所有绘图函数只修改裁剪矩形内的像素
+ *
+ * @param clip 裁剪矩形(包含边界), 绘制时再与目标画布求交; x0 > x1 或 y0 > y1 时不绘制任何内容
+ */
+static void setClipRect(RectParamTypeDef clip) { clipRect = clip; }
+
+/**
+ * @brief 取消裁剪, 恢复为整个目标画布
+ *
+ */
+static void resetClipRect(void) { clipRect = CLIP_RECT_NONE; }
+
+/**
+ * @brief 获取本次绘制的有效裁剪矩形
+ *
+ * @param canvas 目标画布, 宽高不为0
+ * @return RectParamTypeDef 裁剪矩形与画布的交集, 为空时x0 > x1或y0 > y1
+ * @note 屏幕尺寸的画布由CANVAS_DISPATCH以常量尺寸传入时, 比较在编译期折叠
+ */
+static inline RectParamTypeDef canvasClip(const CanvasTypeDef* canvas) {
+    RectParamTypeDef clip = clipRect;
+
+    clip.y0 = clip.y0 > CANVAS_TOP(canvas) ? clip.y0 : CANVAS_TOP(canvas);
+    clip.x1 = clip.x1 < canvas->width - 1 ? clip.x1 : canvas->width - 1;
+    clip.y1 = clip.y1 < CANVAS_BOTTOM(canvas) ? clip.y1 : CANVAS_BOTTOM(canvas);
+
+    return clip;
+}
+
+/**
+ * @brief 将区域与裁剪矩形求交集
+ *
+ * @param clip 裁剪矩形
+ * @param area 区域(包含边界), 返回时被截取
+ * @return uint8_t 交集非空时返回1
+ */
+static inline uint8_t clipArea(const RectParamTypeDef* clip, RectParamTypeDef* area) {
+    area->x0 = area->x0 > clip->x0 ? area->x0 : clip->x0;
+    area->y0 = area->y0 > clip->y0 ? area->y0 : clip->y0;
+    area->x1 = area->x1 < clip->x1 ? area->x1 : clip->x1;
+    area->y1 = area->y1 < clip->y1 ? area->y1 : clip->y1;
+
+    return area->x0 <= area->x1 && area->y0 <= area->y1;
+}
+
+/**
+ * @brief 获取裁剪矩形在某一页中覆盖的行掩码
+ *
+ * @param clip 裁剪矩形
+ * @param page 页号
+ * @return uint8_t 行掩码, bit0对应该页最上方一行
+ */
+static inline uint8_t clipPageMask(const RectParamTypeDef* clip, uint8_t page) {
+    uint8_t top    = page << 3;
+    uint8_t bottom = top + 7;
+
+    if (clip->y0 > bottom || clip->y1 < top || clip->x0 > clip->x1) {
+        return 0;
+    }
+
+    top    = clip->y0 > top ? clip->y0 : top;
+    bottom = clip->y1 < bottom ? clip->y1 : bottom;
+
+    return (uint8_t)((0xFF << (top & 7)) & (0xFF >> (7 - (bottom & 7))));
+}
@@ -41,9 +41,24 @@
 #ifndef PAGE
 #define PAGE (HEIGHT / 8)
 #endif /* PAGE */
+#ifndef FONT_MAX_HEIGHT
+#define FONT_MAX_HEIGHT 24 // 字形单元的最大行数, 一列移位后仍可放入32位整数
+#endif /* FONT_MAX_HEIGHT */
+#ifndef FONT_GLYPH_NONE
+#define FONT_GLYPH_NONE 0xFF // 字体索引表中的无效项
+#endif /* FONT_GLYPH_NONE */
 #ifndef PI
 #define PI 3.14159265358979323846f
 #endif /* PI */
+#ifndef LAYER_MAX
+#define LAYER_MAX 4 // 图层合成器的最大图层数
+#endif /* LAYER_MAX */
+#ifndef LAYER_TARGET_MAX
+#define LAYER_TARGET_MAX 2 // 图层合成器的最大合成目标数(双缓冲)
+#endif /* LAYER_TARGET_MAX */
+#ifndef STRIP_RENDER
+#define STRIP_RENDER 0 // 1: 页带渲染, 画面以显示列表逐页渲染并发送, 不保留整帧图形缓冲区
+#endif /* STRIP_RENDER */
 
 
 
@@ -52,12 +67,44 @@
 
 
 
+typedef uint8_t PageCanvasTypeDef[PAGE][WIDTH]; // 屏幕尺寸页格式画布的存储(1bpp, 与SSD1306显存布局一致, 共1KB)
+
+// 页格式画布, 第page页第x列的字节为data[(page - firstPage) * stride + x], bit0为该页最上方一行.
+// 坐标均为屏幕坐标, 画布覆盖第firstPage * 8行起的height行; 页带画布只覆盖屏幕中的一页
+typedef struct {
+    uint8_t* data;     // 画布数据
+    uint8_t width;     // 宽度(列数)
+    uint8_t height;    // 高度(行数), 共BITMAP_PAGES(height)页
+    uint16_t stride;   // 相邻两页同一列之间的字节数, 不小于width
+    uint8_t firstPage; // 画布第一页在屏幕中的页号, 整幅画布为0
+} CanvasTypeDef;
+
+typedef struct {
+    uint16_t offset; // 首列在字体位图中的列号
+    uint8_t width;   // 位图列数, 0表示没有墨迹(如空格)
+    uint8_t height;  // 字形框顶部到字形单元底部的行数, 用于垂直居中
+    uint8_t advance; // 光标前进量
+    int8_t xOffset;  // 位图首列相对光标的列偏移
+} FontGlyphTypeDef;  // 字形类型定义
+
+typedef struct {
+    uint8_t left;   // 左侧字符
+    uint8_t right;  // 右侧字符
+    int8_t adjust;  // 两字符之间的光标调整量
+} FontKernTypeDef; // 字距调整对类型定义
+
+// 页格式比例字体, 由Tools/bdf2font.py从BDF字体生成
 typedef struct {
-    uint16_t character;
-    uint8_t height;
-    uint8_t width;
-    uint8_t* fontByte;
-} FontTypeDef;
+    uint8_t height;                // 字形单元行数, 不超过FONT_MAX_HEIGHT
+    uint8_t firstChar;             // 字体覆盖的最小字符编码
+    uint8_t lastChar;              // 字体覆盖的最大字符编码
+    uint8_t kernCount;             // 字距调整对数量
+    const uint8_t* index;          // 字符编码减去firstChar得到字形序号, FONT_GLYPH_NONE表示没有该字符
+    const FontGlyphTypeDef* glyph; // 字形表
+    const uint8_t* bitmap;         // 字形位图, 按列排列, 每列BITMAP_PAGES(height)字节, bit0为字形单元最上方一行
+    const uint8_t* shifted;        // 预移位位图, 每列按单元顶部页内偏移0~7各存BITMAP_PAGES(height) + 1字节
+    const FontKernTypeDef* kern;   // 字距调整对, 按(left, right)升序排列
+} FontFaceTypeDef;
 
 typedef struct {
     uint8_t x0;
@@ -71,24 +118,81 @@ typedef struct {
     uint8_t y;
 } PointTypeDef; // 点类型定义
 
+typedef enum {
+    RASTER_OP_COPY, // dst = src
+    RASTER_OP_OR,   // dst |= src
+    RASTER_OP_AND,  // dst &= src
+    RASTER_OP_XOR,  // dst ^= src
+    RASTER_OP_MASK, // dst = (dst & ~mask) | (src & mask), 仅blit支持, 位图后紧跟同尺寸的掩码平面
+} RasterOpEnum;     // 光栅操作类型定义
+
+typedef struct {
+    uint8_t x0[PAGE]; // 各页被修改的起始列
+    uint8_t x1[PAGE]; // 各页被修改的结束列(包含), x0 > x1 表示该页未被修改
+} DirtyMapTypeDef;    // 脏页表类型定义
+
+// 合成图层, 内容为屏幕尺寸的连续画布
+typedef struct {
+    const CanvasTypeDef* canvas; // 图层内容
+    RasterOpEnum rop;            // 与下方图层合成的光栅操作, 最底层总是复制
+    uint8_t dirty;               // 自上次合成以来被修改的页, 第n位对应第n页
+} LayerTypeDef;
+
+// 图层合成器, 自底向上逐层合成到目标缓冲区
 typedef struct {
-    void (*drawStar)(uint8_t graphBuffer[PAGE][WIDTH]); // 绘制五角星函数
-    void (*drawRoundRect2DotMatrix)(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t startX, uint8_t startY, uint8_t endX,
-                                    uint8_t endY, uint8_t radius, uint8_t padding);        // 绘制圆角矩形到点阵图像素
-    void (*bitToByte)(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t graphBuffer[PAGE][WIDTH]); // 点阵图像素转换为字节数组
-    void (*drawStarDot)(uint8_t dotMatrix[HEIGHT][WIDTH], float centerX, float centerY, float radius); // 绘制五角星点阵
-    void (*drawLine)(uint8_t dotMatrix[HEIGHT][WIDTH], uint8_t startX, uint8_t startY, uint8_t endX,
-                     uint8_t endY);                                                        // 绘制线段
-    void (*InverBufferWithMask)(uint8_t mask[HEIGHT][WIDTH], uint8_t buffer[PAGE][WIDTH]); // 使用掩码反转缓冲区
-    uint8_t dotMatrix[HEIGHT][WIDTH];
-    void (*printStringOnBuffer)(uint8_t buffer[PAGE][WIDTH], const char* str, uint8_t startX, uint8_t startY,
-                                uint8_t endX, uint8_t endY); // 点阵图
+    LayerTypeDef layer[LAYER_MAX];   // 自底向上排列的图层
+    uint8_t count;                   // 图层数量
+    uint8_t stale[LAYER_TARGET_MAX]; // 各合成目标中内容过期的页, 第n位对应第n页
+} LayerCompositorTypeDef;
+
+typedef struct {
+    void (*drawStar)(const CanvasTypeDef* canvas); // 绘制五角星函数
+    void (*drawRoundRect2DotMatrix)(const CanvasTypeDef* canvas, uint8_t startX, uint8_t startY, uint8_t endX,
+                                    uint8_t endY, uint8_t radius, uint8_t padding);         // 绘制圆角矩形到画布
+    void (*bitToByte)(const uint8_t* dotMatrix, const CanvasTypeDef* graphBuffer);          // 字节点阵图转换为页格式
+    void (*drawStarDot)(const CanvasTypeDef* canvas, uint8_t centerX, uint8_t centerY, uint8_t radius); // 绘制五角星
+    void (*drawLine)(const CanvasTypeDef* canvas, uint8_t startX, uint8_t startY, uint8_t endX,
+                     uint8_t endY);                                                         // 绘制线段
+    void (*drawPolyline)(const CanvasTypeDef* canvas, const PointTypeDef* points, uint16_t count); // 依次连接各点
+    void (*InverBufferWithMask)(const CanvasTypeDef* mask, const CanvasTypeDef* buffer,
+                                RectParamTypeDef area); // 使用掩码反转缓冲区
+    void (*rasterOp)(const CanvasTypeDef* dst, const CanvasTypeDef* src, RectParamTypeDef area,
+                     RasterOpEnum rop); // 区域内按页进行光栅操作
+    void (*copyRect)(const CanvasTypeDef* dst, const CanvasTypeDef* src,
+                     RectParamTypeDef area); // 按像素行精确复制矩形区域
+    void (*blit)(const CanvasTypeDef* canvas, int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bitmap,
+                 RasterOpEnum rop); // 以光栅操作将页格式位图绘制到任意像素位置
+    void (*fillRoundRect)(const CanvasTypeDef* canvas, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                          uint8_t radius, RasterOpEnum rop); // 按列跨度填充或反转实心圆角矩形
+    void (*fillColumnSpans)(const CanvasTypeDef* canvas, uint8_t x, uint8_t count, const uint8_t* top,
+                            const uint8_t* bottom); // 逐列点亮竖直跨度
+    void (*drawGraticule)(const CanvasTypeDef* canvas, RectParamTypeDef area, uint8_t division,
+                          uint8_t dot); // 在区域内绘制点线网格刻度
+    RectParamTypeDef (*printStringOnBuffer)(const CanvasTypeDef* canvas, const FontFaceTypeDef* font, const char* str,
+                                            uint8_t startX, uint8_t startY, uint8_t endX,
+                                            uint8_t endY); // 以指定字体打印字符串, 返回覆盖区域
     RectParamTypeDef (*animateMovingResizingRect)(uint8_t sx0, uint8_t sy0, uint8_t sx1, uint8_t sy1, uint8_t ex0,
                                                   uint8_t ey0, uint8_t ex1, uint8_t ey1, float progress);
 
-    void (*insertNewPoint)(uint8_t new_x, uint8_t new_y, uint8_t pixelDrawCount[HEIGHT][WIDTH]); // 插入新点到队列
-    void (*blendImagesWithSineScroll)(uint8_t imageA[PAGE][WIDTH], uint8_t imageB[PAGE][WIDTH], uint8_t shift,
-                                      uint8_t direction, uint8_t result[PAGE][WIDTH]);
+    void (*blendImagesWithSineScroll)(const CanvasTypeDef* imageA, const CanvasTypeDef* imageB, uint8_t shift,
+                                      uint8_t direction, const CanvasTypeDef* result);
+
+    void (*bindDirtyMap)(const CanvasTypeDef* canvas, DirtyMapTypeDef* map); // 为画布绑定脏页表
+    void (*markDirty)(const CanvasTypeDef* canvas, RectParamTypeDef area);   // 标记画布中被外部直接修改的区域
+    void (*clearDirtyMap)(DirtyMapTypeDef* map);                             // 清空脏页表
+
+    void (*layerInit)(LayerCompositorTypeDef* compositor); // 清空合成器
+    uint8_t (*layerAdd)(LayerCompositorTypeDef* compositor, const CanvasTypeDef* canvas,
+                        RasterOpEnum rop); // 在最上方添加图层, 返回图层序号
+    void (*layerMarkDirty)(LayerCompositorTypeDef* compositor, uint8_t index,
+                           RectParamTypeDef area); // 标记图层中被修改的区域
+    void (*layerInvalidateTarget)(LayerCompositorTypeDef* compositor,
+                                  uint8_t target); // 标记合成目标被其他绘制覆盖, 下次整体合成
+    void (*layerCompose)(LayerCompositorTypeDef* compositor, uint8_t target,
+                         const CanvasTypeDef* dst); // 将过期的页合成到目标缓冲区
+
+    void (*setClipRect)(RectParamTypeDef clip); // 设置裁剪矩形, 所有绘图函数只修改其中的像素
+    void (*resetClipRect)(void);                // 恢复裁剪矩形为整个画布
 
 } GraphServIntfTypeDef;
 
@@ -101,6 +205,36 @@ typedef struct {
 #define MAP_ADC_TO_OLED_X(x) (x * 55 / 4095 + 36) // 将ADC值映射到OLED X坐标范围
 #define MAP_ADC_TO_OLED_Y(y) (y * 55 / 4095 + 4)  // 将ADC值映射到OLED Y坐标范围
 
+// 以二维页数组uint8_t array[pages][columns]构造画布
+#define CANVAS_FROM_ARRAY(array)                                                                                       \
+    ((CanvasTypeDef){(uint8_t*)(array), sizeof((array)[0]), sizeof(array) / sizeof((array)[0]) * 8,                    \
+                     sizeof((array)[0]), 0})
+
+// 以一页WIDTH字节的存储构造覆盖屏幕第page页的页带画布
+#define CANVAS_STRIP(strip, page) ((CanvasTypeDef){(uint8_t*)(strip), WIDTH, 8, WIDTH, (page)})
+
+#define CANVAS_IS_SCREEN(canvas)                                                                                       \
+    ((canvas)->width == WIDTH && (canvas)->height == HEIGHT && (canvas)->stride == WIDTH &&                            \
+     (canvas)->firstPage == 0) // 是否为屏幕尺寸的连续画布
+#define CANVAS_COVERS_SCREEN(canvas)                                                                                   \
+    ((canvas)->width == WIDTH && (canvas)->height == HEIGHT &&                                                         \
+     (canvas)->firstPage == 0) // 是否为覆盖整个屏幕的画布, 页间可有间隔
+#define CANVAS_PAGE(canvas, page)                                                                                      \
+    ((canvas)->data + (uint16_t)((page) - (canvas)->firstPage) * (canvas)->stride) // 画布中屏幕第page页第0列的地址
+
+#define CANVAS_SET_PIXEL(canvas, x, y) (CANVAS_PAGE(canvas, (y) >> 3)[(x)] |= (uint8_t)(1 << ((y) & 7)))  // 点亮像素
+#define CANVAS_CLR_PIXEL(canvas, x, y) (CANVAS_PAGE(canvas, (y) >> 3)[(x)] &= (uint8_t)~(1 << ((y) & 7))) // 熄灭像素
+#define CANVAS_GET_PIXEL(canvas, x, y) ((CANVAS_PAGE(canvas, (y) >> 3)[(x)] >> ((y) & 7)) & 1)            // 读取像素
+
+#define CANVAS_TOP(canvas)    ((uint8_t)((canvas)->firstPage << 3))                  // 画布第一行在屏幕中的行号
+#define CANVAS_BOTTOM(canvas) ((uint8_t)(CANVAS_TOP(canvas) + (canvas)->height - 1)) // 画布最后一行在屏幕中的行号
+#define CANVAS_AREA(canvas)                                                                                            \
+    ((RectParamTypeDef){0, CANVAS_TOP(canvas), (canvas)->width - 1, CANVAS_BOTTOM(canvas)}) // 整个画布区域
+
+#define CANVAS_FULL_AREA          ((RectParamTypeDef){0, 0, WIDTH - 1, HEIGHT - 1}) // 整个屏幕区域
+#define DIRTY_PAGE_CLEAN(map, page) ((map)->x0[page] > (map)->x1[page])            // 判断脏页表中某页是否未被修改
+#define BITMAP_PAGES(h)             (((h) + 7) >> 3)                               // 高度为h的页格式位图的页数
+
 
 
 
@@ -108,6 +242,9 @@ typedef struct {
 
 extern GraphServIntfTypeDef graphServIntf;
 
+extern const FontFaceTypeDef fontUI16; // 参数界面数值字体, 16行字形单元
+extern const FontFaceTypeDef fontUI8;  // 5x7小字体, 8行字形单元
+
 
 
 
@@ -0,0 +1,150 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : image-service.c
+ * @brief          : 压缩图像资源服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 按页RLE解码: 游程以memset写入, 原样输出段以memcpy写入, 区域外的数据只解析不写入
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "image-service.h"
+#include <string.h>
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- function prototypes ---------------------------------------------------------------------------------------*/
+
+static void decode(const CanvasTypeDef* canvas, const ImageAssetTypeDef* asset, uint8_t x, uint8_t page,
+                   RectParamTypeDef area);
+static void writeSpan(uint8_t* dst, const uint8_t* src, uint8_t value, uint8_t len, uint8_t mask);
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+ImageServIntfTypeDef imageServIntf = {
+    .decode = decode,
+};
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 将压缩图像解码到画布
+ *
+ * @param canvas 目标画布
+ * @param asset 图像资源
+ * @param x 图像左上角在画布中的列
+ * @param page 图像第一页在屏幕中的页号
+ * @param area 画布中允许写入的区域(包含边界), 传入CANVAS_AREA(canvas)解码整幅图像
+ * @note 1. 只解码与area相交的页, 由pageIndex直接定位到该页数据
+ *       2. area上下边界所在的页只替换区域内的行, 与graphServIntf.copyRect一致
+ *       3. 写入区域已标记到画布的脏页表
+ */
+static void decode(const CanvasTypeDef* canvas, const ImageAssetTypeDef* asset, uint8_t x, uint8_t page,
+                   RectParamTypeDef area) {
+    uint16_t right  = x + asset->width - 1;
+    uint16_t bottom = ((page + BITMAP_PAGES(asset->height)) << 3) - 1;
+
+    // 区域与图像及画布求交
+    area.x0 = area.x0 > x ? area.x0 : x;
+    area.y0 = area.y0 > (page << 3) ? area.y0 : (page << 3);
+    area.x1 = area.x1 < right ? area.x1 : right;
+    area.y1 = area.y1 < bottom ? area.y1 : bottom;
+    area.y0 = area.y0 > CANVAS_TOP(canvas) ? area.y0 : CANVAS_TOP(canvas);
+    area.x1 = area.x1 < canvas->width - 1 ? area.x1 : canvas->width - 1;
+    area.y1 = area.y1 < CANVAS_BOTTOM(canvas) ? area.y1 : CANVAS_BOTTOM(canvas);
+
+    if (area.x0 > area.x1 || area.y0 > area.y1) {
+        return; // 图像与区域不相交
+    }
+
+    graphServIntf.markDirty(canvas, area);
+
+    uint8_t first = area.x0 - x; // 图像中第一个写入的列
+    uint8_t last  = area.x1 - x; // 图像中最后一个写入的列
+
+    for (uint8_t dstPage = area.y0 >> 3; dstPage <= (area.y1 >> 3); dstPage++) {
+        uint8_t top         = dstPage == (area.y0 >> 3) ? (area.y0 & 7) : 0;
+        uint8_t end         = dstPage == (area.y1 >> 3) ? (area.y1 & 7) : 7;
+        uint8_t mask        = (uint8_t)((0xFF << top) & (0xFF >> (7 - end)));
+        const uint8_t* data = asset->data + asset->pageIndex[dstPage - page];
+        uint8_t* dst        = CANVAS_PAGE(canvas, dstPage) + x;
+        uint16_t col        = 0; // 当前控制字节对应的起始列
+
+        while (col <= last) {
+            uint8_t ctrl     = *data++;
+            uint8_t isRun    = ctrl & IMAGE_RLE_RUN;
+            uint16_t len     = (ctrl & IMAGE_RLE_LEN_MASK) + (isRun ? IMAGE_RLE_RUN_MIN : 1);
+            uint16_t spanEnd = col + len - 1;
+
+            if (spanEnd >= first) {
+                // 该段与写入列范围的交集
+                uint8_t from = col > first ? col : first;
+                uint8_t to   = spanEnd < last ? spanEnd : last;
+
+                writeSpan(dst + from, isRun ? NULL : data + (from - col), *data, to - from + 1, mask);
+            }
+
+            data += isRun ? 1 : len;
+            col += len;
+        }
+    }
+}
+
+/**
+ * @brief 以行掩码写入一页中的连续列
+ *
+ * @param dst 目标字节
+ * @param src 原样输出段的数据, 为NULL时写入游程
+ * @param value 游程的重复字节
+ * @param len 列数
+ * @param mask 该页中允许修改的行
+ */
+static void writeSpan(uint8_t* dst, const uint8_t* src, uint8_t value, uint8_t len, uint8_t mask) {
+    if (mask == 0xFF) {
+        if (src != NULL) {
+            memcpy(dst, src, len);
+        } else {
+            memset(dst, value, len);
+        }
+        return;
+    }
+
+    for (uint8_t i = 0; i < len; i++) {
+        uint8_t byte = src != NULL ? src[i] : value;
+        dst[i]       = (dst[i] & (uint8_t)~mask) | (byte & mask);
+    }
+}
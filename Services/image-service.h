@@ -0,0 +1,81 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : image-service.h
+ * @brief          : 压缩图像资源服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 由Tools/img2rle.py生成的按页RLE压缩图像, 解码时直接写入页格式画布
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __IMAGE_SERVICE_H__
+#define __IMAGE_SERVICE_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include <stdint.h>
+
+
+
+
+/*-------- typedef ---------------------------------------------------------------------------------------------------*/
+
+// 按页RLE压缩的图像资源, 格式见Tools/img2rle.py
+typedef struct {
+    uint8_t width;             // 宽度(列)
+    uint8_t height;            // 高度(行)
+    const uint16_t* pageIndex; // 各页压缩数据在data中的起始位置, 共BITMAP_PAGES(height)项
+    const uint8_t* data;       // 按页顺序的压缩数据, 游程不跨页
+} ImageAssetTypeDef;
+
+/* 图像资源服务对外接口 */
+typedef struct {
+    void (*decode)(const CanvasTypeDef* canvas, const ImageAssetTypeDef* asset, uint8_t x, uint8_t page,
+                   RectParamTypeDef area); // 将图像解码到画布, 只写入area内的像素
+} ImageServIntfTypeDef;
+
+
+
+
+/*-------- define ----------------------------------------------------------------------------------------------------*/
+
+#define IMAGE_RLE_RUN      0x80 // 控制字节最高位为1: 重复其后一个字节
+#define IMAGE_RLE_RUN_MIN  3    // 游程的最小重复次数, 控制字节低7位为重复次数减去该值
+#define IMAGE_RLE_LEN_MASK 0x7F // 控制字节中的长度位, 原样输出段的长度为该值加1
+
+
+
+
+/*-------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+extern ImageServIntfTypeDef imageServIntf;
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+
+
+
+
+#endif /* __IMAGE_SERVICE_H__ */
@@ -0,0 +1,282 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : phosphor-service.c
+ * @brief          : 余辉显示服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 亮度缓冲区由采样中断写入, 由UI循环衰减和渲染; FRC相位由屏幕刷新中断推进,
+ * 保证连续发送的帧依次对应不同相位. 仅处理出现过亮点的区域以控制开销
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "phosphor-service.h"
+#include <string.h>
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define PHOSPHOR_EMPTY_AREA ((RectParamTypeDef){0xFF, 0xFF, 0, 0}) // 空区域
+
+
+
+
+
+/* ------- macro -----------------------------------------------------------------------------------------------------*/
+
+// 视口坐标(x, y)处像素的亮度
+#define PHOSPHOR_GET(phosphor, x, y) (((phosphor)->intensity[y][(x) >> 1] >> (((x) & 1) << 2)) & 0x0F)
+
+
+
+
+
+/* ------- function prototypes ---------------------------------------------------------------------------------------*/
+
+static void phosphorInit(PhosphorTypeDef* phosphor);
+static void phosphorHit(PhosphorTypeDef* phosphor, uint8_t x, uint8_t y);
+static void phosphorDecay(PhosphorTypeDef* phosphor, uint8_t ticks);
+static RectParamTypeDef phosphorArea(const PhosphorTypeDef* phosphor);
+static void phosphorRender(PhosphorTypeDef* phosphor, const CanvasTypeDef* canvas, RectParamTypeDef area);
+static void phosphorNextFrame(PhosphorTypeDef* phosphor);
+static inline RectParamTypeDef phosphorUnion(RectParamTypeDef a, RectParamTypeDef b);
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+PhosphorServIntfTypeDef phosphorServIntf = {
+    .init      = phosphorInit,
+    .hit       = phosphorHit,
+    .decay     = phosphorDecay,
+    .area      = phosphorArea,
+    .render    = phosphorRender,
+    .nextFrame = phosphorNextFrame,
+};
+
+// 各亮度的衰减掩码: 衰减周期计数与掩码相与为0的周期亮度减1, 亮度越低衰减越慢, 近似按比例的指数衰减
+static const uint8_t decayMask[PHOSPHOR_MAX + 1] = {0, 3, 3, 3, 3, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 清空亮度缓冲区
+ *
+ * @param phosphor
+ */
+static void phosphorInit(PhosphorTypeDef* phosphor) {
+    memset(phosphor->intensity, 0, sizeof(phosphor->intensity));
+
+    phosphor->active     = PHOSPHOR_EMPTY_AREA;
+    phosphor->hitArea[0] = PHOSPHOR_EMPTY_AREA;
+    phosphor->hitArea[1] = PHOSPHOR_EMPTY_AREA;
+    phosphor->hitIndex   = 0;
+    phosphor->tick       = 0;
+    phosphor->frame      = 0;
+}
+
+/**
+ * @brief 采样点击中像素, 亮度增加PHOSPHOR_HIT_GAIN
+ *
+ * @param phosphor
+ * @param x 屏幕X坐标, 视口外的点忽略
+ * @param y 屏幕Y坐标
+ * @note 在采样中断中调用, 停留越久的位置越亮
+ */
+static void phosphorHit(PhosphorTypeDef* phosphor, uint8_t x, uint8_t y) {
+    uint8_t vx = x - PHOSPHOR_X0;
+    uint8_t vy = y - PHOSPHOR_Y0;
+
+    if (vx >= PHOSPHOR_WIDTH || vy >= PHOSPHOR_HEIGHT) {
+        return;
+    }
+
+    uint8_t* cell = &phosphor->intensity[vy][vx >> 1];
+    uint8_t shift = (vx & 1) << 2;
+    uint8_t value = (*cell >> shift) & 0x0F;
+    value         = (value > PHOSPHOR_MAX - PHOSPHOR_HIT_GAIN) ? PHOSPHOR_MAX : value + PHOSPHOR_HIT_GAIN;
+    *cell         = (uint8_t)((*cell & ~(0x0F << shift)) | (value << shift));
+
+    RectParamTypeDef* hitArea = &phosphor->hitArea[phosphor->hitIndex];
+    hitArea->x0               = x < hitArea->x0 ? x : hitArea->x0;
+    hitArea->x1               = x > hitArea->x1 ? x : hitArea->x1;
+    hitArea->y0               = y < hitArea->y0 ? y : hitArea->y0;
+    hitArea->y1               = y > hitArea->y1 ? y : hitArea->y1;
+}
+
+/**
+ * @brief 亮度衰减, 并将活动区域收缩为仍有亮点的像素的包围盒
+ *
+ * @param phosphor
+ * @param ticks 经过的衰减周期数
+ * @note 先交换击中区域, 此后的击中记入另一个区域, 不会因收缩而丢失; 扫描范围为上次的活动区域与交换出的击中区域之并.
+ *       亮度按decayMask逐级递减, 满亮度约0.4s后降到最低灰度以下, 0.6s后熄灭.
+ *       与采样中断并发时, 个别击中可能被本次写回覆盖, 对显示无可见影响
+ */
+static void phosphorDecay(PhosphorTypeDef* phosphor, uint8_t ticks) {
+    if (ticks == 0) {
+        return;
+    }
+
+    uint8_t index             = phosphor->hitIndex;
+    phosphor->hitArea[!index] = PHOSPHOR_EMPTY_AREA;
+    phosphor->hitIndex        = !index;
+
+    RectParamTypeDef area = phosphorUnion(phosphor->active, phosphor->hitArea[index]);
+    RectParamTypeDef live = PHOSPHOR_EMPTY_AREA;
+    uint8_t tick          = phosphor->tick;
+
+    phosphor->tick += ticks;
+    if (area.x0 > area.x1) {
+        phosphor->active = live;
+        return;
+    }
+
+    uint8_t col0 = (area.x0 - PHOSPHOR_X0) >> 1;
+    uint8_t col1 = (area.x1 - PHOSPHOR_X0) >> 1;
+
+    for (uint8_t vy = area.y0 - PHOSPHOR_Y0; vy <= area.y1 - PHOSPHOR_Y0; vy++) {
+        uint8_t* row = phosphor->intensity[vy];
+
+        for (uint8_t col = col0; col <= col1; col++) {
+            uint8_t cell = row[col];
+
+            if (cell == 0) {
+                continue;
+            }
+
+            for (uint8_t shift = 0; shift <= 4; shift += 4) {
+                uint8_t value = (cell >> shift) & 0x0F;
+
+                for (uint8_t i = 0; i < ticks && value != 0; i++) {
+                    value -= (uint8_t)(((uint8_t)(tick + i) & decayMask[value]) == 0);
+                }
+
+                cell = (uint8_t)((cell & ~(0x0F << shift)) | (value << shift));
+                if (value != 0) {
+                    uint8_t x = PHOSPHOR_X0 + (col << 1) + (shift >> 2);
+                    uint8_t y = PHOSPHOR_Y0 + vy;
+                    live.x0   = x < live.x0 ? x : live.x0;
+                    live.x1   = x > live.x1 ? x : live.x1;
+                    live.y0   = y < live.y0 ? y : live.y0;
+                    live.y1   = y > live.y1 ? y : live.y1;
+                }
+            }
+
+            row[col] = cell;
+        }
+    }
+
+    phosphor->active = live;
+}
+
+/**
+ * @brief 获取可能有亮点的区域
+ *
+ * @param phosphor
+ * @return RectParamTypeDef 活动区域与当前击中区域之并(屏幕坐标), x0 > x1 表示为空
+ */
+static RectParamTypeDef phosphorArea(const PhosphorTypeDef* phosphor) {
+    return phosphorUnion(phosphor->active, phosphor->hitArea[phosphor->hitIndex]);
+}
+
+/**
+ * @brief 以当前FRC相位将亮度缓冲区渲染到页格式画布
+ *
+ * @param phosphor
+ * @param canvas 页格式画布, 仅改写活动区域
+ * @param area 允许写入的区域(包含边界), 传入CANVAS_FULL_AREA渲染整个活动区域
+ * @note 灰度等级 level = I >> PHOSPHOR_LEVEL_SHIFT, 当 level > (frame + x + y) % PHOSPHOR_FRC_FRAMES 时点亮,
+ *       相位随像素位置错开, 同一灰度的像素不会在同一帧整体闪烁
+ */
+static void phosphorRender(PhosphorTypeDef* phosphor, const CanvasTypeDef* canvas, RectParamTypeDef area) {
+    RectParamTypeDef active = phosphorArea(phosphor);
+
+    area.x0 = area.x0 > active.x0 ? area.x0 : active.x0; // 只渲染活动区域与画布内的部分
+    area.y0 = area.y0 > active.y0 ? area.y0 : active.y0;
+    area.x1 = area.x1 < active.x1 ? area.x1 : active.x1;
+    area.y1 = area.y1 < active.y1 ? area.y1 : active.y1;
+
+    area.y0 = area.y0 > CANVAS_TOP(canvas) ? area.y0 : CANVAS_TOP(canvas);
+    area.x1 = area.x1 < canvas->width - 1 ? area.x1 : canvas->width - 1;
+    area.y1 = area.y1 < CANVAS_BOTTOM(canvas) ? area.y1 : CANVAS_BOTTOM(canvas);
+
+    if (area.x0 > area.x1 || area.y0 > area.y1) {
+        return;
+    }
+
+    uint8_t frame = phosphor->frame % PHOSPHOR_FRC_FRAMES;
+
+    for (uint8_t page = area.y0 >> 3; page <= area.y1 >> 3; page++) {
+        uint8_t rowStart = (page << 3) > area.y0 ? (page << 3) : area.y0;
+        uint8_t rowEnd   = (page << 3) + 7 < area.y1 ? (page << 3) + 7 : area.y1;
+        uint8_t mask     = (uint8_t)((0xFF << (rowStart & 7)) & (0xFF >> (7 - (rowEnd & 7))));
+        uint8_t phase    = (frame + area.x0 + rowStart) % PHOSPHOR_FRC_FRAMES;
+        uint8_t* dst     = CANVAS_PAGE(canvas, page);
+
+        for (uint8_t x = area.x0; x <= area.x1; x++) {
+            uint8_t vx   = x - PHOSPHOR_X0;
+            uint8_t bits = 0;
+            uint8_t ph   = phase;
+
+            for (uint8_t y = rowStart; y <= rowEnd; y++) {
+                if ((PHOSPHOR_GET(phosphor, vx, y - PHOSPHOR_Y0) >> PHOSPHOR_LEVEL_SHIFT) > ph) {
+                    bits |= (uint8_t)(1 << (y & 7));
+                }
+                ph = (ph + 1 == PHOSPHOR_FRC_FRAMES) ? 0 : ph + 1;
+            }
+
+            dst[x] = (dst[x] & ~mask) | bits;
+            phase  = (phase + 1 == PHOSPHOR_FRC_FRAMES) ? 0 : phase + 1;
+        }
+    }
+
+    graphServIntf.markDirty(canvas, area);
+}
+
+/**
+ * @brief 推进FRC相位
+ *
+ * @param phosphor
+ * @note 在屏幕刷新中断中, 仅当一帧确实开始发送时调用
+ */
+static void phosphorNextFrame(PhosphorTypeDef* phosphor) { phosphor->frame++; }
+
+/**
+ * @brief 两个区域的包围盒
+ *
+ * @param a
+ * @param b
+ * @return RectParamTypeDef 空区域(x0 > x1)不参与合并
+ */
+static inline RectParamTypeDef phosphorUnion(RectParamTypeDef a, RectParamTypeDef b) {
+    if (a.x0 > a.x1) {
+        return b;
+    }
+    if (b.x0 > b.x1) {
+        return a;
+    }
+
+    return (RectParamTypeDef){a.x0 < b.x0 ? a.x0 : b.x0, a.y0 < b.y0 ? a.y0 : b.y0, a.x1 > b.x1 ? a.x1 : b.x1,
+                              a.y1 > b.y1 ? a.y1 : b.y1};
+}
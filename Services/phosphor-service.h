@@ -0,0 +1,97 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : phosphor-service.h
+ * @brief          : 余辉显示服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 模拟示波管荧光余辉: 采样点累加到亮度缓冲区并按指数衰减, 以帧率调制(FRC)在1bpp屏幕上显示灰度
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __PHOSPHOR_SERVICE_H__
+#define __PHOSPHOR_SERVICE_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include <stdint.h>
+
+
+
+
+/*-------- define ----------------------------------------------------------------------------------------------------*/
+
+// 余辉视口: 采样点映射到屏幕上的区域, 亮度缓冲区只覆盖该区域
+#define PHOSPHOR_X0     MAP_ADC_TO_OLED_X(0)
+#define PHOSPHOR_Y0     MAP_ADC_TO_OLED_Y(0)
+#define PHOSPHOR_WIDTH  (MAP_ADC_TO_OLED_X(4095) - PHOSPHOR_X0 + 1)
+#define PHOSPHOR_HEIGHT (MAP_ADC_TO_OLED_Y(4095) - PHOSPHOR_Y0 + 1)
+#define PHOSPHOR_STRIDE ((PHOSPHOR_WIDTH + 1) / 2) // 每行字节数, 每字节存放两个像素, 低4位为偶数列
+
+#define PHOSPHOR_MAX          15    // 最大亮度
+#define PHOSPHOR_HIT_GAIN     8     // 每次击中增加的亮度, 饱和于PHOSPHOR_MAX
+#define PHOSPHOR_DECAY_PERIOD 0.02f // 衰减周期(s)
+#define PHOSPHOR_LEVEL_SHIFT  2     // 亮度右移得到灰度等级0~3
+#define PHOSPHOR_FRC_FRAMES   3     // FRC周期帧数, 灰度等级n在每个周期中点亮n帧
+
+
+
+
+/*-------- typedef ---------------------------------------------------------------------------------------------------*/
+
+// 余辉亮度缓冲区
+typedef struct {
+    uint8_t intensity[PHOSPHOR_HEIGHT][PHOSPHOR_STRIDE]; // 视口内各像素4位亮度, 0为熄灭
+    RectParamTypeDef active;                             // 上次衰减后仍有亮点的区域(屏幕坐标), x0 > x1 表示为空
+    RectParamTypeDef hitArea[2];                         // 击中区域, 采样中断写入hitArea[hitIndex], 衰减时交换
+    volatile uint8_t hitIndex;                           // 采样中断当前写入的击中区域
+    uint8_t tick;                                        // 衰减周期计数
+    volatile uint8_t frame;                              // FRC帧计数, 每发送一帧加1
+} PhosphorTypeDef;
+
+/* 余辉显示服务对外接口 */
+typedef struct {
+    void (*init)(PhosphorTypeDef* phosphor);                             // 清空亮度缓冲区
+    void (*hit)(PhosphorTypeDef* phosphor, uint8_t x, uint8_t y);        // 采样点击中像素
+    void (*decay)(PhosphorTypeDef* phosphor, uint8_t ticks);             // 按衰减周期数衰减
+    RectParamTypeDef (*area)(const PhosphorTypeDef* phosphor);           // 可能有亮点的区域
+    void (*render)(PhosphorTypeDef* phosphor, const CanvasTypeDef* canvas,
+                   RectParamTypeDef area); // 按当前FRC帧渲染到画布, 只写入area内的像素
+    void (*nextFrame)(PhosphorTypeDef* phosphor);                        // 屏幕刷新一帧后推进FRC相位
+} PhosphorServIntfTypeDef;
+
+
+
+
+/*-------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+extern PhosphorServIntfTypeDef phosphorServIntf;
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+
+
+
+
+#endif /* __PHOSPHOR_SERVICE_H__ */
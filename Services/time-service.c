@@ -31,6 +31,9 @@
 
 /* ------- define ----------------------------------------------------------------------------------------------------*/
 
+#define TIME_DWT_CTRL      (*(volatile uint32_t*)0xE0001000) // DWT控制寄存器, 所用CMSIS版本未定义DWT
+#define TIME_DWT_CYCCNT    (*(volatile uint32_t*)0xE0001004) // DWT周期计数器, 72MHz下约59s回绕一次
+#define TIME_DWT_CYCCNTENA 0x00000001                        // DWT_CTRL中的周期计数器使能位
 
 
 
@@ -52,6 +55,7 @@ float getGlobalTime(void);
 SoftTimerHandle softTimerRegister(void);
 void softTimerUnregister(SoftTimerHandle handle);
 float getElapsedTime(SoftTimerHandle handle);
+uint32_t getCycles(void);
 
 
 
@@ -67,6 +71,7 @@ TimeServIntfTypeDef timeServIntf = {
     .softTimerRegister   = softTimerRegister,
     .softTimerUnregister = softTimerUnregister,
     .getElapsedTime      = getElapsedTime,
+    .getCycles           = getCycles,
 };
 
 static TIMObjTypeDef systTimObjSub;
@@ -91,6 +96,10 @@ void servInit(void) {
 
     timIntf.start(&systTimObjSub);
     timIntf.start(&systTimObj);
+
+    // 使能DWT周期计数器, 用于测量代码段的周期数
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    TIME_DWT_CTRL |= TIME_DWT_CYCCNTENA;
 }
 
 void delayUWithSyst(uint32_t u) { systIntf.systDelayClkCycles(72 * u); }
@@ -151,3 +160,10 @@ float getElapsedTime(SoftTimerHandle handle) {
     ((SoftTimerDataTypeDef*)handle)->startTime = getGlobalTime();                     // 更新开始时间
     return eplasedTime;                                                               // 返回经过的时间
 }
+
+/**
+ * @brief 获取DWT周期计数器的值
+ *
+ * @return uint32_t 两次读数之差(无符号减法)即为经过的CPU周期数, 回绕不影响结果
+ */
+uint32_t getCycles(void) { return TIME_DWT_CYCCNT; }
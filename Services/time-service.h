@@ -47,6 +47,7 @@ typedef struct {
     SoftTimerHandle (*softTimerRegister)(void);
     void (*softTimerUnregister)(SoftTimerHandle handle);
     float (*getElapsedTime)(SoftTimerHandle handle);
+    uint32_t (*getCycles)(void);
 } TimeServIntfTypeDef;
 
 /* 软件定时器计时数据 */
@@ -0,0 +1,112 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : trig-service.c
+ * @brief          : 定点三角函数服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 四分之一周期正弦表(129项)加线性插值, 其余象限由对称性得到, 最大误差小于1.5LSB(Q15)
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "trig-service.h"
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define TRIG_QUARTER    0x4000                      // 二进制角度的PI/2
+#define TRIG_FRAC_SHIFT (14 - TRIG_TABLE_BIT)       // 段内插值的位数
+#define TRIG_FRAC_MASK  ((1 << TRIG_FRAC_SHIFT) - 1)
+
+
+
+
+/* ------- macro -----------------------------------------------------------------------------------------------------*/
+
+
+
+
+
+/* ------- function prototypes ---------------------------------------------------------------------------------------*/
+
+static int32_t sinQ15(uint16_t angle);
+static int32_t cosQ15(uint16_t angle);
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+TrigServIntfTypeDef trigServIntf = {
+    .sinQ15 = sinQ15,
+    .cosQ15 = cosQ15,
+};
+
+// sinTable[i] = round(sin(PI/2 * i / 128) * 32768)
+static const uint16_t sinTable[(1 << TRIG_TABLE_BIT) + 1] = {
+        0,   402,   804,  1206,  1608,  2009,  2411,  2811,  3212,  3612,  4011,  4410,
+     4808,  5205,  5602,  5998,  6393,  6787,  7180,  7571,  7962,  8351,  8740,  9127,
+     9512,  9896, 10279, 10660, 11039, 11417, 11793, 12167, 12540, 12910, 13279, 13646,
+    14010, 14373, 14733, 15091, 15447, 15800, 16151, 16500, 16846, 17190, 17531, 17869,
+    18205, 18538, 18868, 19195, 19520, 19841, 20160, 20475, 20788, 21097, 21403, 21706,
+    22006, 22302, 22595, 22884, 23170, 23453, 23732, 24008, 24279, 24548, 24812, 25073,
+    25330, 25583, 25833, 26078, 26320, 26557, 26791, 27020, 27246, 27467, 27684, 27897,
+    28106, 28311, 28511, 28707, 28899, 29086, 29269, 29448, 29622, 29792, 29957, 30118,
+    30274, 30425, 30572, 30715, 30853, 30986, 31114, 31238, 31357, 31471, 31581, 31686,
+    31786, 31881, 31972, 32058, 32138, 32214, 32286, 32352, 32413, 32470, 32522, 32568,
+    32610, 32647, 32679, 32706, 32729, 32746, 32758, 32766, 32768,
+};
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 计算正弦值
+ *
+ * @param angle 二进制角度, 65536对应2PI
+ * @return int32_t Q15格式的正弦值, 范围[-32768, 32768]
+ * @note 第二、四象限将角度镜像到第一象限, 第三、四象限取负
+ */
+static int32_t sinQ15(uint16_t angle) {
+    uint16_t x = angle & (TRIG_QUARTER - 1);
+
+    if (angle & TRIG_QUARTER) {
+        x = TRIG_QUARTER - x; // 第二、四象限, x范围(0, PI/2]
+    }
+
+    uint16_t index = x >> TRIG_FRAC_SHIFT;
+    uint16_t frac  = x & TRIG_FRAC_MASK;
+    int32_t value  = sinTable[index];
+
+    if (frac != 0) {
+        value += ((int32_t)(sinTable[index + 1] - sinTable[index]) * frac + (1 << (TRIG_FRAC_SHIFT - 1))) >> TRIG_FRAC_SHIFT;
+    }
+
+    return (angle & TRIG_ANGLE_PI) ? -value : value;
+}
+
+/**
+ * @brief 计算余弦值
+ *
+ * @param angle 二进制角度, 65536对应2PI
+ * @return int32_t Q15格式的余弦值, 范围[-32768, 32768]
+ */
+static int32_t cosQ15(uint16_t angle) { return sinQ15((uint16_t)(angle + TRIG_QUARTER)); }
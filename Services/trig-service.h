@@ -0,0 +1,74 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : trig-service.h
+ * @brief          : 定点三角函数服务
+ * @author         : 李嘉豪
+ * @date           : 2025-07-05
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 查表加线性插值的Q15正弦/余弦, 用于替代动画与绘图中的软件浮点三角函数
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __TRIG_SERVICE_H__
+#define __TRIG_SERVICE_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+
+
+
+/*-------- typedef ---------------------------------------------------------------------------------------------------*/
+
+/* 三角函数服务对外接口 */
+typedef struct {
+    int32_t (*sinQ15)(uint16_t angle); // 正弦, 角度为二进制角度, 返回Q15
+    int32_t (*cosQ15)(uint16_t angle); // 余弦, 角度为二进制角度, 返回Q15
+} TrigServIntfTypeDef;
+
+
+
+
+/*-------- define ----------------------------------------------------------------------------------------------------*/
+
+#define TRIG_Q15_ONE   32768  // Q15格式的1.0, 正弦/余弦返回值范围为[-TRIG_Q15_ONE, TRIG_Q15_ONE]
+#define TRIG_ANGLE_PI  0x8000 // 二进制角度的PI, 一周为65536, uint16_t溢出即为取模2PI
+#define TRIG_TABLE_BIT 7      // 四分之一周期的查表段数为2^TRIG_TABLE_BIT
+
+
+
+
+/*-------- macro -----------------------------------------------------------------------------------------------------*/
+
+// 将[0, 1]范围内的浮点数转换为Q15定点数
+#define TRIG_FLOAT_TO_Q15(x) ((int32_t)((x) * (float)TRIG_Q15_ONE + 0.5f))
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+extern TrigServIntfTypeDef trigServIntf;
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+
+
+
+
+#endif /* __TRIG_SERVICE_H__ */
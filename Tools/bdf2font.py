@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+bdf2font.py: 将BDF点阵字体编译为graph-service使用的页格式比例字体(FontFaceTypeDef)
+
+用法:
+    python bdf2font.py <字体.bdf> <字体名> [-o 输出.c] [--chars 字符集] [--kern 字距表]
+
+    --chars  只编译其中的字符, 默认为BDF中编码在0~255之间的全部字符
+    --kern   字距调整对, 格式为"左右:调整量"并以逗号分隔, 如"AV:-1,7.:-1"
+
+数据格式(与Services/graph-service.c的printStringOnBuffer一致):
+    1. 字形单元高度为FONT_ASCENT + FONT_DESCENT行, 不超过24行; 单元底部为绘制时的y坐标
+    2. 每个字形按BBX宽度存储若干列, 每列BITMAP_PAGES(单元高度)字节, bit0为单元最上方一行
+       预移位位图中每列按单元顶部的页内偏移0~7依次存储左移后的BITMAP_PAGES(单元高度) + 1字节
+    3. 字形记录{首列的列号, 列数, 框顶到单元底部的行数, 光标前进量, 首列相对光标的偏移}
+    4. 字符编码减去firstChar查index得到字形序号, 0xFF表示字体中没有该字符
+    5. 字距调整对按(左字符, 右字符)升序排列, 供二分查找
+"""
+
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from img2rle import format_array  # noqa: E402
+
+FONT_MAX_HEIGHT = 24  # 预移位后一列需放入32位整数
+GLYPH_NONE = 0xFF
+
+
+def read_bdf(text):
+    """读取BDF, 返回(ascent, descent, {编码: 字形})"""
+    props = {}
+    glyphs = {}
+    glyph = None
+    rows = None
+
+    for line in text.splitlines():
+        words = line.split()
+        if not words:
+            continue
+        key = words[0]
+
+        if rows is not None:
+            if key == "ENDCHAR":
+                glyph["rows"] = rows
+                if 0 <= glyph["encoding"] <= 255:
+                    glyphs[glyph["encoding"]] = glyph
+                glyph = rows = None
+            else:
+                rows.append((int(key, 16), len(key) * 4))  # 每行按字节补齐, 最高位为最左侧像素
+            continue
+
+        if key in ("FONT_ASCENT", "FONT_DESCENT"):
+            props[key] = int(words[1])
+        elif key == "STARTCHAR":
+            glyph = {"name": " ".join(words[1:])}
+        elif key == "ENCODING":
+            glyph["encoding"] = int(words[1])
+        elif key == "DWIDTH":
+            glyph["advance"] = int(words[1])
+        elif key == "BBX":
+            glyph["bbx"] = [int(v) for v in words[1:5]]
+        elif key == "BITMAP":
+            rows = []
+
+    return props["FONT_ASCENT"], props["FONT_DESCENT"], glyphs
+
+
+def glyph_columns(glyph, ascent, height):
+    """将BDF位图转换为按列排列的整数, bit0为单元最上方一行, 返回(列列表, 框顶到单元底部的行数)"""
+    width, rows_count, xoff, yoff = glyph["bbx"]
+    top = ascent - (yoff + rows_count)  # 框顶在单元中的行号
+
+    if top < 0 or top + rows_count > height:
+        raise ValueError("字形%s超出字形单元" % glyph["name"])
+
+    columns = []
+    for x in range(width):
+        value = 0
+        for r, (bits, nbits) in enumerate(glyph["rows"]):
+            if (bits >> (nbits - 1 - x)) & 1:
+                value |= 1 << (top + r)
+        columns.append(value)
+
+    return columns, height - top if rows_count else 0
+
+
+def column_bytes(columns, pages):
+    """按列展开为每列pages字节"""
+    return [(value >> (8 * p)) & 0xFF for value in columns for p in range(pages)]
+
+
+def shifted_bytes(columns, pages):
+    """每列按页内偏移0~7预移位, 每种偏移pages + 1字节"""
+    return [(value << shift >> (8 * p)) & 0xFF for value in columns for shift in range(8) for p in range(pages + 1)]
+
+
+def parse_kern(spec):
+    """解析字距调整对"""
+    pairs = []
+    for item in filter(None, spec.split(",")):
+        chars, adjust = item.rsplit(":", 1)
+        if len(chars) != 2:
+            raise ValueError("字距调整对格式错误: %s" % item)
+        pairs.append((ord(chars[0]), ord(chars[1]), int(adjust)))
+    return sorted(pairs)
+
+
+def c_char(code):
+    """字符的注释形式"""
+    if code == 0x20:
+        return "空格"
+    return chr(code) if 0x20 < code < 0x7F else "0x%02X" % code
+
+
+def option(argv, name, default=None):
+    return argv[argv.index(name) + 1] if name in argv else default
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write(__doc__)
+        return 1
+
+    path, name = argv[1], argv[2]
+    output = option(argv, "-o")
+    chars = option(argv, "--chars")
+    kern = parse_kern(option(argv, "--kern", ""))
+
+    with open(path, encoding="utf-8") as f:
+        ascent, descent, glyphs = read_bdf(f.read())
+
+    height = ascent + descent
+    if height > FONT_MAX_HEIGHT:
+        raise ValueError("字形单元高度%d超过%d" % (height, FONT_MAX_HEIGHT))
+
+    codes = sorted(glyphs if chars is None else {ord(c) for c in chars} & set(glyphs))
+    first, last = codes[0], codes[-1]
+
+    pages = (height + 7) // 8
+    bitmap = []
+    shifted = []
+    records = []
+    index = [GLYPH_NONE] * (last - first + 1)
+    for code in codes:
+        glyph = glyphs[code]
+        columns, box = glyph_columns(glyph, ascent, height)
+        index[code - first] = len(records)
+        records.append((len(bitmap) // pages, glyph["bbx"][0], box, glyph["advance"], glyph["bbx"][2], code))
+        bitmap.extend(column_bytes(columns, pages))
+        shifted.extend(shifted_bytes(columns, pages))
+
+    if len(records) >= GLYPH_NONE:
+        raise ValueError("字形数量超过254")
+    kern = [k for k in kern if k[0] in codes and k[1] in codes]
+
+    base = os.path.splitext(os.path.basename(output))[0] if output else name
+    lines = [
+        "/**",
+        " " + "*" * 119,
+        " * @file           : %s.c" % base,
+        " * @brief          : %s字体数据" % name,
+        " " + "*" * 119,
+        " * @attention",
+        " *",
+        " * 由Tools/bdf2font.py从%s生成, 请勿手动修改" % path.replace("\\", "/"),
+        " * 字形单元%d行, %d个字形, 位图%d字节, 预移位位图%d字节" % (height, len(records), len(bitmap), len(shifted)),
+        " *",
+        " " + "*" * 119,
+        " **/",
+        "",
+        "",
+        "",
+        "",
+        "/* ------- includes " + "-" * 98 + "*/",
+        "",
+        '#include "graph-service.h"',
+        "#include <stddef.h>",
+        "",
+        "",
+        "",
+        "",
+        "/* ------- variables " + "-" * 97 + "*/",
+        "",
+        format_array("static const uint8_t %sBitmap[%d]" % (name, len(bitmap)), bitmap, "0x%02X"),
+        "",
+        format_array("static const uint8_t %sShifted[%d]" % (name, len(shifted)), shifted, "0x%02X"),
+        "",
+        format_array("static const uint8_t %sIndex[%d]" % (name, len(index)), index, "%d"),
+        "",
+        "static const FontGlyphTypeDef %sGlyph[%d] = {" % (name, len(records)),
+    ]
+    entries = ["    {%d, %d, %d, %d, %d}," % record[:5] for record in records]
+    pad = max(len(entry) for entry in entries)
+    for entry, record in zip(entries, records):
+        lines.append("%s // %s" % (entry.ljust(pad), c_char(record[5])))
+    lines.append("};")
+    lines.append("")
+
+    if kern:
+        lines.append("static const FontKernTypeDef %sKern[%d] = {" % (name, len(kern)))
+        for left, right, adjust in kern:
+            lines.append("    {0x%02X, 0x%02X, %d}, // %s%s" % (left, right, adjust, c_char(left), c_char(right)))
+        lines.append("};")
+        lines.append("")
+
+    lines.append("const FontFaceTypeDef %s = {" % name)
+    lines.append("    .height    = %d," % height)
+    lines.append("    .firstChar = 0x%02X," % first)
+    lines.append("    .lastChar  = 0x%02X," % last)
+    lines.append("    .kernCount = %d," % len(kern))
+    lines.append("    .index     = %sIndex," % name)
+    lines.append("    .glyph     = %sGlyph," % name)
+    lines.append("    .bitmap    = %sBitmap," % name)
+    lines.append("    .shifted   = %sShifted," % name)
+    lines.append("    .kern      = %s," % (name + "Kern" if kern else "NULL"))
+    lines.append("};")
+    lines.append("")
+
+    text = "\n".join(lines)
+    if output:
+        with open(output, "w", encoding="utf-8") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+    sys.stderr.write("%s: %d个字形, 位图%d字节\n" % (name, len(records), len(bitmap)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
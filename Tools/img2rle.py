@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+img2rle.py: 将PBM/XBM单色图像转换为按页顺序RLE压缩的C语言图像资源(ImageAssetTypeDef)
+
+用法:
+    python img2rle.py <图像.pbm|图像.xbm> <资源名> [-o 输出.c]
+
+数据格式(与Services/image-service.c的解码器一致):
+    1. 图像按SSD1306页格式排列: 每页8行, 每列一个字节, bit0为该页最上方一行
+    2. 每页单独编码, 游程不跨页, pageIndex记录各页在data中的起始位置, 解码时可直接跳到任意页
+    3. 控制字节c < 0x80: 其后c + 1个字节原样输出
+       控制字节c >= 0x80: 其后一个字节重复(c & 0x7F) + 3次
+输出前会把编码结果解码一遍与原图比较, 不一致时报错退出
+"""
+
+import re
+import sys
+
+RLE_LITERAL_MAX = 128  # 一个原样输出段的最大长度
+RLE_RUN_MIN = 3  # 使用游程编码的最小重复次数
+RLE_RUN_MAX = 130  # 一个游程的最大重复次数
+LINE_WIDTH = 120  # 输出C代码的最大行宽
+
+
+def read_pbm(data):
+    """读取PBM(P1文本或P4二进制), 返回(宽, 高, 像素行列表), 1为点亮"""
+    tokens = []
+    pos = 0
+
+    # 头部: 魔数, 宽, 高, 以空白分隔, #开始注释
+    while len(tokens) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos) + 1
+            continue
+        end = pos
+        while end < len(data) and not data[end:end + 1].isspace():
+            end += 1
+        tokens.append(data[pos:end])
+        pos = end
+
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b"P4":
+        pos += 1  # 头部之后的单个空白
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            line = data[pos + y * stride:pos + (y + 1) * stride]
+            rows.append([(line[x >> 3] >> (7 - (x & 7))) & 1 for x in range(width)])
+        return width, height, rows
+    if magic == b"P1":
+        bits = [int(c) for c in re.sub(rb"#[^\n]*", b"", data[pos:]).decode() if c in "01"]
+        return width, height, [bits[y * width:(y + 1) * width] for y in range(height)]
+
+    raise ValueError("不支持的PBM格式: %r" % magic)
+
+
+def read_xbm(text):
+    """读取XBM, 返回(宽, 高, 像素行列表), 每行按字节对齐, 字节内低位在左"""
+    width = int(re.search(r"_width\s+(\d+)", text).group(1))
+    height = int(re.search(r"_height\s+(\d+)", text).group(1))
+    values = [int(v, 16) for v in re.findall(r"0[xX]([0-9a-fA-F]+)", text[text.index("{"):])]
+    stride = (width + 7) // 8
+
+    rows = []
+    for y in range(height):
+        line = values[y * stride:(y + 1) * stride]
+        rows.append([(line[x >> 3] >> (x & 7)) & 1 for x in range(width)])
+    return width, height, rows
+
+
+def to_pages(width, height, rows):
+    """像素行转换为页格式, 返回各页的字节列表, 不足8行的末页高位补0"""
+    pages = []
+    for page in range((height + 7) // 8):
+        line = []
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and rows[y][x]:
+                    byte |= 1 << bit
+            line.append(byte)
+        pages.append(line)
+    return pages
+
+
+def encode_page(line):
+    """对一页字节进行RLE编码"""
+    out = []
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:RLE_LITERAL_MAX]
+            del literal[:RLE_LITERAL_MAX]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(line):
+        run = 1
+        while i + run < len(line) and line[i + run] == line[i] and run < RLE_RUN_MAX:
+            run += 1
+        if run >= RLE_RUN_MIN:
+            flush_literal()
+            out.append(0x80 | (run - RLE_RUN_MIN))
+            out.append(line[i])
+            i += run
+        else:
+            literal.append(line[i])
+            i += 1
+    flush_literal()
+    return out
+
+
+def decode_page(data, pos, width):
+    """解码一页, 用于校验编码结果"""
+    line = []
+    while len(line) < width:
+        c = data[pos]
+        if c & 0x80:
+            line.extend([data[pos + 1]] * ((c & 0x7F) + RLE_RUN_MIN))
+            pos += 2
+        else:
+            line.extend(data[pos + 1:pos + 2 + c])
+            pos += c + 2
+    if len(line) != width:
+        raise ValueError("游程跨越了页边界")
+    return line
+
+
+def format_array(decl, values, fmt):
+    """按行宽排列数组元素, 与仓库代码格式一致"""
+    single = decl + " = {" + ", ".join(fmt % v for v in values) + "};"
+    if len(single) <= LINE_WIDTH:
+        return single
+
+    lines = [decl + " = {"]
+    line = "   "
+    for v in values:
+        item = " " + (fmt % v) + ","
+        if len(line) + len(item) > LINE_WIDTH:
+            lines.append(line)
+            line = "   "
+        line += item
+    lines.append(line[:-1] + "};")
+    return "\n".join(lines)
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write(__doc__)
+        return 1
+
+    path, name = argv[1], argv[2]
+    output = argv[argv.index("-o") + 1] if "-o" in argv else None
+
+    with open(path, "rb") as f:
+        raw = f.read()
+    if path.lower().endswith(".xbm"):
+        width, height, rows = read_xbm(raw.decode("ascii"))
+    else:
+        width, height, rows = read_pbm(raw)
+
+    if width > 255 or height > 255:
+        raise ValueError("图像尺寸超过255")
+
+    pages = to_pages(width, height, rows)
+    data = []
+    index = []
+    for line in pages:
+        index.append(len(data))
+        data.extend(encode_page(line))
+
+    for page, line in enumerate(pages):
+        if decode_page(data, index[page], width) != line:
+            raise ValueError("第%d页解码结果与原图不一致" % page)
+
+    raw_size = width * len(pages)
+    text = "\n".join([
+        "// %s: %dx%d, 由img2rle.py从%s生成, 原始%d字节, 压缩后%d字节" %
+        (name, width, height, path.replace("\\", "/"), raw_size, len(data) + 2 * len(index)),
+        format_array("static const uint8_t %sData[%d]" % (name, len(data)), data, "0x%02X"),
+        format_array("static const uint16_t %sPageIndex[%d]" % (name, len(index)), index, "%d"),
+        "const ImageAssetTypeDef %s = {%d, %d, %sPageIndex, %sData};" % (name, width, height, name, name),
+        "",
+    ])
+
+    if output:
+        with open(output, "w", encoding="utf-8") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+    sys.stderr.write("%s: %d -> %d 字节\n" % (name, raw_size, len(data) + 2 * len(index)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
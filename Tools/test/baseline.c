@@ -0,0 +1,350 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : baseline.c
+ * @brief          : 基线版本的图形函数
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 函数体与优化前的graph-service.c一致, 仅改名并去掉接口表
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "baseline.h"
+#include <math.h>
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    uint16_t character;
+    uint8_t height;
+    uint8_t width;
+    uint8_t* fontByte;
+} BaselineFontTypeDef;
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static const uint8_t font016x8[2][8]     = {{0x7C, 0xC2, 0x81, 0x80, 0x40, 0x20, 0x1F, 0x00},
+                                            {0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00}};
+static const uint8_t font116x8[2][8]     = {{0x80, 0x81, 0xF9, 0x87, 0x80, 0x00, 0x00, 0x00},
+                                            {0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00}};
+static const uint8_t font216x8[2][8]     = {{0xC1, 0xA0, 0x90, 0x8C, 0x83, 0x00, 0x00, 0x00},
+                                            {0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
+static const uint8_t font316x8[2][8]     = {{0x80, 0x80, 0x88, 0x88, 0xCC, 0x73, 0x00, 0x00},
+                                            {0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00}};
+static const uint8_t font416x8[2][8]     = {{0x18, 0x14, 0x13, 0xD0, 0x3C, 0x17, 0x10, 0x00},
+                                            {0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
+static const uint8_t font516x8[2][8]     = {{0x80, 0x87, 0x84, 0x4C, 0x28, 0x00, 0x00, 0x00},
+                                            {0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00}};
+static const uint8_t font616x8[2][8]     = {{0x7C, 0xCB, 0x85, 0x84, 0x44, 0x38, 0x00, 0x00},
+                                            {0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00}};
+static const uint8_t font716x8[2][8]     = {{0xC0, 0x30, 0x0C, 0x02, 0x01, 0x00, 0x00, 0x00},
+                                            {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00}};
+static const uint8_t font816x8[2][8]     = {{0x70, 0xCB, 0x84, 0x88, 0x9C, 0x73, 0x00, 0x00},
+                                            {0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00}};
+static const uint8_t font916x8[2][8]     = {{0x8E, 0x91, 0x90, 0xD0, 0x69, 0x1F, 0x00, 0x00},
+                                            {0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00}};
+static const uint8_t fontDot16x8[2][8]   = {{0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+                                            {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}; // 小数点
+static const uint8_t fontk16x8[2][8]     = {{0xE0, 0x3C, 0x13, 0xE8, 0x04, 0x00, 0x00, 0x00},
+                                            {0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00}};
+static const uint8_t fontH16x8[2][8]     = {{0xC0, 0x3C, 0x27, 0x10, 0x10, 0xF0, 0x1C, 0x03},
+                                            {0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x80}};
+static const uint8_t fontz16x8[2][8]     = {{0xC0, 0xB8, 0xA8, 0x98, 0x48, 0x00, 0x00, 0x00},
+                                            {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}};
+static const uint8_t fontV16x8[2][8]     = {{0x7F, 0x80, 0x40, 0x20, 0x18, 0x07, 0x01, 0x00},
+                                            {0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00}};
+static const uint8_t fontDeg16x8[2][8]   = {{0x07, 0x05, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00},
+                                            {0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00}};
+static const uint8_t fontStar16x8[2][8]  = {{0x05, 0x0F, 0x02, 0x05, 0x00, 0x00, 0x00, 0x00},
+                                            {0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}};
+
+// 字体, 度符号按UTF-8的首字节匹配
+static BaselineFontTypeDef font[] = {
+    {'0', 9, 6, (uint8_t*)font016x8},    {'1', 9, 6, (uint8_t*)font116x8},
+    {'.', 2, 4, (uint8_t*)fontDot16x8},  {'2', 9, 6, (uint8_t*)font216x8},
+    {'3', 9, 6, (uint8_t*)font316x8},    {'4', 9, 6, (uint8_t*)font416x8},
+    {'5', 9, 7, (uint8_t*)font516x8},    {'6', 9, 6, (uint8_t*)font616x8},
+    {'7', 9, 6, (uint8_t*)font716x8},    {'8', 9, 6, (uint8_t*)font816x8},
+    {'9', 9, 6, (uint8_t*)font916x8},    {'k', 9, 5, (uint8_t*)fontk16x8},
+    {'H', 16, 7, (uint8_t*)fontH16x8},   {'z', 5, 5, (uint8_t*)fontz16x8},
+    {'V', 9, 8, (uint8_t*)fontV16x8},    {(uint16_t)"°"[0], 8, 5, (uint8_t*)fontDeg16x8}, // 度符号
+    {'*', 8, 5, (uint8_t*)fontStar16x8},                                                  // 星号
+};
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 将点阵图转换为字节数组
+ *
+ * @param dotMatrix 点阵图
+ * @param graphBuffer 字节数组
+ */
+void baselineBitToByte(DotMatrixTypeDef dotMatrix, uint8_t graphBuffer[PAGE][WIDTH]) {
+    for (uint16_t col = 0; col < WIDTH; col++) {
+        for (uint16_t page = 0; page < PAGE; page++) {
+            uint8_t byte = 0;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                uint8_t y = page * 8 + bit;
+                if (y < HEIGHT && dotMatrix[y][col]) {
+                    byte |= (1 << bit); // bit0对应页顶部像素
+                }
+            }
+            graphBuffer[page][col] = byte;
+        }
+    }
+}
+
+/**
+ * @brief 点阵中绘制圆角矩形
+ *
+ * @param dotMatrix 点阵图像素数组
+ * @param startX 起始X坐标
+ * @param startY 起始Y坐标
+ * @param endX 结束X坐标
+ * @param endY 结束Y坐标
+ * @param radius 圆角半径
+ * @param padding 是否填充
+ */
+void baselineRoundRect(DotMatrixTypeDef dotMatrix, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                       uint8_t radius, uint8_t padding) {
+    // 逐行绘制
+    for (uint8_t y = startY; y <= endY; y++) {
+        uint8_t lightUpFromX;
+        uint8_t lightUpToX;
+
+        // 计算当前行的起始和结束点
+        // 1.位于上方圆角区域
+        if (y < startY + radius) {
+            uint8_t l       = y - startY;
+            uint8_t xOffset = radius - (uint8_t)sqrt(2 * l * radius - 2 * l - l * l) - 1;
+            lightUpFromX    = startX + xOffset;
+            lightUpToX      = endX - xOffset;
+        } else if (y < endY - radius + 1) {
+            // 2.位于中间区域
+            lightUpFromX = startX;
+            lightUpToX   = endX;
+        } else {
+            // 3.位于下方圆角区域
+            uint8_t l       = endY - y; // 计算当前行到下方圆角的距离
+            uint8_t xOffset = radius - (uint8_t)sqrt(2 * l * radius - 2 * l - l * l) - 1;
+            lightUpFromX    = startX + xOffset;
+            lightUpToX      = endX - xOffset;
+        }
+
+        if (padding) {
+            for (uint8_t x = lightUpFromX; x <= lightUpToX; x++) {
+                dotMatrix[y][x] = 1; // 设置点阵图像素为1
+            }
+        } else {
+            // 如果不需要填充，则只绘制边框
+            if (y == startY || y == endY) {
+                for (uint8_t x = lightUpFromX; x <= lightUpToX; x++) {
+                    dotMatrix[y][x] = 1; // 设置点阵图像素为1
+                }
+            } else {
+                dotMatrix[y][lightUpFromX] = 1; // 左边框
+                dotMatrix[y][lightUpToX]   = 1; // 右边框
+            }
+        }
+    }
+}
+
+/**
+ * @brief 反转图形缓冲区中指定掩码的像素
+ *
+ * @param mask 掩码数组，指示哪些像素需要被反转
+ * @param buffer 图形缓冲区
+ */
+void baselineInvertWithMask(DotMatrixTypeDef mask, uint8_t buffer[PAGE][WIDTH]) {
+    for (uint8_t y = 0; y < 64; y++) {
+        for (uint8_t x = 0; x < 128; x++) {
+            if (mask[y][x]) {
+                uint8_t page    = y / 8;
+                uint8_t bit_pos = y % 8;
+                buffer[page][x] ^= (1 << bit_pos);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 平滑动画过渡矩形位置和大小
+ *
+ * @param sx0 起始矩形左上角X坐标
+ * @param sy0 起始矩形左上角Y坐标
+ * @param sx1 起始矩形右下角X坐标
+ * @param sy1 起始矩形右下角Y坐标
+ * @param ex0 结束矩形左上角X坐标
+ * @param ey0 结束矩形左上角Y坐标
+ * @param ex1 结束矩形右下角X坐标
+ * @param ey1 结束矩形右下角Y坐标
+ * @param progress 动画进度 [0, 1]，0表示起始状态，1表示结束状态
+ * @return RectParamTypeDef
+ */
+RectParamTypeDef baselineAnimateRect(uint8_t sx0, uint8_t sy0, uint8_t sx1, uint8_t sy1, uint8_t ex0, uint8_t ey0,
+                                     uint8_t ex1, uint8_t ey1, float progress) {
+    RectParamTypeDef r;
+
+    // 限制进度在 [0,1]
+    if (progress < 0.0f)
+        progress = 0.0f;
+    if (progress > 1.0f)
+        progress = 1.0f;
+
+    // 平滑位置过渡（sine in-out）
+    float posFactor   = 0.5f * (1 - cosf(PI * progress));
+
+    // 尺寸缩放：1 → 0.3 → 1，最大压缩出现在 progress=0.5
+    float scaleFactor = 0.8f + 0.2f * cosf(2 * PI * progress);
+    // 范围 [0.3, 1.0]
+
+    // 起始中心和大小
+    float sx          = (sx0 + sx1) / 2.0f;
+    float sy          = (sy0 + sy1) / 2.0f;
+    float sw          = sx1 - sx0;
+    float sh          = sy1 - sy0;
+
+    // 目标中心和大小
+    float ex          = (ex0 + ex1) / 2.0f;
+    float ey          = (ey0 + ey1) / 2.0f;
+    float ew          = ex1 - ex0;
+    float eh          = ey1 - ey0;
+
+    // 当前中心位置
+    float cx          = sx + (ex - sx) * posFactor;
+    float cy          = sy + (ey - sy) * posFactor;
+
+    // 当前宽高
+    float w           = (sw + (ew - sw) * posFactor) * scaleFactor;
+    float h           = (sh + (eh - sh) * posFactor) * scaleFactor;
+
+    // 当前矩形
+    r.x0              = (uint8_t)(cx - w / 2.0f);
+    r.y0              = (uint8_t)(cy - h / 2.0f);
+    r.x1              = (uint8_t)(cx + w / 2.0f);
+    r.y1              = (uint8_t)(cy + h / 2.0f);
+
+    return r;
+}
+
+/**
+ * @brief 在图形缓冲区中打印单个字符
+ *
+ * @param x 左下角X坐标
+ * @param y 左下角Y坐标
+ * @param fontByte 字符对应的字模数据
+ * @param buffer 图形缓冲区
+ */
+static void baselinePrintChar(uint8_t x, uint8_t y, const uint8_t fontByte[16], uint8_t buffer[8][128]) {
+    if (x > 120 || y > 63) {
+        return; // 越界检查
+    }
+
+    uint8_t page      = y / 8;     // 起始页（从下往上）
+    uint8_t bitOffset = 8 - y % 8; // 像素行偏移（不为0说明跨页）
+
+    for (uint8_t i = 0; i < 8; i++) {    // 字符列数 = 8
+        uint8_t lower = fontByte[i];     // 字模下半部分（低位）
+        uint8_t upper = fontByte[i + 8]; // 字模上半部分（高位）
+
+        // 合成到页 buffer 中（注意跨页处理）
+        if (bitOffset == 0) {
+            // 恰好对齐页边界
+            buffer[page - 1][x + i] |= lower;
+            if (page - 2 >= 0) {
+                buffer[page - 2][x + i] |= upper;
+            }
+        } else {
+            // 跨页，需要移位叠加
+            uint8_t lowerShifted = lower >> bitOffset;
+            uint8_t upperShifted = (upper >> bitOffset) | (lower << (8 - bitOffset));
+            uint8_t top          = upper << (8 - bitOffset);
+
+            buffer[page][x + i] |= lowerShifted;
+            buffer[page - 1][x + i] |= upperShifted;
+            if (page - 2 >= 0) {
+                buffer[page - 2][x + i] |= top;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 在图形缓冲区中在一定范围内居中打印字符串
+ *
+ * @param buffer 图形缓冲区
+ * @param str 要打印的字符串
+ * @param startX // 打印起始X坐标
+ * @param startY // 打印起始Y坐标
+ * @param endX // 打印结束X坐标
+ * @param endY // 打印结束Y坐标
+ * @note 字符串会在指定范围内水平和垂直居中对齐
+ */
+void baselinePrintString(uint8_t buffer[PAGE][WIDTH], const char* str, uint8_t startX, uint8_t startY, uint8_t endX,
+                         uint8_t endY) {
+    uint8_t totalWidth  = 0; // 当前字符串总宽度
+    uint8_t totalHeight = 0; // 当前字符串总高度
+    for (uint8_t i = 0; str[i] != '\0'; i++) {
+        for (uint8_t j = 0; j < sizeof(font) / sizeof(BaselineFontTypeDef); j++) {
+            if (str[i] == font[j].character) {
+                totalWidth += font[j].width; // 累加字符宽度
+                if (font[j].height > totalHeight) {
+                    totalHeight = font[j].height; // 更新总高度
+                }
+                break;
+            }
+        }
+    }
+
+    uint8_t offsetX = 0;
+    uint8_t offsetY = 0;
+
+
+    if (totalWidth < (endX - startX)) {
+        offsetX = (endX - startX - totalWidth) / 2; // 水平居中
+    }
+
+
+    if (totalHeight < (startY - endY)) {
+        offsetY = (startY - endY - totalHeight) / 2; // 垂直居中
+    }
+
+    uint8_t cursor = startX + offsetX;
+    uint8_t charY  = startY - offsetY; // 字符的起始Y坐标
+
+    for (uint8_t i = 0; str[i] != '\0'; i++) {
+        if (str[i] == ' ') {
+            cursor += 4; // 空格宽度为4
+            continue;    // 跳过空格
+        }
+        for (uint8_t j = 0; j < sizeof(font) / sizeof(BaselineFontTypeDef); j++) {
+            if (str[i] == font[j].character) {
+                // 计算字符在缓冲区中的起始位置
+                // 打印字符到缓冲区
+                baselinePrintChar(cursor, charY, font[j].fontByte, buffer);
+                cursor += font[j].width; // 更新光标位置
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : baseline.h
+ * @brief          : 基线版本的图形函数
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 优化前的实现原样保留于此, 作为各测试的参考输出和耗时基准. 基线以每像素一字节的点阵图绘制,
+ * 再整体转换为页格式
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __BASELINE_H__
+#define __BASELINE_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+
+
+
+
+/*-------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef uint8_t DotMatrixTypeDef[HEIGHT][WIDTH]; // 每像素一字节的点阵图
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+void baselineBitToByte(DotMatrixTypeDef dotMatrix, uint8_t graphBuffer[PAGE][WIDTH]);
+void baselineRoundRect(DotMatrixTypeDef dotMatrix, uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY,
+                       uint8_t radius, uint8_t padding);
+void baselineInvertWithMask(DotMatrixTypeDef mask, uint8_t buffer[PAGE][WIDTH]);
+void baselinePrintString(uint8_t buffer[PAGE][WIDTH], const char* str, uint8_t startX, uint8_t startY, uint8_t endX,
+                         uint8_t endY);
+RectParamTypeDef baselineAnimateRect(uint8_t sx0, uint8_t sy0, uint8_t sx1, uint8_t sy1, uint8_t ex0, uint8_t ey0,
+                                     uint8_t ex1, uint8_t ey1, float progress);
+
+
+
+
+#endif /* __BASELINE_H__ */
@@ -0,0 +1,26 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : graph-ref.c
+ * @brief          : 图形服务的参考实现
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 以编译开关关闭优化分支后再编译一份graph-service.c, 接口改名为graphServIntfRef, 与正常编译的graphServIntf
+ * 链接到同一测试程序中逐字节比较. 两份实现各自持有裁剪矩形和脏页表绑定, 测试时需分别设置
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-ref.h"
+
+#define GRAPH_WORD_TRANSPOSE 0 // bitToByte使用逐像素转换
+#define graphServIntf        graphServIntfRef
+
+#include "graph-service.c"
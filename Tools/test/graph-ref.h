@@ -0,0 +1,40 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : graph-ref.h
+ * @brief          : 图形服务的参考实现
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * None
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __GRAPH_REF_H__
+#define __GRAPH_REF_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+extern GraphServIntfTypeDef graphServIntfRef; // 关闭优化分支编译的graph-service.c
+
+
+
+
+#endif /* __GRAPH_REF_H__ */
@@ -0,0 +1,387 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : sim-oled.c
+ * @brief          : 主机端IIC总线与SSD1306屏幕模拟
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 屏幕模拟只实现驱动使用到的命令: 水平寻址模式下的列/页地址窗口, 显示起始行, 硬件滚动的设置与停止,
+ * 以及初始化序列中的各配置命令(只检查参数个数). 未知的控制字节或命令计入simPanel.errors
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "sim-oled.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    uint8_t cmd;       // 等待参数的命令
+    uint8_t remain;    // 剩余参数个数
+    uint8_t param[6];  // 已收到的参数
+    uint8_t count;     // 已收到的参数个数
+    uint8_t col0;      // 列地址窗口
+    uint8_t col1;
+    uint8_t page0;     // 页地址窗口
+    uint8_t page1;
+    uint8_t col;       // 数据写入位置
+    uint8_t page;
+} SimControllerTypeDef; // SSD1306命令解析状态
+
+
+
+
+
+/* ------- function prototypes ---------------------------------------------------------------------------------------*/
+
+static IICErrCode simIicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA, GPIOPinEnum SDA_Pin,
+                             GPIOPortEnum SCL, GPIOPinEnum SCL_Pin, uint16_t txBufferSize, uint16_t rxBufferSize,
+                             uint16_t timeoutMs, uint32_t speed);
+static IICErrCode simIicTransmit(IICObjTypeDef* iicObj);
+static IICErrCode simIicSuccess(IICObjTypeDef* iicObj);
+static IICErrCode simIicSetClock(IICObjTypeDef* iicObj, uint32_t speed, IICDutyEnum duty, uint8_t overclock);
+static IICErrCode simIicSubmit(IICObjTypeDef* iicObj, const IICXferTypeDef* xfer);
+static void simIicPoll(IICObjTypeDef* iicObj);
+static void simBusTransfer(const uint8_t* data, uint16_t len);
+static void simCommand(uint8_t byte);
+static void simData(uint8_t byte);
+static void simDelay(uint32_t value);
+static float simGetGlobalTime(void);
+static SoftTimerHandle simSoftTimerRegister(void);
+static float simGetElapsedTime(SoftTimerHandle handle);
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+IICIntfTypeDef iicIntf = {
+    .init              = simIicInit,
+    .transmit          = simIicTransmit,
+    .equippedWithDMA   = simIicSuccess,
+    .setClock          = simIicSetClock,
+    .equippedWithQueue = simIicSuccess,
+    .submit            = simIicSubmit,
+    .poll              = simIicPoll,
+};
+
+TimeServIntfTypeDef timeServIntf = {
+    .delayUs           = simDelay,
+    .delayMs           = simDelay,
+    .delaySec          = simDelay,
+    .getGlobalTime     = simGetGlobalTime,
+    .softTimerRegister = simSoftTimerRegister,
+    .getElapsedTime    = simGetElapsedTime,
+};
+
+SimPanelTypeDef simPanel;
+float simElapsed = 0.02f;
+
+static SimControllerTypeDef controller = {.col1 = 127, .page1 = 7};
+
+static IICXferTypeDef queue[IIC_QUEUE_SIZE]; // 模拟传输队列
+static uint8_t queueHead;
+static uint8_t queueCount;
+static uint8_t async;      // 1: 传输由测试逐个完成
+static uint8_t completing; // 正在完成传输, 回调中提交的传输留给外层循环
+static uint32_t failEvery; // 每failEvery次传输失败一次, 0表示不失败
+static uint32_t xferCount;
+static uint32_t busSpeed = 400000; // 模拟时间使用的总线速率
+static double busTime;             // 模拟时间(秒)
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 设置传输完成方式
+ *
+ * @param mode 0: 提交即完成(含回调中继续提交的传输); 1: 留在队列中, 由simIicComplete或iicIntf.poll逐个完成
+ */
+void simIicSetAsync(uint8_t mode) { async = mode; }
+
+/**
+ * @brief 设置传输失败的频率, 失败的传输不写入屏幕, 回调收到IIC_ERR_NACK
+ *
+ * @param n 每n次传输失败一次, 0表示不失败
+ */
+void simIicFailEvery(uint32_t n) { failEvery = n; }
+
+/**
+ * @brief 队列中是否有未完成的传输
+ *
+ * @return uint8_t
+ */
+uint8_t simIicPending(void) { return queueCount != 0; }
+
+/**
+ * @brief 完成队首的传输并调用其回调
+ *
+ * @return uint8_t 队列为空时返回0
+ */
+uint8_t simIicComplete(void) {
+    if (queueCount == 0) {
+        return 0;
+    }
+
+    IICXferTypeDef xfer = queue[queueHead];
+    queueHead           = (queueHead + 1) % IIC_QUEUE_SIZE;
+    queueCount--;
+
+    IICErrCode status = IIC_SUCCESS;
+    if (failEvery != 0 && ++xferCount % failEvery == 0) {
+        status = IIC_ERR_NACK;
+    } else {
+        simBusTransfer(xfer.txData, xfer.txLen);
+    }
+
+    if (xfer.callback != NULL) {
+        xfer.callback(xfer.arg, status);
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 完成队列中的全部传输, 包括回调中新提交的传输
+ *
+ */
+void simIicDrain(void) {
+    while (simIicComplete()) {
+    }
+}
+
+/**
+ * @brief 模拟时间
+ *
+ * @return float 秒
+ */
+float simTime(void) { return (float)busTime; }
+
+/**
+ * @brief 屏幕上显示的像素, 按显示起始行循环平移显存
+ *
+ * @param shown 第y行第x列为1表示点亮
+ */
+void simPanelShown(uint8_t shown[64][128]) {
+    for (uint8_t row = 0; row < 64; row++) {
+        uint8_t line = (row + simPanel.startLine) & 63;
+        for (uint8_t x = 0; x < 128; x++) {
+            shown[row][x] = (simPanel.gddram[line >> 3][x] >> (line & 7)) & 1;
+        }
+    }
+}
+
+/**
+ * @brief 屏幕的显存和显示起始行是否与画布一致
+ *
+ * @param canvas 屏幕尺寸的画布
+ * @param startLine 期望的显示起始行
+ * @return uint8_t
+ */
+uint8_t simPanelEquals(const CanvasTypeDef* canvas, uint8_t startLine) {
+    for (uint8_t page = 0; page < 8; page++) {
+        if (memcmp(simPanel.gddram[page], CANVAS_PAGE(canvas, page), 128) != 0) {
+            return 0;
+        }
+    }
+    return simPanel.startLine == startLine;
+}
+
+/**
+ * @brief 初始化IIC对象, 只分配发送缓冲区
+ *
+ */
+static IICErrCode simIicInit(IICObjTypeDef* iicObj, IICImplTypeEnum type, GPIOPortEnum SDA, GPIOPinEnum SDA_Pin,
+                             GPIOPortEnum SCL, GPIOPinEnum SCL_Pin, uint16_t txBufferSize, uint16_t rxBufferSize,
+                             uint16_t timeoutMs, uint32_t speed) {
+    memset(iicObj, 0, sizeof(IICObjTypeDef));
+    iicObj->type         = type;
+    iicObj->txBuffer     = malloc(txBufferSize);
+    iicObj->txBufferSize = txBufferSize;
+    iicObj->speed        = speed;
+    busSpeed             = speed;
+
+    return iicObj->txBuffer != NULL ? IIC_SUCCESS : IIC_ERR_MEM_ALLOC_FAIL;
+}
+
+/**
+ * @brief 阻塞发送txBuffer[txIndex]起的txLen字节
+ *
+ */
+static IICErrCode simIicTransmit(IICObjTypeDef* iicObj) {
+    simBusTransfer(iicObj->txBuffer + iicObj->txIndex, iicObj->txLen);
+    return IIC_SUCCESS;
+}
+
+static IICErrCode simIicSuccess(IICObjTypeDef* iicObj) {
+    (void)iicObj;
+    return IIC_SUCCESS;
+}
+
+/**
+ * @brief 记录速率, 用于推进模拟时间
+ *
+ */
+static IICErrCode simIicSetClock(IICObjTypeDef* iicObj, uint32_t speed, IICDutyEnum duty, uint8_t overclock) {
+    (void)overclock;
+    iicObj->speed = speed;
+    iicObj->duty  = duty;
+    busSpeed      = speed;
+    return IIC_SUCCESS;
+}
+
+/**
+ * @brief 加入模拟传输队列
+ *
+ */
+static IICErrCode simIicSubmit(IICObjTypeDef* iicObj, const IICXferTypeDef* xfer) {
+    (void)iicObj;
+    if (queueCount >= IIC_QUEUE_SIZE) {
+        return IIC_ERR_BUSY;
+    }
+
+    queue[(queueHead + queueCount) % IIC_QUEUE_SIZE] = *xfer;
+    queueCount++;
+
+    if (!async && !completing) {
+        completing = 1;
+        simIicDrain();
+        completing = 0;
+    }
+
+    return IIC_SUCCESS;
+}
+
+/**
+ * @brief 异步模式下每次查询完成一个传输, 模拟等待期间总线上的进展
+ *
+ */
+static void simIicPoll(IICObjTypeDef* iicObj) {
+    (void)iicObj;
+    simIicComplete();
+}
+
+/**
+ * @brief 一次传输到达屏幕: 推进模拟时间, 按控制字节解析命令和数据
+ *
+ * @param data 传输内容
+ * @param len 字节数
+ */
+static void simBusTransfer(const uint8_t* data, uint16_t len) {
+    simPanel.transfers++;
+    simPanel.bytes += len;
+    busTime += (double)(len * 9 + SIM_XFER_OVERHEAD_BITS) / busSpeed;
+
+    uint16_t i = 0;
+    while (i < len) {
+        uint8_t control = data[i++];
+
+        if (control == 0x80 || control == 0xC0) {
+            if (i < len) {
+                (control == 0x80 ? simCommand : simData)(data[i++]); // 单字节, 其后还有控制字节
+            }
+        } else if (control == 0x00 || control == 0x40) {
+            while (i < len) {
+                (control == 0x00 ? simCommand : simData)(data[i++]); // 其后全部为命令或数据
+            }
+        } else {
+            simPanel.errors++;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 解析一个命令字节
+ *
+ * @param byte
+ */
+static void simCommand(uint8_t byte) {
+    SimControllerTypeDef* c = &controller;
+
+    if (c->remain > 0) {
+        c->param[c->count++] = byte;
+        if (--c->remain > 0) {
+            return;
+        }
+
+        switch (c->cmd) {
+            case 0x21:
+                c->col0 = c->param[0] & 127;
+                c->col1 = c->param[1] & 127;
+                c->col  = c->col0;
+                break;
+            case 0x22:
+                c->page0 = c->param[0] & 7;
+                c->page1 = c->param[1] & 7;
+                c->page  = c->page0;
+                break;
+            default: break; // 其余带参数的命令只影响显示效果
+        }
+        return;
+    }
+
+    c->cmd   = byte;
+    c->count = 0;
+
+    if (byte >= 0x40 && byte <= 0x7F) {
+        simPanel.startLine = byte & 63;
+    } else if (byte == 0x21 || byte == 0x22 || byte == 0xA3) {
+        c->remain = 2;
+    } else if (byte == 0x26 || byte == 0x27) {
+        c->remain = 6;
+    } else if (byte == 0x20 || byte == 0x81 || byte == 0x8D || byte == 0xA8 || byte == 0xD3 || byte == 0xD5 ||
+               byte == 0xD9 || byte == 0xDA || byte == 0xDB) {
+        c->remain = 1;
+    } else if (byte == 0x2E) {
+        simPanel.scrolling = 0;
+    } else if (byte == 0x2F) {
+        simPanel.scrolling = 1;
+    } else if (!(byte == 0xAE || byte == 0xAF || (byte & 0xFE) == 0xA0 || byte == 0xC0 || byte == 0xC8 ||
+                 (byte & 0xFE) == 0xA4 || (byte & 0xFE) == 0xA6)) {
+        simPanel.errors++;
+    }
+}
+
+/**
+ * @brief 在水平寻址模式下写入一个数据字节
+ *
+ * @param byte
+ */
+static void simData(uint8_t byte) {
+    SimControllerTypeDef* c = &controller;
+
+    simPanel.gddram[c->page][c->col] = byte;
+    if (++c->col > c->col1) {
+        c->col = c->col0;
+        if (++c->page > c->page1) {
+            c->page = c->page0;
+        }
+    }
+}
+
+static void simDelay(uint32_t value) { (void)value; }
+
+static float simGetGlobalTime(void) { return (float)busTime; }
+
+static SoftTimerHandle simSoftTimerRegister(void) { return 1; }
+
+static float simGetElapsedTime(SoftTimerHandle handle) {
+    (void)handle;
+    return simElapsed;
+}
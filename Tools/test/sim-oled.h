@@ -0,0 +1,81 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : sim-oled.h
+ * @brief          : 主机端IIC总线与SSD1306屏幕模拟
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 代替drv-iic.c和time-service.c链接到测试程序中, 使drv-oled.c可以在主机上运行:
+ * 1. iicIntf的异步传输进入模拟队列, 同步模式下提交即完成, 异步模式下由测试调用simIicComplete逐个完成,
+ *    以模拟DMA与渲染并行; 完成时按控制字节解析数据, 写入模拟屏幕的显存
+ * 2. 模拟时间按总线速率和传输字节数推进, timeServIntf.getGlobalTime返回该时间
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __SIM_OLED_H__
+#define __SIM_OLED_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "drv-iic.h"
+#include "graph-service.h"
+#include "time-service.h"
+
+
+
+
+/*-------- define ----------------------------------------------------------------------------------------------------*/
+
+#define SIM_XFER_OVERHEAD_BITS 20 // 每次传输除数据外的位数: START, 地址字节(9位), STOP, 以及中断切换的空闲
+
+
+
+
+/*-------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    uint8_t gddram[8][128]; // 显存, 与SSD1306的页格式一致
+    uint8_t startLine;      // 显示起始行
+    uint8_t scrolling;      // 硬件滚动是否激活
+    uint32_t transfers;     // 完成的传输数
+    uint32_t bytes;         // 传输的字节数, 包含控制字节, 不含地址字节
+    uint32_t errors;        // 无法解析的命令数
+} SimPanelTypeDef;          // 模拟SSD1306屏幕
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+extern SimPanelTypeDef simPanel;
+extern float simElapsed; // timeServIntf.getElapsedTime的返回值, 由测试设置
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+void simIicSetAsync(uint8_t async);
+void simIicFailEvery(uint32_t n);
+uint8_t simIicPending(void);
+uint8_t simIicComplete(void);
+void simIicDrain(void);
+float simTime(void);
+void simPanelShown(uint8_t shown[64][128]);
+uint8_t simPanelEquals(const CanvasTypeDef* canvas, uint8_t startLine);
+
+
+
+
+#endif /* __SIM_OLED_H__ */
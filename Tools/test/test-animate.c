@@ -0,0 +1,156 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-animate.c
+ * @brief          : 定点矩形过渡动画与浮点版本的比较
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 随机起止矩形(屏幕范围内), 进度以1/1024步长扫过[0, 1], 另加随机进度和越界进度, 每个坐标与基线的浮点实现
+ *    相差不超过1像素; 进度为0和1时结果与起止矩形完全相同
+ * 2. 固定一对矩形, 进度扫过全部Q15取值
+ * 3. 给出每次调用的耗时; 主机带FPU, 浮点版本的耗时不代表M3上的软浮点, 片上周期数见main.c中的debugInfo
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "baseline.h"
+#include "test-common.h"
+#include <stdlib.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define RECT_COUNT     20000 // 随机矩形对数量
+#define PROGRESS_STEPS 1024  // 每对矩形的进度步数
+#define MAX_ERROR      1     // 允许的最大误差(像素)
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static uint32_t worstError; // 观测到的最大误差
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 生成屏幕范围内的随机矩形
+ *
+ * @param rect
+ */
+static void randomRect(RectParamTypeDef* rect) {
+    rect->x0 = (uint8_t)testRange(0, WIDTH - 1);
+    rect->x1 = (uint8_t)testRange(rect->x0, WIDTH - 1);
+    rect->y0 = (uint8_t)testRange(0, HEIGHT - 1);
+    rect->y1 = (uint8_t)testRange(rect->y0, HEIGHT - 1);
+}
+
+/**
+ * @brief 比较一组参数下定点与浮点版本的结果
+ *
+ * @param s 起始矩形
+ * @param e 结束矩形
+ * @param progress
+ */
+static void checkOne(const RectParamTypeDef* s, const RectParamTypeDef* e, float progress) {
+    RectParamTypeDef actual = graphServIntf.animateMovingResizingRect(s->x0, s->y0, s->x1, s->y1, e->x0, e->y0, e->x1,
+                                                                      e->y1, progress);
+    RectParamTypeDef expect = baselineAnimateRect(s->x0, s->y0, s->x1, s->y1, e->x0, e->y0, e->x1, e->y1, progress);
+    uint32_t error          = abs(actual.x0 - expect.x0);
+
+    error = error > (uint32_t)abs(actual.y0 - expect.y0) ? error : (uint32_t)abs(actual.y0 - expect.y0);
+    error = error > (uint32_t)abs(actual.x1 - expect.x1) ? error : (uint32_t)abs(actual.x1 - expect.x1);
+    error = error > (uint32_t)abs(actual.y1 - expect.y1) ? error : (uint32_t)abs(actual.y1 - expect.y1);
+    if (error > worstError) {
+        worstError = error;
+    }
+
+    TEST_EXPECT(error <= MAX_ERROR,
+                "(%u,%u)-(%u,%u) -> (%u,%u)-(%u,%u) at %.6f: (%u,%u)-(%u,%u), float (%u,%u)-(%u,%u)", s->x0, s->y0,
+                s->x1, s->y1, e->x0, e->y0, e->x1, e->y1, progress, actual.x0, actual.y0, actual.x1, actual.y1,
+                expect.x0, expect.y0, expect.x1, expect.y1);
+}
+
+/**
+ * @brief 进度为0和1时结果应与起止矩形完全相同
+ *
+ * @param s 起始矩形
+ * @param e 结束矩形
+ */
+static void checkEnds(const RectParamTypeDef* s, const RectParamTypeDef* e) {
+    RectParamTypeDef r0 = graphServIntf.animateMovingResizingRect(s->x0, s->y0, s->x1, s->y1, e->x0, e->y0, e->x1,
+                                                                  e->y1, 0.0f);
+    RectParamTypeDef r1 = graphServIntf.animateMovingResizingRect(s->x0, s->y0, s->x1, s->y1, e->x0, e->y0, e->x1,
+                                                                  e->y1, 1.0f);
+
+    TEST_EXPECT(r0.x0 == s->x0 && r0.y0 == s->y0 && r0.x1 == s->x1 && r0.y1 == s->y1,
+                "progress 0: (%u,%u)-(%u,%u) instead of (%u,%u)-(%u,%u)", r0.x0, r0.y0, r0.x1, r0.y1, s->x0, s->y0,
+                s->x1, s->y1);
+    TEST_EXPECT(r1.x0 == e->x0 && r1.y0 == e->y0 && r1.x1 == e->x1 && r1.y1 == e->y1,
+                "progress 1: (%u,%u)-(%u,%u) instead of (%u,%u)-(%u,%u)", r1.x0, r1.y0, r1.x1, r1.y1, e->x0, e->y0,
+                e->x1, e->y1);
+}
+
+int main(void) {
+    RectParamTypeDef s;
+    RectParamTypeDef e;
+    uint32_t count = 0;
+
+    // 1. 随机矩形对
+    for (uint32_t i = 0; i < RECT_COUNT; i++) {
+        randomRect(&s);
+        randomRect(&e);
+        checkEnds(&s, &e);
+        for (uint32_t step = 0; step <= PROGRESS_STEPS; step++, count++) {
+            checkOne(&s, &e, (float)step / PROGRESS_STEPS);
+        }
+        for (uint8_t j = 0; j < 16; j++, count++) {
+            checkOne(&s, &e, (float)testRand() / UINT32_MAX);
+        }
+        checkOne(&s, &e, -0.25f);
+        checkOne(&s, &e, 1.25f);
+        count += 2;
+    }
+
+    // 2. 全屏对角移动, 进度扫过全部Q15取值
+    s = (RectParamTypeDef){0, 0, 20, 10};
+    e = (RectParamTypeDef){WIDTH - 41, HEIGHT - 21, WIDTH - 1, HEIGHT - 1};
+    for (uint32_t q = 0; q <= 32768; q++, count++) {
+        checkOne(&s, &e, (float)q / 32768);
+    }
+
+    printf("compared %u calls, worst coordinate error %u px\n", count, worstError);
+
+    // 3. 耗时
+    volatile float progress = 0.37f;
+    double rate             = testCyclesPerNs();
+    double fixedNs          = TEST_BENCH({
+        RectParamTypeDef r = graphServIntf.animateMovingResizingRect(4, 4, 60, 20, 66, 40, 123, 59, progress);
+        testSink += r.x0;
+    });
+    double floatNs = TEST_BENCH({
+        RectParamTypeDef r = baselineAnimateRect(4, 4, 60, 20, 66, 40, 123, 59, progress);
+        testSink += r.x0;
+    });
+
+    printf("ns per call (host has an FPU; cycles on target are recorded in main.c debugInfo.animateCycles):\n");
+    printf("  Q15 table %6.1f ns (%4.0f cycles)  float cosf %6.1f ns (%4.0f cycles)\n", fixedNs, fixedNs * rate, floatNs,
+           floatNs * rate);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,301 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-blit.c
+ * @brief          : 位图blit与逐像素参考实现的比较
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 几种典型尺寸的精灵在0~15的全部行偏移和0~3的列对齐下, 以全部光栅操作绘制到随机内容的屏幕画布上,
+ *    与逐像素读取位图、逐像素修改画布的参考实现比较
+ * 2. 随机尺寸、随机位置(可部分或完全超出画布)、随机裁剪矩形的位图, 目标分别为屏幕画布、页带画布以及比屏幕宽、
+ *    页间有间隔的画布; 屏幕画布同时检查脏页表恰好覆盖位图与裁剪矩形的交集
+ * 3. 给出16x16精灵(行不对齐)和整屏位图(页对齐)的耗时, 与逐像素绘制比较
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include "test-common.h"
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define RANDOM_BLITS 60000 // 每种画布的随机位图数量
+#define BITMAP_MAX_W 255   // 位图最大宽度
+#define BITMAP_MAX_H 80    // 位图最大高度
+#define WIDE_WIDTH   200   // 宽画布的列数
+#define WIDE_STRIDE  208   // 宽画布相邻两页的间隔
+#define WIDE_PAGES   3     // 宽画布的页数
+#define WIDE_FIRST   2     // 宽画布第一页在屏幕中的页号
+#define ROP_COUNT    5     // 光栅操作数量
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static const char* ropName[ROP_COUNT] = {"COPY", "OR", "AND", "XOR", "MASK"};
+
+static uint8_t bitmap[2 * BITMAP_PAGES(BITMAP_MAX_H) * BITMAP_MAX_W]; // 位图及其后的掩码平面
+static PageCanvasTypeDef expectScreen, actualScreen;
+static uint8_t expectWide[WIDE_PAGES * WIDE_STRIDE], actualWide[WIDE_PAGES * WIDE_STRIDE];
+static uint8_t expectStrip[WIDTH], actualStrip[WIDTH];
+static DirtyMapTypeDef dirty;
+static uint32_t blitCount;
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 逐像素参考实现
+ *
+ * @param canvas 目标画布
+ * @param clip 裁剪矩形(包含边界)
+ * @param x
+ * @param y
+ * @param w
+ * @param h
+ * @param bits 页格式位图, RASTER_OP_MASK时其后紧跟掩码平面
+ * @param rop
+ */
+static void referenceBlit(const CanvasTypeDef* canvas, RectParamTypeDef clip, int x, int y, int w, int h,
+                          const uint8_t* bits, RasterOpEnum rop) {
+    const uint8_t* mask = bits + BITMAP_PAGES(h) * w;
+
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            int dx = x + i;
+            int dy = y + j;
+
+            if (dx < clip.x0 || dx > clip.x1 || dy < clip.y0 || dy > clip.y1 || dx >= canvas->width ||
+                dy < CANVAS_TOP(canvas) || dy > CANVAS_BOTTOM(canvas)) {
+                continue;
+            }
+
+            uint8_t s = (bits[(j >> 3) * w + i] >> (j & 7)) & 1;
+            uint8_t d = CANVAS_GET_PIXEL(canvas, dx, dy);
+            switch (rop) {
+                case RASTER_OP_COPY: d = s; break;
+                case RASTER_OP_OR: d |= s; break;
+                case RASTER_OP_AND: d &= s; break;
+                case RASTER_OP_XOR: d ^= s; break;
+                case RASTER_OP_MASK: d = ((mask[(j >> 3) * w + i] >> (j & 7)) & 1) ? s : d; break;
+            }
+            if (d) {
+                CANVAS_SET_PIXEL(canvas, dx, dy);
+            } else {
+                CANVAS_CLR_PIXEL(canvas, dx, dy);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 以随机内容填充
+ *
+ * @param data
+ * @param len
+ */
+static void randomFill(uint8_t* data, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) {
+        data[i] = (uint8_t)testRand();
+    }
+}
+
+/**
+ * @brief 以随机内容填充两份相同的画布数据
+ *
+ * @param expect
+ * @param actual
+ * @param len
+ */
+static void randomCanvas(uint8_t* expect, uint8_t* actual, uint16_t len) {
+    randomFill(expect, len);
+    memcpy(actual, expect, len);
+}
+
+/**
+ * @brief 在一对画布上分别以blit和参考实现绘制并比较
+ *
+ * @param expect 参考画布
+ * @param actual blit的画布
+ * @param len 画布数据长度
+ * @param clip 裁剪矩形
+ * @param x
+ * @param y
+ * @param w
+ * @param h
+ * @param rop
+ */
+static void checkBlit(const CanvasTypeDef* expect, const CanvasTypeDef* actual, uint16_t len, RectParamTypeDef clip,
+                      int16_t x, int16_t y, uint8_t w, uint8_t h, RasterOpEnum rop) {
+    referenceBlit(expect, clip, x, y, w, h, bitmap, rop);
+    graphServIntf.setClipRect(clip);
+    graphServIntf.blit(actual, x, y, w, h, bitmap, rop);
+    graphServIntf.resetClipRect();
+
+    blitCount++;
+    TEST_EXPECT(memcmp(expect->data, actual->data, len) == 0,
+                "%ux%u at (%d,%d) %s clip (%u,%u)-(%u,%u) on %ux%u canvas from page %u differs", w, h, x, y,
+                ropName[rop], clip.x0, clip.y0, clip.x1, clip.y1, actual->width, actual->height, actual->firstPage);
+}
+
+/**
+ * @brief 检查屏幕画布的脏页表恰好为位图与裁剪矩形的交集
+ *
+ * @param clip 裁剪矩形, 已与屏幕求交
+ * @param x
+ * @param y
+ * @param w
+ * @param h
+ */
+static void checkDirty(RectParamTypeDef clip, int16_t x, int16_t y, uint8_t w, uint8_t h) {
+    int x0 = x > clip.x0 ? x : clip.x0;
+    int y0 = y > clip.y0 ? y : clip.y0;
+    int x1 = x + w - 1 < clip.x1 ? x + w - 1 : clip.x1;
+    int y1 = y + h - 1 < clip.y1 ? y + h - 1 : clip.y1;
+
+    for (uint8_t page = 0; page < PAGE; page++) {
+        if (x0 > x1 || y0 > y1 || page < (y0 >> 3) || page > (y1 >> 3)) {
+            TEST_EXPECT(DIRTY_PAGE_CLEAN(&dirty, page), "%ux%u at (%d,%d): page %u marked dirty", w, h, x, y, page);
+        } else {
+            TEST_EXPECT(dirty.x0[page] == x0 && dirty.x1[page] == x1,
+                        "%ux%u at (%d,%d): page %u dirty %u-%u, not %d-%d", w, h, x, y, page, dirty.x0[page],
+                        dirty.x1[page], x0, x1);
+        }
+    }
+}
+
+/**
+ * @brief 随机裁剪矩形, 三分之二的情况不裁剪
+ *
+ * @return RectParamTypeDef
+ */
+static RectParamTypeDef randomClip(void) {
+    RectParamTypeDef clip = {0, 0, 0xFF, 0xFF};
+
+    if (testRand() % 3 == 0) {
+        clip.x0 = (uint8_t)testRange(0, WIDE_WIDTH - 1);
+        clip.x1 = (uint8_t)testRange(clip.x0, 0xFF);
+        clip.y0 = (uint8_t)testRange(0, HEIGHT - 1);
+        clip.y1 = (uint8_t)testRange(clip.y0, 0xFF);
+    }
+    return clip;
+}
+
+/**
+ * @brief 典型尺寸的精灵在全部行偏移和列对齐下的比较
+ *
+ */
+static void checkSprites(void) {
+    static const uint8_t sizes[][2] = {{8, 8}, {16, 16}, {13, 11}, {1, 1}, {32, 7}, {5, 24}};
+    CanvasTypeDef expect            = CANVAS_FROM_ARRAY(expectScreen);
+    CanvasTypeDef actual            = CANVAS_FROM_ARRAY(actualScreen);
+    RectParamTypeDef none           = {0, 0, 0xFF, 0xFF};
+
+    for (uint8_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint8_t w = sizes[s][0];
+        uint8_t h = sizes[s][1];
+
+        for (uint8_t rop = 0; rop < ROP_COUNT; rop++) {
+            for (int16_t y = 16; y < 32; y++) {
+                for (int16_t x = 40; x < 44; x++) {
+                    randomFill(bitmap, 2 * BITMAP_PAGES(h) * w);
+                    randomCanvas(expectScreen[0], actualScreen[0], sizeof(expectScreen));
+                    checkBlit(&expect, &actual, sizeof(expectScreen), none, x, y, w, h, (RasterOpEnum)rop);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 随机位图绘制到屏幕、页带和宽画布上
+ *
+ */
+static void checkRandom(void) {
+    CanvasTypeDef screenExpect = CANVAS_FROM_ARRAY(expectScreen);
+    CanvasTypeDef screenActual = CANVAS_FROM_ARRAY(actualScreen);
+    CanvasTypeDef wideExpect   = {expectWide, WIDE_WIDTH, WIDE_PAGES * 8, WIDE_STRIDE, WIDE_FIRST};
+    CanvasTypeDef wideActual   = {actualWide, WIDE_WIDTH, WIDE_PAGES * 8, WIDE_STRIDE, WIDE_FIRST};
+
+    graphServIntf.bindDirtyMap(&screenActual, &dirty);
+
+    for (uint32_t i = 0; i < RANDOM_BLITS; i++) {
+        uint8_t w                 = (uint8_t)testRange(1, i & 1 ? 24 : BITMAP_MAX_W);
+        uint8_t h                 = (uint8_t)testRange(1, i & 1 ? 24 : BITMAP_MAX_H);
+        int16_t x                 = (int16_t)testRange(-w - 2, WIDE_WIDTH + 2);
+        int16_t y                 = (int16_t)testRange(-h - 2, HEIGHT + 2);
+        RasterOpEnum rop          = (RasterOpEnum)(testRand() % ROP_COUNT);
+        RectParamTypeDef clip     = randomClip();
+        uint8_t page              = (uint8_t)testRange(0, PAGE - 1);
+        CanvasTypeDef stripExpect = CANVAS_STRIP(expectStrip, page);
+        CanvasTypeDef stripActual = CANVAS_STRIP(actualStrip, page);
+        RectParamTypeDef screen   = {clip.x0, clip.y0, clip.x1 < WIDTH ? clip.x1 : WIDTH - 1,
+                                     clip.y1 < HEIGHT ? clip.y1 : HEIGHT - 1};
+
+        randomFill(bitmap, 2 * BITMAP_PAGES(h) * w);
+
+        randomCanvas(expectScreen[0], actualScreen[0], sizeof(expectScreen));
+        graphServIntf.clearDirtyMap(&dirty);
+        checkBlit(&screenExpect, &screenActual, sizeof(expectScreen), clip, x, y, w, h, rop);
+        checkDirty(screen, x, y, w, h);
+
+        randomCanvas(expectStrip, actualStrip, sizeof(expectStrip));
+        checkBlit(&stripExpect, &stripActual, sizeof(expectStrip), clip, x, y, w, h, rop);
+
+        randomCanvas(expectWide, actualWide, sizeof(expectWide));
+        checkBlit(&wideExpect, &wideActual, sizeof(expectWide), clip, x, y, w, h, rop);
+    }
+}
+
+/**
+ * @brief 打印一种位图的blit与逐像素绘制的耗时
+ *
+ * @param name
+ * @param x
+ * @param y
+ * @param w
+ * @param h
+ * @param rop
+ */
+static void benchBlit(const char* name, int16_t x, int16_t y, uint8_t w, uint8_t h, RasterOpEnum rop) {
+    CanvasTypeDef canvas  = CANVAS_FROM_ARRAY(actualScreen);
+    RectParamTypeDef none = {0, 0, 0xFF, 0xFF};
+
+    double blitNs  = TEST_BENCH(graphServIntf.blit(&canvas, x, y, w, h, bitmap, rop));
+    double pixelNs = TEST_BENCH(referenceBlit(&canvas, none, x, y, w, h, bitmap, rop));
+
+    printf("  %-28s blit %8.1f ns  per-pixel %9.1f ns  speedup %5.1fx\n", name, blitNs, pixelNs, pixelNs / blitNs);
+}
+
+int main(void) {
+    checkSprites();
+    checkRandom();
+    printf("compared %u blits against the per-pixel reference\n", blitCount);
+
+    printf("ns per blit:\n");
+    randomFill(bitmap, sizeof(bitmap));
+    benchBlit("16x16 sprite at y=21, XOR", 40, 21, 16, 16, RASTER_OP_XOR);
+    benchBlit("16x16 sprite at y=21, MASK", 40, 21, 16, 16, RASTER_OP_MASK);
+    benchBlit("16x16 sprite at y=16, OR", 40, 16, 16, 16, RASTER_OP_OR);
+    benchBlit("128x64 screen at y=0, COPY", 0, 0, WIDTH, HEIGHT, RASTER_OP_COPY);
+    benchBlit("128x64 screen at y=3, COPY", 0, 3, WIDTH, HEIGHT, RASTER_OP_COPY);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,313 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-canvas.c
+ * @brief          : 画布描述符测试: 非屏幕尺寸画布与屏幕快速路径的一致性及耗时
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 以同样的随机绘图序列(全部坐标类绘图函数, 随机裁剪矩形)同时绘制到屏幕画布和以下画布:
+ *    页间隔136的128x64画布(通用路径), SH1106布局的132列画布, 128x32画布, 位于第3页的40x24小图块, 以及页带画布.
+ *    各画布中的像素与屏幕画布的对应区域相同, 画布以外的填充字节不被改写
+ * 2. 给出屏幕快速路径与页间隔136的通用路径中各绘图函数的耗时
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include "test-common.h"
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define STEPS       200000 // 随机绘图步数
+#define SENTINEL    0xA5   // 填充字节的内容
+#define WIDE_STRIDE 136    // 通用路径画布的页间隔
+#define SH1106_COLS 132    // SH1106的列数
+#define TILE_WIDTH  40     // 小图块宽度
+#define TILE_STRIDE 48     // 小图块页间隔
+#define TILE_PAGES  3      // 小图块页数
+#define TILE_FIRST  3      // 小图块第一页在屏幕中的页号
+#define HALF_PAGES  4      // 128x32画布的页数
+#define POLY_MAX    16     // 折线最大顶点数
+#define OP_COUNT    11     // 绘图操作种类数
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    const char* name;     // 画布名
+    CanvasTypeDef canvas; // 画布
+    uint16_t size;        // 数据长度, 含填充字节
+} CanvasCaseTypeDef;
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static PageCanvasTypeDef screen;               // 参考: 屏幕快速路径
+static PageCanvasTypeDef source;               // rasterOp和copyRect的源画布
+static uint8_t strided[PAGE * WIDE_STRIDE];    // 页间隔136的128x64画布
+static uint8_t sh1106[PAGE * SH1106_COLS];     // 132列画布
+static uint8_t half[HALF_PAGES * WIDTH];       // 128x32画布
+static uint8_t tile[TILE_PAGES * TILE_STRIDE]; // 小图块
+static uint8_t strip[WIDTH + 8];               // 页带画布, 其后8字节为填充
+static uint8_t bitmap[2 * 3 * 24];             // blit位图及掩码
+
+static CanvasCaseTypeDef canvasCase[] = {
+    {"128x64 stride 136", {strided, WIDTH, HEIGHT, WIDE_STRIDE, 0}, sizeof(strided)},
+    {"132x64 SH1106", {sh1106, SH1106_COLS, HEIGHT, SH1106_COLS, 0}, sizeof(sh1106)},
+    {"128x32", {half, WIDTH, HALF_PAGES * 8, WIDTH, 0}, sizeof(half)},
+    {"40x24 tile at page 3", {tile, TILE_WIDTH, TILE_PAGES * 8, TILE_STRIDE, TILE_FIRST}, sizeof(tile)},
+    {"strip", {strip, WIDTH, 8, WIDTH, 0}, sizeof(strip)},
+};
+
+#define CASE_COUNT (sizeof(canvasCase) / sizeof(canvasCase[0]))
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 画布中的字节是否属于画布(而非页间隔或页带之后的填充)
+ *
+ * @param c
+ * @param offset 数据中的偏移
+ * @return uint8_t
+ */
+static uint8_t inCanvas(const CanvasTypeDef* c, uint16_t offset) {
+    return offset / c->stride < BITMAP_PAGES(c->height) && offset % c->stride < c->width;
+}
+
+/**
+ * @brief 从屏幕画布复制画布覆盖的区域, 其余字节填为SENTINEL; 132列画布超出屏幕的列也填为SENTINEL
+ *
+ * @param cc
+ */
+static void syncFromScreen(CanvasCaseTypeDef* cc) {
+    CanvasTypeDef* c = &cc->canvas;
+
+    memset(c->data, SENTINEL, cc->size);
+    for (uint8_t page = c->firstPage; page < c->firstPage + BITMAP_PAGES(c->height); page++) {
+        memcpy(CANVAS_PAGE(c, page), screen[page], c->width < WIDTH ? c->width : WIDTH);
+    }
+}
+
+/**
+ * @brief 比较画布与屏幕画布的对应区域, 检查填充字节
+ *
+ * @param cc
+ * @param step
+ */
+static void compareWithScreen(const CanvasCaseTypeDef* cc, uint32_t step) {
+    const CanvasTypeDef* c = &cc->canvas;
+
+    for (uint16_t offset = 0; offset < cc->size; offset++) {
+        uint8_t page = c->firstPage + offset / c->stride;
+        uint8_t x    = offset % c->stride;
+
+        if (!inCanvas(c, offset) || x >= WIDTH) {
+            TEST_EXPECT(c->data[offset] == SENTINEL, "step %u: %s padding at page %u column %u written", step,
+                        cc->name, page, x);
+        } else {
+            TEST_EXPECT(c->data[offset] == screen[page][x], "step %u: %s differs at page %u column %u", step,
+                        cc->name, page, x);
+        }
+    }
+}
+
+/**
+ * @brief 随机矩形, 在屏幕内
+ *
+ * @return RectParamTypeDef
+ */
+static RectParamTypeDef randomRect(void) {
+    RectParamTypeDef r;
+
+    r.x0 = (uint8_t)testRange(0, WIDTH - 1);
+    r.x1 = (uint8_t)testRange(r.x0, WIDTH - 1);
+    r.y0 = (uint8_t)testRange(0, HEIGHT - 1);
+    r.y1 = (uint8_t)testRange(r.y0, HEIGHT - 1);
+    return r;
+}
+
+/**
+ * @brief 以当前随机状态在一块画布上执行一种绘图操作
+ *
+ * @param c 目标画布
+ * @param op 操作序号
+ * @param seed 操作参数的随机种子, 同一步骤在各画布上使用同样的参数
+ */
+static void drawOp(const CanvasTypeDef* c, uint8_t op, uint32_t seed) {
+    CanvasTypeDef src = CANVAS_FROM_ARRAY(source);
+    testSeed          = seed;
+
+    switch (op) {
+        case 0:
+            graphServIntf.drawLine(c, (uint8_t)testRange(0, 150), (uint8_t)testRange(0, 80),
+                                   (uint8_t)testRange(0, 150), (uint8_t)testRange(0, 80));
+            break;
+        case 1: {
+            PointTypeDef points[POLY_MAX];
+            uint16_t count = (uint16_t)testRange(1, POLY_MAX);
+            for (uint16_t i = 0; i < count; i++) {
+                points[i] = (PointTypeDef){(uint8_t)testRange(0, 140), (uint8_t)testRange(0, 72)};
+            }
+            graphServIntf.drawPolyline(c, points, count);
+            break;
+        }
+        case 2: {
+            RectParamTypeDef r = randomRect();
+            graphServIntf.fillRoundRect(c, r.x0, r.y0, r.x1, r.y1, (uint8_t)testRange(0, 8),
+                                        (RasterOpEnum)testRange(RASTER_OP_COPY, RASTER_OP_XOR));
+            break;
+        }
+        case 3: {
+            RectParamTypeDef r = randomRect();
+            graphServIntf.drawRoundRect2DotMatrix(c, r.x0, r.y0, r.x1, r.y1, (uint8_t)testRange(0, 6),
+                                                  (uint8_t)testRange(0, 2));
+            break;
+        }
+        case 4:
+            graphServIntf.drawStarDot(c, (uint8_t)testRange(0, WIDTH - 1), (uint8_t)testRange(0, HEIGHT - 1),
+                                      (uint8_t)testRange(1, 12));
+            break;
+        case 5: {
+            static const char* text[] = {"1000.0kHz", "3.3V", "180\xB0", "25"};
+            RectParamTypeDef r        = randomRect();
+            graphServIntf.printStringOnBuffer(c, testRand() & 1 ? &fontUI16 : &fontUI8, text[testRand() & 3], r.x0,
+                                              r.y0, r.x1, r.y1);
+            break;
+        }
+        case 6:
+            graphServIntf.blit(c, (int16_t)testRange(-20, WIDTH), (int16_t)testRange(-20, HEIGHT),
+                               (uint8_t)testRange(1, 24), (uint8_t)testRange(1, 24), bitmap,
+                               (RasterOpEnum)testRange(RASTER_OP_COPY, RASTER_OP_MASK));
+            break;
+        case 7:
+            graphServIntf.rasterOp(c, &src, randomRect(), (RasterOpEnum)testRange(RASTER_OP_COPY, RASTER_OP_XOR));
+            break;
+        case 8:
+            graphServIntf.copyRect(c, &src, randomRect());
+            break;
+        case 9:
+            graphServIntf.drawGraticule(c, randomRect(), (uint8_t)testRange(1, 32), (uint8_t)testRange(1, 8));
+            break;
+        default: {
+            uint8_t top[WIDTH], bottom[WIDTH];
+            uint8_t x     = (uint8_t)testRange(0, WIDTH - 1);
+            uint8_t count = (uint8_t)testRange(1, WIDTH - x);
+            for (uint8_t i = 0; i < count; i++) {
+                top[i]    = (uint8_t)testRange(0, HEIGHT - 1);
+                bottom[i] = (uint8_t)testRange(top[i], HEIGHT - 1);
+            }
+            graphServIntf.fillColumnSpans(c, x, count, top, bottom);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 随机绘图序列
+ *
+ */
+static void checkSequence(void) {
+    CanvasTypeDef reference    = CANVAS_FROM_ARRAY(screen);
+    uint32_t opCount[OP_COUNT] = {0};
+
+    for (uint16_t i = 0; i < sizeof(screen); i++) {
+        ((uint8_t*)screen)[i] = (uint8_t)testRand();
+        ((uint8_t*)source)[i] = (uint8_t)testRand();
+    }
+    for (uint16_t i = 0; i < sizeof(bitmap); i++) {
+        bitmap[i] = (uint8_t)testRand();
+    }
+    for (uint8_t i = 0; i < CASE_COUNT; i++) {
+        syncFromScreen(&canvasCase[i]);
+    }
+
+    for (uint32_t step = 0; step < STEPS; step++) {
+        uint32_t seed = testRand();
+        uint8_t op    = (uint8_t)(testRand() % OP_COUNT);
+
+        // 每64步整屏随机一次, 页带移到另一页
+        if (step % 64 == 0) {
+            canvasCase[4].canvas.firstPage = (uint8_t)testRange(0, PAGE - 1);
+            syncFromScreen(&canvasCase[4]);
+        }
+
+        RectParamTypeDef clip = {0, 0, 0xFF, 0xFF};
+        if (testRand() % 4 == 0) {
+            clip = randomRect();
+        }
+        clip.x1 = clip.x1 < WIDTH - 1 ? clip.x1 : WIDTH - 1; // 132列画布超出屏幕的列保持不变
+
+        graphServIntf.setClipRect(clip);
+        drawOp(&reference, op, seed);
+        for (uint8_t i = 0; i < CASE_COUNT; i++) {
+            drawOp(&canvasCase[i].canvas, op, seed);
+        }
+        graphServIntf.resetClipRect();
+        testSeed = seed ^ 0x9E3779B9u;
+
+        opCount[op]++;
+        for (uint8_t i = 0; i < CASE_COUNT; i++) {
+            compareWithScreen(&canvasCase[i], step);
+        }
+    }
+
+    printf("%u random steps on %u canvases, ops:", STEPS, (unsigned)CASE_COUNT);
+    for (uint8_t i = 0; i < OP_COUNT; i++) {
+        printf(" %u", opCount[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief 打印一种操作在屏幕快速路径与通用路径上的耗时
+ *
+ * @param name
+ * @param op
+ */
+static void benchOp(const char* name, uint8_t op) {
+    CanvasTypeDef fast    = CANVAS_FROM_ARRAY(screen);
+    CanvasTypeDef generic = canvasCase[0].canvas;
+    uint32_t seed         = 0x12345678;
+
+    double fastNs    = TEST_BENCH(drawOp(&fast, op, seed));
+    double genericNs = TEST_BENCH(drawOp(&generic, op, seed));
+
+    printf("  %-20s screen %7.1f ns  stride %u %7.1f ns  (%+.0f%%)\n", name, fastNs, WIDE_STRIDE, genericNs,
+           100.0 * (genericNs - fastNs) / fastNs);
+}
+
+int main(void) {
+    checkSequence();
+
+    printf("ns per call, fast path for the 128x64 screen vs the generic strided path (includes argument setup):\n");
+    benchOp("drawLine", 0);
+    benchOp("drawPolyline", 1);
+    benchOp("fillRoundRect", 2);
+    benchOp("printStringOnBuffer", 5);
+    benchOp("blit", 6);
+    benchOp("rasterOp", 7);
+
+    return TEST_RESULT();
+}
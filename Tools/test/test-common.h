@@ -0,0 +1,151 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-common.h
+ * @brief          : 主机端测试公共工具
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 各测试程序共用的断言, 伪随机数和计时工具. 测试以主机gcc编译固件源文件, 断言失败时打印位置并计数,
+ * 测试结束时以TEST_RESULT()返回非0退出码. 计时结果为主机上的纳秒数, 只用于比较同一主机上的新旧实现
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+
+#ifndef __TEST_COMMON_H__
+#define __TEST_COMMON_H__
+
+
+
+
+/*-------- includes --------------------------------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+
+
+
+/*-------- define ----------------------------------------------------------------------------------------------------*/
+
+#ifndef TEST_BENCH_MIN_NS
+#define TEST_BENCH_MIN_NS 200000000ULL // 每项基准的最短运行时间
+#endif /* TEST_BENCH_MIN_NS */
+
+
+
+
+/*-------- macro -----------------------------------------------------------------------------------------------------*/
+
+// 断言cond成立, 否则打印位置和格式化信息并计入失败数
+#define TEST_EXPECT(cond, ...)                                                                                         \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            testFailures++;                                                                                            \
+            if (testFailures <= 10) {                                                                                  \
+                printf("  FAIL %s:%d: ", __FILE__, __LINE__);                                                          \
+                printf(__VA_ARGS__);                                                                                   \
+                printf("\n");                                                                                          \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+// 重复执行stmt至少TEST_BENCH_MIN_NS, 返回每次执行的平均纳秒数(double)
+#define TEST_BENCH(stmt)                                                                                               \
+    ({                                                                                                                 \
+        uint64_t benchRuns  = 0;                                                                                       \
+        uint64_t benchStart = testNowNs();                                                                             \
+        uint64_t benchElapsed;                                                                                         \
+        do {                                                                                                           \
+            for (uint32_t benchI = 0; benchI < 64; benchI++) {                                                         \
+                stmt;                                                                                                  \
+            }                                                                                                          \
+            benchRuns += 64;                                                                                           \
+            benchElapsed = testNowNs() - benchStart;                                                                   \
+        } while (benchElapsed < TEST_BENCH_MIN_NS);                                                                    \
+        (double)benchElapsed / (double)benchRuns;                                                                      \
+    })
+
+// 打印失败数并返回退出码, 用于main的末尾
+#define TEST_RESULT()                                                                                                  \
+    (printf("%s: %s (%u failures)\n", __FILE__, testFailures ? "FAILED" : "passed", testFailures), testFailures != 0)
+
+
+
+
+/*-------- variables -------------------------------------------------------------------------------------------------*/
+
+static unsigned testFailures;    // 断言失败数
+static uint32_t testSeed = 1;    // 伪随机数状态
+static volatile uint32_t testSink; // 基准结果的去向, 防止被优化掉
+
+
+
+
+/*-------- function prototypes ---------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 单调时钟的当前时间
+ *
+ * @return uint64_t 纳秒
+ */
+static inline uint64_t testNowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 主机时间戳计数器每纳秒的计数, 用于将基准耗时折算为周期数
+ *
+ * @return double 首次调用时以50ms校准; 非x86主机返回0, 此时只打印纳秒数
+ * @note 时间戳计数器以标称频率计数, 折算结果为主机的近似周期数, 不代表Cortex-M3上的周期数
+ */
+static inline double testCyclesPerNs(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    static double rate;
+    if (rate == 0) {
+        uint64_t t0 = testNowNs();
+        uint64_t c0 = __builtin_ia32_rdtsc();
+        while (testNowNs() - t0 < 50000000ULL) {
+        }
+        rate = (double)(__builtin_ia32_rdtsc() - c0) / (double)(testNowNs() - t0);
+    }
+    return rate;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief xorshift32伪随机数, 各测试以固定种子开始, 结果可复现
+ *
+ * @return uint32_t
+ */
+static inline uint32_t testRand(void) {
+    testSeed ^= testSeed << 13;
+    testSeed ^= testSeed >> 17;
+    testSeed ^= testSeed << 5;
+    return testSeed;
+}
+
+/**
+ * @brief [lo, hi]内的伪随机整数
+ *
+ * @param lo
+ * @param hi
+ * @return int32_t
+ */
+static inline int32_t testRange(int32_t lo, int32_t hi) { return lo + (int32_t)(testRand() % (uint32_t)(hi - lo + 1)); }
+
+
+
+
+#endif /* __TEST_COMMON_H__ */
@@ -0,0 +1,199 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-decimate.c
+ * @brief          : 采样抽取的逐列比较与每秒抽取的采样点数
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. minMax以随机采样块(数量从1到多于列数的数倍, 交错存放的间隔1~3)与逐列独立计算范围的参考实现比较,
+ *    参考实现按注释的定义取每列的采样点并加入上一列的最后一个采样点
+ * 2. toRows与浮点计算四舍五入的行比较: 误差不超过1行, 0和满量程恰好映射到bottom和top行, 起止行不颠倒
+ * 3. 给出Y-t显示的采样块(256点, 两通道交错)和较长采样块每秒抽取的采样点数, 以及与参考实现的比较
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "decimate-service.h"
+#include "test-common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define RANDOM_BLOCKS 20000 // 随机采样块数量
+#define MAX_SAMPLES   4096  // 采样块的最大采样点数
+#define MAX_STRIDE    3     // 最大交错间隔
+#define ADC_MAX       4095  // 12位ADC满量程
+#define UI_BLOCK_LEN  256   // 与app-ui.h中UI_SCOPE_BLOCK_LEN相同
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static uint16_t samples[MAX_SAMPLES * MAX_STRIDE];
+static EnvelopeTypeDef expect, actual;
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 按定义逐列独立计算包络, 作为参考实现
+ *
+ * @param data 第一个采样点
+ * @param stride 相邻采样点间隔的元素数
+ * @param count 采样点数量, 不为0
+ * @param envelope 输出的包络
+ */
+static void referenceMinMax(const uint16_t* data, uint8_t stride, uint16_t count, EnvelopeTypeDef* envelope) {
+    for (uint16_t c = 0; c < ENVELOPE_COLUMNS; c++) {
+        uint16_t start = (uint32_t)c * count / ENVELOPE_COLUMNS;
+        uint16_t end   = (uint32_t)(c + 1) * count / ENVELOPE_COLUMNS;
+        uint16_t first = start > 0 ? start - 1 : 0; // 上一列的最后一个采样点
+        uint16_t lo    = data[first * stride];
+        uint16_t hi    = lo;
+
+        for (uint16_t i = start; i < end; i++) {
+            uint16_t value = data[i * stride];
+            lo             = value < lo ? value : lo;
+            hi             = value > hi ? value : hi;
+        }
+
+        envelope->min[c] = lo;
+        envelope->max[c] = hi;
+    }
+}
+
+/**
+ * @brief 以随机游走或全范围随机值填充采样块
+ *
+ * @param count 采样点数量
+ * @param stride 交错间隔, 其余通道填入与本通道无关的值
+ */
+static void fillSamples(uint16_t count, uint8_t stride) {
+    uint16_t value = (uint16_t)testRange(0, ADC_MAX);
+    uint8_t walk   = testRand() & 1;
+
+    for (uint32_t i = 0; i < (uint32_t)count * stride; i++) {
+        if (i % stride != 0) {
+            samples[i] = (uint16_t)testRand();
+        } else if (walk) {
+            int32_t next = value + testRange(-200, 200);
+            value        = (uint16_t)(next < 0 ? 0 : next > ADC_MAX ? ADC_MAX : next);
+            samples[i]   = value;
+        } else {
+            samples[i] = (uint16_t)testRange(0, ADC_MAX);
+        }
+    }
+}
+
+/**
+ * @brief 随机采样块的包络与参考实现比较
+ *
+ */
+static void checkMinMax(void) {
+    for (uint32_t n = 0; n < RANDOM_BLOCKS; n++) {
+        uint16_t count = (uint16_t)testRange(1, (n & 3) == 0 ? ENVELOPE_COLUMNS * 2 : MAX_SAMPLES);
+        uint8_t stride = (uint8_t)testRange(1, MAX_STRIDE);
+
+        fillSamples(count, stride);
+        referenceMinMax(samples, stride, count, &expect);
+        memset(&actual, 0x5A, sizeof(actual));
+        decimateServIntf.minMax(samples, stride, count, &actual);
+
+        TEST_EXPECT(memcmp(&expect, &actual, sizeof(expect)) == 0, "count %u stride %u: envelope differs", count,
+                    stride);
+    }
+}
+
+/**
+ * @brief 行映射与浮点计算比较
+ *
+ */
+static void checkToRows(void) {
+    uint8_t rowTop[ENVELOPE_COLUMNS], rowBottom[ENVELOPE_COLUMNS];
+    uint32_t exact = 0;
+    uint32_t total = 0;
+
+    for (uint32_t n = 0; n < RANDOM_BLOCKS / 10; n++) {
+        uint16_t fullScale = n == 0 ? ADC_MAX : (uint16_t)testRange(1, 0xFFFF);
+        uint8_t top        = (uint8_t)testRange(0, HEIGHT - 1);
+        uint8_t bottom     = (uint8_t)testRange(top, HEIGHT - 1);
+
+        for (uint8_t c = 0; c < ENVELOPE_COLUMNS; c++) {
+            uint16_t a    = (uint16_t)testRand();
+            uint16_t b    = (uint16_t)testRand();
+            actual.min[c] = a < b ? a : b;
+            actual.max[c] = a < b ? b : a;
+        }
+        actual.min[0] = 0;
+        actual.max[0] = fullScale;
+        decimateServIntf.toRows(&actual, fullScale, top, bottom, rowTop, rowBottom);
+
+        TEST_EXPECT(rowTop[0] == top && rowBottom[0] == bottom, "full scale %u: 0..full scale mapped to rows %u..%u",
+                    fullScale, rowTop[0], rowBottom[0]);
+        for (uint8_t c = 0; c < ENVELOPE_COLUMNS; c++) {
+            uint16_t hi  = actual.max[c] < fullScale ? actual.max[c] : fullScale;
+            uint16_t lo  = actual.min[c] < fullScale ? actual.min[c] : fullScale;
+            int32_t top0 = bottom - (int32_t)lround((double)hi * (bottom - top) / fullScale);
+            int32_t bot0 = bottom - (int32_t)lround((double)lo * (bottom - top) / fullScale);
+
+            TEST_EXPECT(abs(rowTop[c] - top0) <= 1 && abs(rowBottom[c] - bot0) <= 1 && rowTop[c] <= rowBottom[c],
+                        "full scale %u rows %u..%u: %u..%u mapped to %u..%u, expected %d..%d", fullScale, top, bottom,
+                        lo, hi, rowBottom[c], rowTop[c], bot0, top0);
+            exact += (rowTop[c] == top0) + (rowBottom[c] == bot0);
+            total += 2;
+        }
+    }
+    printf("toRows: %u of %u rows equal to the rounded exact value, the rest within one row\n", exact, total);
+}
+
+/**
+ * @brief 打印一种采样块的抽取速度
+ *
+ * @param name 采样块说明
+ * @param count 采样点数量
+ * @param stride 交错间隔
+ */
+static void benchMinMax(const char* name, uint16_t count, uint8_t stride) {
+    fillSamples(count, stride);
+
+    double ns          = TEST_BENCH(decimateServIntf.minMax(samples, stride, count, &actual));
+    double referenceNs = TEST_BENCH(referenceMinMax(samples, stride, count, &expect));
+    double cycles      = testCyclesPerNs() * ns / count;
+
+    testSink += actual.min[testSink & 0x7F] + expect.max[testSink & 0x7F];
+    printf("  %-28s minMax %7.1f M/s (%4.1f host cycles/sample)  per-column reference %7.1f M/s\n", name,
+           count / ns * 1e3, cycles, count / referenceNs * 1e3);
+}
+
+int main(void) {
+    checkMinMax();
+    printf("compared %u random blocks (1..%u samples, stride 1..%u) against a per-column reference\n", RANDOM_BLOCKS,
+           MAX_SAMPLES, MAX_STRIDE);
+    checkToRows();
+
+    printf("samples per second (the Y-t view needs 2 channels x 500 samples/s):\n");
+    benchMinMax("Y-t block 256, stride 2", UI_BLOCK_LEN, 2);
+    benchMinMax("128 samples, stride 1", ENVELOPE_COLUMNS, 1);
+    benchMinMax("4096 samples, stride 1", MAX_SAMPLES, 1);
+    benchMinMax("4096 samples, stride 3", MAX_SAMPLES, 3);
+
+    return TEST_RESULT();
+}
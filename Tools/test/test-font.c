@@ -0,0 +1,380 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-font.c
+ * @brief          : BDF字体编译测试
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 由bdf2font.py从Tools/fonts中的BDF重新生成字体(build/font-ui*.c)并链接到本测试, 检查与Services中提交的
+ *    字体源文件逐字节相同
+ * 2. 逐字形将生成的字形表和位图与直接读取BDF得到的度量和点阵比较; BDF中没有的字符在索引表中为FONT_GLYPH_NONE
+ * 3. 以printStringOnBuffer单独绘制每个字形, 画布上的墨迹与BDF点阵一致(平移后), 且在返回的区域内
+ * 4. 参数界面字段字符串以fontUI16绘制的结果与基线版本的固定8x16字模渲染相同, 每个字形的绘制耗时不超过基线版本
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "baseline.h"
+#include "graph-service.h"
+#include "test-common.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define BDF_ROWS_MAX     32    // 字形点阵的最大行数
+#define BENCH_BATCHES    20000 // 与基线版本交替测量的批数
+#define BENCH_BATCH_RUNS 16    // 每批绘制全部字段字符串的次数
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    uint8_t present;             // BDF中有该字符
+    uint8_t advance;             // DWIDTH
+    int8_t bbx[4];               // BBX: 宽, 高, x偏移, y偏移
+    uint32_t rows[BDF_ROWS_MAX]; // 点阵行, 最高位对齐到第31位, 为最左侧像素
+} BdfGlyphTypeDef;
+
+typedef struct {
+    const char* name;            // 字体名
+    const FontFaceTypeDef* face; // 生成的字体
+    const char* bdf;             // BDF源文件
+    const char* generated;       // 生成的字体源文件
+    const char* committed;       // 提交的字体源文件
+} FontCaseTypeDef;
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static const FontCaseTypeDef fontCase[] = {
+    {"fontUI16", &fontUI16, "../fonts/ui-16.bdf", "build/font-ui16.c", "../../Services/font-ui16.c"},
+    {"fontUI8", &fontUI8, "../fonts/ui-8.bdf", "build/font-ui8.c", "../../Services/font-ui8.c"},
+};
+
+static BdfGlyphTypeDef bdf[256];
+static int bdfAscent, bdfDescent;
+static PageCanvasTypeDef screen;
+static PageCanvasTypeDef baselineScreen;
+
+// 参数界面的字段字符串, 基线版本的度符号按UTF-8首字节匹配
+static const char* fields[]         = {"1000.0kHz", "3.3V", "180\xB0", "25.5kHz", "-12.5*"};
+static const char* baselineFields[] = {"1000.0kHz", "3.3V", "180\xC2\xB0", "25.5kHz", "-12.5*"};
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 读取整个文件
+ *
+ * @param path
+ * @param size 返回文件长度
+ * @return char* 以'\0'结尾的文件内容, 失败时返回NULL
+ */
+static char* readFile(const char* path, long* size) {
+    FILE* file = fopen(path, "rb");
+    char* text = NULL;
+
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    text = calloc(1, *size + 1);
+    if (fread(text, 1, *size, file) != (size_t)*size) {
+        free(text);
+        text = NULL;
+    }
+    fclose(file);
+
+    return text;
+}
+
+/**
+ * @brief 读取BDF中编码在0~255之间的字形
+ *
+ * @param path
+ * @return uint8_t 成功时返回1
+ */
+static uint8_t readBdf(const char* path) {
+    FILE* file = fopen(path, "r");
+    char line[256];
+    BdfGlyphTypeDef glyph;
+    int encoding = -1;
+    int rows     = -1; // 正在读取点阵时为已读行数
+
+    if (file == NULL) {
+        return 0;
+    }
+    memset(bdf, 0, sizeof(bdf));
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (rows >= 0) {
+            if (strncmp(line, "ENDCHAR", 7) == 0) {
+                if (encoding >= 0 && encoding <= 255) {
+                    glyph.present = 1;
+                    bdf[encoding] = glyph;
+                }
+                rows = -1;
+            } else if (rows < BDF_ROWS_MAX) {
+                uint8_t digits   = (uint8_t)strspn(line, "0123456789ABCDEFabcdef");
+                glyph.rows[rows] = (uint32_t)strtoul(line, NULL, 16) << (32 - 4 * digits);
+                rows++;
+            }
+        } else if (sscanf(line, "FONT_ASCENT %d", &bdfAscent) == 1 ||
+                   sscanf(line, "FONT_DESCENT %d", &bdfDescent) == 1) {
+            continue;
+        } else if (strncmp(line, "STARTCHAR", 9) == 0) {
+            memset(&glyph, 0, sizeof(glyph));
+            encoding = -1;
+        } else if (sscanf(line, "ENCODING %d", &encoding) == 1) {
+            continue;
+        } else if (strncmp(line, "DWIDTH", 6) == 0) {
+            glyph.advance = (uint8_t)atoi(line + 6);
+        } else if (strncmp(line, "BBX", 3) == 0) {
+            int w, h, x, y;
+            sscanf(line + 3, "%d %d %d %d", &w, &h, &x, &y);
+            glyph.bbx[0] = (int8_t)w;
+            glyph.bbx[1] = (int8_t)h;
+            glyph.bbx[2] = (int8_t)x;
+            glyph.bbx[3] = (int8_t)y;
+        } else if (strncmp(line, "BITMAP", 6) == 0) {
+            rows = 0;
+        }
+    }
+
+    fclose(file);
+    return 1;
+}
+
+/**
+ * @brief BDF字形在字形单元中的像素
+ *
+ * @param g
+ * @param col 位图列
+ * @param row 单元中的行, 0为单元最上方一行
+ * @return uint8_t
+ */
+static uint8_t bdfPixel(const BdfGlyphTypeDef* g, int col, int row) {
+    int r = row - (bdfAscent - (g->bbx[3] + g->bbx[1])); // 点阵中的行
+
+    if (col < 0 || col >= g->bbx[0] || r < 0 || r >= g->bbx[1]) {
+        return 0;
+    }
+    return (g->rows[r] >> (31 - col)) & 1;
+}
+
+/**
+ * @brief 生成的字体源文件与提交的相同
+ *
+ * @param fc
+ */
+static void checkSource(const FontCaseTypeDef* fc) {
+    long generatedSize, committedSize;
+    char* generated = readFile(fc->generated, &generatedSize);
+    char* committed = readFile(fc->committed, &committedSize);
+
+    TEST_EXPECT(generated != NULL && committed != NULL, "cannot read %s or %s", fc->generated, fc->committed);
+    if (generated != NULL && committed != NULL) {
+        TEST_EXPECT(generatedSize == committedSize && memcmp(generated, committed, generatedSize) == 0,
+                    "%s differs from bdf2font.py output for %s", fc->committed, fc->bdf);
+    }
+    free(generated);
+    free(committed);
+}
+
+/**
+ * @brief 字形表和位图与BDF一致
+ *
+ * @param fc
+ * @return uint16_t 字形数
+ */
+static uint16_t checkTables(const FontCaseTypeDef* fc) {
+    const FontFaceTypeDef* face = fc->face;
+    uint8_t pages               = BITMAP_PAGES(face->height);
+    uint16_t count              = 0;
+
+    TEST_EXPECT(face->height == bdfAscent + bdfDescent, "%s: height %u, BDF cell %d", fc->name, face->height,
+                bdfAscent + bdfDescent);
+
+    for (uint16_t code = 0; code < 256; code++) {
+        const BdfGlyphTypeDef* g = &bdf[code];
+        uint8_t inRange          = code >= face->firstChar && code <= face->lastChar;
+        uint8_t index            = inRange ? face->index[code - face->firstChar] : FONT_GLYPH_NONE;
+
+        if (!g->present) {
+            TEST_EXPECT(index == FONT_GLYPH_NONE, "%s: 0x%02X is not in the BDF but has glyph %u", fc->name, code,
+                        index);
+            continue;
+        }
+        TEST_EXPECT(index != FONT_GLYPH_NONE, "%s: 0x%02X is missing", fc->name, code);
+        if (index == FONT_GLYPH_NONE) {
+            continue;
+        }
+
+        const FontGlyphTypeDef* glyph = &face->glyph[index];
+        uint8_t box                   = g->bbx[1] ? bdfDescent + g->bbx[3] + g->bbx[1] : 0;
+
+        count++;
+        TEST_EXPECT(glyph->width == g->bbx[0] && glyph->advance == g->advance && glyph->xOffset == g->bbx[2] &&
+                        glyph->height == box,
+                    "%s: 0x%02X metrics {%u, %u, %u, %d}, BDF {%d, %u, %u, %d}", fc->name, code, glyph->width,
+                    glyph->height, glyph->advance, glyph->xOffset, g->bbx[0], box, g->advance, g->bbx[2]);
+
+        for (uint8_t col = 0; col < glyph->width; col++) {
+            for (uint8_t row = 0; row < face->height; row++) {
+                uint8_t byte = face->bitmap[(glyph->offset + col) * pages + (row >> 3)];
+                TEST_EXPECT(((byte >> (row & 7)) & 1) == bdfPixel(g, col, row), "%s: 0x%02X differs at (%u,%u)",
+                            fc->name, code, col, row);
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief 单独绘制每个字形, 墨迹平移后与BDF点阵一致且在返回区域内
+ *
+ * @param fc
+ */
+static void checkRender(const FontCaseTypeDef* fc) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(screen);
+
+    for (uint16_t code = 1; code < 256; code++) {
+        const BdfGlyphTypeDef* g = &bdf[code];
+        char str[2]              = {(char)code, '\0'};
+        int inkX = WIDTH, inkY = HEIGHT, bdfX = 32, bdfY = 32;
+        uint16_t ink = 0, bdfInk = 0;
+
+        if (!g->present) {
+            continue;
+        }
+
+        memset(screen, 0, sizeof(screen));
+        RectParamTypeDef area = graphServIntf.printStringOnBuffer(&canvas, fc->face, str, 10, 10, 100, 50);
+
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                if (CANVAS_GET_PIXEL(&canvas, x, y)) {
+                    inkX = x < inkX ? x : inkX;
+                    inkY = y < inkY ? y : inkY;
+                    ink++;
+                    TEST_EXPECT(x >= area.x0 && x <= area.x1 && y >= area.y0 && y <= area.y1,
+                                "%s: 0x%02X ink at (%d,%d) outside (%u,%u)-(%u,%u)", fc->name, code, x, y, area.x0,
+                                area.y0, area.x1, area.y1);
+                }
+            }
+        }
+        for (int row = 0; row < fc->face->height; row++) {
+            for (int col = 0; col < g->bbx[0]; col++) {
+                if (bdfPixel(g, col, row)) {
+                    bdfX = col < bdfX ? col : bdfX;
+                    bdfY = row < bdfY ? row : bdfY;
+                    bdfInk++;
+                }
+            }
+        }
+
+        TEST_EXPECT(ink == bdfInk, "%s: 0x%02X draws %u pixels, BDF has %u", fc->name, code, ink, bdfInk);
+        for (int row = 0; row < fc->face->height && ink != 0; row++) {
+            for (int col = 0; col < g->bbx[0]; col++) {
+                int x = inkX + col - bdfX;
+                int y = inkY + row - bdfY;
+                if (bdfPixel(g, col, row) && (x >= WIDTH || y >= HEIGHT || !CANVAS_GET_PIXEL(&canvas, x, y))) {
+                    TEST_EXPECT(0, "%s: 0x%02X pixel (%d,%d) of the BDF bitmap not drawn", fc->name, code, col, row);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 字段字符串与基线版本比较输出和耗时
+ *
+ */
+static void checkBaseline(void) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(screen);
+    uint8_t count        = sizeof(fields) / sizeof(fields[0]);
+    uint16_t glyphs      = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        glyphs += (uint16_t)strlen(fields[i]);
+        memset(screen, 0, sizeof(screen));
+        memset(baselineScreen, 0, sizeof(baselineScreen));
+        graphServIntf.printStringOnBuffer(&canvas, &fontUI16, fields[i], 32, 17, 76, 29);
+        baselinePrintString(baselineScreen, baselineFields[i], 32, 17, 76, 29);
+        TEST_EXPECT(memcmp(screen, baselineScreen, sizeof(screen)) == 0, "\"%s\" differs from the baseline",
+                    baselineFields[i]);
+    }
+
+    // 交替测量多批并各取最快的一批, 排除主机上其他任务抢占的影响
+    double ns         = 1e30;
+    double baselineNs = 1e30;
+    for (uint16_t batch = 0; batch < BENCH_BATCHES; batch++) {
+        uint64_t start = testNowNs();
+        for (uint8_t n = 0; n < BENCH_BATCH_RUNS; n++) {
+            for (uint8_t i = 0; i < count; i++) {
+                graphServIntf.printStringOnBuffer(&canvas, &fontUI16, fields[i], 32, 17, 76, 29);
+            }
+        }
+        uint64_t middle = testNowNs();
+        for (uint8_t n = 0; n < BENCH_BATCH_RUNS; n++) {
+            for (uint8_t i = 0; i < count; i++) {
+                baselinePrintString(baselineScreen, baselineFields[i], 32, 17, 76, 29);
+            }
+        }
+        uint64_t end = testNowNs();
+
+        ns         = middle - start < ns ? middle - start : ns;
+        baselineNs = end - middle < baselineNs ? end - middle : baselineNs;
+    }
+    ns /= BENCH_BATCH_RUNS;
+    baselineNs /= BENCH_BATCH_RUNS;
+
+    printf("fontUI16 field strings: %.1f ns per glyph, baseline 8x16 renderer %.1f ns per glyph\n", ns / glyphs,
+           baselineNs / glyphs);
+    TEST_EXPECT(ns <= baselineNs, "%.1f ns per glyph, slower than the baseline %.1f ns", ns / glyphs,
+                baselineNs / glyphs);
+}
+
+int main(void) {
+    for (uint8_t i = 0; i < sizeof(fontCase) / sizeof(fontCase[0]); i++) {
+        const FontCaseTypeDef* fc = &fontCase[i];
+
+        if (!readBdf(fc->bdf)) {
+            printf("cannot read %s\n", fc->bdf);
+            return 1;
+        }
+        checkSource(fc);
+        uint16_t glyphs = checkTables(fc);
+        checkRender(fc);
+        printf("%-8s %2u glyphs, %2u-row cell: tables, bitmaps and rendering match %s\n", fc->name, glyphs,
+               fc->face->height, fc->bdf);
+    }
+
+    checkBaseline();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,146 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-format.c
+ * @brief          : 定点格式化与sprintf的逐字节比较
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. formatInt与formatFixed(1~4位小数)在[-200000, 200000]内逐个整数, 以及边界值和随机int32_t,
+ *    与sprintf("%d")/("%.Nf")比较
+ * 2. 参数界面的三种字段: 频率和幅度范围内的每一个float经roundFixed和formatFixed格式化, 与基线的
+ *    sprintf("%.1fkHz")/("%.1f V")比较; 相位范围内的每个整数与sprintf("%d \xB0")比较
+ * 3. 给出格式化一个字段与sprintf的耗时
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "format-service.h"
+#include "test-common.h"
+#include <math.h>
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define INT_SWEEP    200000 // 逐个比较的整数范围
+#define RANDOM_COUNT 200000 // 随机int32_t数量
+
+// 参数界面的字段范围, 与app-ui.c一致
+#define FREQ_MAX  6.0f
+#define FREQ_MIN  1.0f
+#define AMP_MAX   3.3f
+#define AMP_MIN   1.5f
+#define PHASE_MAX 180
+#define PHASE_MIN 0
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static const int32_t power10[] = {1, 10, 100, 1000, 10000};
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 比较一个整数在各小数位数下的格式化结果
+ *
+ * @param value
+ */
+static void checkInteger(int32_t value) {
+    char expect[32];
+    char actual[32];
+    uint8_t len;
+
+    sprintf(expect, "%d%s", value, "Hz");
+    len = formatServIntf.formatInt(actual, value, "Hz");
+    TEST_EXPECT(strcmp(expect, actual) == 0 && len == strlen(expect), "formatInt(%d): \"%s\" vs \"%s\"", value, actual,
+                expect);
+
+    for (uint8_t decimals = 1; decimals <= FORMAT_DECIMALS_MAX; decimals++) {
+        sprintf(expect, "%.*f", decimals, (double)value / power10[decimals]);
+        len = formatServIntf.formatFixed(actual, value, decimals, NULL);
+        TEST_EXPECT(strcmp(expect, actual) == 0 && len == strlen(expect), "formatFixed(%d, %u): \"%s\" vs \"%s\"", value,
+                    decimals, actual, expect);
+    }
+}
+
+/**
+ * @brief 比较[lo, hi]内每一个float按字段格式化的结果
+ *
+ * @param lo
+ * @param hi
+ * @param suffix 单位后缀
+ * @return uint32_t 比较的float数量
+ */
+static uint32_t checkFloatRange(float lo, float hi, const char* suffix) {
+    char expect[32];
+    char actual[32];
+    uint32_t count = 0;
+
+    for (float value = lo; value <= hi; value = nextafterf(value, INFINITY), count++) {
+        sprintf(expect, "%.1f%s", value, suffix);
+        formatServIntf.formatFixed(actual, formatServIntf.roundFixed(value, 1), 1, suffix);
+        TEST_EXPECT(strcmp(expect, actual) == 0, "%.9g: \"%s\" vs \"%s\"", value, actual, expect);
+    }
+
+    return count;
+}
+
+int main(void) {
+    static const int32_t edges[] = {0, 1, -1, 9, -9, 10, -10, 99999, -99999, INT32_MAX, INT32_MIN, INT32_MIN + 1};
+
+    for (int32_t value = -INT_SWEEP; value <= INT_SWEEP; value++) {
+        checkInteger(value);
+    }
+    for (uint8_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+        checkInteger(edges[i]);
+    }
+    for (uint32_t i = 0; i < RANDOM_COUNT; i++) {
+        checkInteger((int32_t)testRand());
+    }
+
+    uint32_t freqCount = checkFloatRange(FREQ_MIN, FREQ_MAX, "kHz");
+    uint32_t ampCount  = checkFloatRange(AMP_MIN, AMP_MAX, " V");
+    printf("compared every float: %u in freq [%.1f, %.1f], %u in amp [%.1f, %.1f]\n", freqCount, FREQ_MIN, FREQ_MAX,
+           ampCount, AMP_MIN, AMP_MAX);
+
+    for (int32_t phase = PHASE_MIN; phase <= PHASE_MAX; phase++) {
+        char expect[32];
+        char actual[32];
+        sprintf(expect, "%d \xB0", phase);
+        formatServIntf.formatInt(actual, phase, " \xB0");
+        TEST_EXPECT(strcmp(expect, actual) == 0, "phase %d: \"%s\" vs \"%s\"", phase, actual, expect);
+    }
+
+    // 基准: 格式化一个频率字段
+    char str[32];
+    volatile float freq = 3.5f;
+    double fixedNs      = TEST_BENCH(testSink += formatServIntf.formatFixed(str, FORMAT_TO_TENTHS(freq), 1, "kHz"));
+    double sprintfNs    = TEST_BENCH(testSink += sprintf(str, "%.1fkHz", freq));
+    double intNs        = TEST_BENCH(testSink += formatServIntf.formatInt(str, (int32_t)freq * 30, " \xB0"));
+    double sprintfIntNs = TEST_BENCH(testSink += sprintf(str, "%d \xB0", (int32_t)freq * 30));
+
+    printf("ns per field:\n");
+    printf("  %%.1fkHz  roundFixed + formatFixed %6.1f  sprintf %6.1f  speedup %.1fx\n", fixedNs, sprintfNs,
+           sprintfNs / fixedNs);
+    printf("  %%d \\xB0   formatInt                %6.1f  sprintf %6.1f  speedup %.1fx\n", intNs, sprintfIntNs,
+           sprintfIntNs / intNs);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,182 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-graticule.c
+ * @brief          : 点线网格刻度测试
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 以随机区域, 随机裁剪矩形, 格宽1~32和点距1~8比较drawGraticule与逐像素的参考实现, 区域外的像素不变,
+ *    脏页表为区域与裁剪矩形的交集
+ * 2. 逐页带绘制(每页以本页为区域)与整幅绘制的结果相同
+ * 3. 给出Y-t刻度(格宽16, 点距4)整幅绘制与逐像素参考实现的耗时
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include "test-common.h"
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define RANDOM_DRAWS 20000 // 随机绘制次数
+#define MAX_DIVISION 32    // 最大格宽
+#define MAX_DOT      8     // 最大点距
+#define UI_DIVISION  16    // 与app-ui.c中UI_GRATICULE_DIV相同
+#define UI_DOT       4     // 与app-ui.c中UI_GRATICULE_DOT相同
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static PageCanvasTypeDef expectScreen;
+static PageCanvasTypeDef actualScreen;
+static PageCanvasTypeDef stripScreen;
+static uint8_t strip[WIDTH];
+static DirtyMapTypeDef dirty;
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 逐像素绘制网格刻度, 作为参考实现
+ *
+ * @param canvas 屏幕画布
+ * @param area 绘制区域, 已与裁剪矩形和屏幕求交
+ * @param division 格宽
+ * @param dot 点距
+ */
+static void referenceGraticule(const CanvasTypeDef* canvas, RectParamTypeDef area, uint8_t division, uint8_t dot) {
+    for (uint8_t y = area.y0; y <= area.y1; y++) {
+        for (uint8_t x = area.x0; x <= area.x1; x++) {
+            uint8_t vertical   = x != 0 && x % division == 0 && y % dot == 0;
+            uint8_t horizontal = y != 0 && y % division == 0 && x % dot == 0;
+            if (vertical || horizontal) {
+                CANVAS_SET_PIXEL(canvas, x, y);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 随机区域和裁剪矩形下与参考实现比较, 并检查脏页表
+ *
+ */
+static void checkRandom(void) {
+    CanvasTypeDef expect = CANVAS_FROM_ARRAY(expectScreen);
+    CanvasTypeDef actual = CANVAS_FROM_ARRAY(actualScreen);
+
+    graphServIntf.bindDirtyMap(&actual, &dirty);
+
+    for (uint32_t i = 0; i < RANDOM_DRAWS; i++) {
+        uint8_t division      = (uint8_t)testRange(1, MAX_DIVISION);
+        uint8_t dot           = (uint8_t)testRange(1, MAX_DOT);
+        RectParamTypeDef area = {(uint8_t)testRange(0, 0xFF), (uint8_t)testRange(0, 0xFF), 0, 0};
+        RectParamTypeDef clip = {0, 0, 0xFF, 0xFF};
+
+        area.x1 = (uint8_t)testRange(area.x0, 0xFF);
+        area.y1 = (uint8_t)testRange(area.y0, 0xFF);
+        if (i % 4 == 0) {
+            area = CANVAS_FULL_AREA;
+        }
+        if (testRand() % 3 == 0) {
+            clip.x0 = (uint8_t)testRange(0, WIDTH - 1);
+            clip.x1 = (uint8_t)testRange(clip.x0, 0xFF);
+            clip.y0 = (uint8_t)testRange(0, HEIGHT - 1);
+            clip.y1 = (uint8_t)testRange(clip.y0, 0xFF);
+        }
+
+        for (uint16_t n = 0; n < sizeof(expectScreen); n++) {
+            ((uint8_t*)expectScreen)[n] = ((uint8_t*)actualScreen)[n] = (uint8_t)(testRand() & testRand());
+        }
+
+        // 区域与裁剪矩形和屏幕的交集
+        RectParamTypeDef drawn = area;
+        drawn.x0               = drawn.x0 > clip.x0 ? drawn.x0 : clip.x0;
+        drawn.y0               = drawn.y0 > clip.y0 ? drawn.y0 : clip.y0;
+        drawn.x1               = drawn.x1 < clip.x1 ? drawn.x1 : clip.x1;
+        drawn.y1               = drawn.y1 < clip.y1 ? drawn.y1 : clip.y1;
+        drawn.x1               = drawn.x1 < WIDTH - 1 ? drawn.x1 : WIDTH - 1;
+        drawn.y1               = drawn.y1 < HEIGHT - 1 ? drawn.y1 : HEIGHT - 1;
+        uint8_t empty          = drawn.x0 > drawn.x1 || drawn.y0 > drawn.y1;
+
+        if (!empty) {
+            referenceGraticule(&expect, drawn, division, dot);
+        }
+        graphServIntf.clearDirtyMap(&dirty);
+        graphServIntf.setClipRect(clip);
+        graphServIntf.drawGraticule(&actual, area, division, dot);
+        graphServIntf.resetClipRect();
+
+        TEST_EXPECT(memcmp(expectScreen, actualScreen, sizeof(expectScreen)) == 0,
+                    "division %u dot %u area (%u,%u)-(%u,%u) clip (%u,%u)-(%u,%u): pixels differ", division, dot,
+                    area.x0, area.y0, area.x1, area.y1, clip.x0, clip.y0, clip.x1, clip.y1);
+        for (uint8_t page = 0; page < PAGE; page++) {
+            if (empty || page < (drawn.y0 >> 3) || page > (drawn.y1 >> 3)) {
+                TEST_EXPECT(DIRTY_PAGE_CLEAN(&dirty, page), "area (%u,%u)-(%u,%u): page %u marked dirty", area.x0,
+                            area.y0, area.x1, area.y1, page);
+            } else {
+                TEST_EXPECT(dirty.x0[page] == drawn.x0 && dirty.x1[page] == drawn.x1,
+                            "area (%u,%u)-(%u,%u): page %u dirty %u-%u, not %u-%u", area.x0, area.y0, area.x1,
+                            area.y1, page, dirty.x0[page], dirty.x1[page], drawn.x0, drawn.x1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 逐页带绘制与整幅绘制比较
+ *
+ */
+static void checkStrips(void) {
+    CanvasTypeDef whole = CANVAS_FROM_ARRAY(actualScreen);
+
+    for (uint8_t division = 1; division <= MAX_DIVISION; division++) {
+        for (uint8_t dot = 1; dot <= MAX_DOT; dot++) {
+            memset(actualScreen, 0, sizeof(actualScreen));
+            graphServIntf.drawGraticule(&whole, CANVAS_FULL_AREA, division, dot);
+
+            for (uint8_t page = 0; page < PAGE; page++) {
+                CanvasTypeDef band = CANVAS_STRIP(strip, page);
+                memset(strip, 0, sizeof(strip));
+                graphServIntf.drawGraticule(&band, CANVAS_AREA(&band), division, dot);
+                memcpy(stripScreen[page], strip, WIDTH);
+            }
+
+            TEST_EXPECT(memcmp(stripScreen, actualScreen, sizeof(actualScreen)) == 0,
+                        "division %u dot %u: strips differ from the whole screen", division, dot);
+        }
+    }
+}
+
+int main(void) {
+    CanvasTypeDef expect = CANVAS_FROM_ARRAY(expectScreen);
+    CanvasTypeDef actual = CANVAS_FROM_ARRAY(actualScreen);
+
+    checkRandom();
+    printf("compared %u random graticules (division 1..%u, dot 1..%u) against a per-pixel reference\n",
+           RANDOM_DRAWS, MAX_DIVISION, MAX_DOT);
+    checkStrips();
+
+    double ns          = TEST_BENCH(graphServIntf.drawGraticule(&actual, CANVAS_FULL_AREA, UI_DIVISION, UI_DOT));
+    double referenceNs = TEST_BENCH(referenceGraticule(&expect, CANVAS_FULL_AREA, UI_DIVISION, UI_DOT));
+    printf("full-screen Y-t graticule: drawGraticule %.1f ns, per-pixel reference %.1f ns\n", ns, referenceNs);
+
+    return TEST_RESULT();
+}
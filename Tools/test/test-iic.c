@@ -0,0 +1,731 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-iic.c
+ * @brief          : 硬件IIC速率配置, DMA发送的超时, 异步传输队列的测试与实际SCL速率表
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. drv-iic.c被直接包含, StdPeriph的I2C/DMA/RCC/NVIC函数和GPIO, DMA, 时间服务接口以主机实现代替,
+ *    I2C外设寄存器为内存中的结构体
+ * 2. 以2~36MHz的PCLK1和随机的目标速率, 占空比, 超频开关调用iicSetClock: 超出范围时返回IIC_ERR_PARAM且不改写寄存器;
+ *    成功时CR2.FREQ, CCR(含FS/DUTY位)和TRISE符合参考手册, 实际速率不超过目标速率, CCR再减1就会超过,
+ *    iicObj->speed等于按寄存器计算的实际速率, 外设重新使能
+ * 3. iicSendBlockWithDMA和iicFinishWithDMA中BUSY, START, 地址应答和BTF随机在若干次查询后出现或一直不出现:
+ *    返回值与第一个没有出现的条件对应, 总线被占用, START或BTF超时时恢复总线, 地址无应答时产生STOP,
+ *    失败时不启动DMA, 以模拟的周期计数器计, 每次调用的耗时不超过timeoutUs加上总线恢复的时间
+ * 4. 异步传输队列: 按参考手册的SR1事件序列逐个调用事件中断, 覆盖写, 无数据写, DMA批量写和读取1, 2, 3, 5字节的
+ *    先写后读. 寄存器操作(START, STOP, 地址方向, ACK, POS, BUF中断, DMA, 数据读写)和回调按发生顺序记录为字符串,
+ *    与期望序列比较, 同时检查写出和收到的字节. 再以连续加入的4个传输检查地址NACK, 超时后iicQueuePoll恢复总线,
+ *    成功和总线错误的处理: 回调按加入顺序执行, 每个传输结束后立即开始下一个, 复位后时钟和地址寄存器被恢复
+ * 5. 给出PCLK1为36MHz(HCLK 72MHz, APB1二分频)时各目标速率的CCR, TRISE, 实际SCL速率,
+ *    以及按实际速率计算的整屏刷新时间和帧率上限
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "drv-iic.h"
+#include "test-common.h"
+#include <stdlib.h>
+#include <string.h>
+
+// core_cm3.h中的__disable_irq为Cortex-M3内联汇编, 包含drv-iic.c前替换为主机实现
+#define __disable_irq hostDisableIrq
+static void hostDisableIrq(void) {}
+
+// DWT周期计数器以每次读取前进固定周期数的变量代替
+static uint32_t hostCycles;
+static uint32_t hostDWTCtrl;
+static uint32_t hostReadCycles(void);
+#define IIC_DWT_CTRL   hostDWTCtrl
+#define IIC_DWT_CYCCNT hostReadCycles()
+
+#pragma GCC diagnostic ignored "-Wpointer-to-int-cast" // 驱动把地址转为32位DMA寄存器值, 主机上不使用
+#include "../../Protocols/drv-iic.c"
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define RANDOM_CONFIGS 200000            // 随机配置次数
+#define BOARD_PCLK1    36000000          // 目标板的PCLK1: HCLK 72MHz, APB1二分频
+#define FRAME_BYTES    (7 + 8 * 129 + 9) // drv-oled整屏刷新: 窗口命令7字节, 8页各带控制字节, 9次传输的地址字节
+#define BITS_PER_BYTE  9                 // 每字节8个数据位加1个应答位
+
+#define RANDOM_XFERS     20000      // 随机DMA发送次数
+#define TIMEOUT_US       1000       // DMA发送测试中每一步的超时时间
+#define CYCLES_PER_READ  8          // 每次读取周期计数器前进的周期数
+#define RECOVERY_US      200        // 总线恢复耗时的上限, 约15个5us的半周期
+#define NEVER            UINT32_MAX // 条件一直不出现
+
+#define SLAVE_ADDR 0x78   // 异步传输测试中的从设备地址
+#define DMA_DONE   0xFFFF // 事件序列中表示DMA搬运结束, 调用iicQueueDMAComplete而不是事件中断
+#define LOG_SIZE   64     // 寄存器操作记录的长度
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t speed;   // 目标速率(Hz)
+    IICDutyEnum duty; // 快速模式占空比
+} RateCaseTypeDef;
+
+
+
+
+
+typedef enum {
+    WAIT_BUSY,  // 等待BUSY清除
+    WAIT_START, // 等待START发出
+    WAIT_ADDR,  // 等待地址应答
+    WAIT_BTF,   // 等待最后一个字节移出
+    WAIT_COUNT,
+} WaitEnum;
+
+/* 模拟的总线: 各条件在查询若干次后出现 */
+typedef struct {
+    uint32_t after[WAIT_COUNT];  // 条件在第几次查询时出现, NEVER表示一直不出现
+    uint32_t polled[WAIT_COUNT]; // 已查询次数
+    uint32_t starts;             // 产生START的次数
+    uint32_t stops;              // 产生STOP的次数
+    uint32_t resets;             // 外设软件复位的次数, 即总线恢复次数
+    uint32_t dmaStarts;          // 启动DMA的次数
+} BusTypeDef;
+
+
+
+
+
+/* 异步传输测试中的寄存器操作记录和从设备 */
+typedef struct {
+    char log[LOG_SIZE];   // 按顺序记录的操作, 字符含义见logOp
+    uint8_t len;          // 记录长度
+    uint8_t addr;         // 最近一次写入的地址字节, 含方向位
+    uint8_t tx[16];       // 写入DR的字节
+    uint8_t txLen;        // 写入DR的字节数
+    const uint8_t* slave; // 从设备依次返回的字节
+    uint8_t rxLen;        // 从DR读出的字节数
+} QueueSimTypeDef;
+
+/* 单个异步传输的事件序列和期望的操作记录 */
+typedef struct {
+    IICXferTypeEnum type; // 传输类型
+    uint16_t txLen;       // 写入字节数
+    uint16_t rxLen;       // 读取字节数
+    uint16_t events[16];  // 依次出现的SR1, 0结束
+    const char* log;      // 期望的操作记录
+} QueueCaseTypeDef;
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+uint32_t SystemCoreClock = 72000000;
+
+static I2C_TypeDef i2c;              // 代替I2C1的寄存器
+static uint32_t pclk1 = BOARD_PCLK1; // RCC_GetClocksFreq返回的PCLK1
+
+static DMAObjTypeDef dmaObj;
+static BusTypeDef bus;
+static QueueSimTypeDef sim;
+static IICErrCode callbackStatus[8]; // 各次回调的传输结果, 按回调顺序
+static uint8_t callbackCount;        // 回调次数
+DMAIntfTypeDef dmaIntf;
+GPIOIntfTypeDef gpioIntf;
+TimeServIntfTypeDef timeServIntf;
+
+// 速率表中的目标速率: 标准模式, 快速模式和超频到快速模式+
+static const RateCaseTypeDef rateTable[] = {
+    {100000, IIC_DUTY_2},  {400000, IIC_DUTY_2},  {400000, IIC_DUTY_16_9},  {600000, IIC_DUTY_2},
+    {800000, IIC_DUTY_2},  {800000, IIC_DUTY_16_9},  {900000, IIC_DUTY_2},  {1000000, IIC_DUTY_2},
+    {1000000, IIC_DUTY_16_9},
+};
+
+// 加入队列后的操作: iicQueueStart打开ACK(K)和事件中断(E)并产生START(S); 结束时iicQueueFinish关闭BUF中断(b),
+// POS回到当前字节(n)并打开ACK(K), 之后执行回调(C)
+static const QueueCaseTypeDef queueCases[] = {
+    {IIC_XFER_WRITE, 2, 0, {I2C_SR1_SB, I2C_SR1_ADDR, I2C_SR1_TXE, I2C_SR1_TXE, I2C_SR1_TXE | I2C_SR1_BTF},
+     "KES" "T" "B" "w" "wb" "P" "bnK" "C"},
+    {IIC_XFER_WRITE, 0, 0, {I2C_SR1_SB, I2C_SR1_ADDR},
+     "KES" "T" "P" "bnK" "C"},
+    {IIC_XFER_DMA_WRITE, 4, 0, {I2C_SR1_SB, I2C_SR1_ADDR, DMA_DONE, I2C_SR1_TXE | I2C_SR1_BTF},
+     "KES" "T" "DM" "m" "P" "bnK" "C"},
+    // 1字节: 清除ADDR前关闭ACK, 之后STOP, RXNE时读取
+    {IIC_XFER_WRITE_READ, 1, 1,
+     {I2C_SR1_SB, I2C_SR1_ADDR, I2C_SR1_TXE, I2C_SR1_TXE | I2C_SR1_BTF, I2C_SR1_SB, I2C_SR1_ADDR, I2C_SR1_RXNE},
+     "KES" "T" "B" "wb" "S" "R" "kPB" "r" "bnK" "C"},
+    // 2字节: 关闭ACK并设置POS, BTF时STOP后读取2字节
+    {IIC_XFER_WRITE_READ, 1, 2,
+     {I2C_SR1_SB, I2C_SR1_ADDR, I2C_SR1_TXE, I2C_SR1_TXE | I2C_SR1_BTF, I2C_SR1_SB, I2C_SR1_ADDR,
+      I2C_SR1_RXNE | I2C_SR1_BTF},
+     "KES" "T" "B" "wb" "S" "R" "kN" "Prr" "bnK" "C"},
+    // 3字节: 第一个BTF时关闭ACK读取1字节, 第二个BTF时STOP后读取2字节
+    {IIC_XFER_WRITE_READ, 1, 3,
+     {I2C_SR1_SB, I2C_SR1_ADDR, I2C_SR1_TXE, I2C_SR1_TXE | I2C_SR1_BTF, I2C_SR1_SB, I2C_SR1_ADDR,
+      I2C_SR1_RXNE | I2C_SR1_BTF, I2C_SR1_RXNE | I2C_SR1_BTF},
+     "KES" "T" "B" "wb" "S" "R" "K" "kr" "Prr" "bnK" "C"},
+    // 5字节: RXNE逐字节读取, 剩3字节起关闭BUF中断改为等待BTF
+    {IIC_XFER_WRITE_READ, 2, 5,
+     {I2C_SR1_SB, I2C_SR1_ADDR, I2C_SR1_TXE, I2C_SR1_TXE, I2C_SR1_TXE | I2C_SR1_BTF, I2C_SR1_SB, I2C_SR1_ADDR,
+      I2C_SR1_RXNE, I2C_SR1_RXNE, I2C_SR1_RXNE | I2C_SR1_BTF, I2C_SR1_RXNE | I2C_SR1_BTF},
+     "KES" "T" "B" "w" "wb" "S" "R" "KB" "r" "rb" "kr" "Prr" "bnK" "C"},
+};
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/* CMSIS和StdPeriph函数的主机实现 ------------------------------------------------------------------------------------*/
+
+uint32_t __get_PRIMASK(void) { return 0; }
+void __set_PRIMASK(uint32_t priMask) {}
+
+void RCC_GetClocksFreq(RCC_ClocksTypeDef* RCC_Clocks) {
+    memset(RCC_Clocks, 0, sizeof(*RCC_Clocks));
+    RCC_Clocks->SYSCLK_Frequency = SystemCoreClock;
+    RCC_Clocks->HCLK_Frequency   = SystemCoreClock;
+    RCC_Clocks->PCLK1_Frequency  = pclk1;
+    RCC_Clocks->PCLK2_Frequency  = SystemCoreClock;
+}
+
+void I2C_Cmd(I2C_TypeDef* I2Cx, FunctionalState NewState) {
+    I2Cx->CR1 = NewState == ENABLE ? I2Cx->CR1 | I2C_CR1_PE : I2Cx->CR1 & ~I2C_CR1_PE;
+}
+
+/**
+ * @brief 查询一次模拟总线上的条件
+ *
+ * @param wait
+ * @return uint8_t 条件已出现时为1
+ */
+static uint8_t busPoll(WaitEnum wait) { return bus.polled[wait]++ >= bus.after[wait]; }
+
+static uint32_t hostReadCycles(void) { return hostCycles += CYCLES_PER_READ; }
+
+FlagStatus I2C_GetFlagStatus(I2C_TypeDef* I2Cx, uint32_t I2C_FLAG) {
+    if (I2C_FLAG == I2C_FLAG_BUSY) {
+        return busPoll(WAIT_BUSY) ? RESET : SET;
+    }
+    if (I2C_FLAG == I2C_FLAG_BTF) {
+        return busPoll(WAIT_BTF) ? SET : RESET;
+    }
+    return RESET;
+}
+
+ErrorStatus I2C_CheckEvent(I2C_TypeDef* I2Cx, uint32_t I2C_EVENT) {
+    if (I2C_EVENT == I2C_EVENT_MASTER_MODE_SELECT) {
+        return busPoll(WAIT_START) ? SUCCESS : ERROR;
+    }
+    if (I2C_EVENT == I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED) {
+        return busPoll(WAIT_ADDR) ? SUCCESS : ERROR;
+    }
+    return ERROR;
+}
+
+/**
+ * @brief 记录一次寄存器操作
+ *
+ * @param op S: START, P: STOP, T/R: 写入发送/接收方向的地址, w/r: 写入/读出DR, K/k: 打开/关闭ACK,
+ *           N/n: POS设为下一字节/当前字节, E/e: 打开/关闭事件中断, B/b: 打开/关闭BUF中断,
+ *           M/m: 打开/关闭IIC的DMA请求, D: 启动DMA通道; 回调记录其参数字符
+ */
+static void logOp(char op) {
+    if (sim.len < LOG_SIZE - 1) {
+        sim.log[sim.len++] = op;
+        sim.log[sim.len]   = '\0';
+    }
+}
+
+void I2C_GenerateSTART(I2C_TypeDef* I2Cx, FunctionalState NewState) {
+    bus.starts += NewState == ENABLE;
+    logOp('S');
+}
+
+void I2C_GenerateSTOP(I2C_TypeDef* I2Cx, FunctionalState NewState) {
+    bus.stops += NewState == ENABLE;
+    logOp('P');
+}
+
+// 软件复位清除全部寄存器
+void I2C_SoftwareResetCmd(I2C_TypeDef* I2Cx, FunctionalState NewState) {
+    if (NewState == ENABLE) {
+        bus.resets++;
+        I2Cx->CR1   = I2C_CR1_SWRST;
+        I2Cx->CR2   = 0;
+        I2Cx->CCR   = 0;
+        I2Cx->TRISE = 0;
+        I2Cx->OAR1  = 0;
+    } else {
+        I2Cx->CR1 &= ~I2C_CR1_SWRST;
+    }
+}
+
+void I2C_AcknowledgeConfig(I2C_TypeDef* I2Cx, FunctionalState NewState) {
+    I2Cx->CR1 = NewState == ENABLE ? I2Cx->CR1 | I2C_CR1_ACK : I2Cx->CR1 & ~I2C_CR1_ACK;
+    logOp(NewState == ENABLE ? 'K' : 'k');
+}
+
+void I2C_NACKPositionConfig(I2C_TypeDef* I2Cx, uint16_t I2C_NACKPosition) {
+    I2Cx->CR1 = I2C_NACKPosition == I2C_NACKPosition_Next ? I2Cx->CR1 | I2C_CR1_POS : I2Cx->CR1 & ~I2C_CR1_POS;
+    logOp(I2C_NACKPosition == I2C_NACKPosition_Next ? 'N' : 'n');
+}
+
+void I2C_ITConfig(I2C_TypeDef* I2Cx, uint16_t I2C_IT, FunctionalState NewState) {
+    if (I2C_IT & I2C_IT_EVT) {
+        logOp(NewState == ENABLE ? 'E' : 'e');
+    }
+    if (I2C_IT & I2C_IT_BUF) {
+        logOp(NewState == ENABLE ? 'B' : 'b');
+    }
+}
+
+void I2C_Send7bitAddress(I2C_TypeDef* I2Cx, uint8_t Address, uint8_t I2C_Direction) {
+    sim.addr = I2C_Direction == I2C_Direction_Receiver ? Address | 0x01 : Address & ~0x01;
+    logOp(I2C_Direction == I2C_Direction_Receiver ? 'R' : 'T');
+}
+
+void I2C_SendData(I2C_TypeDef* I2Cx, uint8_t Data) {
+    if (sim.txLen < sizeof(sim.tx)) {
+        sim.tx[sim.txLen++] = Data;
+    }
+    logOp('w');
+}
+
+uint8_t I2C_ReceiveData(I2C_TypeDef* I2Cx) {
+    logOp('r');
+    return sim.slave != NULL ? sim.slave[sim.rxLen++] : 0;
+}
+
+void I2C_DMACmd(I2C_TypeDef* I2Cx, FunctionalState NewState) { logOp(NewState == ENABLE ? 'M' : 'm'); }
+
+static DMAErrCode hostDMAStart(DMAObjTypeDef* obj) {
+    bus.dmaStarts++;
+    logOp('D');
+    return DMA_SUCCESS;
+}
+static DMAErrCode hostDMAAddr(DMAObjTypeDef* obj, uint32_t addr, DMASizeEnum size, uint16_t len) {
+    return DMA_SUCCESS;
+}
+static GPIOErrCode hostPinInit(GPIOPortEnum port, GPIOPinEnum pin, GPIOModeEnum mode) { return GPIO_SUCCESS; }
+static GPIOErrCode hostPinWrite(GPIOPortEnum port, GPIOPinEnum pin) { return GPIO_SUCCESS; }
+static uint8_t hostPinRead(GPIOPortEnum port, GPIOPinEnum pin) { return 1; }
+
+void I2C_Init(I2C_TypeDef* I2Cx, I2C_InitTypeDef* I2C_InitStruct) {}
+void I2C_ClearFlag(I2C_TypeDef* I2Cx, uint32_t I2C_FLAG) {}
+void DMA_ClearFlag(uint32_t DMAy_FLAG) {}
+void DMA_Cmd(DMA_Channel_TypeDef* DMAy_Channelx, FunctionalState NewState) {}
+void NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct) {}
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState) {}
+
+/* 测试 ----------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 构造一个已初始化的硬件IIC对象, 不经过iicInit
+ *
+ * @param obj
+ */
+static void hardwareObj(IICObjTypeDef* obj) {
+    memset(obj, 0, sizeof(*obj));
+    obj->type   = IIC_HARDWARE_1;
+    obj->i2c    = &i2c;
+    obj->dmaObj = &dmaObj;
+}
+
+/**
+ * @brief 以随机PCLK1和参数调用iicSetClock并检查寄存器与实际速率
+ *
+ */
+static void checkRandom(void) {
+    uint32_t accepted = 0;
+    IICObjTypeDef obj;
+
+    hardwareObj(&obj);
+
+    for (uint32_t n = 0; n < RANDOM_CONFIGS; n++) {
+        uint32_t speed    = n % 8 == 0 ? (uint32_t)testRange(0, 2000) : (uint32_t)testRange(1, 1100000);
+        IICDutyEnum duty  = (IICDutyEnum)(testRand() & 1);
+        uint8_t overclock = testRand() & 1;
+        uint8_t fast      = speed > IIC_STANDARD_MODE_MAX_SPEED;
+        uint32_t limit    = overclock ? IIC_OVERCLOCK_MAX_SPEED : IIC_FAST_MODE_MAX_SPEED;
+        uint32_t period   = !fast ? 2 : duty == IIC_DUTY_16_9 ? 25 : 3;
+
+        pclk1 = (uint32_t)testRange(1000000, 37000000);
+        memset(&i2c, 0x5A, sizeof(i2c));
+        i2c.CR1 &= ~I2C_CR1_PE;
+        I2C_TypeDef before = i2c;
+        obj.speed          = 0;
+
+        IICErrCode err = iicSetClock(&obj, speed, duty, overclock);
+
+        uint32_t freqMHz = pclk1 / 1000000;
+        uint8_t pclkOk   = freqMHz >= (fast ? 4 : 2) && freqMHz <= 36;
+        if (speed == 0 || speed > limit || !pclkOk) {
+            TEST_EXPECT(err == IIC_ERR_PARAM, "PCLK1 %u, %u Hz, overclock %u: accepted", pclk1, speed, overclock);
+        }
+        if (err != IIC_SUCCESS) {
+            TEST_EXPECT(memcmp(&before, &i2c, sizeof(i2c)) == 0 && obj.speed == 0,
+                        "PCLK1 %u, %u Hz: rejected but registers or speed changed", pclk1, speed);
+            continue;
+        }
+        accepted++;
+
+        uint16_t ccr      = i2c.CCR & I2C_CCR_CCR;
+        uint32_t achieved = pclk1 / (ccr * period);
+        uint16_t trise    = !fast                            ? freqMHz + 1
+                            : speed > IIC_FAST_MODE_MAX_SPEED ? freqMHz * 120 / 1000 + 1
+                                                              : freqMHz * 300 / 1000 + 1;
+
+        TEST_EXPECT(speed <= limit && pclkOk, "PCLK1 %u, %u Hz, overclock %u: not rejected", pclk1, speed, overclock);
+        TEST_EXPECT((i2c.CR2 & I2C_CR2_FREQ) == freqMHz && (i2c.CR2 & ~I2C_CR2_FREQ) == (before.CR2 & ~I2C_CR2_FREQ),
+                    "PCLK1 %u: CR2 0x%04x", pclk1, i2c.CR2);
+        TEST_EXPECT(!(i2c.CCR & I2C_CCR_FS) == !fast && !(i2c.CCR & I2C_CCR_DUTY) == !(fast && duty == IIC_DUTY_16_9),
+                    "%u Hz duty %u: CCR 0x%04x mode bits", speed, duty, i2c.CCR);
+        TEST_EXPECT(i2c.TRISE == trise, "PCLK1 %u, %u Hz: TRISE %u, expected %u", pclk1, speed, i2c.TRISE, trise);
+        TEST_EXPECT(ccr >= (fast ? 1 : 4) && ccr <= 0x0FFF, "PCLK1 %u, %u Hz: CCR %u", pclk1, speed, ccr);
+        TEST_EXPECT(achieved <= speed, "PCLK1 %u, %u Hz duty %u: achieved %u Hz", pclk1, speed, duty, achieved);
+        TEST_EXPECT(ccr == (fast ? 1 : 4) || (uint64_t)pclk1 > (uint64_t)speed * (ccr - 1) * period,
+                    "PCLK1 %u, %u Hz duty %u: CCR %u is not the smallest", pclk1, speed, duty, ccr);
+        TEST_EXPECT(obj.speed == achieved && obj.duty == duty, "PCLK1 %u, %u Hz: speed %u, achieved %u", pclk1, speed,
+                    obj.speed, achieved);
+        TEST_EXPECT(i2c.CR1 & I2C_CR1_PE, "PCLK1 %u, %u Hz: peripheral left disabled", pclk1, speed);
+    }
+
+    printf("%u random configurations, %u accepted, registers and achieved rate checked\n", RANDOM_CONFIGS, accepted);
+
+    // 软件IIC和空对象不配置时钟
+    obj.type = IIC_SOFTWARE;
+    TEST_EXPECT(iicSetClock(&obj, 400000, IIC_DUTY_2, 0) == IIC_ERR_PARAM, "software IIC accepted");
+    TEST_EXPECT(iicSetClock(NULL, 400000, IIC_DUTY_2, 0) == IIC_ERR_PARAM, "NULL object accepted");
+}
+
+/**
+ * @brief 打印目标板PCLK1下的实际速率表
+ *
+ */
+static void printRateTable(void) {
+    IICObjTypeDef obj;
+
+    hardwareObj(&obj);
+    pclk1 = BOARD_PCLK1;
+
+    printf("achieved SCL rate at PCLK1 %u MHz (full frame: %u bytes x %u clocks):\n", BOARD_PCLK1 / 1000000,
+           FRAME_BYTES, BITS_PER_BYTE);
+    printf("  requested  mode   CCR  TRISE   achieved   error   frame     max fps\n");
+    for (uint8_t i = 0; i < sizeof(rateTable) / sizeof(rateTable[0]); i++) {
+        const RateCaseTypeDef* c = &rateTable[i];
+        uint8_t overclock        = c->speed > IIC_FAST_MODE_MAX_SPEED;
+        const char* mode         = c->speed <= IIC_STANDARD_MODE_MAX_SPEED ? "Sm"
+                                   : c->duty == IIC_DUTY_16_9              ? "16:9"
+                                                                           : "2:1";
+
+        TEST_EXPECT(iicSetClock(&obj, c->speed, c->duty, overclock) == IIC_SUCCESS, "%u Hz rejected", c->speed);
+
+        double frameUs = (double)FRAME_BYTES * BITS_PER_BYTE * 1e6 / obj.speed;
+        printf("  %5u kHz  %-5s %4u  %5u  %7.1f kHz  %5.1f%%  %5.2f ms  %7.1f\n", c->speed / 1000, mode,
+               i2c.CCR & I2C_CCR_CCR, i2c.TRISE, obj.speed / 1e3, 100.0 * ((double)obj.speed - c->speed) / c->speed,
+               frameUs / 1e3, 1e6 / frameUs);
+    }
+}
+
+/**
+ * @brief 随机的总线状况下检查DMA发送的返回值, 总线操作和耗时
+ *
+ */
+static void checkDMABlocking(void) {
+    static const uint8_t data[16];
+    uint32_t outcome[IIC_ERR_ADDR + 1] = {0};
+    uint32_t recoverCycles             = IIC_US_TO_CYCLES(RECOVERY_US);
+    IICObjTypeDef obj;
+
+    hardwareObj(&obj);
+    obj.timeoutUs = TIMEOUT_US;
+    obj.slaveAddr = 0x78;
+    dmaIntf       = (DMAIntfTypeDef){.setSorce = hostDMAAddr, .setDest = hostDMAAddr, .start = hostDMAStart};
+    gpioIntf      = (GPIOIntfTypeDef){.pinInit  = hostPinInit,
+                                      .pinSet   = hostPinWrite,
+                                      .pinReset = hostPinWrite,
+                                      .pinRead  = hostPinRead};
+
+    for (uint32_t n = 0; n < RANDOM_XFERS; n++) {
+        memset(&bus, 0, sizeof(bus));
+        for (uint8_t w = 0; w < WAIT_COUNT; w++) {
+            bus.after[w] = testRange(0, 15) == 0 ? NEVER : (uint32_t)testRange(0, testRange(0, 1) ? 3 : 4000);
+        }
+
+        // 第一个一直不出现的条件决定返回值
+        IICErrCode expect = IIC_SUCCESS;
+        uint8_t recovered = 0;
+        if (bus.after[WAIT_BUSY] == NEVER || bus.after[WAIT_START] == NEVER) {
+            expect    = IIC_ERR_BUSY;
+            recovered = 1;
+        } else if (bus.after[WAIT_ADDR] == NEVER) {
+            expect = IIC_ERR_NACK;
+        }
+
+        uint32_t start = hostCycles;
+        IICErrCode err = iicSendBlockWithDMA(&obj, data, sizeof(data));
+        uint32_t spent = hostCycles - start;
+
+        TEST_EXPECT(err == expect, "BUSY %u START %u ADDR %u: returned %u, expected %u", bus.after[WAIT_BUSY],
+                    bus.after[WAIT_START], bus.after[WAIT_ADDR], err, expect);
+        TEST_EXPECT(bus.resets == recovered && bus.dmaStarts == (err == IIC_SUCCESS) &&
+                        bus.stops == (err == IIC_ERR_NACK),
+                    "send returned %u: %u recoveries, %u DMA starts, %u STOPs", err, bus.resets, bus.dmaStarts,
+                    bus.stops);
+        TEST_EXPECT(spent <= IIC_US_TO_CYCLES(3 * TIMEOUT_US) + recoverCycles, "send returned %u after %u cycles",
+                    err, spent);
+        outcome[err]++;
+        if (err != IIC_SUCCESS) {
+            continue;
+        }
+
+        // DMA搬运结束后等待BTF
+        start  = hostCycles;
+        err    = iicFinishWithDMA(&obj);
+        spent  = hostCycles - start;
+        expect = bus.after[WAIT_BTF] == NEVER ? IIC_ERR_TIMEOUT : IIC_SUCCESS;
+
+        TEST_EXPECT(err == expect, "BTF %u: finish returned %u, expected %u", bus.after[WAIT_BTF], err, expect);
+        TEST_EXPECT(bus.stops == 1 && bus.resets == (err != IIC_SUCCESS),
+                    "finish returned %u: %u STOPs, %u recoveries", err, bus.stops, bus.resets);
+        TEST_EXPECT(spent <= IIC_US_TO_CYCLES(TIMEOUT_US) + recoverCycles, "finish returned %u after %u cycles", err,
+                    spent);
+        outcome[err]++;
+    }
+
+    printf("%u DMA sends with random bus stalls: %u busy, %u NACK, %u BTF timeouts, all within %u us per step\n",
+           RANDOM_XFERS, outcome[IIC_ERR_BUSY], outcome[IIC_ERR_NACK], outcome[IIC_ERR_TIMEOUT], TIMEOUT_US);
+}
+
+/**
+ * @brief 异步传输结束回调, 记录参数字符和传输结果
+ *
+ * @param arg 标识传输的字符串
+ * @param status
+ */
+static void queueCallback(void* arg, IICErrCode status) {
+    logOp(*(const char*)arg);
+    if (callbackCount < sizeof(callbackStatus) / sizeof(callbackStatus[0])) {
+        callbackStatus[callbackCount++] = status;
+    }
+}
+
+/**
+ * @brief 以给定的SR1调用一次事件中断
+ *
+ * @param obj
+ * @param sr1 SR1的值, DMA_DONE表示DMA搬运结束
+ */
+static void queueEvent(IICObjTypeDef* obj, uint16_t sr1) {
+    if (sr1 == DMA_DONE) {
+        iicQueueDMAComplete(obj);
+        return;
+    }
+    i2c.SR1 = sr1;
+    iicQueueEventISR(obj);
+}
+
+/**
+ * @brief 比较操作记录并清空
+ *
+ * @param step 出错时打印的步骤名
+ * @param expect 期望的操作记录
+ */
+static void expectLog(const char* step, const char* expect) {
+    TEST_EXPECT(strcmp(sim.log, expect) == 0, "%s: operations %s, expected %s", step, sim.log, expect);
+    sim.len    = 0;
+    sim.log[0] = '\0';
+}
+
+/**
+ * @brief 构造一个配置了异步传输队列的硬件IIC对象, 清空寄存器和操作记录
+ *
+ * @param obj
+ */
+static void queueObj(IICObjTypeDef* obj) {
+    hardwareObj(obj);
+    obj->speed = 400000;
+    memset(&i2c, 0, sizeof(i2c));
+    memset(&bus, 0, sizeof(bus));
+    memset(&sim, 0, sizeof(sim));
+    callbackCount = 0;
+    TEST_EXPECT(iicQueueEquip(obj) == IIC_SUCCESS, "queue not equipped");
+}
+
+/**
+ * @brief 按事件序列驱动各类型的单个异步传输, 检查寄存器操作, 收发的字节和回调
+ *
+ */
+static void checkQueueTransfers(void) {
+    static const uint8_t txData[]    = {0x10, 0x11, 0x12, 0x13};
+    static const uint8_t slaveData[] = {0xA0, 0xA1, 0xA2, 0xA3, 0xA4};
+    IICObjTypeDef obj;
+
+    for (uint8_t n = 0; n < sizeof(queueCases) / sizeof(queueCases[0]); n++) {
+        const QueueCaseTypeDef* c = &queueCases[n];
+        uint8_t rx[sizeof(slaveData)] = {0};
+        IICXferTypeDef xfer           = {.type      = c->type,
+                                         .slaveAddr = SLAVE_ADDR,
+                                         .txData    = txData,
+                                         .txLen     = c->txLen,
+                                         .rxData    = rx,
+                                         .rxLen     = c->rxLen,
+                                         .callback  = queueCallback,
+                                         .arg       = "C"};
+
+        queueObj(&obj);
+        sim.slave = slaveData;
+
+        TEST_EXPECT(iicQueueSubmit(&obj, &xfer) == IIC_SUCCESS, "case %u: submit failed", n);
+        for (uint8_t e = 0; e < sizeof(c->events) / sizeof(c->events[0]) && c->events[e] != 0; e++) {
+            queueEvent(&obj, c->events[e]);
+        }
+
+        uint8_t written = c->type == IIC_XFER_DMA_WRITE ? 0 : c->txLen; // DMA写入的数据不经过I2C_SendData
+        char step[48];
+        snprintf(step, sizeof(step), "case %u (type %u, tx %u, rx %u)", n, c->type, c->txLen, c->rxLen);
+
+        expectLog(step, c->log);
+        TEST_EXPECT(sim.txLen == written && memcmp(sim.tx, txData, written) == 0, "%s: wrote %u bytes", step,
+                    sim.txLen);
+        TEST_EXPECT(sim.rxLen == c->rxLen && memcmp(rx, slaveData, c->rxLen) == 0, "%s: read %u bytes", step,
+                    sim.rxLen);
+        TEST_EXPECT(sim.addr == (c->rxLen > 0 ? SLAVE_ADDR | 0x01 : SLAVE_ADDR), "%s: address byte 0x%02x", step,
+                    sim.addr);
+        TEST_EXPECT(callbackCount == 1 && callbackStatus[0] == IIC_SUCCESS && obj.queue->stat.completed == 1,
+                    "%s: %u callbacks, status %u", step, callbackCount, callbackStatus[0]);
+        TEST_EXPECT(obj.queue->state == IIC_STATE_IDLE && obj.queue->count == 0, "%s: queue not idle", step);
+        TEST_EXPECT((i2c.CR1 & (I2C_CR1_ACK | I2C_CR1_POS)) == I2C_CR1_ACK, "%s: CR1 0x%04x, ACK/POS not restored",
+                    step, i2c.CR1);
+
+        free(obj.queue);
+    }
+
+    printf("%u queued transfers (write, DMA write, write-read of 1/2/3/5 bytes): register operations, bytes and "
+           "callbacks match the event sequences\n",
+           (unsigned)(sizeof(queueCases) / sizeof(queueCases[0])));
+}
+
+/**
+ * @brief 连续加入的传输依次遇到地址NACK, 超时, 成功和总线错误
+ *
+ */
+static void checkQueueErrors(void) {
+    static const uint8_t data[] = {0x5A};
+    static const char* names[]  = {"A", "B", "C", "D"};
+    static const IICErrCode expect[] = {IIC_ERR_NACK, IIC_ERR_TIMEOUT, IIC_SUCCESS, IIC_ERR_BUSY};
+    uint8_t rx[2];
+    IICObjTypeDef obj;
+
+    queueObj(&obj);
+    dmaIntf  = (DMAIntfTypeDef){.setSorce = hostDMAAddr, .setDest = hostDMAAddr, .start = hostDMAStart};
+    gpioIntf = (GPIOIntfTypeDef){.pinInit  = hostPinInit,
+                                 .pinSet   = hostPinWrite,
+                                 .pinReset = hostPinWrite,
+                                 .pinRead  = hostPinRead};
+
+    // 4个传输的从设备地址各不相同, 由地址字节判断开始的是哪一个
+    for (uint8_t n = 0; n < 4; n++) {
+        IICXferTypeDef xfer = {.type      = n == 0 ? IIC_XFER_WRITE_READ : IIC_XFER_WRITE,
+                               .slaveAddr = SLAVE_ADDR + 2 * n,
+                               .txData    = data,
+                               .txLen     = sizeof(data),
+                               .rxData    = rx,
+                               .rxLen     = n == 0 ? sizeof(rx) : 0,
+                               .callback  = queueCallback,
+                               .arg       = (void*)names[n]};
+        TEST_EXPECT(iicQueueSubmit(&obj, &xfer) == IIC_SUCCESS, "transfer %s: submit failed", names[n]);
+    }
+    TEST_EXPECT(obj.queue->count == 4, "%u transfers queued", obj.queue->count);
+    expectLog("submit", "KES"); // 只有第一个开始
+
+    // A: 地址无应答, 错误中断产生STOP后结束, 开始B
+    queueEvent(&obj, I2C_SR1_SB);
+    TEST_EXPECT(sim.addr == SLAVE_ADDR, "A: address 0x%02x", sim.addr);
+    i2c.SR1 = I2C_SR1_AF;
+    iicQueueErrorISR(&obj);
+    TEST_EXPECT(!(i2c.SR1 & I2C_SR1_AF), "A: AF not cleared");
+    expectLog("A: address NACK", "T" "mP" "bnK" "A" "KES");
+
+    // B: 最后一个字节之后BTF一直不出现, 超时前查询不做任何事, 超时后恢复总线并开始C
+    queueEvent(&obj, I2C_SR1_SB);
+    TEST_EXPECT(sim.addr == SLAVE_ADDR + 2, "B: address 0x%02x", sim.addr);
+    queueEvent(&obj, I2C_SR1_ADDR);
+    queueEvent(&obj, I2C_SR1_TXE);
+    iicQueuePoll(&obj);
+    expectLog("B: before the timeout", "T" "B" "wb");
+
+    i2c.CR2           = (i2c.CR2 & ~I2C_CR2_FREQ) | 36;
+    i2c.CCR           = I2C_CCR_FS | 30;
+    i2c.TRISE         = 11;
+    i2c.OAR1          = 0x4000;
+    I2C_TypeDef saved = i2c;
+    hostCycles += obj.queue->timeoutCycles;
+    iicQueuePoll(&obj);
+    expectLog("B: timeout", "m" "bnK" "B" "KES");
+    TEST_EXPECT(bus.resets == 1 && obj.queue->stat.recoveries == 1, "B: %u resets, %u recoveries", bus.resets,
+                obj.queue->stat.recoveries);
+    TEST_EXPECT(i2c.CR2 == saved.CR2 && i2c.CCR == saved.CCR && i2c.TRISE == saved.TRISE && i2c.OAR1 == saved.OAR1 &&
+                    (i2c.CR1 & I2C_CR1_PE),
+                "B: registers not restored after the reset");
+
+    // C: 正常完成, 开始D
+    queueEvent(&obj, I2C_SR1_SB);
+    TEST_EXPECT(sim.addr == SLAVE_ADDR + 4, "C: address 0x%02x", sim.addr);
+    queueEvent(&obj, I2C_SR1_ADDR);
+    queueEvent(&obj, I2C_SR1_TXE);
+    queueEvent(&obj, I2C_SR1_TXE | I2C_SR1_BTF);
+    expectLog("C: write", "T" "B" "wb" "P" "bnK" "C" "KES");
+
+    // D: 总线错误, 恢复总线后结束, 队列已空
+    queueEvent(&obj, I2C_SR1_SB);
+    TEST_EXPECT(sim.addr == SLAVE_ADDR + 6, "D: address 0x%02x", sim.addr);
+    i2c.SR1 = I2C_SR1_BERR;
+    iicQueueErrorISR(&obj);
+    expectLog("D: bus error", "T" "m" "bnK" "D");
+
+    // 队列空闲时残留的BTF关闭事件中断
+    queueEvent(&obj, I2C_SR1_BTF);
+    expectLog("stray BTF", "eb");
+
+    TEST_EXPECT(callbackCount == 4, "%u callbacks", callbackCount);
+    for (uint8_t n = 0; n < 4 && n < callbackCount; n++) {
+        TEST_EXPECT(callbackStatus[n] == expect[n], "transfer %s: status %u, expected %u", names[n], callbackStatus[n],
+                    expect[n]);
+    }
+    TEST_EXPECT(obj.queue->stat.completed == 1 && obj.queue->stat.failed == 2 && obj.queue->stat.timeouts == 1 &&
+                    obj.queue->stat.recoveries == 2,
+                "stat: %u completed, %u failed, %u timeouts, %u recoveries", obj.queue->stat.completed,
+                obj.queue->stat.failed, obj.queue->stat.timeouts, obj.queue->stat.recoveries);
+    TEST_EXPECT(obj.queue->state == IIC_STATE_IDLE && obj.queue->count == 0, "queue not idle");
+
+    free(obj.queue);
+
+    printf("queued NACK, timeout with bus recovery, success and bus error: callbacks in order, next transfer started "
+           "after each\n");
+}
+
+int main(void) {
+    checkRandom();
+    checkDMABlocking();
+    checkQueueTransfers();
+    checkQueueErrors();
+    printRateTable();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,257 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-image.c
+ * @brief          : RLE图像资源的往返测试与解码速度
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 由img2rle.py从Tools/images/param-screen.pbm重新生成资源(build/param-screen.inc), 检查app-ui.c中的资源
+ *    与之逐字相同
+ * 2. 整幅解码与直接读取PBM得到的像素比较; 再以随机位置、随机区域解码到随机内容的宽画布上, 与逐像素复制比较,
+ *    区域外的像素不变; 屏幕画布的脏页表恰好为写入区域
+ * 3. 给出整屏解码与1KB memcpy、字段区域解码与copyRect的耗时
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "image-service.h"
+#include "test-common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "build/param-screen.inc" // make生成的paramScreenImage
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define SOURCE_PBM   "../images/param-screen.pbm"
+#define ASSET_INC    "build/param-screen.inc"
+#define APP_UI       "../../Applications/app-ui.c"
+#define RANDOM_AREAS 200000         // 随机区域数量
+#define WIDE_WIDTH   (2 * WIDTH - 1) // 宽画布的列数, 图像可整体右移到任意列
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static uint8_t pixel[HEIGHT][WIDTH]; // PBM中的像素, 1为点亮
+static PageCanvasTypeDef source;     // 未压缩的页格式图像
+static PageCanvasTypeDef screen;
+static uint8_t expectWide[PAGE][WIDE_WIDTH], actualWide[PAGE][WIDE_WIDTH];
+static DirtyMapTypeDef dirty;
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 读取整个文件
+ *
+ * @param path
+ * @param size 返回文件长度
+ * @return char* 以'\0'结尾的文件内容, 失败时返回NULL
+ */
+static char* readFile(const char* path, long* size) {
+    FILE* file = fopen(path, "rb");
+    char* text = NULL;
+
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    text = calloc(1, *size + 1);
+    if (fread(text, 1, *size, file) != (size_t)*size) {
+        free(text);
+        text = NULL;
+    }
+    fclose(file);
+
+    return text;
+}
+
+/**
+ * @brief 读取P1格式的PBM, 得到像素和未压缩的页格式图像
+ *
+ * @return uint8_t 成功时返回1
+ */
+static uint8_t readSource(void) {
+    long size;
+    char* text = readFile(SOURCE_PBM, &size);
+    char* p    = text;
+    int values[2];
+
+    if (text == NULL || strncmp(text, "P1", 2) != 0) {
+        free(text);
+        return 0;
+    }
+    p += 2;
+
+    for (uint8_t i = 0; i < 2;) {
+        if (*p == '#') {
+            p = strchr(p, '\n');
+        } else if (*p >= '0' && *p <= '9') {
+            values[i++] = (int)strtol(p, &p, 10);
+            continue;
+        }
+        p++;
+    }
+    if (values[0] != WIDTH || values[1] != HEIGHT) {
+        free(text);
+        return 0;
+    }
+
+    for (uint16_t n = 0; n < WIDTH * HEIGHT && *p != '\0'; p++) {
+        if (*p == '#') {
+            p = strchr(p, '\n');
+        } else if (*p == '0' || *p == '1') {
+            uint8_t x = n % WIDTH;
+            uint8_t y = n / WIDTH;
+            pixel[y][x] = *p - '0';
+            source[y >> 3][x] |= (uint8_t)(pixel[y][x] << (y & 7));
+            n++;
+        }
+    }
+
+    free(text);
+    return 1;
+}
+
+/**
+ * @brief app-ui.c中的资源与重新生成的资源逐字相同
+ *
+ */
+static void checkEmbeddedAsset(void) {
+    long incSize, uiSize;
+    char* inc = readFile(ASSET_INC, &incSize);
+    char* ui  = readFile(APP_UI, &uiSize);
+
+    TEST_EXPECT(inc != NULL && ui != NULL, "cannot read %s or %s", ASSET_INC, APP_UI);
+    if (inc != NULL && ui != NULL) {
+        TEST_EXPECT(strstr(ui, inc) != NULL, "paramScreenImage in app-ui.c differs from img2rle.py output");
+    }
+    free(inc);
+    free(ui);
+}
+
+/**
+ * @brief 在宽画布上以随机位置和区域解码, 与逐像素复制比较
+ *
+ * @param x 图像左上角在画布中的列
+ * @param area 允许写入的区域
+ */
+static void checkArea(uint8_t x, RectParamTypeDef area) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(actualWide);
+
+    for (uint8_t y = area.y0; y <= area.y1 && y < HEIGHT; y++) {
+        for (uint16_t dx = area.x0; dx <= area.x1 && dx < WIDE_WIDTH; dx++) {
+            if (dx < x || dx >= x + WIDTH) {
+                continue;
+            }
+            expectWide[y >> 3][dx] &= (uint8_t)~(1 << (y & 7));
+            expectWide[y >> 3][dx] |= (uint8_t)(pixel[y][dx - x] << (y & 7));
+        }
+    }
+    imageServIntf.decode(&canvas, &paramScreenImage, x, 0, area);
+
+    TEST_EXPECT(memcmp(expectWide, actualWide, sizeof(expectWide)) == 0, "image at %u, area (%u,%u)-(%u,%u) differs",
+                x, area.x0, area.y0, area.x1, area.y1);
+}
+
+/**
+ * @brief 屏幕画布的脏页表恰好为写入区域
+ *
+ * @param area 允许写入的区域, 在屏幕内
+ */
+static void checkDirty(RectParamTypeDef area) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(screen);
+
+    graphServIntf.clearDirtyMap(&dirty);
+    imageServIntf.decode(&canvas, &paramScreenImage, 0, 0, area);
+
+    for (uint8_t page = 0; page < PAGE; page++) {
+        if (page < (area.y0 >> 3) || page > (area.y1 >> 3)) {
+            TEST_EXPECT(DIRTY_PAGE_CLEAN(&dirty, page), "area (%u,%u)-(%u,%u): page %u marked dirty", area.x0, area.y0,
+                        area.x1, area.y1, page);
+        } else {
+            TEST_EXPECT(dirty.x0[page] == area.x0 && dirty.x1[page] == area.x1,
+                        "area (%u,%u)-(%u,%u): page %u dirty %u-%u", area.x0, area.y0, area.x1, area.y1, page,
+                        dirty.x0[page], dirty.x1[page]);
+        }
+    }
+}
+
+int main(void) {
+    if (!readSource()) {
+        printf("cannot read %s as a %ux%u P1 PBM\n", SOURCE_PBM, WIDTH, HEIGHT);
+        return 1;
+    }
+
+    // 1. 资源与源图像
+    printf("paramScreenImage: %u bytes of RLE data + %u bytes of page index for a %u-byte screen\n",
+           (unsigned)sizeof(paramScreenImageData), (unsigned)sizeof(paramScreenImagePageIndex),
+           (unsigned)sizeof(source));
+    checkEmbeddedAsset();
+
+    // 2. 往返
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(screen);
+    memset(screen, 0x5A, sizeof(screen));
+    imageServIntf.decode(&canvas, &paramScreenImage, 0, 0, CANVAS_FULL_AREA);
+    TEST_EXPECT(memcmp(screen, source, sizeof(screen)) == 0, "full decode differs from %s", SOURCE_PBM);
+
+    for (uint16_t i = 0; i < sizeof(expectWide); i++) {
+        ((uint8_t*)expectWide)[i] = (uint8_t)testRand();
+    }
+    memcpy(actualWide, expectWide, sizeof(expectWide));
+    for (uint32_t i = 0; i < RANDOM_AREAS; i++) {
+        RectParamTypeDef area;
+        area.x0 = (uint8_t)testRange(0, WIDE_WIDTH - 1);
+        area.x1 = (uint8_t)testRange(area.x0, i & 1 ? 0xFF : area.x0 + 40 < 0xFF ? area.x0 + 40 : 0xFF);
+        area.y0 = (uint8_t)testRange(0, HEIGHT - 1);
+        area.y1 = (uint8_t)testRange(area.y0, i & 2 ? HEIGHT + 8 : area.y0 + 12);
+        checkArea((uint8_t)testRange(0, WIDE_WIDTH - 1), area);
+    }
+
+    graphServIntf.bindDirtyMap(&canvas, &dirty);
+    for (uint32_t i = 0; i < RANDOM_AREAS / 10; i++) {
+        RectParamTypeDef area;
+        area.x0 = (uint8_t)testRange(0, WIDTH - 1);
+        area.x1 = (uint8_t)testRange(area.x0, WIDTH - 1);
+        area.y0 = (uint8_t)testRange(0, HEIGHT - 1);
+        area.y1 = (uint8_t)testRange(area.y0, HEIGHT - 1);
+        checkDirty(area);
+    }
+    printf("decoded %u random areas and compared against a per-pixel copy of %s\n", RANDOM_AREAS, SOURCE_PBM);
+
+    // 3. 耗时
+    CanvasTypeDef raw      = CANVAS_FROM_ARRAY(source);
+    RectParamTypeDef field = {32, 49, 76, 61}; // 信号1相位字段
+    double decodeNs        = TEST_BENCH(imageServIntf.decode(&canvas, &paramScreenImage, 0, 0, CANVAS_FULL_AREA));
+    double memcpyNs        = TEST_BENCH({
+        memcpy(screen, source, sizeof(screen));
+        testSink += screen[3][testSink & 0x7F];
+    });
+    double fieldDecodeNs   = TEST_BENCH(imageServIntf.decode(&canvas, &paramScreenImage, 0, 0, field));
+    double fieldCopyRectNs = TEST_BENCH(graphServIntf.copyRect(&canvas, &raw, field));
+
+    printf("ns per restore:\n");
+    printf("  full screen   RLE decode %7.1f  memcpy from raw   %7.1f\n", decodeNs, memcpyNs);
+    printf("  45x13 field   RLE decode %7.1f  copyRect from raw %7.1f\n", fieldDecodeNs, fieldCopyRectNs);
+
+    return TEST_RESULT();
+}
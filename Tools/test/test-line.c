@@ -0,0 +1,297 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-line.c
+ * @brief          : 线段光栅化与教科书Bresenham的逐像素比较
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 从若干起点到屏幕上每一个终点画线, 覆盖全部八个方向以及水平、竖直、对角和单点; 再以随机端点(可超出屏幕,
+ *    坐标取满uint8_t范围)、随机裁剪矩形和页带画布画线, 与逐点判断边界的教科书整数Bresenham逐像素比较
+ * 2. drawPolyline与逐段画线的结果比较
+ * 3. 给出全屏随机线段和短线段(轨迹中的典型长度)每秒绘制的线段数
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-service.h"
+#include "test-common.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define RANDOM_LINES  500000 // 随机线段数量
+#define POLYLINES     2000   // 随机折线数量
+#define POLYLINE_MAX  64     // 折线最大顶点数
+#define SHORT_SEGMENT 8      // 短线段的最大长度
+#define BENCH_LINES   1024   // 基准测试使用的线段数量
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    uint8_t x0, y0, x1, y1;
+} SegmentTypeDef;
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static PageCanvasTypeDef expect, actual;
+static uint8_t strip[WIDTH];
+static uint32_t octantCount[8];
+static SegmentTypeDef segments[BENCH_LINES];
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 教科书整数Bresenham, 适用于全部八个方向, 逐点判断是否在裁剪矩形内
+ *
+ * @param buffer 屏幕页缓冲区
+ * @param clip 裁剪矩形(包含边界), 已与屏幕求交
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ */
+static void textbookLine(PageCanvasTypeDef buffer, RectParamTypeDef clip, int x0, int y0, int x1, int y1) {
+    int dx  = abs(x1 - x0);
+    int dy  = -abs(y1 - y0);
+    int sx  = x0 < x1 ? 1 : -1;
+    int sy  = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+
+    while (1) {
+        if (x0 >= clip.x0 && x0 <= clip.x1 && y0 >= clip.y0 && y0 <= clip.y1) {
+            buffer[y0 >> 3][x0] |= (uint8_t)(1 << (y0 & 7));
+        }
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+/**
+ * @brief 线段所在的八分区, 0~7, 起点终点重合时记为0
+ *
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ * @return uint8_t
+ */
+static uint8_t octantOf(int x0, int y0, int x1, int y1) {
+    int dx = x1 - x0;
+    int dy = y1 - y0;
+
+    return (uint8_t)(((dy < 0) << 2) | ((dx < 0) << 1) | (abs(dy) > abs(dx)));
+}
+
+/**
+ * @brief 在屏幕画布上以裁剪矩形画一条线并与参考比较
+ *
+ * @param clip 裁剪矩形, 可超出屏幕
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ */
+static void checkLine(RectParamTypeDef clip, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    CanvasTypeDef canvas    = CANVAS_FROM_ARRAY(actual);
+    RectParamTypeDef screen = {clip.x0, clip.y0, clip.x1 < WIDTH ? clip.x1 : WIDTH - 1,
+                               clip.y1 < HEIGHT ? clip.y1 : HEIGHT - 1};
+
+    memset(expect, 0, sizeof(expect));
+    memset(actual, 0, sizeof(actual));
+    textbookLine(expect, screen, x0, y0, x1, y1);
+    graphServIntf.setClipRect(clip);
+    graphServIntf.drawLine(&canvas, x0, y0, x1, y1);
+    graphServIntf.resetClipRect();
+
+    octantCount[octantOf(x0, y0, x1, y1)]++;
+    TEST_EXPECT(memcmp(expect, actual, sizeof(expect)) == 0, "(%u,%u)-(%u,%u) clip (%u,%u)-(%u,%u) differs", x0, y0,
+                x1, y1, clip.x0, clip.y0, clip.x1, clip.y1);
+}
+
+/**
+ * @brief 在页带画布上画一条线, 与参考中对应的页比较
+ *
+ * @param page 页带所在的页
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ */
+static void checkStripLine(uint8_t page, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    CanvasTypeDef canvas = CANVAS_STRIP(strip, page);
+
+    memset(expect, 0, sizeof(expect));
+    memset(strip, 0, sizeof(strip));
+    textbookLine(expect, (RectParamTypeDef){0, page * 8, WIDTH - 1, page * 8 + 7}, x0, y0, x1, y1);
+    graphServIntf.drawLine(&canvas, x0, y0, x1, y1);
+
+    TEST_EXPECT(memcmp(expect[page], strip, WIDTH) == 0, "(%u,%u)-(%u,%u) on strip page %u differs", x0, y0, x1, y1,
+                page);
+}
+
+/**
+ * @brief 随机折线与逐段画线比较
+ *
+ */
+static void checkPolylines(void) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(actual);
+    RectParamTypeDef all = {0, 0, WIDTH - 1, HEIGHT - 1};
+    PointTypeDef points[POLYLINE_MAX];
+
+    for (uint32_t i = 0; i < POLYLINES; i++) {
+        uint16_t count = (uint16_t)testRange(1, POLYLINE_MAX);
+
+        for (uint16_t j = 0; j < count; j++) {
+            points[j] = (PointTypeDef){(uint8_t)testRange(0, WIDTH + 15), (uint8_t)testRange(0, HEIGHT + 15)};
+        }
+
+        memset(expect, 0, sizeof(expect));
+        memset(actual, 0, sizeof(actual));
+        textbookLine(expect, all, points[0].x, points[0].y, points[0].x, points[0].y);
+        for (uint16_t j = 1; j < count; j++) {
+            textbookLine(expect, all, points[j - 1].x, points[j - 1].y, points[j].x, points[j].y);
+        }
+        graphServIntf.drawPolyline(&canvas, points, count);
+
+        TEST_EXPECT(memcmp(expect, actual, sizeof(expect)) == 0, "polyline %u with %u points differs", i, count);
+    }
+}
+
+/**
+ * @brief 生成基准测试的线段
+ *
+ * @param maxLength 线段在每个轴上的最大长度
+ */
+static void makeSegments(uint8_t maxLength) {
+    for (uint16_t i = 0; i < BENCH_LINES; i++) {
+        SegmentTypeDef* s = &segments[i];
+        s->x0             = (uint8_t)testRange(0, WIDTH - 1);
+        s->y0             = (uint8_t)testRange(0, HEIGHT - 1);
+        s->x1             = (uint8_t)testRange(s->x0 > maxLength ? s->x0 - maxLength : 0,
+                                               s->x0 + maxLength < WIDTH ? s->x0 + maxLength : WIDTH - 1);
+        s->y1             = (uint8_t)testRange(s->y0 > maxLength ? s->y0 - maxLength : 0,
+                                               s->y0 + maxLength < HEIGHT ? s->y0 + maxLength : HEIGHT - 1);
+    }
+}
+
+/**
+ * @brief 打印一组线段的绘制速度
+ *
+ * @param name
+ */
+static void benchSegments(const char* name) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(actual);
+    RectParamTypeDef all = {0, 0, WIDTH - 1, HEIGHT - 1};
+
+    double lineNs = TEST_BENCH({
+        for (uint16_t i = 0; i < BENCH_LINES; i++) {
+            graphServIntf.drawLine(&canvas, segments[i].x0, segments[i].y0, segments[i].x1, segments[i].y1);
+        }
+    });
+    double textbookNs = TEST_BENCH({
+        for (uint16_t i = 0; i < BENCH_LINES; i++) {
+            textbookLine(expect, all, segments[i].x0, segments[i].y0, segments[i].x1, segments[i].y1);
+        }
+    });
+
+    printf("  %-24s drawLine %6.2f M/s  textbook per-pixel clip %6.2f M/s  speedup %.1fx\n", name,
+           BENCH_LINES * 1e3 / lineNs, BENCH_LINES * 1e3 / textbookNs, textbookNs / lineNs);
+}
+
+int main(void) {
+    static const uint8_t origins[][2] = {{0, 0}, {64, 32}, {127, 63}, {5, 60}, {100, 3}};
+    RectParamTypeDef none             = {0, 0, 0xFF, 0xFF};
+    uint32_t count                    = 0;
+
+    // 1. 从各起点到屏幕上每一个终点
+    for (uint8_t o = 0; o < sizeof(origins) / sizeof(origins[0]); o++) {
+        for (uint8_t y = 0; y < HEIGHT; y++) {
+            for (uint8_t x = 0; x < WIDTH; x++, count++) {
+                checkLine(none, origins[o][0], origins[o][1], x, y);
+            }
+        }
+    }
+
+    // 2. 随机端点(含屏幕外)与随机裁剪矩形
+    for (uint32_t i = 0; i < RANDOM_LINES; i++, count++) {
+        RectParamTypeDef clip = none;
+        uint8_t x0            = (uint8_t)testRand();
+        uint8_t y0            = (uint8_t)testRand();
+        uint8_t x1            = (uint8_t)testRand();
+        uint8_t y1            = (uint8_t)testRand();
+
+        if (i & 1) {
+            x0 = (uint8_t)testRange(0, WIDTH + 31); // 一半线段端点靠近屏幕, 更多经过可见区域
+            y0 = (uint8_t)testRange(0, HEIGHT + 31);
+            x1 = (uint8_t)testRange(0, WIDTH + 31);
+            y1 = (uint8_t)testRange(0, HEIGHT + 31);
+        }
+        if (i % 3 == 0) {
+            clip.x0 = (uint8_t)testRange(0, WIDTH - 1);
+            clip.x1 = (uint8_t)testRange(clip.x0, WIDTH + 8);
+            clip.y0 = (uint8_t)testRange(0, HEIGHT - 1);
+            clip.y1 = (uint8_t)testRange(clip.y0, HEIGHT + 8);
+        }
+        checkLine(clip, x0, y0, x1, y1);
+    }
+
+    // 3. 页带画布
+    for (uint32_t i = 0; i < RANDOM_LINES / 10; i++, count++) {
+        checkStripLine((uint8_t)testRange(0, PAGE - 1), (uint8_t)testRange(0, WIDTH + 15),
+                       (uint8_t)testRange(0, HEIGHT + 15), (uint8_t)testRange(0, WIDTH + 15),
+                       (uint8_t)testRange(0, HEIGHT + 15));
+    }
+
+    checkPolylines();
+
+    printf("compared %u lines and %u polylines against textbook Bresenham; per octant:", count, POLYLINES);
+    for (uint8_t i = 0; i < 8; i++) {
+        printf(" %u", octantCount[i]);
+        TEST_EXPECT(octantCount[i] > 1000, "octant %u only has %u lines", i, octantCount[i]);
+    }
+    printf("\n");
+
+    // 4. 每秒线段数
+    printf("segments per second, %u segments per batch:\n", BENCH_LINES);
+    makeSegments(WIDTH);
+    benchSegments("random full-screen");
+    makeSegments(SHORT_SEGMENT);
+    benchSegments("short (<= 8 px per axis)");
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,207 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-oled-crc.c
+ * @brief          : 页CRC跳过测试
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 软件页CRC与STM32 CRC外设的算法一致: 以0x12345678 -> 0xDF8A8A2B的已知结果校验参考实现, 再逐页比较
+ * 2. 以双缓冲交替提交随机变化的画面, 每帧整屏重绘(全部页被标记为脏), 经oledFlush和模拟总线发送后
+ *    检查屏幕与提交的画面一致, 且发送的页数恰好等于与屏幕内容不同的页数
+ * 3. 同一序列关闭CRC比较(每帧清除pageCRCValid)再运行一次, 给出两者的总线字节数和页CRC的耗时
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "sim-oled.h"
+#include "test-common.h"
+
+#include "drv-oled.c" // 直接包含以测试静态函数oledPageCRC
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define FRAMES 3000 // 模拟的帧数
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t bytes;     // 总线字节数
+    uint32_t pagesSent; // 发送的页数
+    uint32_t unchanged; // 无需发送的帧数
+} RunResultTypeDef;
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static PageCanvasTypeDef scene; // 当前画面
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 按STM32 CRC外设的定义逐位计算, 作为参考实现
+ *
+ * @param words 32位字
+ * @param count 字数
+ * @return uint32_t
+ */
+static uint32_t referenceCRC(const uint32_t* words, uint32_t count) {
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (uint32_t i = 0; i < count; i++) {
+        for (int8_t bit = 31; bit >= 0; bit--) {
+            uint32_t in = (words[i] >> bit) & 1;
+            uint32_t c  = crc >> 31;
+            crc <<= 1;
+            if (c ^ in) {
+                crc ^= 0x04C11DB7;
+            }
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief 随机修改画面: 多数帧不变或只改一两页, 少数帧整屏变化
+ *
+ */
+static void evolveScene(void) {
+    uint32_t kind = testRand() % 10;
+
+    if (kind < 4) {
+        return; // 画面不变, 但仍整屏重绘
+    }
+    if (kind < 9) {
+        uint8_t pages = (uint8_t)testRange(1, 2);
+        for (uint8_t i = 0; i < pages; i++) {
+            uint8_t page = (uint8_t)testRange(0, PAGE - 1);
+            uint8_t x    = (uint8_t)testRange(0, WIDTH - 1);
+            scene[page][x] ^= (uint8_t)testRange(1, 255);
+        }
+        return;
+    }
+    for (uint8_t page = 0; page < PAGE; page++) {
+        for (uint8_t x = 0; x < WIDTH; x++) {
+            scene[page][x] = (uint8_t)testRand();
+        }
+    }
+}
+
+/**
+ * @brief 屏幕上与画面内容不同的页数
+ *
+ * @return uint8_t
+ */
+static uint8_t pagesDiffering(void) {
+    uint8_t count = 0;
+    for (uint8_t page = 0; page < PAGE; page++) {
+        count += memcmp(simPanel.gddram[page], scene[page], WIDTH) != 0;
+    }
+    return count;
+}
+
+/**
+ * @brief 以双缓冲运行一段随机画面序列
+ *
+ * @param crcSkip 0时每帧清除pageCRCValid, 所有脏页都发送
+ * @return RunResultTypeDef
+ */
+static RunResultTypeDef runSequence(uint8_t crcSkip) {
+    static OLEDObjTypeDef oled;
+    CanvasTypeDef source = CANVAS_FROM_ARRAY(scene);
+    CanvasTypeDef frames[2];
+
+    testSeed = 12345;
+    memset(scene, 0, sizeof(scene));
+    memset(&simPanel, 0xAA, sizeof(simPanel.gddram)); // 屏幕初始内容未知
+
+    oledIntf.init(&oled);
+    frames[0] = OLED_FRAME_CANVAS(oled.graphicsBuffer);
+    frames[1] = OLED_FRAME_CANVAS(oled.graphicsBufferSub);
+    graphServIntf.bindDirtyMap(&frames[0], &oled.dirtyMap[0]);
+    graphServIntf.bindDirtyMap(&frames[1], &oled.dirtyMap[1]);
+    oledIntf.clear(&oled);
+
+    uint32_t bytes     = simPanel.bytes;
+    uint32_t pagesSent = oled.pageSent;
+
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        uint8_t index = frame & 1;
+
+        evolveScene();
+        graphServIntf.copyRect(&frames[index], &source, CANVAS_FULL_AREA); // 整屏重绘, 全部页被标记为脏
+
+        if (!crcSkip) {
+            oled.pageCRCValid = 0;
+        }
+
+        uint8_t expectPages = crcSkip ? pagesDiffering() : PAGE;
+        uint32_t before     = oled.pageSent;
+
+        oledIntf.submit(&oled, index, 0);
+        TEST_EXPECT(oledIntf.flush(&oled) == OLED_SUCCESS, "frame %u: flush failed", frame);
+        simIicDrain();
+
+        TEST_EXPECT(simPanelEquals(&source, 0), "frame %u: panel differs from the submitted frame", frame);
+        TEST_EXPECT(oled.pageSent - before == expectPages, "frame %u: sent %u pages, %u differ from the panel", frame,
+                    oled.pageSent - before, expectPages);
+    }
+
+    TEST_EXPECT(simPanel.errors == 0, "%u malformed commands", simPanel.errors);
+
+    return (RunResultTypeDef){simPanel.bytes - bytes, oled.pageSent - pagesSent, oled.frameStat.unchanged};
+}
+
+int main(void) {
+    // 1. CRC算法
+    static const uint32_t vector = 0x12345678;
+    TEST_EXPECT(referenceCRC(&vector, 1) == 0xDF8A8A2B, "reference CRC of 0x12345678 is %08X", referenceCRC(&vector, 1));
+
+    uint32_t page[WIDTH / 4];
+    for (uint32_t trial = 0; trial < 10000; trial++) {
+        for (uint8_t i = 0; i < WIDTH / 4; i++) {
+            page[i] = trial < 2 ? -trial : testRand(); // 全0, 全1, 随机
+        }
+        TEST_EXPECT(oledPageCRC((const uint8_t*)page) == referenceCRC(page, WIDTH / 4), "page CRC differs (trial %u)",
+                    trial);
+    }
+
+    // 2. 跳过与屏幕相同的页
+    RunResultTypeDef skip = runSequence(1);
+    RunResultTypeDef full = runSequence(0);
+
+    printf("%u frames, every page redrawn and marked dirty each frame:\n", FRAMES);
+    printf("  CRC skip  %8u bus bytes  %6u pages sent  %u frames unchanged\n", skip.bytes, skip.pagesSent,
+           skip.unchanged);
+    printf("  no skip   %8u bus bytes  %6u pages sent\n", full.bytes, full.pagesSent);
+    printf("  bus bytes saved %.1f%%\n", 100.0 * (full.bytes - skip.bytes) / full.bytes);
+    TEST_EXPECT(skip.bytes < full.bytes, "CRC skip did not reduce bus traffic");
+
+    // 3. 耗时
+    double crcNs = TEST_BENCH(testSink += oledPageCRC((const uint8_t*)page));
+    printf("software page CRC %.0f ns/page (on target the CRC unit takes 32 words x ~4 cycles)\n", crcNs);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,224 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-oled-scroll.c
+ * @brief          : 滚动命令与中断中帧发送的并发测试
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 一帧正在发送时提交滚动命令: 请求被接受但不立即发送, 帧的窗口命令和数据不被改写; 帧发送完成后由帧调度
+ *    发送滚动命令, 命令发送完成前的第二个请求被拒绝
+ * 2. 停止滚动后下一帧整屏发送
+ * 3. 以随机顺序交错主循环的渲染/提交/滚动请求与中断中的帧调度/传输完成, 最后屏幕内容与最后提交的画面一致,
+ *    滚动状态与最后被接受的请求一致, 没有无法解析的命令
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "sim-oled.h"
+#include "test-common.h"
+
+#include "drv-oled.c" // 直接包含以检查滚动请求状态和IIC发送缓冲区
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define RANDOM_STEPS 200000 // 随机交错的步数
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static OLEDObjTypeDef oled;
+static CanvasTypeDef frames[2];
+static PageCanvasTypeDef scene[2]; // 两个图形缓冲区中的画面
+static uint8_t submitted;          // 最后提交的图形缓冲区
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 帧调度中断: TIM6_IRQHandler以及传输结束后挂起的同一中断
+ *
+ * @param tick 1: 定时器更新, 开放发送时隙
+ * @return OLEDErrCode
+ */
+static OLEDErrCode scheduleIsr(uint8_t tick) {
+    if (tick) {
+        oledIntf.frameTick(&oled);
+    }
+    return oledIntf.schedule(&oled);
+}
+
+/**
+ * @brief IIC中断: 完成一次传输, 总线空闲时挂起帧调度中断
+ *
+ * @return uint8_t 没有进行中的传输时返回0
+ */
+static uint8_t completeIsr(void) {
+    if (!simIicComplete()) {
+        return 0;
+    }
+    if (!oled.busy) {
+        scheduleIsr(0);
+    }
+    return 1;
+}
+
+/**
+ * @brief 主循环: 在不被DMA读取的图形缓冲区中随机修改画面并提交
+ *
+ */
+static void renderAndSubmit(void) {
+    uint8_t index = !submitted;
+
+    if (oledIntf.frameInUse(&oled, index)) {
+        index = submitted; // 另一缓冲区正在发送, 已提交的缓冲区尚未开始发送, 可以改写
+    }
+    if (oledIntf.frameInUse(&oled, index)) {
+        return;
+    }
+
+    CanvasTypeDef source = CANVAS_FROM_ARRAY(scene[index]);
+    if (index != submitted) {
+        memcpy(scene[index], scene[submitted], sizeof(scene[index]));
+    }
+    for (uint8_t i = (uint8_t)testRange(0, 3); i > 0; i--) {
+        scene[index][testRange(0, PAGE - 1)][testRange(0, WIDTH - 1)] ^= (uint8_t)testRange(1, 255);
+    }
+    graphServIntf.copyRect(&frames[index], &source, CANVAS_FULL_AREA);
+
+    submitted = index;
+    oledIntf.submit(&oled, index, 0);
+}
+
+/**
+ * @brief 让帧调度和总线运行到没有待发送的帧和命令
+ *
+ */
+static void settle(void) {
+    do {
+        scheduleIsr(1);
+        while (completeIsr()) {
+        }
+    } while (oled.busy || oled.frameReady != OLED_FRAME_NONE || oled.scrollReq != OLED_SCROLL_REQ_NONE);
+}
+
+/**
+ * @brief 初始化驱动和两个图形缓冲区的画布
+ *
+ */
+static void setup(void) {
+    simIicSetAsync(0);
+    oledIntf.init(&oled);
+    frames[0] = OLED_FRAME_CANVAS(oled.graphicsBuffer);
+    frames[1] = OLED_FRAME_CANVAS(oled.graphicsBufferSub);
+    graphServIntf.bindDirtyMap(&frames[0], &oled.dirtyMap[0]);
+    graphServIntf.bindDirtyMap(&frames[1], &oled.dirtyMap[1]);
+    oledIntf.clear(&oled);
+    memset(scene, 0, sizeof(scene));
+    submitted = 0;
+    simIicSetAsync(1);
+}
+
+/**
+ * @brief 帧发送过程中提交滚动命令
+ *
+ */
+static void checkScrollDuringFrame(void) {
+    uint8_t window[OLED_WINDOW_CMD_SIZE];
+    CanvasTypeDef shown;
+
+    setup();
+    renderAndSubmit();
+    TEST_EXPECT(scheduleIsr(1) == OLED_SUCCESS, "frame was not taken");
+    TEST_EXPECT(simIicPending() && oled.busy, "frame is not in flight");
+    memcpy(window, oledIIC.txBuffer, sizeof(window));
+
+    TEST_EXPECT(oledIntf.scroll(&oled, OLED_SCROLL_LEFT, 0, 7, 0) == OLED_SUCCESS, "scroll rejected during a frame");
+    TEST_EXPECT(oledIntf.stopScroll(&oled) == OLED_ERR, "second request accepted while the first is pending");
+    TEST_EXPECT(memcmp(window, oledIIC.txBuffer, sizeof(window)) == 0, "window commands overwritten by scroll");
+    TEST_EXPECT(oled.scrollReq == OLED_SCROLL_REQ_PENDING, "scroll request state %u", oled.scrollReq);
+    TEST_EXPECT(scheduleIsr(1) == OLED_ERR && oled.scrollReq == OLED_SCROLL_REQ_PENDING,
+                "scroll started while the bus is busy");
+
+    simIicSetAsync(0); // 不经中断挂起, 单独检查帧完成后的状态
+    simIicDrain();
+    shown = CANVAS_FROM_ARRAY(scene[submitted]);
+    TEST_EXPECT(simPanelEquals(&shown, 0), "frame corrupted by a concurrent scroll request");
+    TEST_EXPECT(!simPanel.scrolling, "scroll sent before the frame finished");
+
+    TEST_EXPECT(scheduleIsr(0) == OLED_ERR && oled.scrollReq == OLED_SCROLL_REQ_NONE, "scroll not sent when idle");
+    TEST_EXPECT(simPanel.scrolling, "panel is not scrolling");
+
+    // 停止滚动后整屏发送
+    uint32_t pages = oled.pageSent;
+    TEST_EXPECT(oledIntf.stopScroll(&oled) == OLED_SUCCESS, "stop scroll rejected");
+    renderAndSubmit();
+    TEST_EXPECT(scheduleIsr(1) == OLED_ERR && !simPanel.scrolling, "stop scroll not sent before the frame");
+    TEST_EXPECT(scheduleIsr(0) == OLED_SUCCESS, "frame not taken after stop scroll");
+    shown = CANVAS_FROM_ARRAY(scene[submitted]);
+    TEST_EXPECT(simPanelEquals(&shown, 0), "panel differs after stop scroll");
+    TEST_EXPECT(oled.pageSent - pages == PAGE, "%u pages sent after stop scroll", oled.pageSent - pages);
+}
+
+/**
+ * @brief 随机交错主循环与中断
+ *
+ */
+static void checkRandomInterleaving(void) {
+    uint32_t accepted = 0;
+    uint32_t rejected = 0;
+    uint8_t scrolling = 0;
+
+    setup();
+    for (uint32_t step = 0; step < RANDOM_STEPS; step++) {
+        uint32_t action = testRand() % 16;
+
+        if (action < 3) {
+            renderAndSubmit();
+        } else if (action < 5) {
+            scheduleIsr(1);
+        } else if (action < 15) {
+            completeIsr();
+        } else {
+            uint8_t start = testRand() & 1;
+            if ((start ? oledIntf.scroll(&oled, OLED_SCROLL_RIGHT, 0, 7, 7) : oledIntf.stopScroll(&oled)) ==
+                OLED_SUCCESS) {
+                scrolling = start;
+                accepted++;
+            } else {
+                rejected++;
+            }
+        }
+    }
+    settle();
+
+    CanvasTypeDef shown = CANVAS_FROM_ARRAY(scene[submitted]);
+    printf("%u random steps: %u frames sent, %u scroll requests accepted, %u rejected while pending\n", RANDOM_STEPS,
+           oled.frameStat.sent, accepted, rejected);
+    TEST_EXPECT(simPanelEquals(&shown, 0), "panel differs from the last submitted frame");
+    TEST_EXPECT(simPanel.scrolling == scrolling, "panel scrolling %u, last request %u", simPanel.scrolling, scrolling);
+    TEST_EXPECT(simPanel.errors == 0, "%u malformed commands", simPanel.errors);
+}
+
+int main(void) {
+    checkScrollDuringFrame();
+    checkRandomInterleaving();
+
+    return TEST_RESULT();
+}
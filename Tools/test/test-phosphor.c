@@ -0,0 +1,287 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-phosphor.c
+ * @brief          : 余辉亮度缓冲区的衰减、活动区域与FRC渲染测试
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 以500Hz采样的李萨如图形击中缓冲区, 每20ms衰减一个周期; 每次衰减后活动区域必须恰为非零像素的包围盒,
+ *    任何时刻非零像素都在area()之内; 信号停止后所有像素在限定周期内熄灭, 活动区域收缩为空
+ * 2. 每个亮度等级在连续PHOSPHOR_FRC_FRAMES帧中点亮的帧数等于其灰度等级
+ * 3. 信号停止时刻起每3个衰减周期渲染一帧(三帧FRC平均为灰度), 拼接为phosphor-decay.pgm,
+ *    与提交的同名文件逐字节比较; 输出写入build/phosphor-decay.pgm
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "phosphor-service.h"
+#include "test-common.h"
+#include <math.h>
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define SAMPLE_RATE    500                       // 采样频率, 与TIM7一致
+#define TICK_SAMPLES   (SAMPLE_RATE * 20 / 1000) // 每个衰减周期的采样数
+#define SIGNAL_TICKS   50                        // 有信号的衰减周期数
+#define DARK_TICKS     32                        // 信号停止后必须全部熄灭的周期数
+#define PANEL_COUNT    8                         // 衰减序列的帧数
+#define PANEL_INTERVAL 3                         // 衰减序列相邻帧间隔的周期数
+#define PANEL_GAP      2                         // 拼接图中帧之间的间隔像素, 以中灰色填充
+#define PGM_WIDTH      (PANEL_COUNT * PHOSPHOR_WIDTH + (PANEL_COUNT - 1) * PANEL_GAP)
+#define GOLDEN_PGM     "phosphor-decay.pgm"
+#define OUTPUT_PGM     "build/phosphor-decay.pgm"
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static PhosphorTypeDef phosphor;
+static PageCanvasTypeDef screen;
+static uint8_t pgm[PHOSPHOR_HEIGHT][PGM_WIDTH];
+static uint32_t sampleIndex;
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 视口坐标处像素的亮度
+ *
+ * @param vx
+ * @param vy
+ * @return uint8_t
+ */
+static uint8_t intensityAt(uint8_t vx, uint8_t vy) {
+    return (phosphor.intensity[vy][vx >> 1] >> ((vx & 1) << 2)) & 0x0F;
+}
+
+/**
+ * @brief 区域a是否包含区域b
+ *
+ * @param a
+ * @param b 空区域被任何区域包含
+ * @return uint8_t
+ */
+static uint8_t areaContains(RectParamTypeDef a, RectParamTypeDef b) {
+    if (b.x0 > b.x1) {
+        return 1;
+    }
+    return a.x0 <= a.x1 && a.x0 <= b.x0 && a.y0 <= b.y0 && a.x1 >= b.x1 && a.y1 >= b.y1;
+}
+
+/**
+ * @brief 非零像素的包围盒(屏幕坐标)
+ *
+ * @return RectParamTypeDef 无非零像素时为空区域
+ */
+static RectParamTypeDef litBounds(void) {
+    RectParamTypeDef bounds = {0xFF, 0xFF, 0, 0};
+
+    for (uint8_t vy = 0; vy < PHOSPHOR_HEIGHT; vy++) {
+        for (uint8_t vx = 0; vx < PHOSPHOR_WIDTH; vx++) {
+            if (intensityAt(vx, vy)) {
+                uint8_t x = PHOSPHOR_X0 + vx;
+                uint8_t y = PHOSPHOR_Y0 + vy;
+                bounds.x0 = x < bounds.x0 ? x : bounds.x0;
+                bounds.x1 = x > bounds.x1 ? x : bounds.x1;
+                bounds.y0 = y < bounds.y0 ? y : bounds.y0;
+                bounds.y1 = y > bounds.y1 ? y : bounds.y1;
+            }
+        }
+    }
+
+    return bounds;
+}
+
+/**
+ * @brief 一个衰减周期内的采样, 李萨如图形 x:y = 3:2
+ *
+ */
+static void sampleTick(void) {
+    for (uint8_t i = 0; i < TICK_SAMPLES; i++, sampleIndex++) {
+        double t      = (double)sampleIndex / SAMPLE_RATE;
+        uint16_t adcX = (uint16_t)lround(2047.5 + 2047.5 * sin(2 * M_PI * 1.5 * t));
+        uint16_t adcY = (uint16_t)lround(2047.5 + 2047.5 * sin(2 * M_PI * 1.0 * t + M_PI / 4));
+
+        phosphorServIntf.hit(&phosphor, MAP_ADC_TO_OLED_X(adcX), MAP_ADC_TO_OLED_Y(adcY));
+    }
+}
+
+/**
+ * @brief 衰减一个周期并检查活动区域
+ *
+ * @param tick 周期序号, 用于报告
+ */
+static void decayTick(uint32_t tick) {
+    TEST_EXPECT(areaContains(phosphorServIntf.area(&phosphor), litBounds()), "tick %u: lit pixel outside area()",
+                tick);
+
+    phosphorServIntf.decay(&phosphor, 1);
+
+    RectParamTypeDef bounds = litBounds();
+    RectParamTypeDef active = phosphor.active;
+    TEST_EXPECT(memcmp(&bounds, &active, sizeof(bounds)) == 0 || (bounds.x0 > bounds.x1 && active.x0 > active.x1),
+                "tick %u: active (%u,%u)-(%u,%u), lit pixels span (%u,%u)-(%u,%u)", tick, active.x0, active.y0,
+                active.x1, active.y1, bounds.x0, bounds.y0, bounds.x1, bounds.y1);
+}
+
+/**
+ * @brief 以三帧FRC的平均灰度将视口渲染到拼接图的一帧
+ *
+ * @param panel 帧序号
+ */
+static void renderPanel(uint8_t panel) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(screen);
+    uint8_t lit[PHOSPHOR_HEIGHT][PHOSPHOR_WIDTH];
+
+    memset(lit, 0, sizeof(lit));
+    for (uint8_t frame = 0; frame < PHOSPHOR_FRC_FRAMES; frame++) {
+        memset(screen, 0, sizeof(screen));
+        phosphorServIntf.render(&phosphor, &canvas, CANVAS_FULL_AREA);
+        phosphorServIntf.nextFrame(&phosphor);
+
+        for (uint8_t vy = 0; vy < PHOSPHOR_HEIGHT; vy++) {
+            for (uint8_t vx = 0; vx < PHOSPHOR_WIDTH; vx++) {
+                lit[vy][vx] += CANVAS_GET_PIXEL(&canvas, PHOSPHOR_X0 + vx, PHOSPHOR_Y0 + vy) ? 1 : 0;
+            }
+        }
+    }
+
+    for (uint8_t vy = 0; vy < PHOSPHOR_HEIGHT; vy++) {
+        for (uint8_t vx = 0; vx < PHOSPHOR_WIDTH; vx++) {
+            pgm[vy][panel * (PHOSPHOR_WIDTH + PANEL_GAP) + vx] = lit[vy][vx] * 255 / PHOSPHOR_FRC_FRAMES;
+        }
+    }
+}
+
+/**
+ * @brief 每个亮度在一个FRC周期内点亮的帧数等于其灰度等级
+ *
+ */
+static void checkFrc(void) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(screen);
+
+    for (uint8_t level = 0; level <= PHOSPHOR_MAX; level++) {
+        for (uint8_t vx = 0; vx < 3; vx++) {
+            uint8_t lit = 0;
+            uint8_t x   = PHOSPHOR_X0 + vx;
+
+            phosphorServIntf.init(&phosphor);
+            phosphor.intensity[0][vx >> 1] = (uint8_t)(level << ((vx & 1) << 2));
+            phosphor.active                = (RectParamTypeDef){x, PHOSPHOR_Y0, x, PHOSPHOR_Y0};
+
+            for (uint8_t frame = 0; frame < PHOSPHOR_FRC_FRAMES; frame++) {
+                memset(screen, 0, sizeof(screen));
+                phosphorServIntf.render(&phosphor, &canvas, CANVAS_FULL_AREA);
+                phosphorServIntf.nextFrame(&phosphor);
+                lit += CANVAS_GET_PIXEL(&canvas, x, PHOSPHOR_Y0) ? 1 : 0;
+            }
+            TEST_EXPECT(lit == (level >> PHOSPHOR_LEVEL_SHIFT), "intensity %u at column %u lit %u of %u frames", level,
+                        vx, lit, PHOSPHOR_FRC_FRAMES);
+        }
+    }
+}
+
+/**
+ * @brief 写出拼接图并与提交的文件比较
+ *
+ */
+static void writePgm(void) {
+    static uint8_t golden[sizeof(pgm) + 64];
+    char header[32];
+    int headerLen = sprintf(header, "P5\n%u %u\n255\n", PGM_WIDTH, PHOSPHOR_HEIGHT);
+    FILE* file    = fopen(OUTPUT_PGM, "wb");
+
+    TEST_EXPECT(file != NULL, "cannot write %s", OUTPUT_PGM);
+    if (file != NULL) {
+        fwrite(header, 1, headerLen, file);
+        fwrite(pgm, 1, sizeof(pgm), file);
+        fclose(file);
+    }
+
+    file = fopen(GOLDEN_PGM, "rb");
+    TEST_EXPECT(file != NULL, "cannot read %s", GOLDEN_PGM);
+    if (file != NULL) {
+        size_t len = fread(golden, 1, sizeof(golden), file);
+        fclose(file);
+        TEST_EXPECT(len == headerLen + sizeof(pgm) && memcmp(golden, header, headerLen) == 0 &&
+                        memcmp(golden + headerLen, pgm, sizeof(pgm)) == 0,
+                    "%s differs from %s", OUTPUT_PGM, GOLDEN_PGM);
+    }
+}
+
+int main(void) {
+    uint32_t tick = 0;
+
+    printf("PhosphorTypeDef %zu bytes (was %zu with 8-bit full-screen intensities), viewport %ux%u at (%u,%u)\n",
+           sizeof(PhosphorTypeDef), HEIGHT * WIDTH + sizeof(RectParamTypeDef) + 1, PHOSPHOR_WIDTH, PHOSPHOR_HEIGHT,
+           PHOSPHOR_X0, PHOSPHOR_Y0);
+
+    // 1. 有信号时的活动区域
+    phosphorServIntf.init(&phosphor);
+    for (; tick < SIGNAL_TICKS; tick++) {
+        sampleTick();
+        decayTick(tick);
+    }
+    sampleTick(); // 最后一批采样尚未衰减, 只在area()中
+
+    // 2. 信号停止后的衰减序列
+    memset(pgm, 0x80, sizeof(pgm));
+    uint32_t darkTick = 0;
+    for (uint32_t i = 0; i < DARK_TICKS * 2; i++, tick++) {
+        if (i % PANEL_INTERVAL == 0 && i / PANEL_INTERVAL < PANEL_COUNT) {
+            renderPanel(i / PANEL_INTERVAL);
+        }
+        decayTick(tick);
+        if (darkTick == 0 && phosphor.active.x0 > phosphor.active.x1) {
+            darkTick = i + 1;
+        }
+    }
+    RectParamTypeDef area = phosphorServIntf.area(&phosphor);
+    TEST_EXPECT(area.x0 > area.x1, "area() not empty after the signal stopped");
+    TEST_EXPECT(darkTick != 0 && darkTick <= DARK_TICKS, "dark after %u ticks, limit %u", darkTick, DARK_TICKS);
+    printf("all pixels dark %u ticks (%.0f ms) after the signal stopped; active box empty\n", darkTick,
+           darkTick * PHOSPHOR_DECAY_PERIOD * 1000);
+
+    writePgm();
+    printf("decay sequence: %s, one panel every %u ticks (%.0f ms)\n", OUTPUT_PGM, PANEL_INTERVAL,
+           PANEL_INTERVAL * PHOSPHOR_DECAY_PERIOD * 1000);
+
+    // 3. FRC占空比
+    checkFrc();
+
+    // 4. 耗时: 有信号时的一个衰减周期与一帧渲染
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(screen);
+    phosphorServIntf.init(&phosphor);
+    sampleIndex = 0;
+    for (uint8_t i = 0; i < 20; i++) {
+        sampleTick();
+        phosphorServIntf.decay(&phosphor, 1);
+    }
+    PhosphorTypeDef saved = phosphor;
+    double decayNs        = TEST_BENCH({
+        phosphor = saved;
+        phosphorServIntf.decay(&phosphor, 1);
+    });
+    double renderNs       = TEST_BENCH(phosphorServIntf.render(&saved, &canvas, CANVAS_FULL_AREA));
+    printf("ns per call with a live trace: decay %.0f (includes a %zu-byte copy), render %.0f\n", decayNs,
+           sizeof(saved), renderNs);
+
+    return TEST_RESULT();
+}
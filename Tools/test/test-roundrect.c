@@ -0,0 +1,192 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-roundrect.c
+ * @brief          : 圆角矩形列跨度光栅化测试
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 以随机矩形和半径0~12比较fillRoundRect和drawRoundRect2DotMatrix与基线sqrt实现(点阵图绘制后转换为页格式)
+ * 的输出, 半径超过圆角表时覆盖整数开方分支; 再比较高亮反转与基线"点阵掩码+InverBufferWithMask"的结果,
+ * 以及设置裁剪矩形后只有矩形内的像素被修改. 最后按半径0~8给出一次高亮的耗时
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "baseline.h"
+#include "test-common.h"
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define TRIALS       20000 // 随机矩形数量
+#define RADIUS_MAX   12    // 测试的最大半径, 超过圆角表的部分走整数开方
+#define BENCH_RADIUS 8     // 基准测试的最大半径, 与圆角表覆盖的范围相同
+#define BENCH_X0     32    // 基准使用的高亮矩形, 与参数界面的选择框宽度相同, 高度容纳半径8
+#define BENCH_Y0     16
+#define BENCH_X1     76
+#define BENCH_Y1     32
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static DotMatrixTypeDef mask;
+static PageCanvasTypeDef expect, actual, origin;
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 以随机内容填充页格式缓冲区
+ *
+ * @param buffer
+ */
+static void fillRandom(PageCanvasTypeDef buffer) {
+    for (uint8_t page = 0; page < PAGE; page++) {
+        for (uint8_t x = 0; x < WIDTH; x++) {
+            buffer[page][x] = (uint8_t)testRand();
+        }
+    }
+}
+
+/**
+ * @brief 生成基线可以正确绘制的随机圆角矩形, 宽高均不小于2 * radius + 1
+ *
+ * @param rect 返回的矩形
+ * @param radius 返回的半径
+ */
+static void randomRoundRect(RectParamTypeDef* rect, uint8_t* radius) {
+    *radius   = (uint8_t)testRange(0, RADIUS_MAX);
+    uint8_t w = (uint8_t)testRange(2 * *radius + 1, WIDTH);
+    uint8_t h = (uint8_t)testRange(2 * *radius + 1, HEIGHT);
+    rect->x0  = (uint8_t)testRange(0, WIDTH - w);
+    rect->y0  = (uint8_t)testRange(0, HEIGHT - h);
+    rect->x1  = rect->x0 + w - 1;
+    rect->y1  = rect->y0 + h - 1;
+}
+
+/**
+ * @brief 以基线实现在点阵图中绘制后转换为页格式
+ *
+ * @param rect
+ * @param radius
+ * @param padding
+ */
+static void baselineDraw(RectParamTypeDef rect, uint8_t radius, uint8_t padding) {
+    memset(mask, 0, sizeof(mask));
+    baselineRoundRect(mask, rect.x0, rect.y0, rect.x1, rect.y1, radius, padding);
+    baselineBitToByte(mask, expect);
+}
+
+/**
+ * @brief 实心与边框模式分别与基线比较
+ *
+ */
+static void checkDraw(void) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(actual);
+
+    for (uint32_t trial = 0; trial < TRIALS; trial++) {
+        RectParamTypeDef rect;
+        uint8_t radius;
+        randomRoundRect(&rect, &radius);
+
+        for (uint8_t padding = 0; padding <= 1; padding++) {
+            baselineDraw(rect, radius, padding);
+            memset(actual, 0, sizeof(actual));
+            graphServIntf.drawRoundRect2DotMatrix(&canvas, rect.x0, rect.y0, rect.x1, rect.y1, radius, padding);
+            TEST_EXPECT(memcmp(expect, actual, sizeof(actual)) == 0, "rect (%u,%u)-(%u,%u) r%u padding %u differs",
+                        rect.x0, rect.y0, rect.x1, rect.y1, radius, padding);
+        }
+
+        memset(actual, 0, sizeof(actual));
+        graphServIntf.fillRoundRect(&canvas, rect.x0, rect.y0, rect.x1, rect.y1, radius, RASTER_OP_OR);
+        TEST_EXPECT(memcmp(expect, actual, sizeof(actual)) == 0, "fillRoundRect (%u,%u)-(%u,%u) r%u differs", rect.x0,
+                    rect.y0, rect.x1, rect.y1, radius);
+    }
+}
+
+/**
+ * @brief 在随机画面上反转高亮, 与基线的掩码反转比较; 再以随机裁剪矩形检查矩形外的像素不变
+ *
+ */
+static void checkHighlight(void) {
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(actual);
+
+    for (uint32_t trial = 0; trial < TRIALS; trial++) {
+        RectParamTypeDef rect;
+        uint8_t radius;
+        randomRoundRect(&rect, &radius);
+        fillRandom(origin);
+
+        memcpy(expect, origin, sizeof(origin));
+        memset(mask, 0, sizeof(mask));
+        baselineRoundRect(mask, rect.x0, rect.y0, rect.x1, rect.y1, radius, 1);
+        baselineInvertWithMask(mask, expect);
+
+        memcpy(actual, origin, sizeof(origin));
+        graphServIntf.fillRoundRect(&canvas, rect.x0, rect.y0, rect.x1, rect.y1, radius, RASTER_OP_XOR);
+        TEST_EXPECT(memcmp(expect, actual, sizeof(actual)) == 0, "highlight (%u,%u)-(%u,%u) r%u differs", rect.x0,
+                    rect.y0, rect.x1, rect.y1, radius);
+
+        RectParamTypeDef clip = {(uint8_t)testRange(0, WIDTH - 1), (uint8_t)testRange(0, HEIGHT - 1), 0, 0};
+        clip.x1               = (uint8_t)testRange(clip.x0, WIDTH - 1);
+        clip.y1               = (uint8_t)testRange(clip.y0, HEIGHT - 1);
+
+        memcpy(actual, origin, sizeof(origin));
+        graphServIntf.setClipRect(clip);
+        graphServIntf.fillRoundRect(&canvas, rect.x0, rect.y0, rect.x1, rect.y1, radius, RASTER_OP_XOR);
+        graphServIntf.resetClipRect();
+
+        for (uint8_t y = 0; y < HEIGHT; y++) {
+            for (uint8_t x = 0; x < WIDTH; x++) {
+                uint8_t inside = x >= clip.x0 && x <= clip.x1 && y >= clip.y0 && y <= clip.y1;
+                uint8_t want   = ((inside ? expect : origin)[y >> 3][x] >> (y & 7)) & 1;
+                TEST_EXPECT(CANVAS_GET_PIXEL(&canvas, x, y) == want, "clipped highlight r%u: pixel (%u,%u) differs",
+                            radius, x, y);
+            }
+        }
+    }
+}
+
+int main(void) {
+    checkDraw();
+    checkHighlight();
+
+    CanvasTypeDef canvas = CANVAS_FROM_ARRAY(actual);
+    double rate          = testCyclesPerNs();
+
+    printf("highlight %ux%u, fillRoundRect XOR vs baseline sqrt mask + InverBufferWithMask:\n", BENCH_X1 - BENCH_X0 + 1,
+           BENCH_Y1 - BENCH_Y0 + 1);
+    printf("  radius   span ns  (cycles)   sqrt ns  (cycles)  speedup\n");
+    fillRandom(actual);
+    memcpy(expect, actual, sizeof(actual));
+    for (uint8_t radius = 0; radius <= BENCH_RADIUS; radius++) {
+        double spanNs = TEST_BENCH(graphServIntf.fillRoundRect(&canvas, BENCH_X0, BENCH_Y0, BENCH_X1, BENCH_Y1, radius,
+                                                               RASTER_OP_XOR));
+        double sqrtNs = TEST_BENCH({
+            memset(mask, 0, sizeof(mask));
+            baselineRoundRect(mask, BENCH_X0, BENCH_Y0, BENCH_X1, BENCH_Y1, radius, 1);
+            baselineInvertWithMask(mask, expect);
+        });
+        printf("  %6u %9.0f %9.0f %9.0f %9.0f %7.1fx\n", radius, spanNs, spanNs * rate, sqrtNs, sqrtNs * rate,
+               sqrtNs / spanNs);
+    }
+
+    return TEST_RESULT();
+}
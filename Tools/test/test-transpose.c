@@ -0,0 +1,128 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-transpose.c
+ * @brief          : bitToByte字并行转置测试
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 以随机, 全亮和稀疏的字节点阵比较32位字并行转置(GRAPH_WORD_TRANSPOSE 1)与逐像素参考实现的页格式输出,
+ * 覆盖屏幕画布, 页带画布和宽高不是8的倍数时的逐像素回退, 并给出两者转换一帧的耗时
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "graph-ref.h"
+#include "test-common.h"
+#include <string.h>
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define TRIALS 200 // 每种输入的随机点阵数量
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef enum {
+    FILL_RANDOM, // 每像素取随机字节
+    FILL_FULL,   // 全部非0, 取值覆盖0x01~0xFF
+    FILL_SPARSE, // 约1/32的像素非0
+    FILL_ZERO,   // 全部为0
+} FillEnum;
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static uint8_t dotMatrix[HEIGHT * WIDTH];
+static PageCanvasTypeDef fast, ref;
+
+static const char* fillName[] = {"random", "full", "sparse", "zero"};
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 生成字节点阵
+ *
+ * @param count 像素数
+ * @param fill 点阵类型
+ */
+static void fillDotMatrix(uint16_t count, FillEnum fill) {
+    for (uint16_t i = 0; i < count; i++) {
+        switch (fill) {
+            case FILL_RANDOM: dotMatrix[i] = (uint8_t)testRand(); break;
+            case FILL_FULL: dotMatrix[i] = (uint8_t)(testRand() % 255 + 1); break;
+            case FILL_SPARSE: dotMatrix[i] = (testRand() & 31) == 0 ? (uint8_t)(testRand() % 255 + 1) : 0; break;
+            case FILL_ZERO: dotMatrix[i] = 0; break;
+        }
+    }
+}
+
+/**
+ * @brief 以同一点阵分别调用两种实现, 比较画布覆盖的字节
+ *
+ * @param width 画布宽度
+ * @param height 画布高度
+ * @param firstPage 画布第一页的页号
+ * @param fill 点阵类型
+ */
+static void checkCanvas(uint8_t width, uint8_t height, uint8_t firstPage, FillEnum fill) {
+    CanvasTypeDef a = {&fast[0][0], width, height, WIDTH, firstPage};
+    CanvasTypeDef b = {&ref[0][0], width, height, WIDTH, firstPage};
+
+    for (uint16_t trial = 0; trial < TRIALS; trial++) {
+        fillDotMatrix(width * height, fill);
+        memset(fast, 0xA5, sizeof(fast));
+        memset(ref, 0x5A, sizeof(ref));
+
+        graphServIntf.bitToByte(dotMatrix, &a);
+        graphServIntfRef.bitToByte(dotMatrix, &b);
+
+        for (uint8_t page = 0; page < BITMAP_PAGES(height); page++) {
+            TEST_EXPECT(memcmp(fast[page], ref[page], width) == 0, "%ux%u page %u %s input: output differs", width,
+                        height, firstPage + page, fillName[fill]);
+        }
+    }
+}
+
+int main(void) {
+    for (FillEnum fill = FILL_RANDOM; fill <= FILL_ZERO; fill++) {
+        checkCanvas(WIDTH, HEIGHT, 0, fill); // 屏幕画布, 走8x8块转置
+        checkCanvas(WIDTH, 8, 3, fill);      // 页带画布
+        checkCanvas(56, 56, 0, fill);        // 8的倍数的较小画布
+        checkCanvas(60, 61, 0, fill);        // 回退到逐像素转换
+    }
+
+    CanvasTypeDef a = CANVAS_FROM_ARRAY(fast);
+    CanvasTypeDef b = CANVAS_FROM_ARRAY(ref);
+
+    printf("bitToByte %ux%u, ns/frame:\n", WIDTH, HEIGHT);
+    for (FillEnum fill = FILL_RANDOM; fill <= FILL_SPARSE; fill++) {
+        fillDotMatrix(WIDTH * HEIGHT, fill);
+        double wordNs  = TEST_BENCH(graphServIntf.bitToByte(dotMatrix, &a));
+        double pixelNs = TEST_BENCH(graphServIntfRef.bitToByte(dotMatrix, &b));
+        printf("  %-6s word transpose %8.0f  per-pixel %8.0f  speedup %.1fx\n", fillName[fill], wordNs, pixelNs,
+               pixelNs / wordNs);
+    }
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,387 @@
+/**
+ ***********************************************************************************************************************
+ * @file           : test-ui.c
+ * @brief          : 图形缓冲区模式与页带渲染模式的整机画面比较和RAM占用
+ * @author         : 李嘉豪
+ * @date           : 2025-07-20
+ ***********************************************************************************************************************
+ * @attention
+ *
+ * 1. 同一源文件编译两次: test-ui为图形缓冲区模式(STRIP_RENDER=0), test-ui-strip为页带渲染模式(STRIP_RENDER=1).
+ *    两者按main.c的主循环和帧调度驱动app-ui.c与drv-oled.c, 输入相同的按键/编码器序列和采样点, 覆盖参数浏览,
+ *    编辑, 进入/退出图形查看的切换动画以及三种显示模式, 每帧记录模拟屏幕上显示的画面
+ * 2. test-ui把各帧画面写入build/test-ui.frames, test-ui-strip逐帧与之比较, 因此须在test-ui之后运行.
+ *    uiAppLoop返回0的帧与主循环一样不提交也不刷新, 这些帧屏幕上的画面不变
+ * 3. 两种模式各自给出UI和OLED驱动的静态RAM, IIC发送缓冲区, 以及在单独的栈上运行一帧时的栈峰值;
+ *    栈峰值为主机x86-64上的数值, 只用于比较两种模式
+ *
+ ***********************************************************************************************************************
+ **/
+
+
+
+
+/* ------- includes --------------------------------------------------------------------------------------------------*/
+
+#include "sim-oled.h"
+#include "test-common.h"
+#include <math.h>
+#include <string.h>
+#include <ucontext.h>
+
+#include "drv-oled.h"
+#include "app-ui.c" // 直接包含以统计静态变量的大小
+
+
+
+
+
+/* ------- define ----------------------------------------------------------------------------------------------------*/
+
+#define FRAMES_FILE       "build/test-ui.frames"
+#define FRAME_RATE        50    // 模拟的帧率
+#define SAMPLE_RATE       500   // 采样定时器TIM7的频率
+#define RANDOM_FRAMES     6000  // 随机输入阶段的帧数
+#define MAX_FRAMES        8192  // 记录的帧数上限, 大于脚本与随机阶段的帧数之和
+#define FRAME_STACK_SIZE  65536 // 运行一帧使用的栈
+#define STACK_PAINT       0xA5  // 栈的初始填充, 未被改写的部分即为未使用
+#define SHOWN_FRAME_BYTES (64 * 128 / 8)
+
+#if STRIP_RENDER
+#define MODE_NAME "strip"
+#else
+#define MODE_NAME "buffered"
+#endif /* STRIP_RENDER */
+
+
+
+
+
+/* ------- typedef ---------------------------------------------------------------------------------------------------*/
+
+typedef enum {
+    KEY_NONE,         // 无输入
+    KEY_0,            // 进入或退出图形查看
+    KEY_1,            // 进入或退出编辑
+    KEY_ENCODER_POS,  // 编码器正转
+    KEY_ENCODER_NEG,  // 编码器反转
+    KEY_QUANTITY,
+} KeyEnum;
+
+typedef struct {
+    KeyEnum key;     // 本帧的输入
+    uint16_t frames; // 输入之后无输入的帧数
+} ScriptStepTypeDef;
+
+typedef struct {
+    uint32_t uiState;    // UI参数及app-ui.c中的静态变量
+    uint32_t oledObject; // OLED对象及IIC对象
+    uint32_t txBuffer;   // IIC发送缓冲区(堆)
+    uint32_t stackPeak;  // 运行一帧的栈峰值(主机)
+} RamUsageTypeDef;
+
+typedef struct {
+    char magic[8];
+    uint32_t frames;
+    RamUsageTypeDef ram;
+} FramesHeaderTypeDef; // build/test-ui.frames的文件头, 其后为各帧画面, 每帧64行x128列按位打包
+
+
+
+
+
+/* ------- variables -------------------------------------------------------------------------------------------------*/
+
+static UIAppParamTypeDef ui;
+static OLEDObjTypeDef oled;
+static uint8_t sampling;      // TIM7是否开启
+static uint32_t sampleCount;  // 已产生的采样点数
+static uint8_t shown[64][128];
+
+static ucontext_t mainContext, frameContext;
+static uint8_t frameStack[FRAME_STACK_SIZE];
+static KeyEnum frameKey;    // 传给在单独栈上运行的一帧
+static uint8_t frameIdle;  // 本帧uiAppLoop返回0, 没有提交或刷新
+static uint32_t idleCount; // 没有提交或刷新的帧数
+
+// 固定的操作序列: 浏览动画, 编辑, 进入图形查看后依次切换三种显示模式, 再退出
+static const ScriptStepTypeDef script[] = {
+    {KEY_NONE, 20},        {KEY_ENCODER_POS, 20}, {KEY_ENCODER_POS, 3},   {KEY_ENCODER_POS, 20},
+    {KEY_ENCODER_NEG, 20}, {KEY_1, 5},            {KEY_ENCODER_POS, 2},   {KEY_ENCODER_POS, 2},
+    {KEY_ENCODER_NEG, 5},  {KEY_1, 20},           {KEY_ENCODER_POS, 20},  {KEY_1, 2},
+    {KEY_ENCODER_NEG, 2},  {KEY_1, 20},           {KEY_0, 120},           {KEY_ENCODER_POS, 60},
+    {KEY_ENCODER_POS, 80}, {KEY_ENCODER_POS, 40}, {KEY_ENCODER_NEG, 80},  {KEY_ENCODER_NEG, 30},
+    {KEY_0, 10},           {KEY_0, 100},          {KEY_0, 100},           {KEY_0, 120},
+};
+
+
+
+
+
+/* ------- function implement ----------------------------------------------------------------------------------------*/
+
+/**
+ * @brief 代替StdPeriph的TIM_Cmd, 记录采样定时器TIM7的开关
+ *
+ */
+void TIM_Cmd(TIM_TypeDef* TIMx, FunctionalState NewState) {
+    if (TIMx == TIM7) {
+        sampling = NewState == ENABLE;
+    }
+}
+
+/**
+ * @brief 与main.c中uiParamUpdate相同的事件映射
+ *
+ * @param key
+ */
+static void setEvent(KeyEnum key) {
+    switch (key) {
+        case KEY_0: ui.eventGroup |= (1 << UI_EVENT_FIGURE_EXIT) | (1 << UI_EVENT_FIGURE_VIEW); break;
+        case KEY_1: ui.eventGroup |= (1 << UI_EVENT_VALUE_SELECT) | (1 << UI_EVENT_VALUE_UNSELECT); break;
+        case KEY_ENCODER_POS: ui.eventGroup |= (1 << UI_EVENT_SELECT_NEXT) | (1 << UI_EVENT_VALUE_ADD); break;
+        case KEY_ENCODER_NEG: ui.eventGroup |= (1 << UI_EVENT_SELECT_PREV) | (1 << UI_EVENT_VALUE_SUB); break;
+        default: ui.eventGroup = 0; break;
+    }
+}
+
+/**
+ * @brief 一帧时间内TIM7中断插入的采样点, 两路为频率不同的正弦
+ *
+ */
+static void insertSamples(void) {
+    for (uint8_t i = 0; i < SAMPLE_RATE / FRAME_RATE; i++, sampleCount++) {
+        float t          = (float)sampleCount / SAMPLE_RATE;
+        uint16_t signal1 = (uint16_t)(2048 + 1800 * sinf(2 * 3.14159265f * 3 * t));
+        uint16_t signal2 = (uint16_t)(2048 + 1500 * sinf(2 * 3.14159265f * 2 * t + 0.7f));
+
+        uiAppInsertSample(&ui, MAP_ADC_TO_OLED_X(signal2), MAP_ADC_TO_OLED_Y(signal1));
+        uiAppInsertScopeSample(&ui, signal1, signal2);
+    }
+}
+
+#if STRIP_RENDER
+/**
+ * @brief 与main.c中uiRenderStrip相同
+ *
+ */
+static void renderStrip(const void* arg, const CanvasTypeDef* strip) {
+    displayListServIntf.render((const DisplayListTypeDef*)arg, strip);
+}
+#endif /* STRIP_RENDER */
+
+/**
+ * @brief main.c主循环中的一次UI循环和刷新, 总线为同步模式, 刷新在返回前完成
+ *
+ */
+static void runFrame(void) {
+    setEvent(frameKey);
+    uint8_t changed = uiAppLoop(&ui);
+    frameIdle       = !changed;
+    idleCount += frameIdle;
+
+#if STRIP_RENDER
+    if (changed) {
+        oledIntf.setStartLine(&oled, ui.startLine[ui.bufferIndex]);
+        if (oledIntf.flushStrips(&oled, renderStrip, &ui.displayList) == OLED_SUCCESS) {
+            phosphorServIntf.nextFrame(&ui.phosphor);
+        }
+    }
+#else
+    if (changed) {
+        oledIntf.submit(&oled, ui.bufferIndex, ui.startLine[ui.bufferIndex]);
+    }
+    oledIntf.frameTick(&oled); // TIM6以OLED_MAX_FPS开放时隙, 不低于模拟的帧率
+    if (oledIntf.schedule(&oled) == OLED_SUCCESS) {
+        phosphorServIntf.nextFrame(&ui.phosphor);
+    }
+#endif /* STRIP_RENDER */
+}
+
+/**
+ * @brief 在frameStack上运行一帧, 返回后由栈上未被改写的填充得到栈峰值
+ *
+ * @param key 本帧的输入
+ */
+static void runFrameOnStack(KeyEnum key) {
+    frameKey = key;
+    getcontext(&frameContext);
+    frameContext.uc_stack.ss_sp   = frameStack;
+    frameContext.uc_stack.ss_size = sizeof(frameStack);
+    frameContext.uc_link          = &mainContext;
+    makecontext(&frameContext, runFrame, 0);
+    swapcontext(&mainContext, &frameContext);
+}
+
+/**
+ * @brief 初始化OLED和UI, 与main.c的初始化顺序相同
+ *
+ */
+static void setup(void) {
+    simIicSetAsync(0);
+    simElapsed = 1.0f / FRAME_RATE;
+    oledIntf.init(&oled);
+    oledIntf.cmd(&oled);
+    oledIntf.clear(&oled);
+
+#if !STRIP_RENDER
+    ui.graphicsBuffers[0] = OLED_FRAME_CANVAS(oled.graphicsBuffer);
+    ui.graphicsBuffers[1] = OLED_FRAME_CANVAS(oled.graphicsBufferSub);
+    graphServIntf.bindDirtyMap(&ui.graphicsBuffers[0], &oled.dirtyMap[0]);
+    graphServIntf.bindDirtyMap(&ui.graphicsBuffers[1], &oled.dirtyMap[1]);
+#endif /* STRIP_RENDER */
+
+    uiAppInit(&ui);
+    memset(frameStack, STACK_PAINT, sizeof(frameStack));
+}
+
+/**
+ * @brief 运行一帧并记录屏幕上显示的画面
+ *
+ * @param key 本帧的输入
+ * @param frame 按位打包的画面
+ */
+static void step(KeyEnum key, uint8_t frame[SHOWN_FRAME_BYTES]) {
+    if (sampling) {
+        insertSamples();
+    }
+    runFrameOnStack(key);
+
+    simPanelShown(shown);
+    memset(frame, 0, SHOWN_FRAME_BYTES);
+    for (uint16_t i = 0; i < 64 * 128; i++) {
+        frame[i >> 3] |= (uint8_t)(shown[i >> 7][i & 127] << (i & 7));
+    }
+
+    // 没有提交的帧屏幕保持不变, 与另一模式的逐帧比较确认这些帧确实没有变化
+    TEST_EXPECT(!frameIdle || memcmp(frame, frame - SHOWN_FRAME_BYTES, SHOWN_FRAME_BYTES) == 0,
+                "frame not submitted but the panel changed");
+}
+
+/**
+ * @brief 两种模式的RAM占用
+ *
+ * @return RamUsageTypeDef
+ */
+static RamUsageTypeDef measureRam(void) {
+    RamUsageTypeDef ram = {0};
+    uint32_t unused     = 0;
+
+    ram.uiState = sizeof(ui) + sizeof(strBuffer);
+#if !STRIP_RENDER
+    ram.uiState += sizeof(dotMatrix) + sizeof(figureBackground);
+#endif /* STRIP_RENDER */
+    ram.oledObject = sizeof(oled) + sizeof(IICObjTypeDef);
+    ram.txBuffer   = OLED_TX_BUFFER_SIZE;
+
+    while (unused < sizeof(frameStack) && frameStack[unused] == STACK_PAINT) {
+        unused++;
+    }
+    ram.stackPeak = sizeof(frameStack) - unused;
+
+    return ram;
+}
+
+/**
+ * @brief 打印RAM占用, 页带渲染模式下与图形缓冲区模式并列
+ *
+ * @param column 各模式的RAM占用
+ * @param count 模式数量
+ */
+static void printRam(const RamUsageTypeDef* column[], uint8_t count) {
+    static const char* const name[]  = {"UI state", "OLED object", "IIC tx buffer", "host stack peak"};
+    static const char* const title[] = {"buffered", "strip"};
+    uint32_t total[2]                = {0};
+
+    printf("RAM (bytes)       ");
+    for (uint8_t c = 0; c < count; c++) {
+        printf("%10s", title[c]);
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        printf("\n  %-16s", name[i]);
+        for (uint8_t c = 0; c < count; c++) {
+            uint32_t value = (&column[c]->uiState)[i];
+            total[c] += value;
+            printf("%10u", value);
+        }
+    }
+    printf("\n  %-16s", "total");
+    for (uint8_t c = 0; c < count; c++) {
+        printf("%10u", total[c]);
+    }
+    printf("\n");
+}
+
+int main(void) {
+    static uint8_t frames[MAX_FRAMES][SHOWN_FRAME_BYTES]; // 脚本与随机阶段的全部画面
+    uint32_t count = 0;
+
+    setup();
+
+    for (uint8_t i = 0; i < sizeof(script) / sizeof(script[0]); i++) {
+        step(script[i].key, frames[count++]);
+        for (uint16_t n = 0; n < script[i].frames; n++) {
+            step(KEY_NONE, frames[count++]);
+        }
+    }
+    for (uint32_t n = 0; n < RANDOM_FRAMES; n++) {
+        uint32_t r = testRand() % 32; // 平均约每8帧一次输入
+        step(r < KEY_QUANTITY ? (KeyEnum)r : KEY_NONE, frames[count++]);
+    }
+
+    uint32_t changed = 0;
+    for (uint32_t i = 1; i < count; i++) {
+        changed += memcmp(frames[i], frames[i - 1], SHOWN_FRAME_BYTES) != 0;
+    }
+    printf("%s: %u frames, %u differ from the previous one, %u not submitted, %u samples, %u bus bytes\n",
+           MODE_NAME, count, changed, idleCount, sampleCount, simPanel.bytes);
+    TEST_EXPECT(simPanel.errors == 0, "%u malformed commands", simPanel.errors);
+
+    FramesHeaderTypeDef header = {"TESTUI1", count, measureRam()};
+#if STRIP_RENDER
+    FramesHeaderTypeDef reference;
+    FILE* file = fopen(FRAMES_FILE, "rb");
+
+    TEST_EXPECT(file != NULL, "cannot read %s, run test-ui first", FRAMES_FILE);
+    if (file == NULL) {
+        return TEST_RESULT();
+    }
+    if (fread(&reference, sizeof(reference), 1, file) != 1 || memcmp(reference.magic, header.magic, 8) != 0 ||
+        reference.frames != count) {
+        TEST_EXPECT(0, "%s does not come from the same input sequence", FRAMES_FILE);
+        fclose(file);
+        return TEST_RESULT();
+    }
+
+    uint32_t mismatched = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t expect[SHOWN_FRAME_BYTES];
+        if (fread(expect, sizeof(expect), 1, file) != 1) {
+            TEST_EXPECT(0, "%s truncated at frame %u", FRAMES_FILE, i);
+            break;
+        }
+        if (memcmp(expect, frames[i], SHOWN_FRAME_BYTES) != 0) {
+            TEST_EXPECT(mismatched > 0, "frame %u differs from the buffered mode", i);
+            mismatched++;
+        }
+    }
+    fclose(file);
+    TEST_EXPECT(mismatched == 0, "%u of %u frames differ from the buffered mode", mismatched, count);
+    printf("%u frames identical to the buffered mode\n", count - mismatched);
+
+    printRam((const RamUsageTypeDef*[]){&reference.ram, &header.ram}, 2);
+#else
+    FILE* file = fopen(FRAMES_FILE, "wb");
+
+    TEST_EXPECT(file != NULL, "cannot write %s", FRAMES_FILE);
+    if (file != NULL) {
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(frames, SHOWN_FRAME_BYTES, count, file);
+        fclose(file);
+    }
+
+    printRam((const RamUsageTypeDef*[]){&header.ram}, 1);
+#endif /* STRIP_RENDER */
+
+    return TEST_RESULT();
+}